@@ -0,0 +1,64 @@
+#ifndef AAUDIO_OUTPUT_H
+#define AAUDIO_OUTPUT_H
+
+#include <aaudio/AAudio.h>
+#include "AudioSource.h"
+
+namespace deepfilter {
+
+/**
+ * AAudio播放输出流
+ *
+ * 低延迟、独占模式的输出流，渲染回调在AAudio实时线程上调用；
+ * 缓冲区大小设为两个burst（低延迟下不易欠载的最小值）
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class AAudioOutput : public AudioOutput {
+public:
+    AAudioOutput();
+    ~AAudioOutput() override;
+
+    AAudioOutput(const AAudioOutput&) = delete;
+    AAudioOutput& operator=(const AAudioOutput&) = delete;
+
+    bool open(const AudioSourceConfig& config,
+              RenderCallback renderCallback,
+              ErrorCallback errorCallback,
+              void* userData) override;
+    bool start() override;
+    bool stop() override;
+    void close() override;
+
+    int32_t getSampleRate() const override { return sampleRate_; }
+    int32_t getFramesPerBurst() const override { return framesPerBurst_; }
+    const char* getLastError() const override { return lastError_; }
+
+private:
+    static aaudio_data_callback_result_t onData(
+        AAudioStream* stream,
+        void* userData,
+        void* audioData,
+        int32_t numFrames);
+
+    static void onError(
+        AAudioStream* stream,
+        void* userData,
+        aaudio_result_t error);
+
+    AAudioStream* stream_;
+    bool started_;
+    int32_t sampleRate_;
+    int32_t framesPerBurst_;
+
+    RenderCallback renderCallback_;
+    ErrorCallback errorCallback_;
+    void* userData_;
+
+    char lastError_[256];
+};
+
+} // namespace deepfilter
+
+#endif // AAUDIO_OUTPUT_H
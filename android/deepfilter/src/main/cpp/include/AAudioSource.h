@@ -0,0 +1,66 @@
+#ifndef AAUDIO_SOURCE_H
+#define AAUDIO_SOURCE_H
+
+#include <aaudio/AAudio.h>
+#include <atomic>
+#include "AudioSource.h"
+
+namespace deepfilter {
+
+/**
+ * AAudio录音音频源
+ *
+ * 低延迟、独占模式的输入流，数据回调在AAudio实时线程上调用；
+ * getTimestamp由AAudioStream_getTimestamp提供，帧位置换算为本次start之后交付的帧数
+ *
+ * @author hzexe
+ * @version 1.1
+ */
+class AAudioSource : public AudioSource {
+public:
+    AAudioSource();
+    ~AAudioSource() override;
+
+    AAudioSource(const AAudioSource&) = delete;
+    AAudioSource& operator=(const AAudioSource&) = delete;
+
+    bool open(const AudioSourceConfig& config,
+              DataCallback dataCallback,
+              ErrorCallback errorCallback,
+              void* userData) override;
+    bool start() override;
+    bool stop() override;
+    void close() override;
+
+    int32_t getSampleRate() const override { return sampleRate_; }
+    bool getTimestamp(int64_t* framePosition, int64_t* timeNs) const override;
+    const char* getLastError() const override { return lastError_; }
+
+private:
+    static aaudio_data_callback_result_t onData(
+        AAudioStream* stream,
+        void* userData,
+        void* audioData,
+        int32_t numFrames);
+
+    static void onError(
+        AAudioStream* stream,
+        void* userData,
+        aaudio_result_t error);
+
+    AAudioStream* stream_;
+    std::atomic<bool> started_;
+    int32_t sampleRate_;
+    // 本次start之后第一次数据回调交付的第一帧在流中的位置（-1表示尚未回调）
+    std::atomic<int64_t> firstFramePosition_;
+
+    DataCallback dataCallback_;
+    ErrorCallback errorCallback_;
+    void* userData_;
+
+    char lastError_[256];
+};
+
+} // namespace deepfilter
+
+#endif // AAUDIO_SOURCE_H
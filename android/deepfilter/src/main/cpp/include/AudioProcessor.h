@@ -5,47 +5,164 @@
 #include <functional>
 #include <thread>
 #include <mutex>
-#include <condition_variable>
-#include <queue>
 #include <atomic>
-#include <aaudio/AAudio.h>
+#include <semaphore.h>
+#include "AudioSource.h"
+#include "ComputeGate.h"
+#include "deepfilter_ort.h"
+#include "FramePool.h"
+#include "FrameRingBuffer.h"
+#include "HopReblocker.h"
+#include "LatencyHistogram.h"
+#include "ModelCache.h"
+#include "ParameterMailbox.h"
+#include "PlayoutBuffer.h"
+#include "PushAudioSource.h"
+#include "Resampler.h"
+#include "ThreadScheduling.h"
+#include <vector>
 
 namespace deepfilter {
 
 /**
- * 音频帧数据结构
+ * 音频处理器运行统计（每次start时清零）
  */
-struct AudioFrame {
-    float* data;
-    int32_t numFrames;
-    int64_t timestamp;
+struct AudioProcessorStats {
+    uint64_t processedFrames = 0;       // 已降噪的帧数
+    uint64_t droppedFrames = 0;         // 队列溢出丢弃的帧数
+    uint64_t failedFrames = 0;          // df_process_frame_interleaved处理出错（返回NaN）的帧数
+    uint64_t overBudgetFrames = 0;      // 降噪耗时超过帧时长（实时预算）的帧数
+    LatencySummary queueLatency;        // 采集回调到处理线程出队
+    LatencySummary processLatency;      // df_process_frame耗时
+    LatencySummary callbackLatency;     // 结果回调耗时
+    LatencySummary endToEndLatency;     // 采集回调到结果回调返回
+    int64_t resamplerLatencyUs = 0;     // 采样率转换引入的固定延迟（输入+输出，未计入上面各阶段）
+    uint64_t bypassedFrames = 0;        // 计算门控跳过模型推理的帧数（已计入processedFrames）
+    uint64_t syncFrames = 0;            // 同步模式下在采集回调中处理的帧数（已计入processedFrames）
+    uint64_t missedDeadlines = 0;       // 同步模式下采集回调超过截止时间的次数
+    bool syncFallback = false;          // 同步模式是否已因超时回退到异步处理
+    uint64_t pushedFrames = 0;          // 推送模式下接受的帧数（每声道）
+    uint64_t backpressureEvents = 0;    // 推送模式下因队列满未能全部接受的推送次数
+    uint64_t discontinuities = 0;       // 输出与上一块不连续的次数（队列溢出丢帧或处理失败）
+};
+
+/**
+ * 降噪结果块在采集流中的位置和时间（startWithFrameInfo的回调参数）
+ *
+ * 位置和时间已扣除模型算法延迟和采样率转换延迟，指向与本块第一个输出采样对应的输入采样；
+ * 启动后的前几块对应启动前的预卷，framePosition可能为负
+ */
+struct FrameInfo {
+    int64_t framePosition = 0;      // 对应的采集帧位置（采集采样率，每声道帧数，本次start之后第一帧为0）
+    int64_t timestampNs = 0;        // 该帧的采集时间（CLOCK_MONOTONIC纳秒）
+    bool discontinuity = false;     // 与上一块之间有帧未输出（队列溢出丢弃或处理失败）
+    int64_t droppedFrames = 0;      // 与上一块之间未输出的帧数（采集采样率）
+    bool hardwareTimestamp = false; // timestampNs来自音频源的硬件时间戳；false为按回调到达时刻估计
+};
+
+/**
+ * 延迟档位（处理中不可修改，下次start时生效）
+ *
+ * 模型前瞻固化在ONNX模型中，运行时无法修改；档位只决定管线部分，
+ * 低延迟档位需要配合零前瞻模型（如DeepFilterNet3_ll）才能去掉前瞻延迟
+ */
+enum class LatencyProfile {
+    HIGH_QUALITY = 0,   // 异步处理（队列吸收推理耗时抖动），双工播放缓冲目标为一个hop加两个burst
+    LOW_LATENCY = 1     // 同步处理（超时回退异步），双工播放缓冲目标为一个hop加一个burst
+};
+
+/**
+ * 推理后端（initialize创建降噪实例时选择，见df_create_from_model_backend）
+ */
+enum class InferenceBackend {
+    TRACT = DF_BACKEND_TRACT    // libDF的tract实现（默认，目前唯一的后端）
+};
+
+/**
+ * 管线延迟分解（帧数均为每声道采样点数，按输出采样率换算）
+ *
+ * 固定部分（算法、分块、重采样、播放缓冲目标）由配置决定；queueFrames为调用时刻队列中积压的hop，
+ * 同步处理时为0。推理和回调耗时不计入，实测值见AudioProcessorStats::endToEndLatency
+ */
+struct PipelineDelay {
+    int32_t sampleRate = 0;             // 下列帧数的采样率（输出采样率）
+    int32_t lookaheadHops = 0;          // 模型前瞻（hop数，零前瞻模型为0）
+    int64_t algorithmicFrames = 0;      // 模型算法延迟：STFT窗口重叠 + 前瞻（见df_get_algorithmic_delay）
+    int64_t blockingFrames = 0;         // 采集端攒满一个hop的分块延迟
+    int64_t queueFrames = 0;            // 队列中积压的hop
+    int64_t resamplerFrames = 0;        // 采样率转换（输入+输出）
+    int64_t playoutFrames = 0;          // 双工模式播放缓冲目标深度（非双工为0）
+    int64_t totalFrames = 0;            // 以上之和
 };
 
 /**
  * 音频处理器类
  * 
  * 功能说明：
- * 1. 集成AAudio音频录制和deepfilter-ort降噪处理
+ * 1. 集成音频采集（默认AAudio，可替换为任意AudioSource）和deepfilter-ort降噪处理
  * 2. 实现录制后立即降噪的完整流程（异步处理）
  * 3. 支持配置降噪参数（tar_bytes、post_filter_beta、atten_lim_db）
  * 4. 提供实时音频降噪处理接口
- * 5. 音频格式固定：48kHz、单声道、PCM_FLOAT
+ * 5. 音频格式：PCM_FLOAT，默认单声道；默认按设备原生采样率采集，在采集回调中转换为模型的48kHz，
+ *    结果可再转换为调用方指定的输出采样率（默认48kHz）
  * 6. 使用异步处理避免阻塞音频采集线程
+ * 7. 采集线程与处理线程之间使用无锁环形缓冲区，采集回调中不加锁、不分配内存；
+ *    音频设备按自身最佳burst大小回调，回调中重新分块为模型hop大小后入队
+ * 8. 所有帧缓冲区来自初始化时分配的对齐帧池，稳态运行零堆分配
+ * 9. 不依赖Android时可在Linux主机上用模拟音频源驱动同一条管线（基准测试、回归测试）
+ * 10. 支持多声道（多麦克风）采集：交织数据按声道数整体分块入队，所有声道在一次推理中降噪，
+ *    结果仍为交织布局；多声道时采集和输出固定为48kHz
+ * 11. 可选计算门控（ComputeGate）：静音或干净语音时跳过模型推理，过渡处交叉淡化
+ * 12. 处理线程可配置调度策略（SCHED_FIFO/nice）和CPU亲和性（性能核心/指定核心），
+ *    队列积压时自动提升，并逐hop记录运行的CPU核心
+ * 13. 可选同步模式：在采集回调中直接降噪并输出，省去队列和线程唤醒；回调超时时自动回退到异步处理
+ * 14. 双工（监听）模式：降噪结果经无锁播放缓冲区送入输出流（默认AAudio），
+ *    按缓冲深度微调读取速率，补偿采集与播放设备之间的时钟漂移
+ * 15. 报告模型算法延迟和完整管线延迟分解；低延迟/高质量两种档位可在运行时切换
+ * 16. 降噪参数经无锁邮箱在hop边界下发，按斜坡平滑过渡，可在处理中从任意线程高频调整
+ * 17. 可选FP16/INT8量化模型变体（来自同一tar.gz或单独的变体包），按设备档位在速度和精度间取舍
+ * 18. 推理后端在创建实例时选择（见InferenceBackend），C接口与后端无关
+ * 19. 推送模式：不打开采集设备，由调用方推送PCM16/f32数据，复用同一条分块、队列和处理线程；
+ *    队列满时推送只接受放得下的部分（可限时等待），调用方据此反压，不会丢帧
+ * 20. 结果可附带采集帧位置和纳秒采集时间戳（扣除模型和重采样延迟），队列溢出丢帧时标记不连续
  * 
  * @author hzexe
- * @version 2.1
+ * @version 2.14
  */
 class AudioProcessor {
 public:
     /**
      * 降噪音频数据回调函数类型
      * 
-     * @param audioData 降噪后的音频数据（f32格式，单声道）
-     * @param numFrames 帧数
+     * @param audioData 降噪后的音频数据（f32格式，多声道时为交织布局）
+     * @param numFrames 每声道帧数
      * @param lsnr LSNR值（信噪比）
      */
     using AudioCallback = std::function<void(const float* audioData, int32_t numFrames, float lsnr)>;
 
+    /**
+     * 直接输出模式通知回调函数类型
+     * 
+     * 降噪数据已写入调用方提供的共享输出环（如Java direct ByteBuffer），
+     * 回调只通知槽位置，不传递数据
+     * 
+     * @param slotIndex 本次写入的槽索引
+     * @param numFrames 每声道帧数
+     * @param lsnr LSNR值（信噪比）
+     */
+    using DirectCallback = std::function<void(int32_t slotIndex, int32_t numFrames, float lsnr)>;
+
+    /**
+     * 带位置和时间信息的降噪音频数据回调函数类型
+     * 
+     * @param audioData 降噪后的音频数据（f32格式，多声道时为交织布局）
+     * @param numFrames 每声道帧数
+     * @param lsnr LSNR值（信噪比）
+     * @param info 本块对应的采集帧位置、采集时间和不连续标记
+     */
+    using FrameCallback = std::function<void(const float* audioData, int32_t numFrames, float lsnr,
+                                             const FrameInfo& info)>;
+
     /**
      * 构造函数
      */
@@ -56,6 +173,201 @@ public:
      */
     ~AudioProcessor();
 
+    /**
+     * 设置音频源（需在initialize之前调用）
+     * 
+     * 未设置时Android上默认使用AAudioSource；主机构建必须设置
+     * 
+     * @param source 音频源（所有权转移给处理器）
+     * @return true-设置成功，false-正在处理中
+     */
+    bool setAudioSource(std::unique_ptr<AudioSource> source);
+
+    /**
+     * 设置双工模式的输出流（需在startDuplex之前调用）
+     * 
+     * 未设置时Android上默认使用AAudioOutput；主机构建必须设置
+     * 
+     * @param output 输出流（所有权转移给处理器）
+     * @return true-设置成功，false-正在处理中
+     */
+    bool setAudioOutput(std::unique_ptr<AudioOutput> output);
+
+    /**
+     * 设置推送模式（需在initialize之前调用）
+     * 
+     * 启用后使用PushAudioSource作为音频源：不打开采集设备，数据由pushFloat/pushPcm16送入，
+     * 按setCaptureSampleRate设置的采样率（默认48kHz）和setChannelCount设置的声道数解释；
+     * start/startDirect/startDuplex与采集模式相同。关闭后恢复默认音频源
+     * 
+     * @param enabled 是否启用
+     * @return true-设置成功，false-正在处理中
+     */
+    bool setPushMode(bool enabled);
+
+    bool isPushMode() const { return pushSource_ != nullptr; }
+
+    /**
+     * 推送f32数据（推送模式，start之后调用；同一时刻只能有一个线程推送）
+     * 
+     * 数据在调用线程上完成重采样和分块后入队，由处理线程降噪（同步模式下在调用线程上直接降噪）。
+     * 队列放不下全部数据时只接受放得下的前一部分：timeoutMs为0时立即返回，
+     * 否则等待处理线程腾出空间直到全部接受或超时。未接受的部分由调用方稍后重新推送
+     * 
+     * @param samples 音频数据（交织，numFrames × 声道数个采样点）
+     * @param numFrames 每声道帧数
+     * @param timeoutMs 队列满时最长等待时间（毫秒），0表示不等待
+     * @return 接受的帧数（0~numFrames），-1表示未处于推送模式、未启动或参数无效
+     */
+    int32_t pushFloat(const float* samples, int32_t numFrames, int32_t timeoutMs);
+
+    /**
+     * 推送PCM16数据（见pushFloat；按块转换为f32，NEON/AVX2/SSE2向量化，不分配内存）
+     * 
+     * @param samples 音频数据（本机字节序，交织）
+     * @param numFrames 每声道帧数
+     * @param timeoutMs 队列满时最长等待时间（毫秒），0表示不等待
+     * @return 接受的帧数（0~numFrames），-1表示未处于推送模式、未启动或参数无效
+     */
+    int32_t pushPcm16(const int16_t* samples, int32_t numFrames, int32_t timeoutMs);
+
+    /**
+     * 当前不等待即可推送的帧数（推送线程调用；按队列空闲槽保守估计）
+     * 
+     * @return 帧数（每声道），未处于推送模式或未启动时返回0
+     */
+    int32_t getPushableFrames() const;
+
+    /**
+     * 设置采集采样率（需在initialize之前调用）
+     * 
+     * 默认0，即按设备原生采样率打开音频流（避免系统重采样，更容易进入低延迟路径），
+     * 在采集回调中转换为模型采样率48kHz
+     * 
+     * @param sampleRate 采集采样率（Hz），0表示设备原生采样率
+     * @return true-设置成功，false-参数无效或正在处理中
+     */
+    bool setCaptureSampleRate(int32_t sampleRate);
+
+    /**
+     * 设置输出采样率（需在initialize之前调用）
+     * 
+     * 与模型采样率不同时，降噪结果在处理线程上转换后再回调（每次回调的帧数随之变化）
+     * 
+     * @param sampleRate 输出采样率（Hz），0表示模型采样率48kHz
+     * @return true-设置成功，false-参数无效或正在处理中
+     */
+    bool setOutputSampleRate(int32_t sampleRate);
+
+    /**
+     * 设置采集声道数（需在initialize之前调用）
+     * 
+     * 大于1时按交织格式采集多个麦克风，创建同声道数的降噪实例（见df_create_from_model_ex），
+     * 回调数据同样为交织布局；不支持采样率转换，采集采样率默认请求48kHz
+     * 
+     * @param channelCount 声道数（1~16）
+     * @return true-设置成功，false-参数无效或正在处理中
+     */
+    bool setChannelCount(int32_t channelCount);
+
+    /**
+     * 设置计算门控（处理中不可修改，下次start时生效）
+     * 
+     * 启用后处理线程逐hop检测静音（能量）和干净语音（LSNR历史），满足条件时跳过模型推理，
+     * 输出改为按增益旁路的输入，进入和退出旁路时交叉淡化；跳过的帧数见AudioProcessorStats::bypassedFrames。
+     * 旁路信号按模型算法延迟对齐，getPipelineDelay在旁路期间同样准确
+     * 
+     * @param config 门控配置（enabled为false时关闭）
+     * @return true-设置成功，false-参数无效或正在处理中
+     */
+    bool setComputeGate(const ComputeGateConfig& config);
+
+    /**
+     * 获取计算门控统计（每次start时清零）
+     */
+    ComputeGateStats getComputeGateStats() const;
+
+    /**
+     * 设置处理线程调度（处理中不可修改，下次start时生效）
+     * 
+     * 处理线程启动时应用优先级和CPU亲和性；PERFORMANCE_CORES和积压提升使用从sysfs识别的性能核心。
+     * 没有SCHED_FIFO权限（Android应用通常如此）时退回nice值
+     * 
+     * @param config 调度配置
+     * @return true-设置成功，false-参数无效或正在处理中
+     */
+    bool setThreadScheduling(const ThreadSchedulingConfig& config);
+
+    /**
+     * 获取处理线程调度统计（各核心hop数、提升次数，每次start时清零）
+     */
+    ThreadSchedulingStats getThreadSchedulingStats() const;
+
+    /**
+     * 获取识别到的CPU拓扑（构造时从sysfs读取）
+     */
+    const CpuTopology& getCpuTopology() const { return cpuTopology_; }
+
+    /**
+     * 设置同步处理模式（处理中不可修改，下次start时生效）
+     * 
+     * 启用后在采集回调中攒满一个hop即直接降噪并输出（回调、sink或直接输出环），
+     * 不经过队列和处理线程，省去至少一个hop的排队和一次线程唤醒。
+     * 输出回调因此运行在采集回调线程上，不得阻塞；配合AudioSink可把结果直接送入输出流。
+     * 
+     * 单次采集回调的处理耗时超过回调时长 × deadlineRatio记为一次超时，
+     * 每100个hop内超时达到maxMissedDeadlines次时，本次运行剩余时间回退到异步处理
+     * 
+     * @param enabled 是否启用
+     * @param deadlineRatio 截止时间占采集回调时长的比例（0~1]
+     * @param maxMissedDeadlines 触发回退的超时次数（>=1）
+     * @return true-设置成功，false-参数无效或正在处理中
+     */
+    bool setSynchronousMode(bool enabled, float deadlineRatio = 0.8f, int32_t maxMissedDeadlines = 3);
+
+    /**
+     * 当前是否在采集回调中同步处理（启用同步模式且尚未回退）
+     */
+    bool isSynchronousActive() const { return syncActive_.load(std::memory_order_relaxed); }
+
+    /**
+     * 获取同步模式的截止比例和回退阈值（setSynchronousMode设置的值，切换延迟档位时保留）
+     */
+    float getSynchronousDeadlineRatio() const { return syncDeadlineRatio_; }
+    int32_t getSynchronousMaxMissedDeadlines() const { return syncMaxMisses_; }
+
+    /**
+     * 设置延迟档位（处理中不可修改，下次start时生效）
+     * 
+     * LOW_LATENCY启用同步模式并把双工播放缓冲目标减为一个hop加一个burst；
+     * HIGH_QUALITY关闭同步模式并恢复默认播放缓冲深度。档位只切换同步模式的开关，
+     * 之前通过setSynchronousMode设置的截止比例和回退阈值保持不变。
+     * 模型前瞻不随档位变化，低延迟档位配合有前瞻的模型时start会输出警告
+     * 
+     * @param profile 延迟档位
+     * @return true-设置成功，false-正在处理中
+     */
+    bool setLatencyProfile(LatencyProfile profile);
+
+    LatencyProfile getLatencyProfile() const { return latencyProfile_; }
+
+    /**
+     * 设置推理后端（需在initialize之前调用，下次initialize时生效）
+     * 
+     * @param backend 推理后端，默认TRACT
+     * @return true-设置成功，false-当前构建不包含该后端或正在处理中
+     */
+    bool setInferenceBackend(InferenceBackend backend);
+
+    InferenceBackend getInferenceBackend() const { return inferenceBackend_; }
+
+    /**
+     * 获取管线延迟分解（initialize之后有效，任意线程可调用）
+     * 
+     * @return 各部分延迟及总和（按输出采样率），未初始化时全部为0
+     */
+    PipelineDelay getPipelineDelay() const;
+
     /**
      * 初始化音频处理器
      * 
@@ -71,6 +383,21 @@ public:
         float postFilterBeta,
         float attenLimDb);
 
+    /**
+     * 从已加载的共享模型初始化音频处理器（见df_model_load）
+     * 
+     * 不再重复解压和解析模型，适合同一进程内创建多个处理器
+     * 
+     * @param model 模型句柄（初始化完成后即可释放）
+     * @param postFilterBeta 后滤波器beta参数（控制降噪强度）
+     * @param attenLimDb 衰减限制（dB）
+     * @return true-初始化成功，false-初始化失败
+     */
+    bool initializeFromModel(
+        const void* model,
+        float postFilterBeta,
+        float attenLimDb);
+
     /**
      * 开始录制和降噪处理
      * 
@@ -79,6 +406,61 @@ public:
      */
     bool start(AudioCallback callback);
 
+    /**
+     * 开始录制和降噪处理，结果写入sink
+     * 
+     * @param sink 输出（停止前必须保持有效）
+     * @return true-开始成功，false-开始失败
+     */
+    bool start(AudioSink* sink);
+
+    /**
+     * 开始录制和降噪处理，每块结果附带采集帧位置和采集时间
+     * 
+     * 音频源提供时间戳时（AAudio的AAudioStream_getTimestamp），处理线程定期查询并以此换算各块的采集时间，
+     * 跟随采集时钟与单调时钟之间的漂移；否则（主机音频源、推送模式）按hop到达时刻估计。
+     * 同步模式下不查询时间戳（采集回调为实时线程），使用估计值。
+     * 丢帧（队列溢出）或处理失败后的第一块标记为不连续，并给出中间缺少的帧数
+     * 
+     * @param callback 降噪音频数据回调函数
+     * @return true-开始成功，false-开始失败
+     */
+    bool startWithFrameInfo(FrameCallback callback);
+
+    /**
+     * 以直接输出模式开始录制和降噪处理
+     * 
+     * 降噪结果由处理线程直接写入outputRing的第(n % slotCount)个槽（每槽frameSize × 声道数个采样点，交织布局），
+     * 不再经过中间缓冲区。调用方可通过callback获取通知，或轮询getDirectWriteCount()。
+     * 
+     * 输出采样率与模型采样率不同时不可用（槽大小固定为一帧）
+     * 
+     * @param outputRing 共享输出环首地址，至少slotCount * getFrameSize() * getChannelCount()个float，停止前必须保持有效
+     * @param slotCount 槽数量
+     * @param callback 写入通知回调（可为nullptr，表示调用方轮询）
+     * @return true-开始成功，false-开始失败
+     */
+    bool startDirect(float* outputRing, size_t slotCount, DirectCallback callback);
+
+    /**
+     * 以双工（监听）模式开始录制和降噪处理
+     * 
+     * 按输出采样率和声道数打开输出流，降噪结果写入无锁播放缓冲区，由输出流的渲染回调读出播放。
+     * 播放缓冲区目标深度为一个hop加两个输出burst（低延迟档位为一个，附加延迟见getPlayoutStats().targetFrames），
+     * 读取端按缓冲深度微调速率（±0.1%以内），补偿采集与播放设备的时钟偏差；
+     * 启动和欠载时先输出静音直到缓冲达到目标深度。
+     * 启用同步模式时降噪结果在采集回调中直接写入播放缓冲区
+     * 
+     * @param monitor 降噪结果的附加回调（可为nullptr；与写入播放缓冲区在同一线程，不得阻塞）
+     * @return true-开始成功，false-开始失败
+     */
+    bool startDuplex(AudioCallback monitor = nullptr);
+
+    /**
+     * 获取双工模式播放缓冲区统计（欠载、溢出、缓冲深度、漂移修正，每次startDuplex时清零）
+     */
+    PlayoutBufferStats getPlayoutStats() const;
+
     /**
      * 停止录制和降噪处理
      * 
@@ -115,37 +497,62 @@ public:
     /**
      * 设置后滤波器beta参数
      * 
+     * 任意线程可调用（无锁，可逐hop调用）：写入参数邮箱，由处理线程在下一个hop开始前读取，
+     * 在斜坡时长内逐hop过渡到新值（见setParameterRamp）；未在处理时于下次start的首个hop生效
+     * 
      * @param beta beta参数值
-     * @return true-设置成功，false-设置失败
+     * @return true-设置成功，false-未初始化或参数无效
      */
     bool setPostFilterBeta(float beta);
 
     /**
      * 设置衰减限制
      * 
+     * 与setPostFilterBeta相同，经参数邮箱在hop边界平滑生效
+     * 
      * @param attenLimDb 衰减限制（dB）
-     * @return true-设置成功，false-设置失败
+     * @return true-设置成功，false-未初始化或参数无效
      */
     bool setAttenLimDb(float attenLimDb);
 
     /**
-     * 获取当前采样率
+     * 设置参数斜坡时长（任意时刻可调用，下一次参数变化时生效）
      * 
-     * @return 采样率（Hz），固定为48000
+     * @param milliseconds 从旧值过渡到新值的时长（毫秒，按hop向上取整），0表示下一个hop直接生效；默认50ms
+     * @return true-设置成功，false-参数无效
+     */
+    bool setParameterRamp(int32_t milliseconds);
+
+    /**
+     * 获取参数邮箱统计（写入次数、下发次数、目标值和当前生效值）
+     */
+    ParameterMailboxStats getParameterStats() const;
+
+    /**
+     * 获取输出采样率（回调数据的采样率）
+     * 
+     * @return 采样率（Hz），默认48000
      */
     int32_t getSampleRate() const;
 
+    /**
+     * 获取实际采集采样率
+     * 
+     * @return 采样率（Hz），未初始化时返回0
+     */
+    int32_t getCaptureSampleRate() const;
+
     /**
      * 获取当前声道数
      * 
-     * @return 声道数，固定为1
+     * @return 声道数，默认1
      */
     int32_t getChannelCount() const;
 
     /**
      * 获取当前帧大小
      * 
-     * @return 帧大小（采样点数）
+     * @return 帧大小（每声道采样点数）
      */
     int32_t getFrameSize() const;
 
@@ -156,38 +563,208 @@ public:
      */
     size_t getQueueSize() const;
 
+    /**
+     * 设置队列溢出策略
+     * 
+     * @param policy 溢出策略（丢弃最旧帧或丢弃最新帧）
+     */
+    void setOverflowPolicy(OverflowPolicy policy);
+
+    /**
+     * 获取队列溢出策略
+     * 
+     * @return 溢出策略
+     */
+    OverflowPolicy getOverflowPolicy() const;
+
+    /**
+     * 获取因队列溢出而丢弃的帧数
+     * 
+     * @return 丢弃帧数（每次start时清零）
+     */
+    uint64_t getDroppedFrameCount() const;
+
+    /**
+     * 获取帧池统计信息
+     * 
+     * @return 帧池统计（heapAllocations在initialize之后保持不变即表示稳态零堆分配）
+     */
+    FramePoolStats getFramePoolStats() const;
+
+    /**
+     * 获取直接输出模式下已写入的槽总数
+     * 
+     * 最新数据位于槽 (count - 1) % slotCount，计数以release语义更新，
+     * 读取到计数后对应槽的数据已完整写入
+     * 
+     * @return 已写入的槽总数（每次start时清零）
+     */
+    uint64_t getDirectWriteCount() const;
+
+    /**
+     * 获取运行统计快照（任意线程可调用，不阻塞处理线程）
+     * 
+     * @return 各阶段延迟分布（p50/p95/p99/max）和丢帧、失败计数
+     */
+    AudioProcessorStats getStats() const;
+
+    /**
+     * 设置模型解压缓存目录（需在initialize之前调用）
+     * 
+     * 设置后首次initialize把模型重新打包为不压缩格式写入该目录，
+     * 之后的initialize命中缓存时通过内存映射加载，省去解压；
+     * ONNX解析和图优化不在缓存范围内，每次initialize仍会执行（各阶段耗时见bench_model_startup）
+     * 
+     * @param directory 缓存目录（如应用的cacheDir），nullptr表示禁用缓存
+     */
+    void setModelCacheDir(const char* directory);
+
+    /**
+     * 上一次initialize是否命中模型解压缓存
+     */
+    bool isModelCacheHit() const { return modelCacheHit_; }
+
+    /**
+     * 设置模型精度（需在initialize之前调用，对initializeFromModel无效）
+     * 
+     * 非FP32时initialize从模型或变体包中选择训练后量化的子网络（enc/erb_dec/df_dec的_fp16或_int8变体），
+     * 组装后的模型按精度单独缓存；缺少所选精度的子网络时initialize失败
+     * 
+     * @param precision 模型精度，默认FP32
+     * @param variantBytes 变体包（tar.gz格式，可为nullptr表示变体在模型tar.gz中），内部复制
+     * @param variantSize 变体包大小
+     * @return true-设置成功，false-精度无效或正在处理中
+     */
+    bool setModelPrecision(ModelPrecision precision, const uint8_t* variantBytes, size_t variantSize);
+
+    ModelPrecision getModelPrecision() const { return modelPrecision_; }
+
 private:
     /**
-     * AAudio数据回调函数（快速将数据放入队列）
+     * 音频源数据回调函数（快速将数据放入环形缓冲区，无锁、无分配、无日志）
      */
-    static aaudio_data_callback_result_t dataCallback(
-        AAudioStream* stream,
+    static void dataCallback(
         void* userData,
-        void* audioData,
+        const float* samples,
         int32_t numFrames);
 
     /**
-     * AAudio错误回调函数
+     * 推送数据直到全部接受或截止时刻（deadlineNs为0时不等待）
+     * 
+     * @return 接受的帧数
+     */
+    int32_t pushFrames(const float* samples, int32_t numFrames, int64_t deadlineNs);
+
+    /**
+     * 等待处理线程从队列取走数据或截止时刻到达
+     * 
+     * @return false-已到截止时刻
+     */
+    bool waitForPushSpace(int64_t deadlineNs);
+
+    /**
+     * 推送超时时长换算为截止时刻（0表示不等待）
+     */
+    static int64_t pushDeadlineFor(int32_t timeoutMs);
+
+    /**
+     * 音频源错误回调函数
      */
     static void errorCallback(
-        AAudioStream* stream,
         void* userData,
-        aaudio_result_t error);
+        bool disconnected,
+        const char* message);
 
     /**
-     * 异步处理线程函数（从队列取数据进行降噪）
+     * 在单独的线程上停止处理（设备断开时由错误回调调用）
+     * 
+     * AAudio不允许在流自己的回调中停止或关闭流，stop()也会等待音频源线程退出，
+     * 因此错误回调只启动停止线程，不直接调用stop()
+     */
+    void requestDeferredStop();
+
+    /**
+     * 等待停止线程结束（start/release前调用，不能在停止线程上调用）
+     */
+    void joinDeferredStop();
+
+    /**
+     * 输出流渲染回调（从播放缓冲区读取，无锁、无分配、无日志）
+     */
+    static void renderCallback(
+        void* userData,
+        float* samples,
+        int32_t numFrames);
+
+    /**
+     * 异步处理线程函数（从环形缓冲区取数据进行降噪）
      */
     void processingThreadFunc();
 
     /**
-     * 初始化AAudio流
+     * 降噪并输出一个hop（处理线程或同步模式下的采集回调调用）
+     * 
+     * @param data hop数据（交织）
+     * @param numSamples 采样点数（hop × 声道数）
+     * @param captureNs 采集时间戳
+     * @param startNs 开始处理的时刻
+     * @return LSNR（可为负），NaN表示处理失败
+     */
+    float processHop(const float* data, int32_t numSamples, int64_t position, int64_t captureNs, int64_t startNs);
+
+    /**
+     * 计算降噪结果块的采集位置和时间，检测与上一块之间的不连续
+     * 
+     * @param position hop第一个采样在模型采样率下的位置
+     * @param numFrames hop帧数
+     * @param captureNs hop最后一个采样到达的时刻
+     */
+    FrameInfo makeFrameInfo(int64_t position, int32_t numFrames, int64_t captureNs);
+
+    /**
+     * 定期从音频源查询采集时间戳（处理线程调用，不在实时线程上查询）
+     */
+    void refreshTimestampAnchor();
+
+    /**
+     * 从参数邮箱读取本hop的参数，有变化时下发给模型（处理线程或同步模式下的采集回调调用）
+     */
+    void applyParameters();
+
+    /**
+     * 斜坡时长换算为hop数
      */
-    bool initAAudioStream();
+    int32_t rampHopsFor(int32_t milliseconds) const;
 
     /**
-     * 关闭AAudio流
+     * 同步模式下检查采集回调是否超过截止时间，超时过多时回退到异步处理（采集回调线程调用）
      */
-    void closeAAudioStream();
+    void checkSyncDeadline(int64_t callbackStartNs, int32_t numFrames);
+
+    /**
+     * 打开音频源
+     */
+    bool openAudioSource();
+
+    /**
+     * 关闭音频源
+     */
+    void closeAudioSource();
+
+    /**
+     * 打开双工模式输出流
+     */
+    bool openAudioOutput();
+
+    /**
+     * 关闭双工模式输出流
+     */
+    void closeAudioOutput();
+
+    /**
+     * 按实际采集采样率和输出采样率初始化重采样器
+     */
+    bool initResamplers();
 
     /**
      * 停止处理线程
@@ -195,14 +772,14 @@ private:
     void stopProcessingThread();
 
     /**
-     * 分配音频帧
+     * 启动处理线程和音频源（start/startDirect共用）
      */
-    AudioFrame* allocateAudioFrame(int32_t numFrames);
+    bool startInternal();
 
     /**
-     * 释放音频帧
+     * 单调时钟（纳秒），与采集时间戳同一时基
      */
-    void freeAudioFrame(AudioFrame* frame);
+    static int64_t nowNs();
 
 private:
     // DeepFilterNet状态
@@ -210,31 +787,164 @@ private:
     bool dfInitialized_;
     size_t frameSize_;
 
-    // AAudio流
-    AAudioStream* aaudioStream_;
-    bool aaudioInitialized_;
+    // 音频源
+    std::unique_ptr<AudioSource> audioSource_;
+    bool audioSourceOpened_;
+
+    // 推送模式（pushSource_指向audioSource_，处理线程每取走一个hop发一次空间信号）
+    PushAudioSource* pushSource_;
+    sem_t spaceSemaphore_;
+    std::vector<float> pushConvertBuffer_;     // PCM16转换缓冲区（start时分配）
+    std::atomic<uint64_t> pushedFrames_;
+    std::atomic<uint64_t> backpressureEvents_;
+
+    // 双工模式输出流和播放缓冲区（处理线程或同步模式下的采集回调写入，渲染回调读取）
+    std::unique_ptr<AudioOutput> audioOutput_;
+    bool audioOutputOpened_;
+    bool duplexActive_;
+    PlayoutBuffer playoutBuffer_;
+    AudioCallback monitorCallback_;
+    int32_t playoutBursts_;     // 播放缓冲目标中的输出burst数（由延迟档位决定）
+
+    // 延迟档位
+    LatencyProfile latencyProfile_;
+
+    // 推理后端
+    InferenceBackend inferenceBackend_;
+
+    // 降噪参数邮箱（任意线程写入，处理线程在hop边界读取并下发）
+    ParameterMailbox parameterMailbox_;
+    std::atomic<int32_t> parameterRampMs_;
 
     // 异步处理线程
     std::thread* processingThread_;
     std::atomic<bool> processingThreadRunning_;
     
-    // 音频数据队列
-    std::queue<AudioFrame*> audioQueue_;
-    mutable std::mutex queueMutex_;
-    std::condition_variable queueCondition_;
+    // 帧池（环形缓冲区槽 + 处理线程工作帧）
+    FramePool framePool_;
+    
+    // 采集数据按hop重新分块（仅采集回调线程访问）
+    HopReblocker inputReblocker_;
+
+    // 计算门控（处理线程访问，配置在start时生效）
+    ComputeGateConfig gateConfig_;
+    ComputeGate computeGate_;
+
+    // 处理线程调度（配置在setThreadScheduling时校验，处理线程启动时应用）
+    CpuTopology cpuTopology_;
+    ThreadScheduler threadScheduler_;
+
+    // 采样率转换：采集率->模型采样率（采集回调线程），模型采样率->输出采样率（处理线程）
+    int32_t requestedCaptureRate_;
+    int32_t captureSampleRate_;
+    int32_t outputSampleRate_;
+    int32_t channelCount_;
+    Resampler inputResampler_;
+    Resampler outputResampler_;
+    std::vector<float> inputResampleBuffer_;
+    std::vector<float> outputResampleBuffer_;
+
+    // 音频数据队列（单生产者/单消费者无锁环形缓冲区）
+    FrameRingBuffer audioRing_;
+    OverflowPolicy overflowPolicy_;
+    
+    // 新数据到达信号（sem_post可在实时线程中安全调用）
+    sem_t frameSemaphore_;
+    
+    // 处理线程工作帧（从帧池借出）
+    AudioFrame* workFrame_;
+    AudioFrame* outputFrame_;
     
     // 回调函数
     AudioCallback callback_;
+    
+    // 直接输出模式
+    float* directRing_;
+    size_t directSlotCount_;
+    DirectCallback directCallback_;
+    std::atomic<uint64_t> directWriteCount_;
+
+    // 带位置和时间信息的回调
+    FrameCallback frameCallback_;
+
+    // 采集位置（模型采样率下的hop计数仅采集回调线程访问；期望位置由输出方更新）
+    int64_t inputHops_;
+    int64_t expectedPosition_;
+    int64_t modelDelayFrames_;      // 模型算法延迟 + 重采样延迟（模型采样率，start时计算）
+    std::atomic<uint64_t> discontinuities_;
+
+    // 采集时间戳锚点（处理线程访问）：采集位置anchorPosition_的帧在anchorTimeNs_时刻被采集
+    bool anchorValid_;
+    int64_t anchorPosition_;
+    int64_t anchorTimeNs_;
+    int32_t anchorCountdown_;
+
+    // 同步模式（配置在start时生效；计数仅采集回调线程访问）
+    bool syncRequested_;
+    float syncDeadlineRatio_;
+    int32_t syncMaxMisses_;
+    std::atomic<bool> syncActive_;
+    std::atomic<bool> syncFallback_;
+    int32_t syncWindowMisses_;
+    int32_t syncWindowHops_;
+    std::atomic<uint64_t> syncFrames_;
+    std::atomic<uint64_t> missedDeadlines_;
 
     // 处理状态
     std::atomic<bool> isProcessing_;
 
-    // 音频格式（固定）
+    // stop()互斥（调用方线程与设备断开时的停止线程）
+    std::mutex stopMutex_;
+    std::mutex deferredStopMutex_;
+    std::thread deferredStopThread_;
+
+    // 运行统计（处理线程写入，getStats读取）
+    LatencyHistogram queueLatency_;
+    LatencyHistogram processLatency_;
+    LatencyHistogram callbackLatency_;
+    LatencyHistogram endToEndLatency_;
+    std::atomic<uint64_t> processedFrames_;
+    std::atomic<uint64_t> failedFrames_;
+    std::atomic<uint64_t> overBudgetFrames_;
+
+    // 模型采样率（固定）
     static const int32_t SAMPLE_RATE = 48000;
-    static const int32_t CHANNEL_COUNT = 1;
+
+    // 最大声道数（与deepfilter-ort一致）
+    static const int32_t MAX_CHANNEL_COUNT = 16;
     
     // 队列最大大小（防止内存溢出）
     static const size_t MAX_QUEUE_SIZE = 10;
+    
+    // 帧池中除队列槽外的工作帧数量（处理线程输入帧 + 输出帧）
+    static const size_t WORK_FRAME_COUNT = 2;
+
+    // 播放缓冲区容量（目标深度的倍数）
+    static const size_t PLAYOUT_CAPACITY_FACTOR = 4;
+
+    // 默认参数斜坡时长（毫秒）
+    static const int32_t DEFAULT_PARAMETER_RAMP_MS = 50;
+
+    // 同步模式统计超时次数的窗口（hop数）
+    static const int32_t SYNC_MISS_WINDOW_HOPS = 100;
+
+    // 采集回调中单次采样率转换的最大输入帧数（更大的回调分块处理）
+    static const size_t RESAMPLE_BLOCK_FRAMES = 1024;
+
+    // 采集时间戳查询间隔（hop数）：尚未取得时间戳时较短，之后较长（跟随漂移）
+    static const int32_t TIMESTAMP_RETRY_HOPS = 10;
+    static const int32_t TIMESTAMP_REFRESH_HOPS = 100;
+
+    // pushPcm16单次转换的最大帧数（每声道）
+    static const size_t PUSH_CONVERT_FRAMES = 1024;
+
+    // 模型磁盘缓存
+    ModelCache modelCache_;
+    bool modelCacheHit_;
+
+    // 模型精度和变体包（initialize时使用）
+    ModelPrecision modelPrecision_;
+    std::vector<uint8_t> modelVariant_;
 
     // 错误信息
     char lastError_[256];
@@ -0,0 +1,205 @@
+#ifndef AUDIO_SOURCE_H
+#define AUDIO_SOURCE_H
+
+#include <cstdint>
+
+namespace deepfilter {
+
+/**
+ * 音频源配置
+ */
+struct AudioSourceConfig {
+    int32_t sampleRate = 48000;         // 采样率（Hz，0表示使用设备原生采样率）
+    int32_t channelCount = 1;           // 声道数
+    int32_t framesPerCallback = 0;      // 每次回调的帧数（0表示由音频源决定）
+};
+
+/**
+ * 音频源接口（AudioProcessor的采集端）
+ *
+ * 功能说明：
+ * 1. 按配置的格式（f32交错）通过数据回调推送采集到的音频
+ * 2. 数据回调可能在实时线程上调用，回调方不得加锁、分配内存或阻塞
+ * 3. 设备上由AAudioSource实现；主机上由SyntheticAudioSource/FileAudioSource实现，
+ *    用于在Linux上驱动与生产环境相同的队列、处理线程和回调路径
+ *
+ * 4. 可选提供采集时间戳（getTimestamp），用于把采集流中的位置映射到CLOCK_MONOTONIC时间
+ *
+ * 调用顺序：open -> start -> stop -> (start -> stop)* -> close
+ *
+ * @author hzexe
+ * @version 1.1
+ */
+class AudioSource {
+public:
+    /**
+     * 数据回调
+     *
+     * @param userData open时传入的用户数据
+     * @param samples 音频数据（f32交错）
+     * @param numFrames 帧数
+     */
+    using DataCallback = void (*)(void* userData, const float* samples, int32_t numFrames);
+
+    /**
+     * 错误回调
+     *
+     * @param userData open时传入的用户数据
+     * @param disconnected 设备是否已断开（断开后需要重新open）
+     * @param message 错误描述
+     */
+    using ErrorCallback = void (*)(void* userData, bool disconnected, const char* message);
+
+    virtual ~AudioSource() = default;
+
+    /**
+     * 打开音频源
+     *
+     * @param config 音频格式
+     * @param dataCallback 数据回调
+     * @param errorCallback 错误回调（可为nullptr）
+     * @param userData 传给回调的用户数据
+     * @return true-成功，false-失败（见getLastError）
+     */
+    virtual bool open(const AudioSourceConfig& config,
+                      DataCallback dataCallback,
+                      ErrorCallback errorCallback,
+                      void* userData) = 0;
+
+    /**
+     * 开始推送数据
+     */
+    virtual bool start() = 0;
+
+    /**
+     * 停止推送数据（返回后不会再有数据回调）
+     */
+    virtual bool stop() = 0;
+
+    /**
+     * 关闭音频源（未停止时先停止）
+     */
+    virtual void close() = 0;
+
+    /**
+     * 实际采样率（open成功后有效；配置为0时为设备原生采样率）
+     */
+    virtual int32_t getSampleRate() const = 0;
+
+    /**
+     * 最近一次采集时间戳：位置为framePosition的帧在timeNs时刻被采集
+     *
+     * framePosition以本次start之后经数据回调交付的帧计（每声道帧数，第一帧为0），
+     * timeNs为CLOCK_MONOTONIC纳秒（与std::chrono::steady_clock一致）。
+     * 只在非实时线程上调用；不支持时间戳的音频源返回false
+     *
+     * @param framePosition 输出：帧位置
+     * @param timeNs 输出：该帧的采集时间
+     * @return true-成功，false-暂无可用时间戳
+     */
+    virtual bool getTimestamp(int64_t* framePosition, int64_t* timeNs) const {
+        (void)framePosition;
+        (void)timeNs;
+        return false;
+    }
+
+    virtual const char* getLastError() const = 0;
+};
+
+/**
+ * 音频输出流接口（AudioProcessor双工模式的播放端）
+ *
+ * 功能说明：
+ * 1. 按配置的格式（f32交错）通过渲染回调向调用方拉取要播放的音频
+ * 2. 渲染回调可能在实时线程上调用，回调方不得加锁、分配内存或阻塞，
+ *    数据不足时必须自行补齐（如填零），不能少给
+ * 3. 设备上由AAudioOutput实现；主机上由PacedAudioOutput实现（可模拟与采集端的时钟偏差）
+ *
+ * 调用顺序与AudioSource相同：open -> start -> stop -> (start -> stop)* -> close
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class AudioOutput {
+public:
+    /**
+     * 渲染回调
+     *
+     * @param userData open时传入的用户数据
+     * @param samples 待填充的音频缓冲区（f32交错，numFrames × 声道数）
+     * @param numFrames 帧数
+     */
+    using RenderCallback = void (*)(void* userData, float* samples, int32_t numFrames);
+
+    using ErrorCallback = AudioSource::ErrorCallback;
+
+    virtual ~AudioOutput() = default;
+
+    /**
+     * 打开输出流
+     *
+     * @param config 音频格式（sampleRate为0时使用设备原生采样率）
+     * @param renderCallback 渲染回调
+     * @param errorCallback 错误回调（可为nullptr）
+     * @param userData 传给回调的用户数据
+     * @return true-成功，false-失败（见getLastError）
+     */
+    virtual bool open(const AudioSourceConfig& config,
+                      RenderCallback renderCallback,
+                      ErrorCallback errorCallback,
+                      void* userData) = 0;
+
+    /**
+     * 开始拉取数据
+     */
+    virtual bool start() = 0;
+
+    /**
+     * 停止拉取数据（返回后不会再有渲染回调）
+     */
+    virtual bool stop() = 0;
+
+    /**
+     * 关闭输出流（未停止时先停止）
+     */
+    virtual void close() = 0;
+
+    /**
+     * 实际采样率（open成功后有效）
+     */
+    virtual int32_t getSampleRate() const = 0;
+
+    /**
+     * 每次渲染回调的典型帧数（open成功后有效，用于确定缓冲深度）
+     */
+    virtual int32_t getFramesPerBurst() const = 0;
+
+    virtual const char* getLastError() const = 0;
+};
+
+/**
+ * 音频输出接口（AudioProcessor的结果端）
+ *
+ * write在处理线程上调用，同一时刻只有一个线程调用；AudioProcessor启用同步模式时
+ * 在音频源的数据回调线程上调用（超时回退后改为处理线程），实现不得阻塞
+ *
+ * @author hzexe
+ * @version 1.1
+ */
+class AudioSink {
+public:
+    virtual ~AudioSink() = default;
+
+    /**
+     * 写入一帧降噪结果
+     *
+     * @param audioData 降噪后的音频数据（f32）
+     * @param numFrames 帧数
+     * @param lsnr LSNR值
+     */
+    virtual void write(const float* audioData, int32_t numFrames, float lsnr) = 0;
+};
+
+} // namespace deepfilter
+
+#endif // AUDIO_SOURCE_H
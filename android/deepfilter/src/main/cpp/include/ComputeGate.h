@@ -0,0 +1,203 @@
+#ifndef COMPUTE_GATE_H
+#define COMPUTE_GATE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deepfilter {
+
+/**
+ * 计算门控配置
+ */
+struct ComputeGateConfig {
+    bool enabled = false;               // 是否启用门控
+    float silenceDbfs = -60.0f;         // hop能量低于该值（dBFS）视为静音
+    float silenceGainDb = -20.0f;       // 静音旁路时施加的增益（dB），近似模型对静音段的衰减
+    bool bypassClean = true;            // 是否在干净语音（LSNR持续较高）时旁路
+    float cleanLsnrDb = 30.0f;          // 最近lsnrHistoryHops个LSNR均不低于该值视为干净
+    float cleanExitLsnrDb = 25.0f;      // 探测帧LSNR低于该值时恢复推理（迟滞）
+    float energyJumpDb = 10.0f;         // 干净旁路期间能量比参考值高出该值时立即恢复推理
+    int32_t lsnrHistoryHops = 10;       // LSNR历史长度
+    int32_t holdHops = 10;              // 连续满足条件的hop数达到该值才进入旁路
+    int32_t probeIntervalHops = 25;     // 干净旁路期间每隔多少hop运行一次模型刷新LSNR
+    int32_t warmupHops = 2;             // 恢复推理或探测前用最近跳过的hop预热模型状态的数量（至少覆盖算法延迟）
+};
+
+/**
+ * 计算门控统计
+ */
+struct ComputeGateStats {
+    uint64_t totalHops = 0;             // 经过门控的hop数
+    uint64_t bypassedHops = 0;          // 未运行模型的hop数
+    uint64_t silentHops = 0;            // 其中因静音旁路的hop数
+    uint64_t probeHops = 0;             // 旁路期间运行模型探测LSNR的hop数
+    uint64_t warmupHops = 0;            // 恢复推理和探测前额外运行的预热hop数
+    uint64_t transitions = 0;           // 进入和退出旁路的次数
+};
+
+/**
+ * 本hop的处理方式
+ */
+enum class GateMode {
+    PROCESS,    // 运行模型，输出模型结果
+    FADE_OUT,   // 运行模型，输出从模型结果交叉淡化到旁路信号（进入旁路）
+    BYPASS,     // 不运行模型，输出旁路信号
+    PROBE,      // 预热后运行模型刷新LSNR，输出仍为旁路信号
+    FADE_IN     // 预热后运行模型，输出从旁路信号交叉淡化到模型结果（退出旁路）
+};
+
+/**
+ * 计算门控：静音或干净输入时跳过模型推理
+ *
+ * 功能说明：
+ * 1. 按hop能量检测静音，按最近的LSNR历史检测干净语音，连续holdHops个hop满足条件才进入旁路
+ * 2. 旁路信号为输入乘以增益（静音段silenceGainDb，干净语音0dB），增益在hop内线性过渡
+ * 3. 旁路信号经过与模型算法延迟等长的延迟线，和模型输出在时间上对齐，旁路期间管线延迟不变
+ * 4. 进入和退出旁路的hop都运行模型，并在整个hop内线性交叉淡化，避免输出跳变
+ * 5. 干净旁路期间每隔probeIntervalHops运行一次模型探测LSNR，LSNR下降或能量突增时恢复推理
+ * 6. 恢复推理或探测前，先用最近跳过的warmupHops个hop运行模型（输出丢弃），使STFT缓冲和循环状态与当前输入衔接；
+ *    预热hop数不少于算法延迟对应的hop数，否则模型输出中仍残留旁路前的旧数据
+ * 7. 缓冲区在init时分配，beginHop/endHop无锁、无分配，可在处理线程上逐hop调用
+ *
+ * 用法（每个hop）：
+ *   mode = gate.beginHop(input);
+ *   依次处理 getWarmupHop(0 .. getWarmupHopCount()-1)，输出写入 getWarmupOutput()
+ *   if (ComputeGate::runsModel(mode)) lsnr = 处理(input, output);
+ *   lsnr = gate.endHop(input, output, lsnr);
+ *
+ * 线程模型：beginHop/endHop在单个线程调用，getStats可在任意线程调用
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class ComputeGate {
+public:
+    ComputeGate();
+
+    ComputeGate(const ComputeGate&) = delete;
+    ComputeGate& operator=(const ComputeGate&) = delete;
+
+    /**
+     * 按配置分配缓冲区（非实时线程调用），同时清零状态和统计
+     *
+     * @param config 门控配置
+     * @param frameSize 每声道hop大小
+     * @param channelCount 声道数（多声道数据为交织布局）
+     * @param delayFrames 模型算法延迟（每声道帧数，见df_get_algorithmic_delay），旁路信号按此延迟对齐
+     * @return true-成功，false-参数无效
+     */
+    bool init(const ComputeGateConfig& config, size_t frameSize, int32_t channelCount, size_t delayFrames = 0);
+
+    /**
+     * 回到推理状态并清零统计
+     */
+    void reset();
+
+    /**
+     * 分析一个hop的输入，决定处理方式
+     *
+     * @param input hop数据（frameSize × 声道数个采样点）
+     * @return 处理方式
+     */
+    GateMode beginHop(const float* input);
+
+    /**
+     * 本hop是否需要运行模型
+     */
+    static bool runsModel(GateMode mode) { return mode != GateMode::BYPASS; }
+
+    /**
+     * 本hop运行模型前需要预热的hop数（FADE_IN/PROBE时可能非0）
+     */
+    size_t getWarmupHopCount() const { return warmupCount_; }
+
+    /**
+     * 第index个预热hop的输入（按时间顺序）
+     */
+    const float* getWarmupHop(size_t index) const;
+
+    /**
+     * 预热hop的输出缓冲区（内容丢弃）
+     */
+    float* getWarmupOutput() { return warmupOutput_.data(); }
+
+    /**
+     * 完成一个hop：按beginHop返回的处理方式在output中生成最终输出
+     *
+     * @param input hop输入
+     * @param output 运行了模型时为模型输出，结束后为最终输出
+     * @param lsnr 模型LSNR（未运行模型时忽略）
+     * @return 应上报的LSNR（未运行模型时为最近一次模型LSNR）
+     */
+    float endHop(const float* input, float* output, float lsnr);
+
+    /**
+     * 当前是否处于旁路状态
+     */
+    bool isBypassing() const { return bypassing_; }
+
+    /**
+     * 获取统计快照
+     */
+    ComputeGateStats getStats() const;
+
+    const ComputeGateConfig& getConfig() const { return config_; }
+
+private:
+    float hopEnergyDb(const float* input) const;
+    bool lsnrIsClean() const;
+    void pushLsnr(float lsnr);
+    void rememberSkippedHop(const float* input);
+    const float* delayInput(const float* input);
+
+    ComputeGateConfig config_;
+    size_t frameSize_;
+    size_t channelCount_;
+    size_t hopSamples_;
+    size_t delaySamples_;
+    size_t warmupCapacity_;
+
+    // 状态机（仅处理线程访问）
+    GateMode mode_;
+    bool bypassing_;
+    bool silentHop_;
+    bool resumePending_;
+    int32_t qualifyingHops_;
+    int32_t hopsSinceProbe_;
+    float energyDb_;
+    float referenceEnergyDb_;
+    float lastLsnr_;
+    float previousGain_;
+    float currentGain_;
+
+    // 最近LSNR（环形）
+    std::vector<float> lsnrHistory_;
+    size_t lsnrCount_;
+    size_t lsnrNext_;
+
+    // 最近跳过的hop输入（环形），用于恢复推理前预热
+    std::vector<float> skippedHops_;
+    size_t skippedCount_;
+    size_t skippedNext_;
+    size_t warmupCount_;
+    size_t warmupFirst_;
+    std::vector<float> warmupOutput_;
+
+    // 旁路信号的延迟线（前delaySamples_为上一hop留下的尾部，随后是本hop输入）
+    std::vector<float> delayLine_;
+    std::vector<float> delayedHop_;
+
+    // 统计（处理线程写入，getStats读取）
+    std::atomic<uint64_t> totalHops_;
+    std::atomic<uint64_t> bypassedHops_;
+    std::atomic<uint64_t> silentHops_;
+    std::atomic<uint64_t> probeHops_;
+    std::atomic<uint64_t> warmupHops_;
+    std::atomic<uint64_t> transitions_;
+};
+
+} // namespace deepfilter
+
+#endif // COMPUTE_GATE_H
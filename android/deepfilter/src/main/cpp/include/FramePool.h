@@ -0,0 +1,107 @@
+#ifndef FRAME_POOL_H
+#define FRAME_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace deepfilter {
+
+struct AudioFrame;
+
+/**
+ * 帧池统计信息
+ */
+struct FramePoolStats {
+    size_t capacity;            // 帧总数
+    size_t inUse;               // 当前已借出的帧数
+    uint64_t heapAllocations;   // 帧池执行的堆分配次数（仅init时发生）
+    uint64_t acquireCount;      // 借出次数
+    uint64_t releaseCount;      // 归还次数
+    uint64_t exhaustedCount;    // 帧池耗尽导致借出失败的次数
+};
+
+/**
+ * 固定容量音频帧池
+ *
+ * 功能说明：
+ * 1. init时一次性分配所有帧头和采样数据，之后借出/归还不再触碰堆
+ * 2. 每帧采样数据按缓存行（64字节）对齐，帧间距为缓存行整数倍
+ * 3. 借出/归还为无锁操作（带版本号的空闲链表，避免ABA问题），可在实时线程中调用
+ * 4. 提供计数器，便于测试断言稳态运行时零堆分配
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class FramePool {
+public:
+    /**
+     * 缓存行大小（字节）
+     */
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    FramePool();
+    ~FramePool();
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    /**
+     * 分配帧池（非实时线程调用）
+     *
+     * @param frameSize 每帧采样点数
+     * @param capacity 帧数量
+     * @return true-成功，false-参数无效或内存不足
+     */
+    bool init(size_t frameSize, size_t capacity);
+
+    /**
+     * 释放帧池内存（所有帧都已归还且不再使用时调用）
+     */
+    void release();
+
+    /**
+     * 借出一帧
+     *
+     * @return 帧指针（data已指向对齐的采样缓冲区），帧池耗尽时返回nullptr
+     */
+    AudioFrame* acquireFrame();
+
+    /**
+     * 归还一帧
+     *
+     * @param frame 由acquireFrame借出的帧
+     */
+    void releaseFrame(AudioFrame* frame);
+
+    size_t frameSize() const { return frameSize_; }
+
+    size_t capacity() const { return capacity_; }
+
+    /**
+     * 获取统计信息
+     */
+    FramePoolStats getStats() const;
+
+private:
+    static const uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    AudioFrame* frames_;
+    float* arena_;
+    std::atomic<uint32_t>* next_;
+    size_t frameSize_;
+    size_t frameStride_;
+    size_t capacity_;
+
+    // 空闲链表头：高32位为版本号，低32位为帧索引
+    alignas(64) std::atomic<uint64_t> freeHead_;
+
+    std::atomic<uint64_t> heapAllocations_;
+    std::atomic<uint64_t> acquireCount_;
+    std::atomic<uint64_t> releaseCount_;
+    std::atomic<uint64_t> exhaustedCount_;
+};
+
+} // namespace deepfilter
+
+#endif // FRAME_POOL_H
@@ -0,0 +1,161 @@
+#ifndef FRAME_RING_BUFFER_H
+#define FRAME_RING_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "FramePool.h"
+
+namespace deepfilter {
+
+/**
+ * 音频帧数据结构
+ */
+struct AudioFrame {
+    float* data;
+    int32_t numFrames;
+    int64_t timestamp;  // 采集时间戳（steady_clock，纳秒）
+    int64_t position;   // 首个采样点在采集流中的位置（每声道帧数），用于检测丢帧造成的不连续
+};
+
+/**
+ * 队列溢出策略
+ */
+enum class OverflowPolicy : int32_t {
+    DROP_OLDEST = 0,    // 覆盖最旧的帧（默认，保证延迟最低）
+    DROP_NEWEST = 1     // 丢弃新到达的帧（保证已入队数据完整）
+};
+
+/**
+ * 单生产者/单消费者音频帧环形缓冲区
+ *
+ * 功能说明：
+ * 1. 预分配固定数量、固定大小（frameSize）的采样槽，运行期间不再分配内存
+ *    （槽数据取自FramePool，可与调用方共用同一帧池）
+ * 2. 生产者（AAudio实时线程）无锁、无等待、无内存分配、无日志
+ * 3. 消费者（处理线程）无锁读取，读取时将数据复制到调用方缓冲区
+ * 4. 支持可配置的溢出策略，并统计丢弃帧数
+ *
+ * 实现说明：
+ * DROP_OLDEST模式下生产者可能覆盖消费者正在复制的槽，
+ * 每个槽带有序列号（写入中为奇数），消费者复制前后比较序列号，
+ * 若被覆盖则跳过该帧并计入丢弃数。
+ *
+ * @author hzexe
+ * @version 1.1
+ */
+class FrameRingBuffer {
+public:
+    FrameRingBuffer();
+    ~FrameRingBuffer();
+
+    FrameRingBuffer(const FrameRingBuffer&) = delete;
+    FrameRingBuffer& operator=(const FrameRingBuffer&) = delete;
+
+    /**
+     * 分配缓冲区，槽数据使用内部帧池（非实时线程调用）
+     *
+     * @param frameSize 每个槽的采样点数
+     * @param capacity 槽数量
+     * @param policy 溢出策略
+     * @return true-成功，false-参数无效
+     */
+    bool init(size_t frameSize, size_t capacity, OverflowPolicy policy);
+
+    /**
+     * 分配缓冲区，槽数据从外部帧池借出（非实时线程调用）
+     *
+     * @param pool 帧池，生命周期必须长于本缓冲区，且至少有capacity个空闲帧
+     * @param capacity 槽数量
+     * @param policy 溢出策略
+     * @return true-成功，false-参数无效或帧池空闲帧不足
+     */
+    bool init(FramePool& pool, size_t capacity, OverflowPolicy policy);
+
+    /**
+     * 释放缓冲区并将槽数据归还帧池（生产者和消费者都已停止时调用）
+     */
+    void release();
+
+    /**
+     * 清空缓冲区并重置计数（生产者和消费者都已停止时调用）
+     */
+    void reset();
+
+    /**
+     * 写入一帧（仅生产者线程调用，无等待）
+     *
+     * @param data 采样数据
+     * @param numFrames 采样点数（超过frameSize的部分被截断）
+     * @param timestamp 时间戳
+     * @param position 首个采样点在采集流中的位置（原样随帧传递）
+     * @return true-已写入，false-缓冲区已满且策略为DROP_NEWEST
+     */
+    bool push(const float* data, int32_t numFrames, int64_t timestamp, int64_t position = 0);
+
+    /**
+     * 读取一帧（仅消费者线程调用）
+     *
+     * @param frame 输出帧，data必须指向至少frameSize个采样点的缓冲区
+     * @return true-读取成功，false-缓冲区为空
+     */
+    bool pop(AudioFrame* frame);
+
+    /**
+     * 获取当前缓冲的帧数（近似值）
+     */
+    size_t size() const;
+
+    size_t capacity() const { return capacity_; }
+
+    size_t frameSize() const { return frameSize_; }
+
+    void setOverflowPolicy(OverflowPolicy policy);
+
+    OverflowPolicy getOverflowPolicy() const;
+
+    /**
+     * 获取写入成功的帧数
+     */
+    uint64_t getPushedCount() const;
+
+    /**
+     * 获取读取成功的帧数
+     */
+    uint64_t getPoppedCount() const;
+
+    /**
+     * 获取因溢出丢弃的帧数（两种策略合计）
+     *
+     * DROP_OLDEST模式下被覆盖的帧在消费者下一次读取时计入
+     */
+    uint64_t getDroppedCount() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        std::atomic<int32_t> numFrames;
+        std::atomic<int64_t> timestamp;
+        std::atomic<int64_t> position;
+        AudioFrame* frame;
+    };
+
+    Slot* slots_;
+    FramePool ownPool_;
+    FramePool* pool_;
+    size_t frameSize_;
+    size_t capacity_;
+    std::atomic<int32_t> policy_;
+
+    // 生产者写位置与消费者读位置分别独占缓存行，避免伪共享
+    alignas(64) std::atomic<uint64_t> writeIndex_;
+    std::atomic<uint64_t> pushedCount_;
+    std::atomic<uint64_t> droppedCount_;
+
+    alignas(64) std::atomic<uint64_t> readIndex_;
+    std::atomic<uint64_t> poppedCount_;
+};
+
+} // namespace deepfilter
+
+#endif // FRAME_RING_BUFFER_H
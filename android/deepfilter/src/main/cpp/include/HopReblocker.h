@@ -0,0 +1,104 @@
+#ifndef HOP_REBLOCKER_H
+#define HOP_REBLOCKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace deepfilter {
+
+/**
+ * hop重组缓冲区：把任意长度的输入重新分块为固定hop大小
+ *
+ * 功能说明：
+ * 1. 音频设备按自己的最佳burst大小回调（如96/192帧），模型需要固定hop（如480帧），两者互不约束
+ * 2. 攒满一个hop即交给回调；暂存区为空且输入足够时直接传入输入指针，不做额外复制
+ * 3. 不足一个hop的尾部保留到下次写入，不丢弃、不截断、不补零
+ * 4. 暂存区在init时一次性分配，write无锁、无分配，可在实时线程调用
+ *
+ * 线程模型：单线程使用（通常是音频回调线程）
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class HopReblocker {
+public:
+    HopReblocker() : hopSize_(0), pending_(0) {}
+
+    HopReblocker(const HopReblocker&) = delete;
+    HopReblocker& operator=(const HopReblocker&) = delete;
+
+    /**
+     * 分配暂存区（非实时线程调用）
+     *
+     * @param hopSize hop大小（采样点数）
+     * @return true-成功，false-参数无效
+     */
+    bool init(size_t hopSize);
+
+    /**
+     * 丢弃暂存的不完整hop
+     */
+    void reset() { pending_ = 0; }
+
+    /**
+     * 写入任意长度的数据，每攒满一个hop调用一次onHop(const float* hop)
+     *
+     * @param data 采样数据
+     * @param numFrames 采样点数
+     * @param onHop hop回调，参数指向hopSize个采样点（仅在回调期间有效）
+     * @return 本次产生的完整hop数
+     */
+    template <typename OnHop>
+    size_t write(const float* data, size_t numFrames, OnHop&& onHop) {
+        size_t hops = 0;
+
+        // 先补齐暂存区中的不完整hop
+        if (pending_ > 0) {
+            const size_t needed = hopSize_ - pending_;
+            const size_t count = numFrames < needed ? numFrames : needed;
+            memcpy(staging_.get() + pending_, data, count * sizeof(float));
+            pending_ += count;
+            data += count;
+            numFrames -= count;
+            if (pending_ < hopSize_) {
+                return 0;
+            }
+            onHop(static_cast<const float*>(staging_.get()));
+            pending_ = 0;
+            hops++;
+        }
+
+        // 完整的hop直接从输入传递
+        while (numFrames >= hopSize_) {
+            onHop(data);
+            data += hopSize_;
+            numFrames -= hopSize_;
+            hops++;
+        }
+
+        // 剩余不足一个hop的部分暂存
+        if (numFrames > 0) {
+            memcpy(staging_.get(), data, numFrames * sizeof(float));
+            pending_ = numFrames;
+        }
+        return hops;
+    }
+
+    size_t hopSize() const { return hopSize_; }
+
+    /**
+     * 暂存的采样点数（0到hopSize-1）
+     */
+    size_t pending() const { return pending_; }
+
+private:
+    std::unique_ptr<float[]> staging_;
+    size_t hopSize_;
+    size_t pending_;
+};
+
+} // namespace deepfilter
+
+#endif // HOP_REBLOCKER_H
@@ -0,0 +1,86 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace deepfilter {
+
+/**
+ * 延迟分布摘要（单位：微秒）
+ */
+struct LatencySummary {
+    uint64_t count = 0;     // 样本数
+    int64_t p50Us = 0;      // 中位数
+    int64_t p95Us = 0;      // 95分位
+    int64_t p99Us = 0;      // 99分位
+    int64_t maxUs = 0;      // 最大值（精确值）
+    int64_t avgUs = 0;      // 平均值
+};
+
+/**
+ * 无锁延迟直方图
+ *
+ * 功能说明：
+ * 1. 固定数量的对数分桶（每个2的幂区间再分8个子桶），相对误差不超过12.5%
+ * 2. 记录只做一次relaxed原子加，无锁、无分配，可在处理线程热路径调用
+ * 3. 任意线程可随时读取摘要（分位数取所在桶的上界，最大值为精确值）
+ * 4. 覆盖0到约4.7小时（2^34微秒），超出范围的样本计入最后一个桶
+ *
+ * 线程模型：
+ * - record：可多线程并发调用
+ * - snapshot：任意线程调用，与record并发时结果为近似值
+ * - reset：没有record并发时调用
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * 记录一个样本
+     *
+     * @param valueUs 延迟（微秒），负值按0记录
+     */
+    void record(int64_t valueUs);
+
+    /**
+     * 获取分布摘要
+     */
+    LatencySummary snapshot() const;
+
+    /**
+     * 清空所有样本
+     */
+    void reset();
+
+    // 线性区（0到15微秒每微秒一个桶）+ 对数区（2^4到2^33微秒，每个区间8个子桶）
+    static const size_t LINEAR_BUCKETS = 16;
+    static const size_t SUB_BUCKETS = 8;
+    static const size_t BUCKET_COUNT = LINEAR_BUCKETS + (34 - 4) * SUB_BUCKETS;
+
+    /**
+     * 样本值对应的桶索引
+     */
+    static size_t bucketIndex(uint64_t valueUs);
+
+    /**
+     * 桶覆盖的最大值（微秒）
+     */
+    static int64_t bucketUpperBound(size_t index);
+
+private:
+    std::atomic<uint64_t> buckets_[BUCKET_COUNT];
+    std::atomic<int64_t> sumUs_;
+    std::atomic<int64_t> maxUs_;
+};
+
+} // namespace deepfilter
+
+#endif // LATENCY_HISTOGRAM_H
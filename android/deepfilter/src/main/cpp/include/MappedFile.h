@@ -0,0 +1,57 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace deepfilter {
+
+/**
+ * 只读内存映射文件
+ *
+ * 用于读取大文件（录音、模型）而不把整个文件复制到堆上，
+ * 页面由内核按需调入，内存占用与访问窗口相关而非文件大小
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * 映射文件
+     *
+     * @param path 文件路径
+     * @param sequential 是否提示内核按顺序预读
+     * @return true-成功，false-失败（见getLastError）
+     */
+    bool open(const char* path, bool sequential = true);
+
+    /**
+     * 解除映射并关闭文件
+     */
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+
+    const uint8_t* data() const { return data_; }
+
+    size_t size() const { return size_; }
+
+    const char* getLastError() const { return lastError_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    int fd_;
+    char lastError_[256];
+};
+
+} // namespace deepfilter
+
+#endif // MAPPED_FILE_H
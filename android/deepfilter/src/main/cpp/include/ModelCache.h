@@ -0,0 +1,127 @@
+#ifndef MODEL_CACHE_H
+#define MODEL_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "deepfilter_ort.h"
+
+namespace deepfilter {
+
+/**
+ * 模型精度（子网络变体，见df_model_select_precision）
+ */
+enum class ModelPrecision {
+    FP32 = DF_PRECISION_FP32,   // 原始模型（默认）
+    FP16 = DF_PRECISION_FP16,   // 半精度
+    INT8 = DF_PRECISION_INT8    // 训练后量化
+};
+
+/**
+ * 模型解压缓存（磁盘）
+ *
+ * 只缓存解压结果，不缓存优化后的模型：命中时跳过gzip解压，ONNX解析、图优化和
+ * 流式（pulse）转换仍在每次加载后首次创建实例时执行（优化结果只保存在内存中的模型句柄里）
+ *
+ * 功能说明：
+ * 1. 首次加载时把tar.gz模型重新打包为不压缩格式写入缓存目录
+ * 2. 之后的启动以模型字节的哈希为键命中缓存，通过内存映射读取，省去解压
+ * 3. 缓存文件带魔数、格式版本、键和长度校验；不匹配、截断或加载失败时
+ *    回退到原始模型并重建缓存
+ * 4. 未设置缓存目录时直接加载原始模型
+ * 5. 可按精度加载量化变体：组装后的模型以（模型、变体包、精度）为键单独缓存，
+ *    FP32且没有变体包时键与原来相同
+ *
+ * 缓存文件布局（小端序）：
+ *   magic "DFMC" | version u32 | key u64 | payloadSize u64 | payload
+ *
+ * @author hzexe
+ * @version 1.1
+ */
+class ModelCache {
+public:
+    /**
+     * 缓存格式版本（格式或打包方式变化时递增，旧缓存自动失效）
+     */
+    static const uint32_t FORMAT_VERSION = 1;
+
+    ModelCache();
+
+    ModelCache(const ModelCache&) = delete;
+    ModelCache& operator=(const ModelCache&) = delete;
+
+    /**
+     * 设置缓存目录
+     *
+     * @param directory 缓存目录（需已存在且可写），nullptr或空字符串表示禁用缓存
+     */
+    void setDirectory(const char* directory);
+
+    /**
+     * 获取缓存目录
+     */
+    const std::string& getDirectory() const { return directory_; }
+
+    /**
+     * 加载模型（优先从缓存）
+     *
+     * @param tarBytes 模型文件字节数组（tar.gz格式）
+     * @param tarBytesSize 模型文件字节数组大小
+     * @param cacheHit 输出是否命中缓存（可为nullptr）
+     * @return 模型句柄（见df_model_load，需用df_model_free释放），失败返回nullptr
+     */
+    void* loadModel(const uint8_t* tarBytes, size_t tarBytesSize, bool* cacheHit);
+
+    /**
+     * 按精度加载模型（优先从缓存）
+     *
+     * @param tarBytes 模型文件字节数组（tar.gz格式）
+     * @param tarBytesSize 模型文件字节数组大小
+     * @param precision 模型精度，非FP32时从模型或变体包中选择对应的子网络
+     * @param variantBytes 变体包字节数组（tar.gz格式，可为nullptr）
+     * @param variantSize 变体包字节数组大小
+     * @param cacheHit 输出是否命中缓存（可为nullptr）
+     * @return 模型句柄，失败（包括缺少所选精度的子网络）返回nullptr
+     */
+    void* loadModel(const uint8_t* tarBytes, size_t tarBytesSize, ModelPrecision precision,
+                    const uint8_t* variantBytes, size_t variantSize, bool* cacheHit);
+
+    /**
+     * 获取指定模型的缓存文件路径
+     */
+    std::string getCachePath(const uint8_t* tarBytes, size_t tarBytesSize,
+                             ModelPrecision precision = ModelPrecision::FP32,
+                             const uint8_t* variantBytes = nullptr, size_t variantSize = 0) const;
+
+    const char* getLastError() const { return lastError_; }
+
+    /**
+     * 64位FNV-1a哈希
+     */
+    static uint64_t hash(const uint8_t* data, size_t size);
+
+    /**
+     * 精度名称（fp32/fp16/int8）
+     */
+    static const char* precisionName(ModelPrecision precision);
+
+private:
+    // 缓存键：模型哈希，非默认精度或有变体包时再混入变体包和精度
+    static uint64_t cacheKey(const uint8_t* tarBytes, size_t tarBytesSize, ModelPrecision precision,
+                             const uint8_t* variantBytes, size_t variantSize);
+
+    std::string pathForKey(uint64_t key) const;
+
+    // 从缓存文件加载，任何校验失败返回nullptr
+    void* loadFromCache(const std::string& path, uint64_t key);
+
+    // 重新打包并原子写入缓存文件（先写临时文件再重命名）
+    bool writeCache(const std::string& path, uint64_t key, const uint8_t* tarBytes, size_t tarBytesSize);
+
+    std::string directory_;
+    char lastError_[256];
+};
+
+} // namespace deepfilter
+
+#endif // MODEL_CACHE_H
@@ -0,0 +1,53 @@
+#ifndef NATIVE_LOG_H
+#define NATIVE_LOG_H
+
+/**
+ * 平台无关的日志宏
+ *
+ * 使用前先定义LOG_TAG：
+ *   #define LOG_TAG "AudioProcessor"
+ *   #include "NativeLog.h"
+ *
+ * Android上输出到logcat，主机构建输出到stderr（整行一次写入，多线程不交错）
+ */
+
+#ifdef __ANDROID__
+
+#include <android/log.h>
+
+#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
+#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
+
+#else
+
+#include <cstdarg>
+#include <cstdio>
+
+namespace deepfilter {
+
+inline void nativeLogPrint(char level, const char* tag, const char* format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+inline void nativeLogPrint(char level, const char* tag, const char* format, ...) {
+    char line[512];
+    int offset = snprintf(line, sizeof(line), "%c/%s: ", level, tag);
+    if (offset < 0 || offset >= static_cast<int>(sizeof(line))) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line + offset, sizeof(line) - offset, format, args);
+    va_end(args);
+    fprintf(stderr, "%s\n", line);
+}
+
+} // namespace deepfilter
+
+#define LOGI(...) ::deepfilter::nativeLogPrint('I', LOG_TAG, __VA_ARGS__)
+#define LOGW(...) ::deepfilter::nativeLogPrint('W', LOG_TAG, __VA_ARGS__)
+#define LOGE(...) ::deepfilter::nativeLogPrint('E', LOG_TAG, __VA_ARGS__)
+
+#endif // __ANDROID__
+
+#endif // NATIVE_LOG_H
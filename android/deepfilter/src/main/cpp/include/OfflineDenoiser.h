@@ -0,0 +1,118 @@
+#ifndef OFFLINE_DENOISER_H
+#define OFFLINE_DENOISER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "WavFile.h"
+
+namespace deepfilter {
+
+/**
+ * 离线降噪选项
+ */
+struct OfflineOptions {
+    size_t chunkHops = 100;                                 // 每次批量处理的hop数（决定内存占用）
+    WavSampleFormat outputFormat = WavSampleFormat::PCM16;  // 输出采样格式
+    bool compensateDelay = true;                            // 补偿模型算法延迟（见df_get_algorithmic_delay）
+};
+
+/**
+ * 离线降噪结果
+ */
+struct OfflineResult {
+    uint64_t samples = 0;           // 输出采样点数（与输入帧数相同）
+    uint64_t hops = 0;              // 处理的hop数（含末尾补零和冲刷延迟的hop）
+    double audioSeconds = 0.0;      // 音频时长（秒）
+    double processingSeconds = 0.0; // 处理耗时（秒）
+    double realTimeFactor = 0.0;    // 实时率 = 处理耗时 / 音频时长
+};
+
+/**
+ * 离线文件降噪器
+ *
+ * 功能说明：
+ * 1. WAV文件到WAV文件的降噪处理，不依赖Android，可在Linux服务器上批量运行
+ * 2. 输入通过内存映射按块读取，输出边处理边写入，内存占用与文件长度无关
+ * 3. 按chunkHops个hop为一块调用df_process_frames，减少FFI调用次数
+ * 4. 多声道输入下混为单声道，输出单声道48kHz
+ * 5. 同一实例可依次处理多个文件，模型只加载一次，每个文件开始前重建运行时状态
+ * 6. 默认补偿算法延迟：输入结束后补零把尾部冲刷出来，并丢弃输出开头的延迟采样，
+ *    输出与输入逐采样对齐且等长；关闭compensateDelay时输出与流式处理一样滞后
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class OfflineDenoiser {
+public:
+    OfflineDenoiser();
+    ~OfflineDenoiser();
+
+    OfflineDenoiser(const OfflineDenoiser&) = delete;
+    OfflineDenoiser& operator=(const OfflineDenoiser&) = delete;
+
+    /**
+     * 初始化降噪器
+     *
+     * @param tarBytes 模型文件字节数组（tar.gz格式），初始化完成后即可释放
+     * @param tarBytesSize 模型文件字节数组大小
+     * @param postFilterBeta 后滤波器beta参数
+     * @param attenLimDb 衰减限制（dB）
+     * @return true-成功，false-失败（见getLastError）
+     */
+    bool initialize(
+        const uint8_t* tarBytes,
+        size_t tarBytesSize,
+        float postFilterBeta,
+        float attenLimDb);
+
+    /**
+     * 降噪处理一个WAV文件
+     *
+     * @param inputPath 输入WAV路径（48kHz，PCM16或PCM32F）
+     * @param outputPath 输出WAV路径
+     * @param options 处理选项
+     * @param result 处理结果（可为nullptr）
+     * @return true-成功，false-失败（见getLastError）
+     */
+    bool processFile(
+        const char* inputPath,
+        const char* outputPath,
+        const OfflineOptions& options,
+        OfflineResult* result);
+
+    /**
+     * 释放资源
+     */
+    void release();
+
+    /**
+     * 获取hop大小
+     */
+    size_t getFrameSize() const { return frameSize_; }
+
+    const char* getLastError() const { return lastError_; }
+
+private:
+    // 创建新的DeepFilterNet实例（替换旧实例，保证每个文件从干净状态开始）
+    bool createState();
+
+    static const int32_t SAMPLE_RATE = 48000;
+
+    void* model_;
+    float postFilterBeta_;
+    float attenLimDb_;
+
+    void* dfState_;
+    bool stateUsed_;    // 当前实例是否已处理过文件
+    size_t frameSize_;
+
+    std::vector<float> inputChunk_;
+    std::vector<float> outputChunk_;
+
+    char lastError_[256];
+};
+
+} // namespace deepfilter
+
+#endif // OFFLINE_DENOISER_H
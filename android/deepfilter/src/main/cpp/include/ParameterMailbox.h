@@ -0,0 +1,117 @@
+#ifndef PARAMETER_MAILBOX_H
+#define PARAMETER_MAILBOX_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace deepfilter {
+
+/**
+ * 可在处理中调整的降噪参数
+ */
+enum class DenoiseParameter {
+    POST_FILTER_BETA = 0,   // 后滤波器beta（线性插值）
+    ATTEN_LIM_DB = 1,       // 衰减限制（按dB线性插值）
+    COUNT = 2
+};
+
+/**
+ * 参数邮箱统计
+ */
+struct ParameterMailboxStats {
+    uint64_t posts = 0;                 // post调用次数（被后续post覆盖的也计入）
+    uint64_t appliedSteps = 0;          // 实际下发给模型的参数值变化次数（斜坡每步计一次）
+    uint64_t retargets = 0;             // 处理线程读到新目标值（开始新斜坡）的次数
+    float target[static_cast<size_t>(DenoiseParameter::COUNT)] = {};    // 最新目标值
+    float current[static_cast<size_t>(DenoiseParameter::COUNT)] = {};   // 当前生效值
+};
+
+/**
+ * 降噪参数邮箱：任意线程写入目标值，处理线程在hop边界读取并平滑过渡
+ *
+ * 功能说明：
+ * 1. post只做一次原子存储（最后写入者生效），UI滑块、自动响度控制等多个线程可同时调用，不加锁、不阻塞
+ * 2. 处理线程每个hop开始前调用advance：读到新目标值时从当前值开始一段线性斜坡，
+ *    rampHops个hop内到达目标；斜坡途中目标再变时从当前值重新开始，不会跳变
+ * 3. 模型的参数在帧内保持不变，逐hop小步变化代替一次大跳变，避免拉链噪声（zipper noise）
+ * 4. 参数只在处理线程上下发给模型，与推理不会并发访问同一个模型实例
+ *
+ * 线程模型：post/getTarget/getStats可在任意线程调用；init/advance只在处理线程（或处理停止时）调用
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class ParameterMailbox {
+public:
+    static const size_t PARAMETER_COUNT = static_cast<size_t>(DenoiseParameter::COUNT);
+
+    ParameterMailbox();
+
+    ParameterMailbox(const ParameterMailbox&) = delete;
+    ParameterMailbox& operator=(const ParameterMailbox&) = delete;
+
+    /**
+     * 设置初始值（即模型当前生效的值），清空未处理的目标和统计
+     *
+     * @param postFilterBeta 后滤波器beta
+     * @param attenLimDb 衰减限制（dB）
+     * @param rampHops 斜坡长度（hop数，0表示下一个hop直接生效）
+     * @return true-成功，false-rampHops为负
+     */
+    bool init(float postFilterBeta, float attenLimDb, int32_t rampHops);
+
+    /**
+     * 修改斜坡长度（下一次开始斜坡时生效）
+     */
+    void setRampHops(int32_t rampHops);
+
+    int32_t getRampHops() const { return rampHops_.load(std::memory_order_relaxed); }
+
+    /**
+     * 写入目标值（任意线程，无锁）
+     */
+    void post(DenoiseParameter parameter, float value);
+
+    /**
+     * 最新目标值
+     */
+    float getTarget(DenoiseParameter parameter) const;
+
+    /**
+     * 推进一个hop（处理线程）
+     *
+     * @param values 输出：各参数本hop应生效的值（按DenoiseParameter下标）
+     * @return 本hop值发生变化的参数位掩码（第n位对应下标n），0表示无需下发
+     */
+    uint32_t advance(float values[PARAMETER_COUNT]);
+
+    /**
+     * 所有参数的当前生效值是否已等于最新目标值（任意线程）
+     */
+    bool isSettled() const;
+
+    /**
+     * 获取统计快照
+     */
+    ParameterMailboxStats getStats() const;
+
+private:
+    struct Slot {
+        std::atomic<float> target;      // 最新目标值（任意线程写）
+        std::atomic<float> current;     // 当前生效值（处理线程写，统计读取）
+        float rampTarget;               // 当前斜坡的终点（仅处理线程）
+        float rampStep;                 // 每hop步长（仅处理线程）
+        int32_t remainingHops;          // 斜坡剩余hop数（仅处理线程）
+    };
+
+    Slot slots_[PARAMETER_COUNT];
+    std::atomic<int32_t> rampHops_;
+    std::atomic<uint64_t> posts_;
+    std::atomic<uint64_t> appliedSteps_;
+    std::atomic<uint64_t> retargets_;
+};
+
+} // namespace deepfilter
+
+#endif // PARAMETER_MAILBOX_H
@@ -0,0 +1,127 @@
+#ifndef PLAYOUT_BUFFER_H
+#define PLAYOUT_BUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deepfilter {
+
+/**
+ * 播放缓冲区统计（每次reset时清零）
+ */
+struct PlayoutBufferStats {
+    uint64_t writtenFrames = 0;         // 写入缓冲区的帧数（不含溢出丢弃的帧）
+    uint64_t renderedFrames = 0;        // 消费者输出的帧数（含补零）
+    uint64_t underruns = 0;             // 播放中数据不足的次数（每次补零后重新预缓冲）
+    uint64_t silentFrames = 0;          // 预缓冲和欠载时补零的帧数
+    uint64_t overflowFrames = 0;        // 缓冲区满时丢弃的写入帧数
+    int32_t fillFrames = 0;             // 当前缓冲的帧数
+    int32_t targetFrames = 0;           // 目标缓冲帧数
+    int32_t correctionPpm = 0;          // 当前读取速率修正（百万分之一，正数表示读得比写快）
+};
+
+/**
+ * 双工播放缓冲区：单生产者/单消费者无锁采样FIFO，带时钟漂移补偿
+ *
+ * 功能说明：
+ * 1. 生产者（处理线程，同步模式下为采集回调线程）按hop写入降噪结果，
+ *    消费者（输出流渲染回调）按输出burst读取，两端无锁、无分配
+ * 2. 采集和播放由不同的时钟驱动，标称采样率相同的两个设备也会有几十到几百ppm的偏差，
+ *    不补偿时缓冲区会逐渐排空（欠载爆音）或堆满（延迟增长后溢出）
+ * 3. 消费者以可变速率线性插值读取：对平滑后的缓冲深度与目标深度之差做PI控制，
+ *    得到读取速率修正（限制在±maxCorrectionPpm内，默认0.1%，音高变化不可闻），
+ *    稳态时修正量等于两端时钟偏差，缓冲深度保持在目标附近
+ * 4. 启动和欠载后先输出静音，直到缓冲达到目标深度再开始播放（预缓冲）
+ * 5. 缓冲区满时丢弃新写入的数据并计数
+ *
+ * 线程模型：write在单个生产者线程调用，render在单个消费者线程调用，getStats可在任意线程调用；
+ * init/reset须在两端都停止时调用
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class PlayoutBuffer {
+public:
+    PlayoutBuffer();
+
+    PlayoutBuffer(const PlayoutBuffer&) = delete;
+    PlayoutBuffer& operator=(const PlayoutBuffer&) = delete;
+
+    /**
+     * 分配缓冲区（非实时线程调用），同时清零状态和统计
+     *
+     * @param sampleRate 采样率（Hz，用于控制器的时间常数）
+     * @param channelCount 声道数（交织）
+     * @param targetFrames 目标缓冲帧数（决定附加延迟，至少要容纳一次写入和一次读取的间隔）
+     * @param capacityFrames 容量（帧，向上取整为2的幂，必须大于targetFrames）
+     * @param maxCorrectionPpm 读取速率修正上限（ppm）
+     * @return true-成功，false-参数无效
+     */
+    bool init(int32_t sampleRate, int32_t channelCount, size_t targetFrames,
+              size_t capacityFrames, double maxCorrectionPpm = 1000.0);
+
+    /**
+     * 清空数据、控制器状态和统计
+     */
+    void reset();
+
+    /**
+     * 写入数据（生产者线程）
+     *
+     * @param data 交织数据
+     * @param numFrames 帧数
+     * @return 实际写入的帧数（缓冲区满时小于numFrames）
+     */
+    size_t write(const float* data, size_t numFrames);
+
+    /**
+     * 读取并填满输出缓冲区（消费者线程），数据不足时补零
+     *
+     * @param output 输出缓冲区（numFrames × 声道数个float）
+     * @param numFrames 帧数
+     */
+    void render(float* output, size_t numFrames);
+
+    /**
+     * 当前缓冲的帧数
+     */
+    size_t size() const;
+
+    /**
+     * 获取统计快照
+     */
+    PlayoutBufferStats getStats() const;
+
+    size_t getTargetFrames() const { return targetFrames_; }
+
+private:
+    std::vector<float> buffer_;
+    size_t capacity_;           // 容量（帧，2的幂）
+    size_t mask_;
+    size_t channels_;
+    size_t targetFrames_;
+    double sampleRate_;
+    double maxCorrection_;
+
+    // 读写位置（帧，单调递增）
+    std::atomic<uint64_t> writePos_;
+    std::atomic<uint64_t> readPos_;
+
+    // 消费者状态（仅渲染线程访问）
+    bool priming_;
+    double fraction_;           // 读取位置的小数部分
+    double smoothedFill_;       // 平滑后的缓冲深度
+    double integral_;           // PI控制器积分项（已乘以积分增益）
+
+    std::atomic<uint64_t> renderedFrames_;
+    std::atomic<uint64_t> underruns_;
+    std::atomic<uint64_t> silentFrames_;
+    std::atomic<uint64_t> overflowFrames_;
+    std::atomic<int32_t> correctionPpm_;
+};
+
+} // namespace deepfilter
+
+#endif // PLAYOUT_BUFFER_H
@@ -0,0 +1,70 @@
+#ifndef PUSH_AUDIO_SOURCE_H
+#define PUSH_AUDIO_SOURCE_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include "AudioSource.h"
+
+namespace deepfilter {
+
+/**
+ * 由调用方推送数据的音频源（AudioProcessor推送模式）
+ *
+ * 功能说明：
+ * 1. 不打开任何音频设备，数据由调用方（应用自己的AudioRecord/WebRTC采集线程）经push送入，
+ *    push在调用线程上直接调用数据回调，之后的重采样、分块、队列和处理线程与AAudio采集完全相同
+ * 2. 配置采样率为0时按48kHz（模型采样率）处理；其他采样率由AudioProcessor转换
+ * 3. stop返回后push不再调用数据回调（push与stop之间加锁，推送线程不是实时线程）
+ *
+ * 线程模型：同一时刻只能有一个线程调用push
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class PushAudioSource : public AudioSource {
+public:
+    PushAudioSource();
+    ~PushAudioSource() override;
+
+    PushAudioSource(const PushAudioSource&) = delete;
+    PushAudioSource& operator=(const PushAudioSource&) = delete;
+
+    bool open(const AudioSourceConfig& config,
+              DataCallback dataCallback,
+              ErrorCallback errorCallback,
+              void* userData) override;
+    bool start() override;
+    bool stop() override;
+    void close() override;
+
+    int32_t getSampleRate() const override { return opened_ ? config_.sampleRate : 0; }
+    const char* getLastError() const override { return lastError_; }
+
+    /**
+     * 是否已启动（stop之后为false，等待中的推送线程据此退出）
+     */
+    bool isRunning() const { return running_.load(std::memory_order_acquire); }
+
+    /**
+     * 推送一块数据（f32交错）
+     *
+     * @param samples 音频数据（numFrames × 声道数个采样点）
+     * @param numFrames 帧数
+     * @return true-已交给数据回调，false-未启动
+     */
+    bool push(const float* samples, int32_t numFrames);
+
+private:
+    AudioSourceConfig config_;
+    DataCallback dataCallback_;
+    void* userData_;
+    bool opened_;
+    std::atomic<bool> running_;
+    std::mutex mutex_;
+    char lastError_[128];
+};
+
+} // namespace deepfilter
+
+#endif // PUSH_AUDIO_SOURCE_H
@@ -0,0 +1,106 @@
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace deepfilter {
+
+/**
+ * 多相FIR重采样器（单声道，流式）
+ *
+ * 功能说明：
+ * 1. 任意整数采样率之间转换，按最大公约数化为有理比L/M（如44100->48000为160/147）
+ * 2. 原型滤波器为Kaiser窗sinc，截止频率取两侧奈奎斯特频率较低者的0.9倍（抗混叠/抗镜像）
+ * 3. 每个输出采样只计算一个相位的tapsPerPhase点内积，内积使用NEON/SSE向量化
+ * 4. 流式处理：任意长度的输入分块结果与一次性处理完全相同
+ * 5. 缓冲区在init时按最大输入块分配，process无锁、无分配，可在实时线程调用
+ *
+ * 延迟：线性相位FIR的群延迟，见getLatencyFrames/getLatencyUs
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class Resampler {
+public:
+    Resampler();
+
+    Resampler(const Resampler&) = delete;
+    Resampler& operator=(const Resampler&) = delete;
+
+    /**
+     * 初始化
+     *
+     * @param inputRate 输入采样率（Hz）
+     * @param outputRate 输出采样率（Hz）
+     * @param maxInputFrames 单次process的最大输入帧数
+     * @param tapsPerPhase 每个相位的抽头数（越大过渡带越窄、延迟越大），取4的倍数
+     * @return true-成功，false-参数无效
+     */
+    bool init(int32_t inputRate, int32_t outputRate, size_t maxInputFrames, size_t tapsPerPhase = 32);
+
+    /**
+     * 清空历史数据（重新开始一段音频）
+     */
+    void reset();
+
+    /**
+     * 处理一块输入
+     *
+     * @param input 输入采样
+     * @param numFrames 输入帧数（不超过maxInputFrames）
+     * @param output 输出缓冲区，至少getMaxOutputFrames()个采样点
+     * @return 输出帧数；numFrames超出上限时返回0
+     */
+    size_t process(const float* input, size_t numFrames, float* output);
+
+    /**
+     * 单次process最多输出的帧数
+     */
+    size_t getMaxOutputFrames() const { return maxOutputFrames_; }
+
+    /**
+     * 是否为直通（输入输出采样率相同）
+     */
+    bool isPassthrough() const { return upFactor_ == downFactor_; }
+
+    int32_t getInputRate() const { return inputRate_; }
+    int32_t getOutputRate() const { return outputRate_; }
+
+    /**
+     * 群延迟（按输出采样率计的帧数，可能为小数）
+     */
+    double getLatencyFrames() const;
+
+    /**
+     * 群延迟（微秒）
+     */
+    int64_t getLatencyUs() const;
+
+    /**
+     * 当前编译启用的向量指令集名称（"NEON"、"SSE"或"scalar"）
+     */
+    static const char* simdName();
+
+private:
+    // 内积：长度为4的倍数
+    static float dot(const float* a, const float* b, size_t n);
+
+    int32_t inputRate_;
+    int32_t outputRate_;
+    uint32_t upFactor_;         // L
+    uint32_t downFactor_;       // M
+    size_t taps_;               // 每个相位的抽头数
+    size_t maxInputFrames_;
+    size_t maxOutputFrames_;
+
+    std::vector<float> coefficients_;   // upFactor_个相位，每个相位taps_个系数（已反序，便于与历史数据顺序内积）
+    std::vector<float> history_;        // taps_-1个历史采样 + 新输入
+    size_t historySize_;                // history_中有效采样数
+    uint64_t phaseTime_;                // 下一个输出采样的位置（以1/L输入采样为单位，相对history_起点）
+};
+
+} // namespace deepfilter
+
+#endif // RESAMPLER_H
@@ -0,0 +1,262 @@
+#ifndef SIMULATED_AUDIO_H
+#define SIMULATED_AUDIO_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AudioSource.h"
+#include "WavFile.h"
+
+namespace deepfilter {
+
+/**
+ * 由独立线程推送数据的音频源基类（主机基准测试和回归测试用）
+ *
+ * 功能说明：
+ * 1. 在自己的线程上按framesPerCallback分块调用数据回调，模拟AAudio回调线程
+ *    （framesPerCallback为0时使用4ms，即48kHz下192帧，接近常见的AAudio低延迟burst）
+ * 2. speed=1按实时节奏推送；speed>1按倍速推送；speed=0不限速（尽可能快）
+ * 3. 节奏按起始时刻累计计算，单次调度延迟不会累积成漂移
+ * 4. 数据耗尽后线程退出，可通过waitUntilFinished等待
+ * 5. 配置采样率为0时使用音频源的原生采样率（子类在prepare中给出，默认48kHz）
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class PacedAudioSource : public AudioSource {
+public:
+    explicit PacedAudioSource(double speed);
+    ~PacedAudioSource() override;   // 子类析构函数需先调用stop()
+
+    PacedAudioSource(const PacedAudioSource&) = delete;
+    PacedAudioSource& operator=(const PacedAudioSource&) = delete;
+
+    bool open(const AudioSourceConfig& config,
+              DataCallback dataCallback,
+              ErrorCallback errorCallback,
+              void* userData) override;
+    bool start() override;
+    bool stop() override;
+    void close() override;
+
+    int32_t getSampleRate() const override { return opened_ ? config_.sampleRate : 0; }
+    const char* getLastError() const override { return lastError_; }
+
+    /**
+     * 等待数据耗尽
+     *
+     * @param timeoutMs 超时时间（毫秒）
+     * @return true-已耗尽，false-超时
+     */
+    bool waitUntilFinished(int64_t timeoutMs);
+
+    /**
+     * 数据是否已耗尽
+     */
+    bool isFinished() const { return finished_.load(std::memory_order_acquire); }
+
+    /**
+     * 已推送的帧数
+     */
+    uint64_t getDeliveredFrames() const { return deliveredFrames_.load(std::memory_order_relaxed); }
+
+protected:
+    /**
+     * 打开时准备数据（子类校验格式、打开文件等）
+     *
+     * @param config 音频格式；sampleRate为0时子类可填入原生采样率
+     */
+    virtual bool prepare(AudioSourceConfig& /*config*/) { return true; }
+
+    /**
+     * 生成下一块数据
+     *
+     * @param buffer 输出缓冲区（numFrames * channelCount个float）
+     * @param numFrames 请求的帧数
+     * @return 实际生成的帧数，0表示数据耗尽
+     */
+    virtual int32_t generate(float* buffer, int32_t numFrames) = 0;
+
+    AudioSourceConfig config_;
+    char lastError_[256];
+
+private:
+    void threadFunc();
+
+    double speed_;
+    bool opened_;
+
+    DataCallback dataCallback_;
+    void* userData_;
+    std::vector<float> buffer_;
+
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> finished_;
+    std::atomic<uint64_t> deliveredFrames_;
+    std::mutex finishedMutex_;
+    std::condition_variable finishedCondition_;
+};
+
+/**
+ * 合成信号音频源：正弦波叠加白噪声，内容可复现
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class SyntheticAudioSource : public PacedAudioSource {
+public:
+    /**
+     * @param speed 推送速度（1为实时，0为不限速）
+     * @param totalFrames 总帧数（0表示无限）
+     * @param frequencyHz 正弦波频率
+     * @param noiseLevel 噪声幅度（0~1）
+     * @param nativeSampleRate 原生采样率（配置采样率为0时使用）
+     */
+    SyntheticAudioSource(double speed, uint64_t totalFrames,
+                         float frequencyHz = 440.0f, float noiseLevel = 0.1f,
+                         int32_t nativeSampleRate = 48000);
+
+    // 推送线程会调用generate，必须在本类析构前停止
+    ~SyntheticAudioSource() override { stop(); }
+
+protected:
+    bool prepare(AudioSourceConfig& config) override;
+    int32_t generate(float* buffer, int32_t numFrames) override;
+
+private:
+    int32_t nativeSampleRate_;
+    uint64_t totalFrames_;
+    uint64_t position_;
+    float frequencyHz_;
+    float noiseLevel_;
+    uint32_t noiseState_;
+};
+
+/**
+ * WAV文件音频源：按块推送文件内容（多声道文件下混为单声道，仅支持单声道配置）
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class FileAudioSource : public PacedAudioSource {
+public:
+    /**
+     * @param path WAV文件路径（采样率必须与配置一致；配置采样率为0时使用文件采样率）
+     * @param speed 推送速度（1为实时，0为不限速）
+     * @param loop 是否循环播放
+     */
+    FileAudioSource(const char* path, double speed, bool loop);
+
+    ~FileAudioSource() override { stop(); }
+
+protected:
+    bool prepare(AudioSourceConfig& config) override;
+    int32_t generate(float* buffer, int32_t numFrames) override;
+
+private:
+    std::string path_;
+    bool loop_;
+    WavReader reader_;
+};
+
+/**
+ * 由独立线程拉取数据的输出流（主机测试双工模式用）
+ *
+ * 功能说明：
+ * 1. 在自己的线程上按framesPerCallback调用渲染回调，模拟AAudio输出回调线程
+ *    （framesPerCallback为0时使用4ms），节奏与PacedAudioSource相同（speed=0不限速）
+ * 2. clockSkewPpm模拟输出设备时钟与采集设备的偏差：正数表示播放时钟偏快，拉取速度相应提高
+ * 3. 可保留最前面recordFrames帧的输出，停止后通过getRecording检查内容
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class PacedAudioOutput : public AudioOutput {
+public:
+    /**
+     * @param speed 拉取速度（1为实时，0为不限速）
+     * @param clockSkewPpm 时钟偏差（ppm）
+     * @param recordFrames 保留的输出帧数（0表示不保留）
+     */
+    PacedAudioOutput(double speed, double clockSkewPpm = 0.0, size_t recordFrames = 0);
+    ~PacedAudioOutput() override;
+
+    PacedAudioOutput(const PacedAudioOutput&) = delete;
+    PacedAudioOutput& operator=(const PacedAudioOutput&) = delete;
+
+    bool open(const AudioSourceConfig& config,
+              RenderCallback renderCallback,
+              ErrorCallback errorCallback,
+              void* userData) override;
+    bool start() override;
+    bool stop() override;
+    void close() override;
+
+    int32_t getSampleRate() const override { return opened_ ? config_.sampleRate : 0; }
+    int32_t getFramesPerBurst() const override { return opened_ ? config_.framesPerCallback : 0; }
+    const char* getLastError() const override { return lastError_; }
+
+    /**
+     * 已拉取的帧数
+     */
+    uint64_t getRenderedFrames() const { return renderedFrames_.load(std::memory_order_relaxed); }
+
+    /**
+     * 保留的输出（交织，停止后读取）
+     */
+    const std::vector<float>& getRecording() const { return recording_; }
+
+private:
+    void threadFunc();
+
+    double speed_;
+    double clockSkewPpm_;
+    size_t recordFrames_;
+    bool opened_;
+    AudioSourceConfig config_;
+
+    RenderCallback renderCallback_;
+    void* userData_;
+    std::vector<float> buffer_;
+    std::vector<float> recording_;
+
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<uint64_t> renderedFrames_;
+    char lastError_[256];
+};
+
+/**
+ * 空输出：丢弃数据，只计数（衡量处理管线本身的开销）
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class NullAudioSink : public AudioSink {
+public:
+    NullAudioSink() : writes_(0), frames_(0), checksum_(0) {}
+
+    void write(const float* audioData, int32_t numFrames, float lsnr) override;
+
+    uint64_t getWriteCount() const { return writes_.load(std::memory_order_relaxed); }
+    uint64_t getFrameCount() const { return frames_.load(std::memory_order_relaxed); }
+
+    /**
+     * 每次写入首个采样点的位模式累加值（防止编译器优化掉数据读取，也可用于比对输出）
+     */
+    uint64_t getChecksum() const { return checksum_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> writes_;
+    std::atomic<uint64_t> frames_;
+    std::atomic<uint64_t> checksum_;
+};
+
+} // namespace deepfilter
+
+#endif // SIMULATED_AUDIO_H
@@ -0,0 +1,239 @@
+#ifndef STREAM_ENGINE_H
+#define STREAM_ENGINE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <semaphore.h>
+#include "FrameRingBuffer.h"
+#include "HopReblocker.h"
+
+namespace deepfilter {
+
+/**
+ * 多路流引擎配置
+ */
+struct StreamEngineConfig {
+    size_t workerCount = 0;             // 工作线程数（0表示使用硬件并发数）
+    size_t maxStreams = 256;            // 最大并发流数（流槽位在初始化时预分配）
+    size_t queueHops = 32;              // 每路流输入队列容量（hop数），满时丢弃新到达的hop
+    size_t maxHopsPerTurn = 4;          // 每次调度最多连续处理的hop数，处理完后让出给其他流
+    int64_t deadlineUs = 20000;         // 单hop延迟上限（入队到回调完成），超过计为deadline miss
+    double maxUtilization = 0.8;        // 准入控制：预计CPU占用超过该比例时拒绝新流
+};
+
+/**
+ * 单路流统计
+ */
+struct StreamStats {
+    uint64_t processedHops = 0;     // 已处理hop数
+    uint64_t droppedHops = 0;       // 输入队列满被丢弃的hop数
+    uint64_t failedHops = 0;        // 模型处理出错（返回NaN，未回调）的hop数
+    uint64_t deadlineMisses = 0;    // 延迟超过deadlineUs的hop数
+    int64_t avgLatencyUs = 0;       // 平均延迟（微秒）
+    int64_t maxLatencyUs = 0;       // 最大延迟（微秒）
+};
+
+/**
+ * 引擎统计
+ */
+struct StreamEngineStats {
+    size_t workerCount = 0;         // 工作线程数
+    size_t activeStreams = 0;       // 活动流数
+    uint64_t processedHops = 0;     // 全部流已处理hop数
+    uint64_t steals = 0;            // 从其他工作线程窃取的任务数
+    uint64_t rejectedStreams = 0;   // 被准入控制拒绝的流数
+    int64_t hopCostNs = 0;          // 单hop处理耗时（指数滑动平均，纳秒）
+};
+
+/**
+ * 多路流降噪引擎
+ *
+ * 功能说明：
+ * 1. 一台主机上同时降噪大量单声道流（会议后端），模型只加载一次，每路流持有独立的DfTract状态
+ * 2. 固定数量的工作线程，每个线程有自己的任务队列，空闲时从其他线程队列尾部窃取
+ * 3. 每路流同一时刻只在一个队列中、只被一个线程处理，保证hop按顺序处理
+ * 4. 每次调度最多处理maxHopsPerTurn个hop后让出，避免单路流饿死其他流
+ * 5. 按实测单hop耗时做准入控制，预计无法满足实时要求时拒绝创建新流
+ * 6. 记录每路流入队到回调完成的延迟和deadline miss次数
+ *
+ * 线程模型：
+ * - pushAudio：每路流只能由一个线程调用（单生产者），可与destroyStream并发，
+ *   destroyStream等待正在进行的pushAudio返回后才释放该流
+ * - 回调：在工作线程上调用，同一路流的回调不会并发
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class StreamEngine {
+public:
+    /**
+     * 降噪结果回调函数类型
+     *
+     * @param streamId 流ID
+     * @param hopIndex 该流的hop序号（从0开始连续递增，被丢弃的hop不占序号）
+     * @param audioData 降噪后的音频数据
+     * @param numFrames 采样点数（等于hop大小）
+     * @param lsnr LSNR值
+     */
+    using StreamCallback = std::function<void(int32_t streamId, uint64_t hopIndex,
+                                              const float* audioData, int32_t numFrames, float lsnr)>;
+
+    StreamEngine();
+    ~StreamEngine();
+
+    StreamEngine(const StreamEngine&) = delete;
+    StreamEngine& operator=(const StreamEngine&) = delete;
+
+    /**
+     * 初始化引擎并启动工作线程
+     *
+     * @param tarBytes 模型文件字节数组（tar.gz格式），初始化完成后即可释放
+     * @param tarBytesSize 模型文件字节数组大小
+     * @param postFilterBeta 后滤波器beta参数
+     * @param attenLimDb 衰减限制（dB）
+     * @param config 引擎配置
+     * @return true-成功，false-失败（见getLastError）
+     */
+    bool initialize(
+        const uint8_t* tarBytes,
+        size_t tarBytesSize,
+        float postFilterBeta,
+        float attenLimDb,
+        const StreamEngineConfig& config);
+
+    /**
+     * 停止工作线程并释放所有流
+     */
+    void release();
+
+    /**
+     * 创建一路流
+     *
+     * @param callback 降噪结果回调
+     * @return 流ID（>=0），失败返回-1（槽位用尽、准入控制拒绝或模型实例创建失败）
+     */
+    int32_t createStream(StreamCallback callback);
+
+    /**
+     * 销毁一路流（等待该流正在进行的写入和处理完成，未处理的hop被丢弃）
+     *
+     * @param streamId 流ID
+     */
+    void destroyStream(int32_t streamId);
+
+    /**
+     * 写入音频数据
+     *
+     * 任意长度，内部按hop大小分块，不足一个hop的部分留到下次写入
+     *
+     * @param streamId 流ID
+     * @param data 音频数据（f32，单声道，48kHz）
+     * @param numFrames 采样点数
+     * @return 成功入队的完整hop数；流ID无效返回-1
+     */
+    int32_t pushAudio(int32_t streamId, const float* data, size_t numFrames);
+
+    /**
+     * 获取hop大小
+     */
+    size_t getFrameSize() const { return frameSize_; }
+
+    /**
+     * 获取单路流统计
+     */
+    bool getStreamStats(int32_t streamId, StreamStats* stats) const;
+
+    /**
+     * 获取引擎统计
+     */
+    StreamEngineStats getStats() const;
+
+    const char* getLastError() const { return lastError_; }
+
+private:
+    enum StreamState : int32_t {
+        STREAM_FREE = 0,
+        STREAM_ACTIVE = 1,
+        STREAM_CLOSING = 2
+    };
+
+    struct Stream {
+        int32_t id = -1;
+        std::atomic<int32_t> state{STREAM_FREE};
+        std::atomic<bool> scheduled{false};     // 是否已在某个任务队列中或正在被处理
+        std::atomic<int32_t> pushers{0};        // 正在pushAudio中访问该流的生产者数
+        void* dfState = nullptr;
+        StreamCallback callback;
+        FrameRingBuffer input;
+        HopReblocker reblocker;                 // 不足一个hop的输入（仅生产者访问）
+
+        // 统计（仅当前处理线程写入）
+        uint64_t hopIndex = 0;
+        std::atomic<uint64_t> processedHops{0};
+        std::atomic<uint64_t> failedHops{0};
+        std::atomic<uint64_t> deadlineMisses{0};
+        std::atomic<int64_t> totalLatencyUs{0};
+        std::atomic<int64_t> maxLatencyUs{0};
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Stream*> tasks;
+        std::thread thread;
+        std::vector<float> input;               // 输入/输出缓冲区（每线程一份）
+        std::vector<float> output;
+        AudioFrame frame;
+    };
+
+    void workerLoop(size_t workerIndex);
+
+    // 把流放入任务队列（已调度时直接返回）
+    void schedule(Stream* stream, size_t preferredWorker);
+
+    // 取任务：先取本线程队列头部，再从其他线程队列尾部窃取
+    Stream* takeTask(size_t workerIndex);
+
+    // 处理一路流最多maxHopsPerTurn个hop
+    void runStream(Worker& worker, Stream* stream);
+
+    // 按实测单hop耗时判断能否再接纳一路流
+    bool canAdmit() const;
+
+    Stream* lookup(int32_t streamId) const;
+
+    static int64_t nowNs();
+
+    StreamEngineConfig config_;
+    void* model_;                               // 共享模型（所有流从它创建实例）
+    float postFilterBeta_;
+    float attenLimDb_;
+    size_t frameSize_;
+
+    std::unique_ptr<Stream[]> streams_;
+    std::unique_ptr<Worker[]> workers_;
+    size_t workerCount_;
+    std::mutex streamsMutex_;                   // 仅保护流的创建/销毁
+
+    sem_t workSemaphore_;
+    bool semaphoreInitialized_;
+    std::atomic<bool> running_;
+
+    std::atomic<size_t> activeStreams_;
+    std::atomic<uint64_t> processedHops_;
+    std::atomic<uint64_t> steals_;
+    std::atomic<uint64_t> rejectedStreams_;
+    std::atomic<int64_t> hopCostNs_;
+
+    char lastError_[256];
+};
+
+} // namespace deepfilter
+
+#endif // STREAM_ENGINE_H
@@ -0,0 +1,158 @@
+#ifndef THREAD_SCHEDULING_H
+#define THREAD_SCHEDULING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace deepfilter {
+
+/**
+ * 线程优先级策略
+ */
+enum class ThreadPriority {
+    DEFAULT,    // 不修改（继承创建线程的调度策略）
+    NICE,       // SCHED_OTHER + niceValue
+    FIFO        // SCHED_FIFO + fifoPriority，没有权限时退回NICE
+};
+
+/**
+ * 线程CPU亲和性策略
+ */
+enum class CpuAffinity {
+    NONE,               // 不限制
+    PERFORMANCE_CORES,  // 绑定到性能核心（最大频率高于最低一档的核心，见CpuTopology）
+    CPUSET              // 绑定到cpuMask指定的核心
+};
+
+/**
+ * 处理线程调度配置
+ */
+struct ThreadSchedulingConfig {
+    ThreadPriority priority = ThreadPriority::DEFAULT;
+    int32_t niceValue = -16;            // NICE（及FIFO失败时）使用的nice值，-16即Android的ANDROID_PRIORITY_AUDIO
+    int32_t fifoPriority = 2;           // FIFO实时优先级（1~99）
+    CpuAffinity affinity = CpuAffinity::NONE;
+    uint64_t cpuMask = 0;               // CPUSET时使用，第n位表示CPU n
+    bool boostOnBacklog = false;        // 队列积压时自动提升为FIFO并绑定性能核心
+    size_t boostQueueDepth = 4;         // 队列深度达到该值时提升
+    int32_t relaxHops = 200;            // 提升后队列连续该数量hop不超过1帧时恢复基础设置
+};
+
+/**
+ * CPU拓扑（从sysfs读取各核心最大频率）
+ */
+struct CpuTopology {
+    static const int32_t MAX_CPUS = 64;
+
+    int32_t cpuCount = 0;               // 读取到频率信息的核心数
+    uint64_t cpuMask = 0;               // 读取到频率信息的核心
+    uint64_t performanceMask = 0;       // 最大频率高于最低一档的核心；各核心相同时为全部核心
+    uint32_t maxFreqKhz[MAX_CPUS] = {}; // 各核心最大频率（kHz），cpufreq不可用时为cpu_capacity
+};
+
+/**
+ * 处理线程调度统计
+ */
+struct ThreadSchedulingStats {
+    uint64_t coreHops[CpuTopology::MAX_CPUS] = {};  // 各核心上处理的hop数
+    uint64_t unknownCoreHops = 0;       // 无法获取当前核心（或核心号超出范围）的hop数
+    uint64_t performanceCoreHops = 0;   // 在性能核心上处理的hop数
+    uint64_t boosts = 0;                // 因队列积压提升的次数
+    uint64_t failures = 0;              // 调度/亲和性系统调用失败次数
+    bool boosted = false;               // 当前是否处于提升状态
+};
+
+/**
+ * 处理线程调度器
+ *
+ * 功能说明：
+ * 1. 在处理线程启动时应用基础调度设置：SCHED_FIFO或nice值，以及CPU亲和性
+ * 2. 从/sys/devices/system/cpu读取各核心最大频率，自动识别big.LITTLE中较快的核心
+ * 3. 队列深度达到boostQueueDepth时提升为FIFO并绑定性能核心，积压消除一段时间后恢复基础设置
+ * 4. 逐hop记录运行的CPU核心，用于确认线程是否被调度到小核
+ *
+ * Android应用通常没有SCHED_FIFO权限，FIFO失败时退回nice值（失败计入统计，不影响处理）
+ *
+ * 线程模型：applyBase/onHop在处理线程调用，getStats可在任意线程调用
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class ThreadScheduler {
+public:
+    ThreadScheduler();
+
+    ThreadScheduler(const ThreadScheduler&) = delete;
+    ThreadScheduler& operator=(const ThreadScheduler&) = delete;
+
+    /**
+     * 校验配置并计算目标核心（非实时线程调用），同时清零统计
+     *
+     * @param config 调度配置
+     * @param topology CPU拓扑（PERFORMANCE_CORES和积压提升时使用）
+     * @return true-成功，false-参数无效（优先级超出范围、CPUSET为空或不含已知核心）
+     */
+    bool init(const ThreadSchedulingConfig& config, const CpuTopology& topology);
+
+    /**
+     * 在当前线程上应用基础调度设置
+     */
+    void applyBase();
+
+    /**
+     * 记录当前hop运行的核心，并按队列深度提升或恢复调度设置
+     *
+     * @param queueDepth 当前队列中的帧数
+     */
+    void onHop(size_t queueDepth);
+
+    /**
+     * 清零统计
+     */
+    void reset();
+
+    /**
+     * 获取统计快照
+     */
+    ThreadSchedulingStats getStats() const;
+
+    const ThreadSchedulingConfig& getConfig() const { return config_; }
+
+    /**
+     * 读取CPU拓扑
+     *
+     * @param sysfsRoot sysfs中CPU目录（主机测试可指向伪造的目录树）
+     * @return 拓扑，读取失败时cpuCount为0
+     */
+    static CpuTopology detectTopology(const char* sysfsRoot = "/sys/devices/system/cpu");
+
+    /**
+     * 当前线程所在核心，无法获取时返回-1
+     */
+    static int32_t currentCpu();
+
+private:
+    bool applyPriority(ThreadPriority priority, int32_t niceValue);
+    bool applyAffinity(uint64_t mask);
+    void applyLevel(bool boosted);
+
+    ThreadSchedulingConfig config_;
+    uint64_t baseMask_;         // 基础设置的亲和性（0表示不限制）
+    uint64_t boostMask_;        // 提升时的亲和性（0表示不限制）
+    uint64_t performanceMask_;
+    uint64_t originalMask_;     // applyBase前线程的亲和性
+    int32_t originalNice_;      // applyBase前线程的nice值
+    int32_t calmHops_;          // 提升后队列连续不积压的hop数（仅处理线程访问）
+
+    std::atomic<uint64_t> coreHops_[CpuTopology::MAX_CPUS];
+    std::atomic<uint64_t> unknownCoreHops_;
+    std::atomic<uint64_t> performanceCoreHops_;
+    std::atomic<uint64_t> boosts_;
+    std::atomic<uint64_t> failures_;
+    std::atomic<bool> boosted_;
+};
+
+} // namespace deepfilter
+
+#endif // THREAD_SCHEDULING_H
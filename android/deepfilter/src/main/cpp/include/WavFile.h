@@ -0,0 +1,168 @@
+#ifndef WAV_FILE_H
+#define WAV_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include "MappedFile.h"
+
+namespace deepfilter {
+
+/**
+ * WAV采样格式
+ */
+enum class WavSampleFormat : int32_t {
+    PCM16 = 0,      // 16位有符号整数
+    FLOAT32 = 1     // 32位IEEE浮点
+};
+
+/**
+ * 流式WAV读取器
+ *
+ * 功能说明：
+ * 1. 通过内存映射打开文件，按块读取并转换为f32，内存占用与文件大小无关
+ * 2. 支持PCM16和PCM32F（含WAVE_FORMAT_EXTENSIBLE）
+ * 3. 支持交错多声道读取和下混为单声道读取
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class WavReader {
+public:
+    WavReader();
+    ~WavReader();
+
+    WavReader(const WavReader&) = delete;
+    WavReader& operator=(const WavReader&) = delete;
+
+    /**
+     * 打开WAV文件并解析头部
+     *
+     * @param path 文件路径
+     * @return true-成功，false-失败（见getLastError）
+     */
+    bool open(const char* path);
+
+    /**
+     * 关闭文件
+     */
+    void close();
+
+    /**
+     * 读取交错采样
+     *
+     * @param out 输出缓冲区，至少maxFrames * channels()个float
+     * @param maxFrames 最多读取的帧数（每帧包含所有声道）
+     * @return 实际读取的帧数，0表示已到文件末尾
+     */
+    size_t read(float* out, size_t maxFrames);
+
+    /**
+     * 读取并下混为单声道
+     *
+     * @param out 输出缓冲区，至少maxFrames个float
+     * @param maxFrames 最多读取的帧数
+     * @return 实际读取的帧数，0表示已到文件末尾
+     */
+    size_t readMono(float* out, size_t maxFrames);
+
+    /**
+     * 回到数据起始位置
+     */
+    void rewind();
+
+    int32_t sampleRate() const { return sampleRate_; }
+
+    int32_t channels() const { return channels_; }
+
+    WavSampleFormat format() const { return format_; }
+
+    /**
+     * 获取总帧数
+     */
+    uint64_t frameCount() const { return frameCount_; }
+
+    /**
+     * 获取剩余未读帧数
+     */
+    uint64_t framesRemaining() const { return frameCount_ - position_; }
+
+    const char* getLastError() const { return lastError_; }
+
+private:
+    MappedFile file_;
+    const uint8_t* samples_;
+    uint64_t frameCount_;
+    uint64_t position_;
+    int32_t sampleRate_;
+    int32_t channels_;
+    WavSampleFormat format_;
+    char lastError_[256];
+};
+
+/**
+ * 流式WAV写入器
+ *
+ * 先写入占位头部，数据边处理边追加，close时回填RIFF和data块大小
+ *
+ * @author hzexe
+ * @version 1.0
+ */
+class WavWriter {
+public:
+    WavWriter();
+    ~WavWriter();
+
+    WavWriter(const WavWriter&) = delete;
+    WavWriter& operator=(const WavWriter&) = delete;
+
+    /**
+     * 创建WAV文件
+     *
+     * @param path 文件路径
+     * @param sampleRate 采样率
+     * @param channels 声道数
+     * @param format 采样格式
+     * @return true-成功，false-失败（见getLastError）
+     */
+    bool open(const char* path, int32_t sampleRate, int32_t channels, WavSampleFormat format);
+
+    /**
+     * 追加交错采样（PCM16输出时自动限幅）
+     *
+     * @param samples 采样数据，frames * channels个float
+     * @param frames 帧数
+     * @return true-成功，false-写入失败
+     */
+    bool write(const float* samples, size_t frames);
+
+    /**
+     * 回填头部并关闭文件
+     *
+     * @return true-成功，false-失败
+     */
+    bool close();
+
+    uint64_t framesWritten() const { return framesWritten_; }
+
+    const char* getLastError() const { return lastError_; }
+
+private:
+    bool writeHeader(uint32_t dataBytes);
+
+    FILE* file_;
+    int32_t sampleRate_;
+    int32_t channels_;
+    WavSampleFormat format_;
+    uint64_t framesWritten_;
+
+    // 格式转换暂存区（避免逐采样fwrite）
+    static const size_t SCRATCH_BYTES = 16384;
+    uint8_t scratch_[SCRATCH_BYTES];
+
+    char lastError_[256];
+};
+
+} // namespace deepfilter
+
+#endif // WAV_FILE_H
@@ -0,0 +1,324 @@
+#ifndef DEEPFILTER_ORT_H
+#define DEEPFILTER_ORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * deepfilter-ort C接口声明
+ * 
+ * 由Rust库libdeepfilter_ort导出，AudioProcessor和主机端工具共用
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * 创建DeepFilterNet实例
+ * 
+ * @param tar_buf 模型文件字节数组指针（tar.gz格式）
+ * @param tar_size 模型文件字节数组大小
+ * @param post_filter_beta 后滤波器beta参数
+ * @param atten_lim_db 衰减限制（dB）
+ * @return DeepFilterNet状态指针（nullptr表示失败）
+ */
+void* df_create(
+    const uint8_t* tar_buf,
+    size_t tar_size,
+    float post_filter_beta,
+    float atten_lim_db);
+
+/**
+ * 创建多声道DeepFilterNet实例
+ * 
+ * 所有声道在同一次推理中处理，比每个声道各建一个实例开销更低
+ * 
+ * @param tar_buf 模型文件字节数组指针（tar.gz格式）
+ * @param tar_size 模型文件字节数组大小
+ * @param n_ch 声道数（1~16）
+ * @param post_filter_beta 后滤波器beta参数
+ * @param atten_lim_db 衰减限制（dB）
+ * @return DeepFilterNet状态指针（nullptr表示失败）
+ */
+void* df_create_ex(
+    const uint8_t* tar_buf,
+    size_t tar_size,
+    size_t n_ch,
+    float post_filter_beta,
+    float atten_lim_db);
+
+/**
+ * 加载模型（解压tar.gz并读取配置和ONNX文件）
+ * 
+ * 返回的模型可在多个线程间共享，用于通过df_create_from_model创建多个实例；
+ * 子网络在首次创建某一声道数的实例时解析、优化一次，之后同声道数的实例共享优化结果
+ * 
+ * @param tar_buf 模型文件字节数组指针（tar.gz格式）
+ * @param tar_size 模型文件字节数组大小
+ * @return 模型句柄（nullptr表示失败）
+ */
+void* df_model_load(const uint8_t* tar_buf, size_t tar_size);
+
+/**
+ * 从已加载的模型创建DeepFilterNet实例
+ * 
+ * 实例只分配自己的推理和STFT状态，优化后的子网络与模型共享（引用计数），创建完成后模型可以随时释放
+ * 
+ * @param model 模型句柄
+ * @param post_filter_beta 后滤波器beta参数
+ * @param atten_lim_db 衰减限制（dB）
+ * @return DeepFilterNet状态指针（nullptr表示失败）
+ */
+void* df_create_from_model(const void* model, float post_filter_beta, float atten_lim_db);
+
+/**
+ * 从已加载的模型创建多声道DeepFilterNet实例
+ * 
+ * @param model 模型句柄
+ * @param n_ch 声道数（1~16）
+ * @param post_filter_beta 后滤波器beta参数
+ * @param atten_lim_db 衰减限制（dB）
+ * @return DeepFilterNet状态指针（nullptr表示失败）
+ */
+void* df_create_from_model_ex(const void* model, size_t n_ch, float post_filter_beta, float atten_lim_db);
+
+/**
+ * 推理后端（见df_create_from_model_backend）
+ *
+ * 目前只有tract；其他推理实现在Rust层实现Backend trait后再分配编号
+ */
+#define DF_BACKEND_TRACT 0
+
+/**
+ * 从已加载的模型创建DeepFilterNet实例，并指定推理后端
+ * 
+ * 其余接口（df_process_frame*、参数设置、帧大小和延迟查询）与后端无关；
+ * df_create*和df_create_from_model*均使用DF_BACKEND_TRACT
+ * 
+ * @param model 模型句柄
+ * @param n_ch 声道数（1~16）
+ * @param post_filter_beta 后滤波器beta参数
+ * @param atten_lim_db 衰减限制（dB）
+ * @param backend 推理后端（DF_BACKEND_*）
+ * @return DeepFilterNet状态指针（nullptr表示失败，包括未知的后端编号）
+ */
+void* df_create_from_model_backend(const void* model, size_t n_ch, float post_filter_beta, float atten_lim_db,
+                                   int32_t backend);
+
+/**
+ * 当前构建是否包含指定的推理后端
+ * 
+ * @param backend 推理后端（DF_BACKEND_*）
+ * @return 1-包含，0-不包含
+ */
+int32_t df_backend_available(int32_t backend);
+
+/**
+ * 获取实例使用的推理后端
+ * 
+ * @param state DeepFilterNet状态指针
+ * @return 推理后端（DF_BACKEND_*），state为空时返回-1
+ */
+int32_t df_get_backend(void* state);
+
+/**
+ * 释放模型
+ * 
+ * @param model 模型句柄
+ */
+void df_model_free(void* model);
+
+/**
+ * 将tar.gz模型重新打包为不压缩的gzip（用于磁盘缓存）
+ * 
+ * 结果仍可直接传给df_model_load，但加载时解压退化为内存复制
+ * 
+ * @param tar_buf 模型文件字节数组指针（tar.gz格式）
+ * @param tar_size 模型文件字节数组大小
+ * @param out_size 输出缓冲区大小
+ * @return 重新打包后的缓冲区（nullptr表示失败），需用df_free_buffer释放
+ */
+uint8_t* df_model_repack(const uint8_t* tar_buf, size_t tar_size, size_t* out_size);
+
+/**
+ * 模型精度（见df_model_select_precision）
+ */
+#define DF_PRECISION_FP32 0
+#define DF_PRECISION_FP16 1
+#define DF_PRECISION_INT8 2
+
+/**
+ * 按精度选择子网络，组装为标准格式的模型（用于加载训练后量化的模型变体）
+ * 
+ * 变体子网络按后缀命名（enc_fp16.onnx、erb_dec_int8.onnx、df_dec_int8.onnx等），
+ * 可与FP32子网络放在同一个tar.gz中，也可单独打包为同格式的变体包（优先于主包中的同名文件）；
+ * config.ini取自主包。三个子网络都必须有所选精度的变体，否则失败
+ * 
+ * @param tar_buf 模型文件字节数组指针（tar.gz格式）
+ * @param tar_size 模型文件字节数组大小
+ * @param variant_buf 变体包字节数组指针（tar.gz格式，可为nullptr）
+ * @param variant_size 变体包字节数组大小
+ * @param precision 模型精度（DF_PRECISION_*）
+ * @param out_size 输出缓冲区大小
+ * @return 不压缩的tar.gz（可直接传给df_model_load），nullptr表示失败；需用df_free_buffer释放
+ */
+uint8_t* df_model_select_precision(
+    const uint8_t* tar_buf,
+    size_t tar_size,
+    const uint8_t* variant_buf,
+    size_t variant_size,
+    int32_t precision,
+    size_t* out_size);
+
+/**
+ * 释放df_model_repack/df_model_select_precision返回的缓冲区
+ * 
+ * @param buf 缓冲区指针
+ * @param size 缓冲区大小
+ */
+void df_free_buffer(uint8_t* buf, size_t size);
+
+/**
+ * 销毁DeepFilterNet实例
+ * 
+ * @param state DeepFilterNet状态指针
+ */
+void df_destroy(void* state);
+
+/**
+ * 处理音频帧
+ * 
+ * 多声道实例的数据为平面布局（声道0的hop，声道1的hop……），交织数据使用df_process_frame_interleaved
+ * 
+ * @param state DeepFilterNet状态指针
+ * @param input 输入音频数据指针（f32格式）
+ * @param output 输出音频数据指针（f32格式）
+ * @param frame_size 采样点总数（帧大小 × 声道数）
+ * @return LSNR值（噪声较大时为负数）；失败返回NaN（用isnan判断）
+ */
+float df_process_frame(
+    void* state,
+    const float* input,
+    float* output,
+    size_t frame_size);
+
+/**
+ * 处理交织布局的音频帧（如多声道采集回调的数据）
+ * 
+ * 内部转换为模型的平面布局，处理后再交织写回；单声道实例等同于df_process_frame
+ * 
+ * @param state DeepFilterNet状态指针
+ * @param input 输入音频数据指针（f32格式，n_frames × 声道数个采样点）
+ * @param output 输出音频数据指针（f32格式，n_frames × 声道数个采样点）
+ * @param n_frames 每声道帧数（必须等于帧大小）
+ * @return LSNR值（噪声较大时为负数）；失败返回NaN（用isnan判断）
+ */
+float df_process_frame_interleaved(
+    void* state,
+    const float* input,
+    float* output,
+    size_t n_frames);
+
+/**
+ * 批量处理多个hop
+ * 
+ * @param state DeepFilterNet状态指针
+ * @param input 输入音频数据指针（f32格式）
+ * @param output 输出音频数据指针（f32格式）
+ * @param n_samples 采样点总数（必须是帧大小 × 声道数的整数倍，多声道时每个hop为平面布局）
+ * @param lsnr 每个hop的LSNR输出数组（可为nullptr，否则至少n_samples / (帧大小 × 声道数)个元素；失败的hop为NaN）
+ * @return 成功处理的hop数；参数无效返回-1；中途失败时返回已成功处理的hop数
+ */
+int64_t df_process_frames(
+    void* state,
+    const float* input,
+    float* output,
+    size_t n_samples,
+    float* lsnr);
+
+/**
+ * 设置后滤波器beta参数
+ * 
+ * 与df_process_frame*修改同一个实例，不可并发调用：需在处理线程的hop之间调用
+ * （AudioProcessor经ParameterMailbox转发到处理线程）
+ * 
+ * @param state DeepFilterNet状态指针
+ * @param beta beta参数值
+ */
+void df_set_post_filter_beta(void* state, float beta);
+
+/**
+ * 设置衰减限制
+ * 
+ * 线程要求同df_set_post_filter_beta
+ * 
+ * @param state DeepFilterNet状态指针
+ * @param lim_db 衰减限制（dB）
+ */
+void df_set_atten_lim(void* state, float lim_db);
+
+/**
+ * 获取帧大小
+ * 
+ * @param state DeepFilterNet状态指针
+ * @return 帧大小（采样点数）
+ */
+size_t df_get_frame_size(void* state);
+
+/**
+ * 获取声道数
+ * 
+ * @param state DeepFilterNet状态指针
+ * @return 声道数（state为空时返回0）
+ */
+size_t df_get_channel_count(void* state);
+
+/**
+ * 获取模型前瞻
+ * 
+ * @param state DeepFilterNet状态指针
+ * @return 前瞻hop数（max(conv_lookahead, df_lookahead)），零前瞻模型为0
+ */
+size_t df_get_lookahead(void* state);
+
+/**
+ * 获取算法延迟：输出相对输入的固定延迟，(fft_size - hop_size) + lookahead * hop_size
+ * 
+ * 不含调用方攒满一个hop的分块延迟；回声消除、音画同步需要按此值对齐
+ * 
+ * @param state DeepFilterNet状态指针
+ * @return 延迟（每声道采样点数，模型采样率48kHz），state为空时返回0
+ */
+size_t df_get_algorithmic_delay(void* state);
+
+/**
+ * PCM16转换为f32（x / 32768），NEON/AVX2/SSE2向量化
+ * 
+ * @param input 输入PCM16数据（不要求对齐）
+ * @param output 输出f32数据
+ * @param n_samples 采样点数
+ */
+void df_pcm16_to_f32(const int16_t* input, float* output, size_t n_samples);
+
+/**
+ * f32转换为PCM16（乘以32768后饱和到[-32768, 32767]，就近取偶），NEON/AVX2/SSE2向量化
+ * 
+ * @param input 输入f32数据
+ * @param output 输出PCM16数据（不要求对齐）
+ * @param n_samples 采样点数
+ */
+void df_f32_to_pcm16(const float* input, int16_t* output, size_t n_samples);
+
+/**
+ * PCM转换使用的向量指令集名称
+ * 
+ * @return "NEON"、"AVX2"、"SSE2"或"scalar"
+ */
+const char* df_pcm_simd_name(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DEEPFILTER_ORT_H
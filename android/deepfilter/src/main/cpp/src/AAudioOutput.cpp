@@ -0,0 +1,164 @@
+#include "AAudioOutput.h"
+#include <cstdio>
+#include <cstring>
+
+#define LOG_TAG "AAudioOutput"
+#include "NativeLog.h"
+
+namespace deepfilter {
+
+AAudioOutput::AAudioOutput()
+    : stream_(nullptr)
+    , started_(false)
+    , sampleRate_(0)
+    , framesPerBurst_(0)
+    , renderCallback_(nullptr)
+    , errorCallback_(nullptr)
+    , userData_(nullptr) {
+    memset(lastError_, 0, sizeof(lastError_));
+}
+
+AAudioOutput::~AAudioOutput() {
+    close();
+}
+
+bool AAudioOutput::open(const AudioSourceConfig& config,
+                        RenderCallback renderCallback,
+                        ErrorCallback errorCallback,
+                        void* userData) {
+    if (renderCallback == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "渲染回调为空");
+        return false;
+    }
+
+    close();
+
+    renderCallback_ = renderCallback;
+    errorCallback_ = errorCallback;
+    userData_ = userData;
+
+    AAudioStreamBuilder* builder;
+    aaudio_result_t result = AAudio_createStreamBuilder(&builder);
+    if (result != AAUDIO_OK) {
+        snprintf(lastError_, sizeof(lastError_), "创建AAudio流构建器失败: %s",
+                 AAudio_convertResultToText(result));
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    AAudioStreamBuilder_setFormat(builder, AAUDIO_FORMAT_PCM_FLOAT);
+    if (config.sampleRate > 0) {
+        AAudioStreamBuilder_setSampleRate(builder, config.sampleRate);
+    }
+    AAudioStreamBuilder_setChannelCount(builder, config.channelCount);
+    AAudioStreamBuilder_setDirection(builder, AAUDIO_DIRECTION_OUTPUT);
+    AAudioStreamBuilder_setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+    AAudioStreamBuilder_setSharingMode(builder, AAUDIO_SHARING_MODE_EXCLUSIVE);
+    if (config.framesPerCallback > 0) {
+        AAudioStreamBuilder_setFramesPerDataCallback(builder, config.framesPerCallback);
+    }
+    AAudioStreamBuilder_setDataCallback(builder, onData, this);
+    AAudioStreamBuilder_setErrorCallback(builder, onError, this);
+
+    result = AAudioStreamBuilder_openStream(builder, &stream_);
+    AAudioStreamBuilder_delete(builder);
+
+    if (result != AAUDIO_OK) {
+        snprintf(lastError_, sizeof(lastError_), "打开AAudio输出流失败: %s",
+                 AAudio_convertResultToText(result));
+        LOGE("%s", lastError_);
+        stream_ = nullptr;
+        return false;
+    }
+
+    const int32_t channelCount = AAudioStream_getChannelCount(stream_);
+    if (channelCount != config.channelCount) {
+        snprintf(lastError_, sizeof(lastError_), "设备不支持%d声道播放（实际%d声道）",
+                 config.channelCount, channelCount);
+        LOGE("%s", lastError_);
+        AAudioStream_close(stream_);
+        stream_ = nullptr;
+        return false;
+    }
+
+    // 低延迟流的缓冲区默认可能远大于一个burst，收紧到两个burst
+    framesPerBurst_ = AAudioStream_getFramesPerBurst(stream_);
+    if (framesPerBurst_ > 0) {
+        AAudioStream_setBufferSizeInFrames(stream_, framesPerBurst_ * 2);
+    }
+
+    sampleRate_ = AAudioStream_getSampleRate(stream_);
+    LOGI("AAudio输出流初始化成功: 采样率=%dHz, 声道数=%d, burst=%d帧, 缓冲区=%d帧", sampleRate_, channelCount,
+         framesPerBurst_, AAudioStream_getBufferSizeInFrames(stream_));
+    return true;
+}
+
+bool AAudioOutput::start() {
+    if (stream_ == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "AAudio输出流未打开");
+        return false;
+    }
+
+    aaudio_result_t result = AAudioStream_requestStart(stream_);
+    if (result != AAUDIO_OK) {
+        snprintf(lastError_, sizeof(lastError_), "启动AAudio输出流失败: %s",
+                 AAudio_convertResultToText(result));
+        LOGE("%s", lastError_);
+        return false;
+    }
+    started_ = true;
+    return true;
+}
+
+bool AAudioOutput::stop() {
+    if (stream_ == nullptr || !started_) {
+        return true;
+    }
+
+    started_ = false;
+    aaudio_result_t result = AAudioStream_requestStop(stream_);
+    if (result != AAUDIO_OK) {
+        snprintf(lastError_, sizeof(lastError_), "停止AAudio输出流失败: %s",
+                 AAudio_convertResultToText(result));
+        LOGE("%s", lastError_);
+        return false;
+    }
+    return true;
+}
+
+void AAudioOutput::close() {
+    if (stream_ != nullptr) {
+        stop();
+        AAudioStream_close(stream_);
+        stream_ = nullptr;
+        sampleRate_ = 0;
+        framesPerBurst_ = 0;
+        LOGI("AAudio输出流已关闭");
+    }
+}
+
+aaudio_data_callback_result_t AAudioOutput::onData(
+    AAudioStream* stream,
+    void* userData,
+    void* audioData,
+    int32_t numFrames) {
+
+    AAudioOutput* output = static_cast<AAudioOutput*>(userData);
+    output->renderCallback_(output->userData_, static_cast<float*>(audioData), numFrames);
+    return AAUDIO_CALLBACK_RESULT_CONTINUE;
+}
+
+void AAudioOutput::onError(
+    AAudioStream* stream,
+    void* userData,
+    aaudio_result_t error) {
+
+    AAudioOutput* output = static_cast<AAudioOutput*>(userData);
+    snprintf(output->lastError_, sizeof(output->lastError_),
+             "AAudio输出流错误回调: %s", AAudio_convertResultToText(error));
+    if (output->errorCallback_ != nullptr) {
+        output->errorCallback_(output->userData_, error == AAUDIO_ERROR_DISCONNECTED, output->lastError_);
+    }
+}
+
+} // namespace deepfilter
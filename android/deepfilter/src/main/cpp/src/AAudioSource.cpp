@@ -0,0 +1,182 @@
+#include "AAudioSource.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#define LOG_TAG "AAudioSource"
+#include "NativeLog.h"
+
+namespace deepfilter {
+
+AAudioSource::AAudioSource()
+    : stream_(nullptr)
+    , started_(false)
+    , sampleRate_(0)
+    , firstFramePosition_(-1)
+    , dataCallback_(nullptr)
+    , errorCallback_(nullptr)
+    , userData_(nullptr) {
+    memset(lastError_, 0, sizeof(lastError_));
+}
+
+AAudioSource::~AAudioSource() {
+    close();
+}
+
+bool AAudioSource::open(const AudioSourceConfig& config,
+                        DataCallback dataCallback,
+                        ErrorCallback errorCallback,
+                        void* userData) {
+    if (dataCallback == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "数据回调为空");
+        return false;
+    }
+
+    close();
+
+    dataCallback_ = dataCallback;
+    errorCallback_ = errorCallback;
+    userData_ = userData;
+
+    AAudioStreamBuilder* builder;
+    aaudio_result_t result = AAudio_createStreamBuilder(&builder);
+    if (result != AAUDIO_OK) {
+        snprintf(lastError_, sizeof(lastError_), "创建AAudio流构建器失败: %s",
+                 AAudio_convertResultToText(result));
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    AAudioStreamBuilder_setFormat(builder, AAUDIO_FORMAT_PCM_FLOAT);
+    if (config.sampleRate > 0) {
+        AAudioStreamBuilder_setSampleRate(builder, config.sampleRate);
+    }
+    AAudioStreamBuilder_setChannelCount(builder, config.channelCount);
+    AAudioStreamBuilder_setDirection(builder, AAUDIO_DIRECTION_INPUT);
+    AAudioStreamBuilder_setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
+    AAudioStreamBuilder_setSharingMode(builder, AAUDIO_SHARING_MODE_EXCLUSIVE);
+    if (config.framesPerCallback > 0) {
+        AAudioStreamBuilder_setFramesPerDataCallback(builder, config.framesPerCallback);
+    }
+    AAudioStreamBuilder_setDataCallback(builder, onData, this);
+    AAudioStreamBuilder_setErrorCallback(builder, onError, this);
+
+    result = AAudioStreamBuilder_openStream(builder, &stream_);
+    AAudioStreamBuilder_delete(builder);
+
+    if (result != AAUDIO_OK) {
+        snprintf(lastError_, sizeof(lastError_), "打开AAudio流失败: %s",
+                 AAudio_convertResultToText(result));
+        LOGE("%s", lastError_);
+        stream_ = nullptr;
+        return false;
+    }
+
+    // 回调按请求的声道数解释交织数据，设备给出的声道数不同时不能继续
+    const int32_t channelCount = AAudioStream_getChannelCount(stream_);
+    if (channelCount != config.channelCount) {
+        snprintf(lastError_, sizeof(lastError_), "设备不支持%d声道采集（实际%d声道）",
+                 config.channelCount, channelCount);
+        LOGE("%s", lastError_);
+        AAudioStream_close(stream_);
+        stream_ = nullptr;
+        return false;
+    }
+
+    sampleRate_ = AAudioStream_getSampleRate(stream_);
+    LOGI("AAudio流初始化成功: 采样率=%dHz, 声道数=%d, burst=%d帧, 回调=%d帧", sampleRate_, channelCount,
+         AAudioStream_getFramesPerBurst(stream_), AAudioStream_getFramesPerDataCallback(stream_));
+    return true;
+}
+
+bool AAudioSource::start() {
+    if (stream_ == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "AAudio流未打开");
+        return false;
+    }
+
+    firstFramePosition_.store(-1, std::memory_order_relaxed);
+    aaudio_result_t result = AAudioStream_requestStart(stream_);
+    if (result != AAUDIO_OK) {
+        snprintf(lastError_, sizeof(lastError_), "启动AAudio流失败: %s",
+                 AAudio_convertResultToText(result));
+        LOGE("%s", lastError_);
+        return false;
+    }
+    started_ = true;
+    return true;
+}
+
+bool AAudioSource::stop() {
+    if (stream_ == nullptr || !started_) {
+        return true;
+    }
+
+    started_ = false;
+    aaudio_result_t result = AAudioStream_requestStop(stream_);
+    if (result != AAUDIO_OK) {
+        snprintf(lastError_, sizeof(lastError_), "停止AAudio流失败: %s",
+                 AAudio_convertResultToText(result));
+        LOGE("%s", lastError_);
+        return false;
+    }
+    return true;
+}
+
+void AAudioSource::close() {
+    if (stream_ != nullptr) {
+        stop();
+        AAudioStream_close(stream_);
+        stream_ = nullptr;
+        sampleRate_ = 0;
+        LOGI("AAudio流已关闭");
+    }
+}
+
+aaudio_data_callback_result_t AAudioSource::onData(
+    AAudioStream* stream,
+    void* userData,
+    void* audioData,
+    int32_t numFrames) {
+
+    AAudioSource* source = static_cast<AAudioSource*>(userData);
+    if (source->firstFramePosition_.load(std::memory_order_relaxed) < 0) {
+        // 输入流先读出数据再回调，此时的已读帧数已包含本次回调的帧
+        source->firstFramePosition_.store(AAudioStream_getFramesRead(stream) - numFrames,
+                                          std::memory_order_release);
+    }
+    source->dataCallback_(source->userData_, static_cast<const float*>(audioData), numFrames);
+    return AAUDIO_CALLBACK_RESULT_CONTINUE;
+}
+
+bool AAudioSource::getTimestamp(int64_t* framePosition, int64_t* timeNs) const {
+    const int64_t firstFrame = firstFramePosition_.load(std::memory_order_acquire);
+    if (stream_ == nullptr || !started_ || firstFrame < 0) {
+        return false;
+    }
+
+    int64_t position = 0;
+    int64_t time = 0;
+    if (AAudioStream_getTimestamp(stream_, CLOCK_MONOTONIC, &position, &time) != AAUDIO_OK) {
+        // 流刚启动时可能暂无时间戳（AAUDIO_ERROR_INVALID_STATE），调用方稍后重试
+        return false;
+    }
+    *framePosition = position - firstFrame;
+    *timeNs = time;
+    return true;
+}
+
+void AAudioSource::onError(
+    AAudioStream* stream,
+    void* userData,
+    aaudio_result_t error) {
+
+    AAudioSource* source = static_cast<AAudioSource*>(userData);
+    snprintf(source->lastError_, sizeof(source->lastError_),
+             "AAudio错误回调: %s", AAudio_convertResultToText(error));
+    if (source->errorCallback_ != nullptr) {
+        source->errorCallback_(source->userData_, error == AAUDIO_ERROR_DISCONNECTED, source->lastError_);
+    }
+}
+
+} // namespace deepfilter
@@ -1,93 +1,382 @@
 #include "AudioProcessor.h"
-#include <android/log.h>
+#include "deepfilter_ort.h"
+#include <cerrno>
+#include <climits>
+#include <cmath>
 #include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <algorithm>
 #include <chrono>
 
+#ifdef __ANDROID__
+#include "AAudioOutput.h"
+#include "AAudioSource.h"
+#endif
+
 #define LOG_TAG "AudioProcessor"
-#define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
-#define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
+#include "NativeLog.h"
 
 namespace deepfilter {
 
-extern "C" {
-    /**
-     * 创建DeepFilterNet实例
-     * 
-     * @param tar_buf 模型文件字节数组指针（tar.gz格式）
-     * @param tar_size 模型文件字节数组大小
-     * @param post_filter_beta 后滤波器beta参数
-     * @param atten_lim_db 衰减限制（dB）
-     * @return DeepFilterNet状态指针（nullptr表示失败）
-     */
-    void* df_create(
-        const uint8_t* tar_buf,
-        size_t tar_size,
-        float post_filter_beta,
-        float atten_lim_db);
-
-    /**
-     * 销毁DeepFilterNet实例
-     * 
-     * @param state DeepFilterNet状态指针
-     */
-    void df_destroy(void* state);
-
-    /**
-     * 处理音频帧
-     * 
-     * @param state DeepFilterNet状态指针
-     * @param input 输入音频数据指针（f32格式）
-     * @param output 输出音频数据指针（f32格式）
-     * @param frame_size 帧大小（采样点数）
-     * @return LSNR值（负数表示失败）
-     */
-    float df_process_frame(
-        void* state,
-        const float* input,
-        float* output,
-        size_t frame_size);
-
-    /**
-     * 设置后滤波器beta参数
-     * 
-     * @param state DeepFilterNet状态指针
-     * @param beta beta参数值
-     */
-    void df_set_post_filter_beta(void* state, float beta);
-
-    /**
-     * 设置衰减限制
-     * 
-     * @param state DeepFilterNet状态指针
-     * @param lim_db 衰减限制（dB）
-     */
-    void df_set_atten_lim(void* state, float lim_db);
-
-    /**
-     * 获取帧大小
-     * 
-     * @param state DeepFilterNet状态指针
-     * @return 帧大小（采样点数）
-     */
-    size_t df_get_frame_size(void* state);
-}
-
 AudioProcessor::AudioProcessor()
     : dfState_(nullptr)
     , dfInitialized_(false)
     , frameSize_(512)
-    , aaudioStream_(nullptr)
-    , aaudioInitialized_(false)
+    , audioSourceOpened_(false)
+    , pushSource_(nullptr)
+    , pushedFrames_(0)
+    , backpressureEvents_(0)
+    , audioOutputOpened_(false)
+    , duplexActive_(false)
+    , monitorCallback_(nullptr)
+    , playoutBursts_(2)
+    , latencyProfile_(LatencyProfile::HIGH_QUALITY)
+    , inferenceBackend_(InferenceBackend::TRACT)
+    , parameterRampMs_(DEFAULT_PARAMETER_RAMP_MS)
     , processingThread_(nullptr)
     , processingThreadRunning_(false)
+    , cpuTopology_(ThreadScheduler::detectTopology())
+    , requestedCaptureRate_(0)
+    , captureSampleRate_(0)
+    , outputSampleRate_(SAMPLE_RATE)
+    , channelCount_(1)
+    , overflowPolicy_(OverflowPolicy::DROP_OLDEST)
+    , workFrame_(nullptr)
+    , outputFrame_(nullptr)
     , callback_(nullptr)
-    , isProcessing_(false) {
+    , directRing_(nullptr)
+    , directSlotCount_(0)
+    , directCallback_(nullptr)
+    , directWriteCount_(0)
+    , frameCallback_(nullptr)
+    , inputHops_(0)
+    , expectedPosition_(0)
+    , modelDelayFrames_(0)
+    , discontinuities_(0)
+    , anchorValid_(false)
+    , anchorPosition_(0)
+    , anchorTimeNs_(0)
+    , anchorCountdown_(0)
+    , syncRequested_(false)
+    , syncDeadlineRatio_(0.8f)
+    , syncMaxMisses_(3)
+    , syncActive_(false)
+    , syncFallback_(false)
+    , syncWindowMisses_(0)
+    , syncWindowHops_(0)
+    , syncFrames_(0)
+    , missedDeadlines_(0)
+    , isProcessing_(false)
+    , processedFrames_(0)
+    , failedFrames_(0)
+    , overBudgetFrames_(0)
+    , modelCacheHit_(false)
+    , modelPrecision_(ModelPrecision::FP32) {
     memset(lastError_, 0, sizeof(lastError_));
+    sem_init(&frameSemaphore_, 0, 0);
+    sem_init(&spaceSemaphore_, 0, 0);
+    // 默认不修改调度，只逐hop记录运行核心
+    threadScheduler_.init(ThreadSchedulingConfig(), cpuTopology_);
 }
 
 AudioProcessor::~AudioProcessor() {
     release();
+    sem_destroy(&frameSemaphore_);
+    sem_destroy(&spaceSemaphore_);
+}
+
+bool AudioProcessor::setAudioSource(std::unique_ptr<AudioSource> source) {
+    if (isProcessing_) {
+        snprintf(lastError_, sizeof(lastError_), "处理中不能更换音频源");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    closeAudioSource();
+    pushSource_ = nullptr;
+    audioSource_ = std::move(source);
+    return true;
+}
+
+bool AudioProcessor::setPushMode(bool enabled) {
+    if (enabled == isPushMode()) {
+        return true;
+    }
+
+    if (!enabled) {
+        return setAudioSource(nullptr);
+    }
+
+    PushAudioSource* source = new PushAudioSource();
+    if (!setAudioSource(std::unique_ptr<AudioSource>(source))) {
+        return false;
+    }
+    pushSource_ = source;
+    LOGI("推送模式: 数据由调用方推送，不打开采集设备");
+    return true;
+}
+
+int32_t AudioProcessor::pushFloat(const float* samples, int32_t numFrames, int32_t timeoutMs) {
+    if (pushSource_ == nullptr || !isProcessing_ || samples == nullptr || numFrames < 0 || timeoutMs < 0) {
+        return -1;
+    }
+
+    const int32_t accepted = pushFrames(samples, numFrames, pushDeadlineFor(timeoutMs));
+    if (accepted < numFrames) {
+        backpressureEvents_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return accepted;
+}
+
+int32_t AudioProcessor::pushPcm16(const int16_t* samples, int32_t numFrames, int32_t timeoutMs) {
+    if (pushSource_ == nullptr || !isProcessing_ || samples == nullptr || numFrames < 0 || timeoutMs < 0) {
+        return -1;
+    }
+
+    // 按块转换到start时分配的缓冲区，截止时刻对整次调用有效
+    const int64_t deadlineNs = pushDeadlineFor(timeoutMs);
+    const size_t channels = static_cast<size_t>(channelCount_);
+    float* converted = pushConvertBuffer_.data();
+    int32_t accepted = 0;
+    while (accepted < numFrames) {
+        const int32_t count = std::min(numFrames - accepted, static_cast<int32_t>(PUSH_CONVERT_FRAMES));
+        df_pcm16_to_f32(samples + static_cast<size_t>(accepted) * channels, converted,
+                        static_cast<size_t>(count) * channels);
+        const int32_t pushed = pushFrames(converted, count, deadlineNs);
+        accepted += pushed;
+        if (pushed < count) {
+            break;
+        }
+    }
+    if (accepted < numFrames) {
+        backpressureEvents_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return accepted;
+}
+
+int32_t AudioProcessor::getPushableFrames() const {
+    if (pushSource_ == nullptr || !isProcessing_) {
+        return 0;
+    }
+
+    // 队列空闲槽折算为采样点，减去分块暂存区中的不完整hop；只有推送线程入队，size()只会偏大，估计偏保守
+    const size_t capacity = audioRing_.capacity();
+    const size_t freeHops = capacity - std::min(audioRing_.size(), capacity);
+    const size_t room = freeHops * inputReblocker_.hopSize();
+    const size_t pending = inputReblocker_.pending();
+    if (room <= pending) {
+        return 0;
+    }
+
+    size_t frames = (room - pending) / static_cast<size_t>(channelCount_);
+    if (!inputResampler_.isPassthrough()) {
+        // 折算到推送采样率，预留一帧：转换输出的帧数可能比按比例计算的多一帧
+        if (frames <= 1) {
+            return 0;
+        }
+        frames = (frames - 1) * static_cast<size_t>(captureSampleRate_) / SAMPLE_RATE;
+    }
+    return static_cast<int32_t>(std::min(frames, static_cast<size_t>(INT32_MAX)));
+}
+
+int32_t AudioProcessor::pushFrames(const float* samples, int32_t numFrames, int64_t deadlineNs) {
+    const size_t channels = static_cast<size_t>(channelCount_);
+    int32_t accepted = 0;
+    while (accepted < numFrames) {
+        const int32_t count = std::min(getPushableFrames(), numFrames - accepted);
+        if (count > 0) {
+            // 在本线程上完成重采样和分块入队（与采集回调相同的路径）
+            if (!pushSource_->push(samples + static_cast<size_t>(accepted) * channels, count)) {
+                break;
+            }
+            accepted += count;
+        } else if (!pushSource_->isRunning() || !waitForPushSpace(deadlineNs)) {
+            break;
+        }
+    }
+    pushedFrames_.fetch_add(static_cast<uint64_t>(accepted), std::memory_order_relaxed);
+    return accepted;
+}
+
+bool AudioProcessor::waitForPushSpace(int64_t deadlineNs) {
+    const int64_t remainingNs = deadlineNs - nowNs();
+    if (deadlineNs == 0 || remainingNs <= 0) {
+        return false;
+    }
+
+    // sem_timedwait使用CLOCK_REALTIME绝对时间；截止时刻仍按单调时钟判断，系统时间跳变只影响单次等待
+    struct timespec wake;
+    clock_gettime(CLOCK_REALTIME, &wake);
+    const int64_t wakeNs = static_cast<int64_t>(wake.tv_nsec) + remainingNs;
+    wake.tv_sec += static_cast<time_t>(wakeNs / 1000000000);
+    wake.tv_nsec = static_cast<long>(wakeNs % 1000000000);
+    while (sem_timedwait(&spaceSemaphore_, &wake) != 0 && errno == EINTR) {
+    }
+    return true;
+}
+
+int64_t AudioProcessor::pushDeadlineFor(int32_t timeoutMs) {
+    return timeoutMs > 0 ? nowNs() + static_cast<int64_t>(timeoutMs) * 1000000 : 0;
+}
+
+bool AudioProcessor::setAudioOutput(std::unique_ptr<AudioOutput> output) {
+    if (isProcessing_) {
+        snprintf(lastError_, sizeof(lastError_), "处理中不能更换输出流");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    closeAudioOutput();
+    audioOutput_ = std::move(output);
+    return true;
+}
+
+bool AudioProcessor::setCaptureSampleRate(int32_t sampleRate) {
+    if (isProcessing_ || sampleRate < 0) {
+        snprintf(lastError_, sizeof(lastError_), "采集采样率设置无效: %d", sampleRate);
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    requestedCaptureRate_ = sampleRate;
+    return true;
+}
+
+bool AudioProcessor::setOutputSampleRate(int32_t sampleRate) {
+    if (isProcessing_ || sampleRate < 0) {
+        snprintf(lastError_, sizeof(lastError_), "输出采样率设置无效: %d", sampleRate);
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    outputSampleRate_ = sampleRate > 0 ? sampleRate : SAMPLE_RATE;
+    return true;
+}
+
+bool AudioProcessor::setChannelCount(int32_t channelCount) {
+    if (isProcessing_ || channelCount < 1 || channelCount > MAX_CHANNEL_COUNT) {
+        snprintf(lastError_, sizeof(lastError_), "声道数设置无效: %d", channelCount);
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    channelCount_ = channelCount;
+    return true;
+}
+
+bool AudioProcessor::setComputeGate(const ComputeGateConfig& config) {
+    // 用临时门控校验参数，真正的缓冲区在start时按帧大小分配
+    ComputeGate validator;
+    if (isProcessing_ || !validator.init(config, 1, 1)) {
+        snprintf(lastError_, sizeof(lastError_), "计算门控设置无效");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    gateConfig_ = config;
+    LOGI("计算门控: %s, 静音阈值=%.1fdBFS, 干净语音旁路=%s(LSNR>=%.1fdB)",
+         config.enabled ? "启用" : "关闭", config.silenceDbfs,
+         config.bypassClean ? "是" : "否", config.cleanLsnrDb);
+    return true;
+}
+
+ComputeGateStats AudioProcessor::getComputeGateStats() const {
+    return computeGate_.getStats();
+}
+
+bool AudioProcessor::setThreadScheduling(const ThreadSchedulingConfig& config) {
+    if (isProcessing_) {
+        snprintf(lastError_, sizeof(lastError_), "处理中不能修改线程调度");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    if (!threadScheduler_.init(config, cpuTopology_)) {
+        snprintf(lastError_, sizeof(lastError_), "线程调度设置无效");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    LOGI("线程调度: 核心数=%d, 性能核心=0x%llx",
+         cpuTopology_.cpuCount, static_cast<unsigned long long>(cpuTopology_.performanceMask));
+    return true;
+}
+
+ThreadSchedulingStats AudioProcessor::getThreadSchedulingStats() const {
+    return threadScheduler_.getStats();
+}
+
+bool AudioProcessor::setSynchronousMode(bool enabled, float deadlineRatio, int32_t maxMissedDeadlines) {
+    if (isProcessing_ || !(deadlineRatio > 0.0f && deadlineRatio <= 1.0f) || maxMissedDeadlines < 1) {
+        snprintf(lastError_, sizeof(lastError_), "同步模式设置无效");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    syncRequested_ = enabled;
+    syncDeadlineRatio_ = deadlineRatio;
+    syncMaxMisses_ = maxMissedDeadlines;
+    LOGI("同步模式: %s, 截止比例=%.2f, 回退阈值=%d次/%d hop",
+         enabled ? "启用" : "关闭", deadlineRatio, maxMissedDeadlines, SYNC_MISS_WINDOW_HOPS);
+    return true;
+}
+
+bool AudioProcessor::setLatencyProfile(LatencyProfile profile) {
+    if (isProcessing_) {
+        snprintf(lastError_, sizeof(lastError_), "处理中不能修改延迟档位");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    const bool lowLatency = profile == LatencyProfile::LOW_LATENCY;
+    if (!setSynchronousMode(lowLatency, syncDeadlineRatio_, syncMaxMisses_)) {
+        return false;
+    }
+    playoutBursts_ = lowLatency ? 1 : 2;
+    latencyProfile_ = profile;
+    LOGI("延迟档位: %s", lowLatency ? "低延迟" : "高质量");
+    return true;
+}
+
+bool AudioProcessor::setInferenceBackend(InferenceBackend backend) {
+    if (isProcessing_ || df_backend_available(static_cast<int32_t>(backend)) == 0) {
+        snprintf(lastError_, sizeof(lastError_), "推理后端不可用: %d", static_cast<int32_t>(backend));
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    inferenceBackend_ = backend;
+    return true;
+}
+
+PipelineDelay AudioProcessor::getPipelineDelay() const {
+    PipelineDelay delay;
+    if (!dfInitialized_ || dfState_ == nullptr) {
+        return delay;
+    }
+
+    // 模型侧延迟按模型采样率给出，统一换算到输出采样率
+    auto toOutputFrames = [this](int64_t modelFrames) {
+        return (modelFrames * outputSampleRate_ + SAMPLE_RATE / 2) / SAMPLE_RATE;
+    };
+    const int64_t hopFrames = static_cast<int64_t>(frameSize_);
+
+    delay.sampleRate = outputSampleRate_;
+    delay.lookaheadHops = static_cast<int32_t>(df_get_lookahead(dfState_));
+    delay.algorithmicFrames = toOutputFrames(static_cast<int64_t>(df_get_algorithmic_delay(dfState_)));
+    delay.blockingFrames = toOutputFrames(hopFrames);
+    if (!isSynchronousActive()) {
+        delay.queueFrames = toOutputFrames(static_cast<int64_t>(audioRing_.size()) * hopFrames);
+    }
+    delay.resamplerFrames = (inputResampler_.getLatencyUs() + outputResampler_.getLatencyUs()) *
+                            outputSampleRate_ / 1000000;
+    if (duplexActive_) {
+        delay.playoutFrames = static_cast<int64_t>(playoutBuffer_.getStats().targetFrames);
+    }
+    delay.totalFrames = delay.algorithmicFrames + delay.blockingFrames + delay.queueFrames +
+                        delay.resamplerFrames + delay.playoutFrames;
+    return delay;
 }
 
 bool AudioProcessor::initialize(
@@ -102,13 +391,47 @@ bool AudioProcessor::initialize(
         return false;
     }
 
+    const uint8_t* variant = modelVariant_.empty() ? nullptr : modelVariant_.data();
+    void* model = modelCache_.loadModel(tarBytes, tarBytesSize, modelPrecision_, variant, modelVariant_.size(),
+                                        &modelCacheHit_);
+    if (model == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "%s", modelCache_.getLastError());
+        LOGE("%s", lastError_);
+        return false;
+    }
+    if (modelPrecision_ != ModelPrecision::FP32 || variant != nullptr) {
+        LOGI("模型精度: %s%s", ModelCache::precisionName(modelPrecision_), variant != nullptr ? "（变体包）" : "");
+    }
+    if (!modelCache_.getDirectory().empty()) {
+        LOGI("模型缓存%s: %s", modelCacheHit_ ? "命中" : "未命中",
+             modelCache_.getCachePath(tarBytes, tarBytesSize, modelPrecision_, variant, modelVariant_.size()).c_str());
+    }
+
+    bool success = initializeFromModel(model, postFilterBeta, attenLimDb);
+    df_model_free(model);
+    return success;
+}
+
+bool AudioProcessor::initializeFromModel(
+    const void* model,
+    float postFilterBeta,
+    float attenLimDb) {
+
+    if (model == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "模型句柄为空");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
     if (dfState_ != nullptr) {
         release();
     }
 
-    LOGI("初始化音频处理器: postFilterBeta=%.2f, attenLimDb=%.2f", postFilterBeta, attenLimDb);
+    LOGI("初始化音频处理器: postFilterBeta=%.2f, attenLimDb=%.2f, 声道数=%d, 推理后端=%d",
+         postFilterBeta, attenLimDb, channelCount_, static_cast<int32_t>(inferenceBackend_));
 
-    dfState_ = df_create(tarBytes, tarBytesSize, postFilterBeta, attenLimDb);
+    dfState_ = df_create_from_model_backend(model, static_cast<size_t>(channelCount_), postFilterBeta, attenLimDb,
+                                            static_cast<int32_t>(inferenceBackend_));
     
     if (dfState_ == nullptr) {
         snprintf(lastError_, sizeof(lastError_), "创建DeepFilterNet实例失败");
@@ -117,79 +440,175 @@ bool AudioProcessor::initialize(
     }
 
     frameSize_ = df_get_frame_size(dfState_);
+    parameterMailbox_.init(postFilterBeta, attenLimDb, rampHopsFor(parameterRampMs_.load(std::memory_order_relaxed)));
     dfInitialized_ = true;
 
     LOGI("DeepFilterNet初始化成功: 帧大小=%zu", frameSize_);
 
-    if (!initAAudioStream()) {
-        snprintf(lastError_, sizeof(lastError_), "初始化AAudio流失败");
+    // 按帧大小一次性分配帧池，环形缓冲区和处理线程缓冲区均从帧池借出，运行期间不再分配内存
+    // 多声道时每个槽容纳一个交织的hop（帧大小 × 声道数）
+    const size_t hopSamples = frameSize_ * static_cast<size_t>(channelCount_);
+    if (!framePool_.init(hopSamples, MAX_QUEUE_SIZE + WORK_FRAME_COUNT)) {
+        snprintf(lastError_, sizeof(lastError_), "分配音频帧池失败");
+        LOGE("%s", lastError_);
+        release();
+        return false;
+    }
+
+    workFrame_ = framePool_.acquireFrame();
+    outputFrame_ = framePool_.acquireFrame();
+    if (workFrame_ == nullptr || outputFrame_ == nullptr ||
+        !audioRing_.init(framePool_, MAX_QUEUE_SIZE, overflowPolicy_) ||
+        !inputReblocker_.init(hopSamples)) {
+        snprintf(lastError_, sizeof(lastError_), "分配音频环形缓冲区失败");
         LOGE("%s", lastError_);
         release();
         return false;
     }
 
-    LOGI("音频处理器初始化成功: 采样率=%d, 声道数=%d, 帧大小=%zu",
-         SAMPLE_RATE, CHANNEL_COUNT, frameSize_);
+    if (!openAudioSource() || !initResamplers()) {
+        release();
+        return false;
+    }
+
+    LOGI("音频处理器初始化成功: 采集采样率=%d, 模型采样率=%d, 输出采样率=%d, 声道数=%d, 帧大小=%zu",
+         captureSampleRate_, SAMPLE_RATE, outputSampleRate_, channelCount_, frameSize_);
     
     return true;
 }
 
-bool AudioProcessor::initAAudioStream() {
-    AAudioStreamBuilder* builder;
+bool AudioProcessor::openAudioSource() {
+    if (audioSource_ == nullptr) {
+#ifdef __ANDROID__
+        audioSource_.reset(new AAudioSource());
+#else
+        snprintf(lastError_, sizeof(lastError_), "未设置音频源");
+        LOGE("%s", lastError_);
+        return false;
+#endif
+    }
+
+    AudioSourceConfig config;
+    config.sampleRate = requestedCaptureRate_;     // 0表示设备原生采样率
+    if (channelCount_ > 1 && config.sampleRate == 0) {
+        config.sampleRate = SAMPLE_RATE;           // 多声道不做采样率转换，由系统直接提供48kHz
+    }
+    config.channelCount = channelCount_;
+    config.framesPerCallback = 0;   // 使用设备最佳burst大小，由采集回调重新分块为hop
+
+    if (!audioSource_->open(config, dataCallback, errorCallback, this)) {
+        snprintf(lastError_, sizeof(lastError_), "打开音频源失败: %s", audioSource_->getLastError());
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    audioSourceOpened_ = true;
+    captureSampleRate_ = audioSource_->getSampleRate();
+    return true;
+}
+
+bool AudioProcessor::openAudioOutput() {
+    if (audioOutputOpened_) {
+        return true;
+    }
 
-    aaudio_result_t result = AAudio_createStreamBuilder(&builder);
-    if (result != AAUDIO_OK) {
-        snprintf(lastError_, sizeof(lastError_), "创建AAudio流构建器失败: %s", 
-                 AAudio_convertResultToText(result));
+    if (audioOutput_ == nullptr) {
+#ifdef __ANDROID__
+        audioOutput_.reset(new AAudioOutput());
+#else
+        snprintf(lastError_, sizeof(lastError_), "未设置输出流");
         LOGE("%s", lastError_);
         return false;
+#endif
     }
 
-    AAudioStreamBuilder_setFormat(builder, AAUDIO_FORMAT_PCM_FLOAT);
-    AAudioStreamBuilder_setSampleRate(builder, SAMPLE_RATE);
-    AAudioStreamBuilder_setChannelCount(builder, CHANNEL_COUNT);
-    AAudioStreamBuilder_setDirection(builder, AAUDIO_DIRECTION_INPUT);
-    AAudioStreamBuilder_setPerformanceMode(builder, AAUDIO_PERFORMANCE_MODE_LOW_LATENCY);
-    AAudioStreamBuilder_setSharingMode(builder, AAUDIO_SHARING_MODE_EXCLUSIVE);
-    AAudioStreamBuilder_setFramesPerDataCallback(builder, static_cast<int32_t>(frameSize_));
-    AAudioStreamBuilder_setDataCallback(builder, dataCallback, this);
-    AAudioStreamBuilder_setErrorCallback(builder, errorCallback, this);
+    // 输出流按输出采样率打开，播放缓冲区中的数据不再做采样率转换
+    AudioSourceConfig config;
+    config.sampleRate = outputSampleRate_;
+    config.channelCount = channelCount_;
+    config.framesPerCallback = 0;   // 使用设备最佳burst大小
 
-    result = AAudioStreamBuilder_openStream(builder, &aaudioStream_);
-    AAudioStreamBuilder_delete(builder);
+    if (!audioOutput_->open(config, renderCallback, errorCallback, this)) {
+        snprintf(lastError_, sizeof(lastError_), "打开输出流失败: %s", audioOutput_->getLastError());
+        LOGE("%s", lastError_);
+        return false;
+    }
 
-    if (result != AAUDIO_OK) {
-        snprintf(lastError_, sizeof(lastError_), "打开AAudio流失败: %s", 
-                 AAudio_convertResultToText(result));
+    if (audioOutput_->getSampleRate() != outputSampleRate_) {
+        snprintf(lastError_, sizeof(lastError_), "输出流采样率%dHz与输出采样率%dHz不一致",
+                 audioOutput_->getSampleRate(), outputSampleRate_);
         LOGE("%s", lastError_);
-        aaudioStream_ = nullptr;
+        audioOutput_->close();
         return false;
     }
 
-    aaudioInitialized_ = true;
-    LOGI("AAudio流初始化成功");
+    audioOutputOpened_ = true;
     return true;
 }
 
-void AudioProcessor::closeAAudioStream() {
-    if (aaudioStream_ != nullptr) {
-        if (isProcessing_) {
-            AAudioStream_requestStop(aaudioStream_);
-        }
-        AAudioStream_close(aaudioStream_);
-        aaudioStream_ = nullptr;
-        aaudioInitialized_ = false;
-        LOGI("AAudio流已关闭");
+void AudioProcessor::closeAudioOutput() {
+    if (audioOutput_ != nullptr && audioOutputOpened_) {
+        audioOutput_->close();
+        audioOutputOpened_ = false;
+        LOGI("输出流已关闭");
+    }
+}
+
+bool AudioProcessor::initResamplers() {
+    // 重采样器只处理单声道数据
+    if (channelCount_ > 1 && (captureSampleRate_ != SAMPLE_RATE || outputSampleRate_ != SAMPLE_RATE)) {
+        snprintf(lastError_, sizeof(lastError_), "多声道模式不支持采样率转换: 采集%dHz，输出%dHz",
+                 captureSampleRate_, outputSampleRate_);
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    if (!inputResampler_.init(captureSampleRate_, SAMPLE_RATE, RESAMPLE_BLOCK_FRAMES) ||
+        !outputResampler_.init(SAMPLE_RATE, outputSampleRate_, frameSize_)) {
+        snprintf(lastError_, sizeof(lastError_), "不支持的采样率转换: 采集%dHz，输出%dHz",
+                 captureSampleRate_, outputSampleRate_);
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    // 转换缓冲区在此一次性分配，采集回调和处理线程中不再分配
+    inputResampleBuffer_.assign(inputResampler_.isPassthrough() ? 0 : inputResampler_.getMaxOutputFrames(), 0.0f);
+    outputResampleBuffer_.assign(outputResampler_.isPassthrough() ? 0 : outputResampler_.getMaxOutputFrames(), 0.0f);
+
+    if (!inputResampler_.isPassthrough() || !outputResampler_.isPassthrough()) {
+        LOGI("采样率转换: %dHz -> %dHz -> %dHz, 附加延迟=%lldus (%s)",
+             captureSampleRate_, SAMPLE_RATE, outputSampleRate_,
+             static_cast<long long>(inputResampler_.getLatencyUs() + outputResampler_.getLatencyUs()),
+             Resampler::simdName());
+    }
+    return true;
+}
+
+void AudioProcessor::closeAudioSource() {
+    if (audioSource_ != nullptr && audioSourceOpened_) {
+        audioSource_->close();
+        audioSourceOpened_ = false;
+        captureSampleRate_ = 0;
+        LOGI("音频源已关闭");
     }
 }
 
 bool AudioProcessor::start(AudioCallback callback) {
-    if (!dfInitialized_ || !aaudioInitialized_) {
+    if (!dfInitialized_ || !audioSourceOpened_) {
         snprintf(lastError_, sizeof(lastError_), "音频处理器未初始化");
         LOGE("%s", lastError_);
         return false;
     }
 
+    // 等待设备断开时的停止线程结束
+    joinDeferredStop();
+
+    if (isProcessing_) {
+        snprintf(lastError_, sizeof(lastError_), "音频处理器已在运行");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
     if (callback == nullptr) {
         snprintf(lastError_, sizeof(lastError_), "回调函数为空");
         LOGE("%s", lastError_);
@@ -197,40 +616,274 @@ bool AudioProcessor::start(AudioCallback callback) {
     }
 
     callback_ = callback;
+    frameCallback_ = nullptr;
+    monitorCallback_ = nullptr;
+    directRing_ = nullptr;
+    directSlotCount_ = 0;
+    directCallback_ = nullptr;
+
+    return startInternal();
+}
+
+bool AudioProcessor::start(AudioSink* sink) {
+    if (sink == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "输出为空");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    return start([sink](const float* audioData, int32_t numFrames, float lsnr) {
+        sink->write(audioData, numFrames, lsnr);
+    });
+}
+
+bool AudioProcessor::startWithFrameInfo(FrameCallback callback) {
+    if (!dfInitialized_ || !audioSourceOpened_) {
+        snprintf(lastError_, sizeof(lastError_), "音频处理器未初始化");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    // 等待设备断开时的停止线程结束
+    joinDeferredStop();
+
+    if (isProcessing_) {
+        snprintf(lastError_, sizeof(lastError_), "音频处理器已在运行");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    if (callback == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "回调函数为空");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    callback_ = nullptr;
+    frameCallback_ = callback;
+    monitorCallback_ = nullptr;
+    directRing_ = nullptr;
+    directSlotCount_ = 0;
+    directCallback_ = nullptr;
+
+    return startInternal();
+}
+
+bool AudioProcessor::startDirect(float* outputRing, size_t slotCount, DirectCallback callback) {
+    if (!dfInitialized_ || !audioSourceOpened_) {
+        snprintf(lastError_, sizeof(lastError_), "音频处理器未初始化");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    // 等待设备断开时的停止线程结束
+    joinDeferredStop();
+
+    if (isProcessing_) {
+        snprintf(lastError_, sizeof(lastError_), "音频处理器已在运行");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    if (outputRing == nullptr || slotCount == 0) {
+        snprintf(lastError_, sizeof(lastError_), "直接输出缓冲区无效");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    if (!outputResampler_.isPassthrough()) {
+        snprintf(lastError_, sizeof(lastError_), "直接输出模式不支持输出采样率转换");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    callback_ = nullptr;
+    frameCallback_ = nullptr;
+    monitorCallback_ = nullptr;
+    directRing_ = outputRing;
+    directSlotCount_ = slotCount;
+    directCallback_ = callback;
+
+    LOGI("直接输出模式: 槽数量=%zu, 每槽帧数=%zu, 声道数=%d", slotCount, frameSize_, channelCount_);
+    return startInternal();
+}
+
+bool AudioProcessor::startDuplex(AudioCallback monitor) {
+    if (!dfInitialized_ || !audioSourceOpened_) {
+        snprintf(lastError_, sizeof(lastError_), "音频处理器未初始化");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    // 等待设备断开时的停止线程结束
+    joinDeferredStop();
+
+    if (isProcessing_) {
+        snprintf(lastError_, sizeof(lastError_), "音频处理器已在运行");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    if (!openAudioOutput()) {
+        return false;
+    }
+
+    // 目标深度：一个hop（按hop写入造成的锯齿）+ 输出burst（渲染间隔和处理耗时抖动，低延迟档位为一个，否则两个）
+    const size_t hopFrames = (frameSize_ * static_cast<size_t>(outputSampleRate_) + SAMPLE_RATE - 1) / SAMPLE_RATE;
+    int32_t burst = audioOutput_->getFramesPerBurst();
+    if (burst <= 0) {
+        burst = outputSampleRate_ / 250;
+    }
+    const size_t targetFrames = hopFrames + static_cast<size_t>(playoutBursts_) * static_cast<size_t>(burst);
+    if (!playoutBuffer_.init(outputSampleRate_, channelCount_, targetFrames,
+                             targetFrames * PLAYOUT_CAPACITY_FACTOR)) {
+        snprintf(lastError_, sizeof(lastError_), "分配播放缓冲区失败");
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    // 降噪结果写入播放缓冲区（单生产者：处理线程，同步模式下为采集回调线程）
+    monitorCallback_ = monitor;
+    frameCallback_ = nullptr;
+    callback_ = [this](const float* audioData, int32_t numFrames, float lsnr) {
+        playoutBuffer_.write(audioData, static_cast<size_t>(numFrames));
+        if (monitorCallback_ != nullptr) {
+            monitorCallback_(audioData, numFrames, lsnr);
+        }
+    };
+    directRing_ = nullptr;
+    directSlotCount_ = 0;
+    directCallback_ = nullptr;
+
+    // 先启动输出流（预缓冲期间播放静音），再启动采集
+    if (!audioOutput_->start()) {
+        snprintf(lastError_, sizeof(lastError_), "启动输出流失败: %s", audioOutput_->getLastError());
+        LOGE("%s", lastError_);
+        return false;
+    }
+    duplexActive_ = true;
+
+    if (!startInternal()) {
+        audioOutput_->stop();
+        duplexActive_ = false;
+        callback_ = nullptr;
+        monitorCallback_ = nullptr;
+        return false;
+    }
+
+    LOGI("双工模式: 输出采样率=%dHz, burst=%d帧, 播放缓冲目标=%zu帧(%.1fms)",
+         outputSampleRate_, burst, targetFrames, targetFrames * 1000.0 / outputSampleRate_);
+    return true;
+}
+
+PlayoutBufferStats AudioProcessor::getPlayoutStats() const {
+    return playoutBuffer_.getStats();
+}
+
+bool AudioProcessor::startInternal() {
+    if (gateConfig_.enabled &&
+        !computeGate_.init(gateConfig_, frameSize_, channelCount_, df_get_algorithmic_delay(dfState_))) {
+        snprintf(lastError_, sizeof(lastError_), "初始化计算门控失败");
+        LOGE("%s", lastError_);
+        return false;
+    }
 
-    // 启动异步处理线程
+    // 清空上一次运行残留的数据和计数
+    audioRing_.reset();
+    inputReblocker_.reset();
+    computeGate_.reset();
+    threadScheduler_.reset();
+    inputResampler_.reset();
+    outputResampler_.reset();
+    directWriteCount_.store(0, std::memory_order_relaxed);
+    queueLatency_.reset();
+    processLatency_.reset();
+    callbackLatency_.reset();
+    endToEndLatency_.reset();
+    processedFrames_.store(0, std::memory_order_relaxed);
+    failedFrames_.store(0, std::memory_order_relaxed);
+    overBudgetFrames_.store(0, std::memory_order_relaxed);
+    syncFrames_.store(0, std::memory_order_relaxed);
+    missedDeadlines_.store(0, std::memory_order_relaxed);
+    syncFallback_.store(false, std::memory_order_relaxed);
+    syncWindowMisses_ = 0;
+    syncWindowHops_ = 0;
+    syncActive_.store(syncRequested_, std::memory_order_relaxed);
+    pushedFrames_.store(0, std::memory_order_relaxed);
+    backpressureEvents_.store(0, std::memory_order_relaxed);
+    discontinuities_.store(0, std::memory_order_relaxed);
+    inputHops_ = 0;
+    expectedPosition_ = 0;
+    anchorValid_ = false;
+    anchorCountdown_ = 0;
+    // 输出块对应的输入位置：模型算法延迟 + 输入、输出重采样的群延迟（按模型采样率）
+    modelDelayFrames_ = static_cast<int64_t>(df_get_algorithmic_delay(dfState_)) +
+                        (inputResampler_.getLatencyUs() + outputResampler_.getLatencyUs()) * SAMPLE_RATE / 1000000;
+    while (sem_trywait(&frameSemaphore_) == 0) {
+    }
+    while (sem_trywait(&spaceSemaphore_) == 0) {
+    }
+    if (pushSource_ != nullptr) {
+        pushConvertBuffer_.resize(PUSH_CONVERT_FRAMES * static_cast<size_t>(channelCount_));
+    }
+
+    // 启动异步处理线程（同步模式下同样启动，超时回退时接管）
     processingThreadRunning_ = true;
     processingThread_ = new std::thread(&AudioProcessor::processingThreadFunc, this);
 
-    aaudio_result_t result = AAudioStream_requestStart(aaudioStream_);
-    if (result != AAUDIO_OK) {
-        snprintf(lastError_, sizeof(lastError_), "启动AAudio流失败: %s", 
-                 AAudio_convertResultToText(result));
+    if (!audioSource_->start()) {
+        snprintf(lastError_, sizeof(lastError_), "启动音频源失败: %s", audioSource_->getLastError());
         LOGE("%s", lastError_);
         stopProcessingThread();
         return false;
     }
 
     isProcessing_ = true;
-    LOGI("音频录制和降噪处理已启动（异步模式）");
+    LOGI("音频录制和降噪处理已启动（%s%s）", syncRequested_ ? "同步模式" : "异步模式",
+         directRing_ != nullptr ? "，直接输出" : (duplexActive_ ? "，双工" : ""));
+
+    const PipelineDelay delay = getPipelineDelay();
+    LOGI("管线延迟: 算法=%lld帧, 分块=%lld帧, 重采样=%lld帧, 播放缓冲=%lld帧, 合计%.1fms（不含排队和推理）",
+         static_cast<long long>(delay.algorithmicFrames), static_cast<long long>(delay.blockingFrames),
+         static_cast<long long>(delay.resamplerFrames), static_cast<long long>(delay.playoutFrames),
+         delay.totalFrames * 1000.0 / outputSampleRate_);
+    if (latencyProfile_ == LatencyProfile::LOW_LATENCY && delay.lookaheadHops > 0) {
+        LOGW("低延迟档位下模型仍有%d个hop的前瞻（%.1fms），需要零前瞻模型（如DeepFilterNet3_ll）才能去掉",
+             delay.lookaheadHops, delay.lookaheadHops * frameSize_ * 1000.0 / SAMPLE_RATE);
+    }
     return true;
 }
 
 bool AudioProcessor::stop() {
+    std::lock_guard<std::mutex> lock(stopMutex_);
     if (!isProcessing_) {
         return true;
     }
 
-    if (aaudioStream_ != nullptr) {
-        aaudio_result_t result = AAudioStream_requestStop(aaudioStream_);
-        if (result != AAUDIO_OK) {
-            snprintf(lastError_, sizeof(lastError_), "停止AAudio流失败: %s", 
-                     AAudio_convertResultToText(result));
-            LOGE("%s", lastError_);
-        }
+    if (audioSource_ != nullptr && !audioSource_->stop()) {
+        snprintf(lastError_, sizeof(lastError_), "停止音频源失败: %s", audioSource_->getLastError());
+        LOGE("%s", lastError_);
     }
+    // 唤醒等待队列空间的推送线程（音频源已停止，推送随即返回）
+    sem_post(&spaceSemaphore_);
 
     stopProcessingThread();
+    if (duplexActive_) {
+        if (!audioOutput_->stop()) {
+            snprintf(lastError_, sizeof(lastError_), "停止输出流失败: %s", audioOutput_->getLastError());
+            LOGE("%s", lastError_);
+        }
+        duplexActive_ = false;
+        const PlayoutBufferStats playout = playoutBuffer_.getStats();
+        LOGI("双工模式已停止: 欠载=%llu次, 溢出=%llu帧, 漂移修正=%dppm",
+             static_cast<unsigned long long>(playout.underruns),
+             static_cast<unsigned long long>(playout.overflowFrames), playout.correctionPpm);
+    }
+    syncActive_.store(false, std::memory_order_relaxed);
+    if (syncFallback_.load(std::memory_order_relaxed)) {
+        LOGW("同步模式曾因采集回调超时回退到异步处理，超时 %llu 次",
+             static_cast<unsigned long long>(missedDeadlines_.load(std::memory_order_relaxed)));
+    }
 
     isProcessing_ = false;
     LOGI("音频录制和降噪处理已停止");
@@ -240,7 +893,7 @@ bool AudioProcessor::stop() {
 void AudioProcessor::stopProcessingThread() {
     if (processingThread_ != nullptr) {
         processingThreadRunning_ = false;
-        queueCondition_.notify_all();
+        sem_post(&frameSemaphore_);
         
         if (processingThread_->joinable()) {
             processingThread_->join();
@@ -249,15 +902,8 @@ void AudioProcessor::stopProcessingThread() {
         delete processingThread_;
         processingThread_ = nullptr;
         
-        // 清空队列
-        std::lock_guard<std::mutex> lock(queueMutex_);
-        while (!audioQueue_.empty()) {
-            AudioFrame* frame = audioQueue_.front();
-            audioQueue_.pop();
-            freeAudioFrame(frame);
-        }
-        
-        LOGI("处理线程已停止，队列已清空");
+        LOGI("处理线程已停止，累计丢弃帧数: %llu",
+             static_cast<unsigned long long>(audioRing_.getDroppedCount()));
     }
 }
 
@@ -266,8 +912,10 @@ bool AudioProcessor::isProcessing() const {
 }
 
 void AudioProcessor::release() {
+    joinDeferredStop();
     stop();
-    closeAAudioStream();
+    closeAudioSource();
+    closeAudioOutput();
 
     if (dfState_ != nullptr) {
         df_destroy(dfState_);
@@ -277,10 +925,23 @@ void AudioProcessor::release() {
     }
 
     callback_ = nullptr;
+    frameCallback_ = nullptr;
+    monitorCallback_ = nullptr;
+    directCallback_ = nullptr;
+    directRing_ = nullptr;
+    directSlotCount_ = 0;
+
+    // 先归还所有帧，再释放帧池
+    audioRing_.release();
+    framePool_.releaseFrame(workFrame_);
+    framePool_.releaseFrame(outputFrame_);
+    workFrame_ = nullptr;
+    outputFrame_ = nullptr;
+    framePool_.release();
 }
 
 bool AudioProcessor::isInitialized() const {
-    return dfInitialized_ && aaudioInitialized_;
+    return dfInitialized_ && audioSourceOpened_;
 }
 
 const char* AudioProcessor::getLastError() const {
@@ -294,14 +955,14 @@ bool AudioProcessor::setPostFilterBeta(float beta) {
         return false;
     }
 
-    if (beta < 0.0f) {
+    if (!(beta >= 0.0f)) {
         snprintf(lastError_, sizeof(lastError_), "beta参数值无效: %.2f", beta);
         LOGE("%s", lastError_);
         return false;
     }
 
-    df_set_post_filter_beta(dfState_, beta);
-    LOGI("设置后滤波器beta参数: %.2f", beta);
+    // 不直接调用df_set_post_filter_beta：处理线程可能正在同一个模型实例上推理
+    parameterMailbox_.post(DenoiseParameter::POST_FILTER_BETA, beta);
     return true;
 }
 
@@ -312,23 +973,60 @@ bool AudioProcessor::setAttenLimDb(float attenLimDb) {
         return false;
     }
 
-    if (attenLimDb < 0.0f) {
+    if (!(attenLimDb >= 0.0f)) {
         snprintf(lastError_, sizeof(lastError_), "衰减限制值无效: %.2f", attenLimDb);
         LOGE("%s", lastError_);
         return false;
     }
 
-    df_set_atten_lim(dfState_, attenLimDb);
-    LOGI("设置衰减限制: %.2f dB", attenLimDb);
+    parameterMailbox_.post(DenoiseParameter::ATTEN_LIM_DB, attenLimDb);
     return true;
 }
 
+bool AudioProcessor::setParameterRamp(int32_t milliseconds) {
+    if (milliseconds < 0) {
+        snprintf(lastError_, sizeof(lastError_), "参数斜坡时长无效: %d", milliseconds);
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    parameterRampMs_.store(milliseconds, std::memory_order_relaxed);
+    parameterMailbox_.setRampHops(rampHopsFor(milliseconds));
+    LOGI("参数斜坡: %dms（%d hop）", milliseconds, rampHopsFor(milliseconds));
+    return true;
+}
+
+ParameterMailboxStats AudioProcessor::getParameterStats() const {
+    return parameterMailbox_.getStats();
+}
+
+int32_t AudioProcessor::rampHopsFor(int32_t milliseconds) const {
+    const int64_t samples = static_cast<int64_t>(milliseconds) * SAMPLE_RATE / 1000;
+    const int64_t hop = static_cast<int64_t>(frameSize_);
+    return static_cast<int32_t>((samples + hop - 1) / hop);
+}
+
+void AudioProcessor::applyParameters() {
+    float values[ParameterMailbox::PARAMETER_COUNT];
+    const uint32_t changed = parameterMailbox_.advance(values);
+    if (changed & (1u << static_cast<size_t>(DenoiseParameter::POST_FILTER_BETA))) {
+        df_set_post_filter_beta(dfState_, values[static_cast<size_t>(DenoiseParameter::POST_FILTER_BETA)]);
+    }
+    if (changed & (1u << static_cast<size_t>(DenoiseParameter::ATTEN_LIM_DB))) {
+        df_set_atten_lim(dfState_, values[static_cast<size_t>(DenoiseParameter::ATTEN_LIM_DB)]);
+    }
+}
+
 int32_t AudioProcessor::getSampleRate() const {
-    return SAMPLE_RATE;
+    return outputSampleRate_;
+}
+
+int32_t AudioProcessor::getCaptureSampleRate() const {
+    return captureSampleRate_;
 }
 
 int32_t AudioProcessor::getChannelCount() const {
-    return CHANNEL_COUNT;
+    return channelCount_;
 }
 
 int32_t AudioProcessor::getFrameSize() const {
@@ -336,131 +1034,376 @@ int32_t AudioProcessor::getFrameSize() const {
 }
 
 size_t AudioProcessor::getQueueSize() const {
-    std::lock_guard<std::mutex> lock(queueMutex_);
-    return audioQueue_.size();
+    return audioRing_.size();
+}
+
+void AudioProcessor::setOverflowPolicy(OverflowPolicy policy) {
+    overflowPolicy_ = policy;
+    audioRing_.setOverflowPolicy(policy);
+    LOGI("设置队列溢出策略: %s",
+         policy == OverflowPolicy::DROP_OLDEST ? "丢弃最旧帧" : "丢弃最新帧");
+}
+
+OverflowPolicy AudioProcessor::getOverflowPolicy() const {
+    return overflowPolicy_;
+}
+
+uint64_t AudioProcessor::getDroppedFrameCount() const {
+    return audioRing_.getDroppedCount();
+}
+
+void AudioProcessor::setModelCacheDir(const char* directory) {
+    modelCache_.setDirectory(directory);
+}
+
+bool AudioProcessor::setModelPrecision(ModelPrecision precision, const uint8_t* variantBytes, size_t variantSize) {
+    if (isProcessing_) {
+        snprintf(lastError_, sizeof(lastError_), "处理中不能修改模型精度");
+        LOGE("%s", lastError_);
+        return false;
+    }
+    if (precision != ModelPrecision::FP32 && precision != ModelPrecision::FP16 &&
+        precision != ModelPrecision::INT8) {
+        snprintf(lastError_, sizeof(lastError_), "无效的模型精度: %d", static_cast<int32_t>(precision));
+        LOGE("%s", lastError_);
+        return false;
+    }
+
+    modelPrecision_ = precision;
+    if (variantBytes != nullptr && variantSize > 0) {
+        modelVariant_.assign(variantBytes, variantBytes + variantSize);
+    } else {
+        modelVariant_.clear();
+        modelVariant_.shrink_to_fit();
+    }
+    return true;
+}
+
+FramePoolStats AudioProcessor::getFramePoolStats() const {
+    return framePool_.getStats();
+}
+
+uint64_t AudioProcessor::getDirectWriteCount() const {
+    return directWriteCount_.load(std::memory_order_acquire);
+}
+
+AudioProcessorStats AudioProcessor::getStats() const {
+    AudioProcessorStats stats;
+    stats.processedFrames = processedFrames_.load(std::memory_order_relaxed);
+    stats.droppedFrames = audioRing_.getDroppedCount();
+    stats.failedFrames = failedFrames_.load(std::memory_order_relaxed);
+    stats.overBudgetFrames = overBudgetFrames_.load(std::memory_order_relaxed);
+    stats.queueLatency = queueLatency_.snapshot();
+    stats.processLatency = processLatency_.snapshot();
+    stats.callbackLatency = callbackLatency_.snapshot();
+    stats.endToEndLatency = endToEndLatency_.snapshot();
+    stats.resamplerLatencyUs = inputResampler_.getLatencyUs() + outputResampler_.getLatencyUs();
+    stats.bypassedFrames = computeGate_.getStats().bypassedHops;
+    stats.syncFrames = syncFrames_.load(std::memory_order_relaxed);
+    stats.missedDeadlines = missedDeadlines_.load(std::memory_order_relaxed);
+    stats.syncFallback = syncFallback_.load(std::memory_order_relaxed);
+    stats.pushedFrames = pushedFrames_.load(std::memory_order_relaxed);
+    stats.backpressureEvents = backpressureEvents_.load(std::memory_order_relaxed);
+    stats.discontinuities = discontinuities_.load(std::memory_order_relaxed);
+    return stats;
 }
 
-aaudio_data_callback_result_t AudioProcessor::dataCallback(
-    AAudioStream* stream,
+int64_t AudioProcessor::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void AudioProcessor::dataCallback(
     void* userData,
-    void* audioData,
+    const float* samples,
     int32_t numFrames) {
     
     AudioProcessor* processor = static_cast<AudioProcessor*>(userData);
+    const int32_t hopSamples = static_cast<int32_t>(processor->inputReblocker_.hopSize());
     
-    // 快速复制音频数据到队列，避免阻塞音频采集线程
-    AudioFrame* frame = processor->allocateAudioFrame(numFrames);
-    if (frame != nullptr) {
-        memcpy(frame->data, audioData, numFrames * sizeof(float));
-        frame->numFrames = numFrames;
-        frame->timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::steady_clock::now().time_since_epoch()).count();
-        
-        // 将帧放入队列
-        {
-            std::lock_guard<std::mutex> lock(processor->queueMutex_);
-            
-            // 检查队列是否已满
-            if (processor->audioQueue_.size() >= MAX_QUEUE_SIZE) {
-                LOGW("音频队列已满，丢弃最旧的帧");
-                AudioFrame* oldFrame = processor->audioQueue_.front();
-                processor->audioQueue_.pop();
-                processor->freeAudioFrame(oldFrame);
-            }
-            
-            processor->audioQueue_.push(frame);
+    // 实时线程：仅复制到预分配的环形缓冲区，不加锁、不分配内存、不打印日志
+    // 回调大小与hop大小无关：攒满一个hop才入队，不足的部分留到下次回调；多声道时按交织采样点整体分块
+    // 队列满时按溢出策略处理，丢弃帧数由环形缓冲区统计
+    // 时间戳为hop最后一个采样到达的回调时刻（纳秒），处理线程据此统计排队和端到端延迟
+    // 位置为hop第一个采样在模型采样率下的序号（含被丢弃的hop），输出端据此检测不连续
+    // 同步模式下攒满的hop直接在本线程降噪输出（处理线程空闲，回退后接管）
+    const int64_t timestamp = nowNs();
+    bool processedInline = false;
+    auto onHop = [&](const float* hop) {
+        const int64_t position = processor->inputHops_++ * static_cast<int64_t>(processor->frameSize_);
+        if (processor->syncActive_.load(std::memory_order_relaxed) && processor->dfState_ != nullptr) {
+            processor->processHop(hop, hopSamples, position, timestamp, nowNs());
+            processor->syncFrames_.fetch_add(1, std::memory_order_relaxed);
+            processedInline = true;
+            return;
+        }
+        if (processor->audioRing_.push(hop, hopSamples, timestamp, position)) {
+            // 通知处理线程有新数据
+            sem_post(&processor->frameSemaphore_);
+        }
+    };
+    
+    Resampler& resampler = processor->inputResampler_;
+    if (resampler.isPassthrough()) {
+        processor->inputReblocker_.write(samples, static_cast<size_t>(numFrames) * processor->channelCount_, onHop);
+    } else {
+        // 采集采样率与模型不同（仅单声道）：按块转换到预分配缓冲区后再分块
+        float* converted = processor->inputResampleBuffer_.data();
+        const size_t blockFrames = RESAMPLE_BLOCK_FRAMES;
+        for (size_t offset = 0; offset < static_cast<size_t>(numFrames); offset += blockFrames) {
+            const size_t count = std::min(static_cast<size_t>(numFrames) - offset, blockFrames);
+            const size_t produced = resampler.process(samples + offset, count, converted);
+            processor->inputReblocker_.write(converted, produced, onHop);
         }
-        
-        // 通知处理线程有新数据
-        processor->queueCondition_.notify_one();
     }
     
-    return AAUDIO_CALLBACK_RESULT_CONTINUE;
+    if (processedInline) {
+        processor->checkSyncDeadline(timestamp, numFrames);
+    }
+}
+
+void AudioProcessor::renderCallback(
+    void* userData,
+    float* samples,
+    int32_t numFrames) {
+    
+    AudioProcessor* processor = static_cast<AudioProcessor*>(userData);
+    processor->playoutBuffer_.render(samples, static_cast<size_t>(numFrames));
+}
+
+void AudioProcessor::checkSyncDeadline(int64_t callbackStartNs, int32_t numFrames) {
+    // 截止时间：本次采集回调的时长 × 比例（回调需在下一次回调到来前返回，否则设备缓冲区欠载）
+    const int64_t deadlineNs = static_cast<int64_t>(
+        static_cast<double>(numFrames) * 1e9 / captureSampleRate_ * syncDeadlineRatio_);
+    if (nowNs() - callbackStartNs > deadlineNs) {
+        missedDeadlines_.fetch_add(1, std::memory_order_relaxed);
+        syncWindowMisses_++;
+    }
+
+    // 每个窗口内超时过多时回退到异步处理，本次运行不再切回
+    if (syncWindowMisses_ >= syncMaxMisses_) {
+        syncActive_.store(false, std::memory_order_relaxed);
+        syncFallback_.store(true, std::memory_order_relaxed);
+    } else if (++syncWindowHops_ >= SYNC_MISS_WINDOW_HOPS) {
+        syncWindowHops_ = 0;
+        syncWindowMisses_ = 0;
+    }
 }
 
 void AudioProcessor::errorCallback(
-    AAudioStream* stream,
     void* userData,
-    aaudio_result_t error) {
+    bool disconnected,
+    const char* message) {
     
     AudioProcessor* processor = static_cast<AudioProcessor*>(userData);
     
-    snprintf(processor->lastError_, sizeof(processor->lastError_), 
-             "AAudio错误回调: %s", AAudio_convertResultToText(error));
+    snprintf(processor->lastError_, sizeof(processor->lastError_), "%s", message);
     LOGE("%s", processor->lastError_);
 
-    if (error == AAUDIO_ERROR_DISCONNECTED) {
-        LOGW("AAudio流断开连接，尝试恢复...");
-        processor->stop();
+    if (disconnected) {
+        // 采集流和双工输出流共用本回调，都在AAudio的回调线程上调用，不能在此同步停止
+        LOGW("音频设备断开连接，停止处理");
+        processor->requestDeferredStop();
+    }
+}
+
+void AudioProcessor::requestDeferredStop() {
+    std::lock_guard<std::mutex> lock(deferredStopMutex_);
+    if (deferredStopThread_.joinable()) {
+        // 已有停止线程（采集流和输出流先后断开），由它完成停止
+        return;
+    }
+    deferredStopThread_ = std::thread([this]() {
+        stop();
+    });
+}
+
+void AudioProcessor::joinDeferredStop() {
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(deferredStopMutex_);
+        thread = std::move(deferredStopThread_);
+    }
+    if (thread.joinable()) {
+        thread.join();
     }
 }
 
 void AudioProcessor::processingThreadFunc() {
     LOGI("异步处理线程已启动");
+    threadScheduler_.applyBase();
+    
+    AudioFrame& frame = *workFrame_;
     
     while (processingThreadRunning_) {
-        AudioFrame* frame = nullptr;
+        // 等待新数据或线程停止
+        if (sem_wait(&frameSemaphore_) != 0) {
+            continue;
+        }
         
-        // 从队列中获取音频帧
-        {
-            std::unique_lock<std::mutex> lock(queueMutex_);
-            
-            // 等待队列中有数据或线程停止
-            queueCondition_.wait(lock, [this]() {
-                return !audioQueue_.empty() || !processingThreadRunning_;
-            });
-            
-            if (!processingThreadRunning_) {
-                break;
-            }
-            
-            if (!audioQueue_.empty()) {
-                frame = audioQueue_.front();
-                audioQueue_.pop();
-            }
+        if (!processingThreadRunning_) {
+            break;
         }
         
-        // 处理音频帧（降噪）
-        if (frame != nullptr && dfState_ != nullptr) {
-            float* outputBuffer = new float[frame->numFrames];
-            if (outputBuffer != nullptr) {
-                float lsnr = df_process_frame(dfState_, frame->data, outputBuffer, 
-                                              static_cast<size_t>(frame->numFrames));
-                
-                if (lsnr >= 0.0f && callback_ != nullptr) {
-                    // 调用回调函数，将降噪后的音频数据返回给Java层
-                    callback_(outputBuffer, frame->numFrames, lsnr);
-                } else if (lsnr < 0.0f) {
-                    LOGE("音频处理失败: LSNR=%.2f", lsnr);
-                }
-                
-                delete[] outputBuffer;
+        // 取出当前所有可用帧（DROP_OLDEST覆盖时信号数可能多于帧数）
+        while (processingThreadRunning_ && audioRing_.pop(&frame)) {
+            if (pushSource_ != nullptr) {
+                // 通知推送线程队列有空间
+                sem_post(&spaceSemaphore_);
+            }
+            if (dfState_ == nullptr) {
+                continue;
             }
             
-            freeAudioFrame(frame);
+            // 记录本hop运行的核心，队列积压时提升调度
+            threadScheduler_.onHop(audioRing_.size());
+            if (frameCallback_ != nullptr) {
+                refreshTimestampAnchor();
+            }
+            
+            const float lsnr = processHop(frame.data, frame.numFrames, frame.position, frame.timestamp, nowNs());
+            if (std::isnan(lsnr)) {
+                LOGE("音频处理失败");
+            }
         }
     }
     
     LOGI("异步处理线程已停止");
 }
 
-AudioFrame* AudioProcessor::allocateAudioFrame(int32_t numFrames) {
-    AudioFrame* frame = new AudioFrame();
-    if (frame != nullptr) {
-        frame->data = new float[numFrames];
-        frame->numFrames = numFrames;
-        frame->timestamp = 0;
+void AudioProcessor::refreshTimestampAnchor() {
+    if (--anchorCountdown_ > 0) {
+        return;
+    }
+
+    int64_t position = 0;
+    int64_t timeNs = 0;
+    if (audioSource_->getTimestamp(&position, &timeNs)) {
+        anchorValid_ = true;
+        anchorPosition_ = position;
+        anchorTimeNs_ = timeNs;
+        anchorCountdown_ = TIMESTAMP_REFRESH_HOPS;
+    } else {
+        // 暂无时间戳（流刚启动或音频源不支持）：保留上一个锚点，稍后重试
+        anchorCountdown_ = TIMESTAMP_RETRY_HOPS;
     }
-    return frame;
 }
 
-void AudioProcessor::freeAudioFrame(AudioFrame* frame) {
-    if (frame != nullptr) {
-        if (frame->data != nullptr) {
-            delete[] frame->data;
+FrameInfo AudioProcessor::makeFrameInfo(int64_t position, int32_t numFrames, int64_t captureNs) {
+    // 模型采样率下的帧数换算到采集采样率（向下取整，预卷部分为负）
+    auto toCaptureFrames = [this](int64_t modelFrames) {
+        const int64_t scaled = modelFrames * captureSampleRate_;
+        return scaled >= 0 ? scaled / SAMPLE_RATE : -((-scaled + SAMPLE_RATE - 1) / SAMPLE_RATE);
+    };
+
+    FrameInfo info;
+    if (position != expectedPosition_) {
+        info.discontinuity = true;
+        info.droppedFrames = toCaptureFrames(position - expectedPosition_);
+        discontinuities_.fetch_add(1, std::memory_order_relaxed);
+    }
+    expectedPosition_ = position + numFrames;
+
+    info.framePosition = toCaptureFrames(position - modelDelayFrames_);
+    if (anchorValid_) {
+        info.timestampNs = anchorTimeNs_ + (info.framePosition - anchorPosition_) * 1000000000LL / captureSampleRate_;
+        info.hardwareTimestamp = true;
+    } else {
+        // captureNs为hop最后一个采样到达的时刻，往前推hop时长和延迟
+        info.timestampNs = captureNs - (numFrames + modelDelayFrames_) * 1000000000LL / SAMPLE_RATE;
+    }
+    return info;
+}
+
+float AudioProcessor::processHop(const float* data, int32_t numSamples, int64_t position, int64_t captureNs,
+                                 int64_t startNs) {
+    queueLatency_.record((startNs - captureNs) / 1000);
+    const size_t channels = static_cast<size_t>(channelCount_);
+    const int32_t numFrames = numSamples / static_cast<int32_t>(channels);
+    
+    // 直接输出模式下降噪结果直接写入共享输出环的下一个槽
+    float* outputBuffer = outputFrame_->data;
+    uint64_t writeCount = 0;
+    int32_t slotIndex = 0;
+    if (directRing_ != nullptr) {
+        writeCount = directWriteCount_.load(std::memory_order_relaxed);
+        slotIndex = static_cast<int32_t>(writeCount % directSlotCount_);
+        outputBuffer = directRing_ + static_cast<size_t>(slotIndex) * frameSize_ * channels;
+    }
+    
+    // 参数在hop边界生效，与推理在同一线程上，不会并发修改模型
+    applyParameters();
+
+    // 计算门控：静音或干净语音时跳过推理；重新运行模型前先用最近跳过的hop预热
+    const bool gateEnabled = gateConfig_.enabled;
+    GateMode gateMode = GateMode::PROCESS;
+    if (gateEnabled) {
+        gateMode = computeGate_.beginHop(data);
+        for (size_t i = 0; i < computeGate_.getWarmupHopCount(); i++) {
+            df_process_frame_interleaved(dfState_, computeGate_.getWarmupHop(i),
+                                         computeGate_.getWarmupOutput(), static_cast<size_t>(numFrames));
         }
-        delete frame;
     }
+    
+    // 处理音频帧（降噪），多声道时所有声道在一次推理中处理
+    float lsnr = 0.0f;
+    if (ComputeGate::runsModel(gateMode)) {
+        lsnr = df_process_frame_interleaved(dfState_, data, outputBuffer, static_cast<size_t>(numFrames));
+    }
+    
+    // 实时预算：一帧音频的时长
+    const int64_t frameBudgetNs = static_cast<int64_t>(frameSize_) * 1000000000LL / SAMPLE_RATE;
+    const int64_t processedNs = nowNs();
+    const int64_t processNs = processedNs - startNs;
+    processLatency_.record(processNs / 1000);
+    if (processNs > frameBudgetNs) {
+        overBudgetFrames_.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    // LSNR在噪声较大时本身为负，只有NaN表示处理出错（输出无效，不回调）
+    if (std::isnan(lsnr)) {
+        failedFrames_.fetch_add(1, std::memory_order_relaxed);
+        return lsnr;
+    }
+    
+    // 运行了模型的hop（包括负LSNR）都要经过endHop：记入LSNR历史、完成交叉淡化，探测hop据此决定是否恢复推理
+    if (gateEnabled) {
+        lsnr = computeGate_.endHop(data, outputBuffer, lsnr);
+    }
+
+    // 失败的hop不更新期望位置，下一块标记为不连续
+    const FrameInfo info = makeFrameInfo(position, numFrames, captureNs);
+    
+    if (directRing_ != nullptr) {
+        directWriteCount_.store(writeCount + 1, std::memory_order_release);
+        if (directCallback_ != nullptr) {
+            directCallback_(slotIndex, numFrames, lsnr);
+        }
+    } else if (callback_ != nullptr || frameCallback_ != nullptr) {
+        // 输出采样率与模型不同时先转换（帧数随之变化）
+        const float* callbackData = outputBuffer;
+        int32_t callbackFrames = numFrames;
+        if (!outputResampler_.isPassthrough()) {
+            callbackData = outputResampleBuffer_.data();
+            callbackFrames = static_cast<int32_t>(outputResampler_.process(
+                outputBuffer, static_cast<size_t>(numFrames), outputResampleBuffer_.data()));
+        }
+        
+        // 调用回调函数，将降噪后的音频数据返回给Java层
+        if (callbackFrames > 0) {
+            if (frameCallback_ != nullptr) {
+                frameCallback_(callbackData, callbackFrames, lsnr, info);
+            } else {
+                callback_(callbackData, callbackFrames, lsnr);
+            }
+        }
+    }
+    
+    const int64_t deliveredNs = nowNs();
+    callbackLatency_.record((deliveredNs - processedNs) / 1000);
+    endToEndLatency_.record((deliveredNs - captureNs) / 1000);
+    processedFrames_.fetch_add(1, std::memory_order_relaxed);
+    return lsnr;
 }
 
 } // namespace deepfilter
\ No newline at end of file
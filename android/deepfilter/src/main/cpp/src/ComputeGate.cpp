@@ -0,0 +1,266 @@
+#include "ComputeGate.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace deepfilter {
+
+ComputeGate::ComputeGate()
+    : frameSize_(0)
+    , channelCount_(1)
+    , hopSamples_(0)
+    , delaySamples_(0)
+    , warmupCapacity_(0)
+    , mode_(GateMode::PROCESS)
+    , bypassing_(false)
+    , silentHop_(false)
+    , resumePending_(false)
+    , qualifyingHops_(0)
+    , hopsSinceProbe_(0)
+    , energyDb_(0.0f)
+    , referenceEnergyDb_(0.0f)
+    , lastLsnr_(0.0f)
+    , previousGain_(1.0f)
+    , currentGain_(1.0f)
+    , lsnrCount_(0)
+    , lsnrNext_(0)
+    , skippedCount_(0)
+    , skippedNext_(0)
+    , warmupCount_(0)
+    , warmupFirst_(0)
+    , totalHops_(0)
+    , bypassedHops_(0)
+    , silentHops_(0)
+    , probeHops_(0)
+    , warmupHops_(0)
+    , transitions_(0) {
+}
+
+bool ComputeGate::init(const ComputeGateConfig& config, size_t frameSize, int32_t channelCount, size_t delayFrames) {
+    if (frameSize == 0 || channelCount <= 0 || config.lsnrHistoryHops <= 0 ||
+        config.holdHops <= 0 || config.probeIntervalHops <= 0 || config.warmupHops < 0) {
+        return false;
+    }
+
+    config_ = config;
+    frameSize_ = frameSize;
+    channelCount_ = static_cast<size_t>(channelCount);
+    hopSamples_ = frameSize * channelCount_;
+    delaySamples_ = delayFrames * channelCount_;
+    // 预热要覆盖算法延迟，模型在FADE_IN的hop上才能输出与旁路信号衔接的数据
+    warmupCapacity_ = std::max(static_cast<size_t>(config.warmupHops), (delayFrames + frameSize - 1) / frameSize);
+
+    lsnrHistory_.assign(static_cast<size_t>(config.lsnrHistoryHops), 0.0f);
+    skippedHops_.assign(warmupCapacity_ * hopSamples_, 0.0f);
+    warmupOutput_.assign(hopSamples_, 0.0f);
+    delayLine_.assign(delaySamples_ > 0 ? delaySamples_ + hopSamples_ : 0, 0.0f);
+    delayedHop_.assign(delaySamples_ > 0 ? hopSamples_ : 0, 0.0f);
+    reset();
+    return true;
+}
+
+void ComputeGate::reset() {
+    mode_ = GateMode::PROCESS;
+    bypassing_ = false;
+    silentHop_ = false;
+    resumePending_ = false;
+    qualifyingHops_ = 0;
+    hopsSinceProbe_ = 0;
+    energyDb_ = 0.0f;
+    referenceEnergyDb_ = 0.0f;
+    lastLsnr_ = 0.0f;
+    previousGain_ = 1.0f;
+    currentGain_ = 1.0f;
+    lsnrCount_ = 0;
+    lsnrNext_ = 0;
+    skippedCount_ = 0;
+    skippedNext_ = 0;
+    warmupCount_ = 0;
+    warmupFirst_ = 0;
+    std::fill(delayLine_.begin(), delayLine_.end(), 0.0f);
+
+    totalHops_.store(0, std::memory_order_relaxed);
+    bypassedHops_.store(0, std::memory_order_relaxed);
+    silentHops_.store(0, std::memory_order_relaxed);
+    probeHops_.store(0, std::memory_order_relaxed);
+    warmupHops_.store(0, std::memory_order_relaxed);
+    transitions_.store(0, std::memory_order_relaxed);
+}
+
+float ComputeGate::hopEnergyDb(const float* input) const {
+    double power = 0.0;
+    for (size_t i = 0; i < hopSamples_; i++) {
+        power += static_cast<double>(input[i]) * input[i];
+    }
+    return static_cast<float>(10.0 * std::log10(power / static_cast<double>(hopSamples_) + 1e-12));
+}
+
+bool ComputeGate::lsnrIsClean() const {
+    if (lsnrCount_ < lsnrHistory_.size()) {
+        return false;
+    }
+    for (float lsnr : lsnrHistory_) {
+        if (lsnr < config_.cleanLsnrDb) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ComputeGate::pushLsnr(float lsnr) {
+    lsnrHistory_[lsnrNext_] = lsnr;
+    lsnrNext_ = (lsnrNext_ + 1) % lsnrHistory_.size();
+    lsnrCount_ = std::min(lsnrCount_ + 1, lsnrHistory_.size());
+}
+
+void ComputeGate::rememberSkippedHop(const float* input) {
+    const size_t capacity = warmupCapacity_;
+    if (capacity == 0) {
+        return;
+    }
+    memcpy(skippedHops_.data() + skippedNext_ * hopSamples_, input, hopSamples_ * sizeof(float));
+    skippedNext_ = (skippedNext_ + 1) % capacity;
+    skippedCount_ = std::min(skippedCount_ + 1, capacity);
+}
+
+const float* ComputeGate::getWarmupHop(size_t index) const {
+    return skippedHops_.data() + ((warmupFirst_ + index) % warmupCapacity_) * hopSamples_;
+}
+
+const float* ComputeGate::delayInput(const float* input) {
+    if (delaySamples_ == 0) {
+        return input;
+    }
+    memcpy(delayLine_.data() + delaySamples_, input, hopSamples_ * sizeof(float));
+    memcpy(delayedHop_.data(), delayLine_.data(), hopSamples_ * sizeof(float));
+    memmove(delayLine_.data(), delayLine_.data() + hopSamples_, delaySamples_ * sizeof(float));
+    return delayedHop_.data();
+}
+
+GateMode ComputeGate::beginHop(const float* input) {
+    energyDb_ = hopEnergyDb(input);
+    silentHop_ = energyDb_ < config_.silenceDbfs;
+    previousGain_ = currentGain_;
+    currentGain_ = silentHop_ ? std::pow(10.0f, config_.silenceGainDb / 20.0f) : 1.0f;
+    warmupCount_ = 0;
+
+    if (!bypassing_) {
+        const bool clean = config_.bypassClean && lsnrIsClean();
+        qualifyingHops_ = (silentHop_ || clean) ? qualifyingHops_ + 1 : 0;
+        if (qualifyingHops_ >= config_.holdHops) {
+            bypassing_ = true;
+            referenceEnergyDb_ = energyDb_;
+            hopsSinceProbe_ = 0;
+            mode_ = GateMode::FADE_OUT;
+        } else {
+            mode_ = GateMode::PROCESS;
+        }
+        return mode_;
+    }
+
+    // 旁路中：静音持续旁路；非静音时只有干净语音才继续旁路（能量没有突增且LSNR历史仍然干净）
+    bool resume = resumePending_;
+    if (!resume && !silentHop_) {
+        resume = !config_.bypassClean || !lsnrIsClean() ||
+                 energyDb_ > referenceEnergyDb_ + config_.energyJumpDb;
+    }
+
+    if (resume) {
+        bypassing_ = false;
+        resumePending_ = false;
+        qualifyingHops_ = 0;
+        mode_ = GateMode::FADE_IN;
+    } else if (!silentHop_ && ++hopsSinceProbe_ >= config_.probeIntervalHops) {
+        hopsSinceProbe_ = 0;
+        mode_ = GateMode::PROBE;
+    } else {
+        mode_ = GateMode::BYPASS;
+        return mode_;
+    }
+
+    // 重新运行模型前先补上最近跳过的hop
+    const size_t capacity = warmupCapacity_;
+    warmupCount_ = skippedCount_;
+    warmupFirst_ = capacity > 0 ? (skippedNext_ + capacity - skippedCount_) % capacity : 0;
+    return mode_;
+}
+
+float ComputeGate::endHop(const float* input, float* output, float lsnr) {
+    totalHops_.fetch_add(1, std::memory_order_relaxed);
+
+    // 延迟线每个hop都要推进（包括PROCESS），进入旁路时才有对齐的历史输入
+    const float* delayed = delayInput(input);
+
+    if (runsModel(mode_)) {
+        pushLsnr(lsnr);
+        lastLsnr_ = lsnr;
+        skippedCount_ = 0;
+    }
+
+    switch (mode_) {
+    case GateMode::PROCESS:
+        return lsnr;
+    case GateMode::FADE_OUT:
+        transitions_.fetch_add(1, std::memory_order_relaxed);
+        break;
+    case GateMode::FADE_IN:
+        transitions_.fetch_add(1, std::memory_order_relaxed);
+        warmupHops_.fetch_add(warmupCount_, std::memory_order_relaxed);
+        break;
+    case GateMode::PROBE:
+        probeHops_.fetch_add(1, std::memory_order_relaxed);
+        warmupHops_.fetch_add(warmupCount_, std::memory_order_relaxed);
+        if (lsnr < config_.cleanExitLsnrDb) {
+            resumePending_ = true;
+        } else {
+            referenceEnergyDb_ = energyDb_;
+        }
+        break;
+    case GateMode::BYPASS:
+        bypassedHops_.fetch_add(1, std::memory_order_relaxed);
+        if (silentHop_) {
+            silentHops_.fetch_add(1, std::memory_order_relaxed);
+        }
+        rememberSkippedHop(input);
+        break;
+    }
+
+    // 旁路信号的增益和交叉淡化都在整个hop内线性过渡（多声道按帧过渡）
+    const float gainStep = (currentGain_ - previousGain_) / static_cast<float>(frameSize_);
+    const float fadeStep = 1.0f / static_cast<float>(frameSize_);
+    for (size_t i = 0; i < frameSize_; i++) {
+        const float position = static_cast<float>(i) + 0.5f;
+        const float gain = previousGain_ + gainStep * position;
+        const float fade = fadeStep * position;
+        for (size_t c = 0; c < channelCount_; c++) {
+            const size_t index = i * channelCount_ + c;
+            const float bypass = delayed[index] * gain;
+            switch (mode_) {
+            case GateMode::FADE_OUT:
+                output[index] = output[index] * (1.0f - fade) + bypass * fade;
+                break;
+            case GateMode::FADE_IN:
+                output[index] = bypass * (1.0f - fade) + output[index] * fade;
+                break;
+            default:
+                output[index] = bypass;
+                break;
+            }
+        }
+    }
+
+    return runsModel(mode_) ? lsnr : lastLsnr_;
+}
+
+ComputeGateStats ComputeGate::getStats() const {
+    ComputeGateStats stats;
+    stats.totalHops = totalHops_.load(std::memory_order_relaxed);
+    stats.bypassedHops = bypassedHops_.load(std::memory_order_relaxed);
+    stats.silentHops = silentHops_.load(std::memory_order_relaxed);
+    stats.probeHops = probeHops_.load(std::memory_order_relaxed);
+    stats.warmupHops = warmupHops_.load(std::memory_order_relaxed);
+    stats.transitions = transitions_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace deepfilter
@@ -0,0 +1,140 @@
+#include "FramePool.h"
+#include "FrameRingBuffer.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace deepfilter {
+
+FramePool::FramePool()
+    : frames_(nullptr)
+    , arena_(nullptr)
+    , next_(nullptr)
+    , frameSize_(0)
+    , frameStride_(0)
+    , capacity_(0)
+    , freeHead_(INVALID_INDEX)
+    , heapAllocations_(0)
+    , acquireCount_(0)
+    , releaseCount_(0)
+    , exhaustedCount_(0) {
+}
+
+FramePool::~FramePool() {
+    release();
+}
+
+bool FramePool::init(size_t frameSize, size_t capacity) {
+    if (frameSize == 0 || capacity == 0 || capacity >= INVALID_INDEX) {
+        return false;
+    }
+
+    release();
+
+    // 帧间距向上取整到缓存行，保证每帧起始地址对齐且相邻帧不共享缓存行
+    const size_t floatsPerLine = CACHE_LINE_SIZE / sizeof(float);
+    frameStride_ = (frameSize + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+
+    void* arena = nullptr;
+    if (posix_memalign(&arena, CACHE_LINE_SIZE, frameStride_ * capacity * sizeof(float)) != 0) {
+        release();
+        return false;
+    }
+    arena_ = static_cast<float*>(arena);
+    heapAllocations_.fetch_add(1, std::memory_order_relaxed);
+
+    frames_ = new (std::nothrow) AudioFrame[capacity];
+    next_ = new (std::nothrow) std::atomic<uint32_t>[capacity];
+    if (frames_ == nullptr || next_ == nullptr) {
+        release();
+        return false;
+    }
+    heapAllocations_.fetch_add(2, std::memory_order_relaxed);
+
+    memset(arena_, 0, frameStride_ * capacity * sizeof(float));
+
+    frameSize_ = frameSize;
+    capacity_ = capacity;
+    for (size_t i = 0; i < capacity_; i++) {
+        frames_[i].data = arena_ + i * frameStride_;
+        frames_[i].numFrames = 0;
+        frames_[i].timestamp = 0;
+        frames_[i].position = 0;
+        next_[i].store(i + 1 < capacity_ ? static_cast<uint32_t>(i + 1) : INVALID_INDEX,
+                       std::memory_order_relaxed);
+    }
+    freeHead_.store(0, std::memory_order_release);
+    return true;
+}
+
+void FramePool::release() {
+    free(arena_);
+    delete[] frames_;
+    delete[] next_;
+    arena_ = nullptr;
+    frames_ = nullptr;
+    next_ = nullptr;
+    frameSize_ = 0;
+    frameStride_ = 0;
+    capacity_ = 0;
+    freeHead_.store(INVALID_INDEX, std::memory_order_relaxed);
+}
+
+AudioFrame* FramePool::acquireFrame() {
+    if (frames_ == nullptr) {
+        return nullptr;
+    }
+
+    uint64_t head = freeHead_.load(std::memory_order_acquire);
+    while (true) {
+        const uint32_t index = static_cast<uint32_t>(head & 0xFFFFFFFFu);
+        if (index == INVALID_INDEX) {
+            exhaustedCount_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        const uint64_t tag = (head >> 32) + 1;
+        const uint64_t newHead = (tag << 32) | next_[index].load(std::memory_order_relaxed);
+        if (freeHead_.compare_exchange_weak(head, newHead,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+            acquireCount_.fetch_add(1, std::memory_order_relaxed);
+            return &frames_[index];
+        }
+    }
+}
+
+void FramePool::releaseFrame(AudioFrame* frame) {
+    if (frame == nullptr || frames_ == nullptr ||
+        frame < frames_ || frame >= frames_ + capacity_) {
+        return;
+    }
+
+    const uint32_t index = static_cast<uint32_t>(frame - frames_);
+    uint64_t head = freeHead_.load(std::memory_order_relaxed);
+    while (true) {
+        next_[index].store(static_cast<uint32_t>(head & 0xFFFFFFFFu), std::memory_order_relaxed);
+        const uint64_t tag = (head >> 32) + 1;
+        const uint64_t newHead = (tag << 32) | index;
+        if (freeHead_.compare_exchange_weak(head, newHead,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+            releaseCount_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+FramePoolStats FramePool::getStats() const {
+    FramePoolStats stats;
+    stats.capacity = capacity_;
+    stats.heapAllocations = heapAllocations_.load(std::memory_order_relaxed);
+    stats.acquireCount = acquireCount_.load(std::memory_order_relaxed);
+    stats.releaseCount = releaseCount_.load(std::memory_order_relaxed);
+    stats.exhaustedCount = exhaustedCount_.load(std::memory_order_relaxed);
+    stats.inUse = stats.acquireCount >= stats.releaseCount
+        ? static_cast<size_t>(stats.acquireCount - stats.releaseCount) : 0;
+    return stats;
+}
+
+} // namespace deepfilter
@@ -0,0 +1,211 @@
+#include "FrameRingBuffer.h"
+#include <cstring>
+#include <new>
+
+namespace deepfilter {
+
+FrameRingBuffer::FrameRingBuffer()
+    : slots_(nullptr)
+    , pool_(nullptr)
+    , frameSize_(0)
+    , capacity_(0)
+    , policy_(static_cast<int32_t>(OverflowPolicy::DROP_OLDEST))
+    , writeIndex_(0)
+    , pushedCount_(0)
+    , droppedCount_(0)
+    , readIndex_(0)
+    , poppedCount_(0) {
+}
+
+FrameRingBuffer::~FrameRingBuffer() {
+    release();
+}
+
+bool FrameRingBuffer::init(size_t frameSize, size_t capacity, OverflowPolicy policy) {
+    release();
+
+    if (!ownPool_.init(frameSize, capacity)) {
+        return false;
+    }
+    return init(ownPool_, capacity, policy);
+}
+
+bool FrameRingBuffer::init(FramePool& pool, size_t capacity, OverflowPolicy policy) {
+    if (pool.frameSize() == 0 || capacity == 0) {
+        return false;
+    }
+
+    if (slots_ != nullptr) {
+        release();
+    }
+
+    slots_ = new (std::nothrow) Slot[capacity];
+    if (slots_ == nullptr) {
+        return false;
+    }
+
+    pool_ = &pool;
+    capacity_ = capacity;
+    frameSize_ = pool.frameSize();
+    for (size_t i = 0; i < capacity_; i++) {
+        slots_[i].frame = nullptr;
+    }
+    for (size_t i = 0; i < capacity_; i++) {
+        slots_[i].frame = pool.acquireFrame();
+        if (slots_[i].frame == nullptr) {
+            release();
+            return false;
+        }
+    }
+
+    setOverflowPolicy(policy);
+    reset();
+    return true;
+}
+
+void FrameRingBuffer::release() {
+    if (slots_ != nullptr) {
+        for (size_t i = 0; i < capacity_; i++) {
+            if (slots_[i].frame != nullptr && pool_ != nullptr) {
+                pool_->releaseFrame(slots_[i].frame);
+            }
+        }
+        delete[] slots_;
+    }
+    slots_ = nullptr;
+    pool_ = nullptr;
+    frameSize_ = 0;
+    capacity_ = 0;
+    ownPool_.release();
+}
+
+void FrameRingBuffer::reset() {
+    for (size_t i = 0; i < capacity_; i++) {
+        slots_[i].sequence.store(0, std::memory_order_relaxed);
+        slots_[i].numFrames.store(0, std::memory_order_relaxed);
+        slots_[i].timestamp.store(0, std::memory_order_relaxed);
+        slots_[i].position.store(0, std::memory_order_relaxed);
+    }
+    writeIndex_.store(0, std::memory_order_relaxed);
+    readIndex_.store(0, std::memory_order_relaxed);
+    pushedCount_.store(0, std::memory_order_relaxed);
+    droppedCount_.store(0, std::memory_order_relaxed);
+    poppedCount_.store(0, std::memory_order_release);
+}
+
+bool FrameRingBuffer::push(const float* data, int32_t numFrames, int64_t timestamp, int64_t position) {
+    if (slots_ == nullptr || data == nullptr || numFrames <= 0) {
+        return false;
+    }
+
+    const uint64_t write = writeIndex_.load(std::memory_order_relaxed);
+    const uint64_t read = readIndex_.load(std::memory_order_acquire);
+
+    if (write - read >= capacity_ && getOverflowPolicy() == OverflowPolicy::DROP_NEWEST) {
+        droppedCount_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    // DROP_OLDEST：直接覆盖，由消费者在跳过被覆盖的槽时计入丢弃数
+
+    size_t count = static_cast<size_t>(numFrames);
+    if (count > frameSize_) {
+        count = frameSize_;
+    }
+
+    Slot& slot = slots_[write % capacity_];
+    slot.sequence.store(write * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memcpy(slot.frame->data, data, count * sizeof(float));
+    slot.numFrames.store(static_cast<int32_t>(count), std::memory_order_relaxed);
+    slot.timestamp.store(timestamp, std::memory_order_relaxed);
+    slot.position.store(position, std::memory_order_relaxed);
+
+    slot.sequence.store(write * 2 + 2, std::memory_order_release);
+    writeIndex_.store(write + 1, std::memory_order_release);
+    pushedCount_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool FrameRingBuffer::pop(AudioFrame* frame) {
+    if (slots_ == nullptr || frame == nullptr || frame->data == nullptr) {
+        return false;
+    }
+
+    uint64_t read = readIndex_.load(std::memory_order_relaxed);
+
+    while (true) {
+        const uint64_t write = writeIndex_.load(std::memory_order_acquire);
+        if (read == write) {
+            readIndex_.store(read, std::memory_order_release);
+            return false;
+        }
+
+        // 被生产者套圈：跳到仍然有效的最旧帧
+        if (write - read > capacity_) {
+            droppedCount_.fetch_add(write - capacity_ - read, std::memory_order_relaxed);
+            read = write - capacity_;
+        }
+
+        Slot& slot = slots_[read % capacity_];
+        const uint64_t expected = read * 2 + 2;
+        const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before != expected) {
+            droppedCount_.fetch_add(1, std::memory_order_relaxed);
+            read++;
+            continue;
+        }
+
+        const int32_t numFrames = slot.numFrames.load(std::memory_order_relaxed);
+        const int64_t timestamp = slot.timestamp.load(std::memory_order_relaxed);
+        const int64_t position = slot.position.load(std::memory_order_relaxed);
+        memcpy(frame->data, slot.frame->data, static_cast<size_t>(numFrames) * sizeof(float));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) {
+            // 复制过程中被覆盖，数据无效
+            droppedCount_.fetch_add(1, std::memory_order_relaxed);
+            read++;
+            continue;
+        }
+
+        frame->numFrames = numFrames;
+        frame->timestamp = timestamp;
+        frame->position = position;
+        readIndex_.store(read + 1, std::memory_order_release);
+        poppedCount_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+}
+
+size_t FrameRingBuffer::size() const {
+    const uint64_t read = readIndex_.load(std::memory_order_acquire);
+    const uint64_t write = writeIndex_.load(std::memory_order_acquire);
+    if (write <= read) {
+        return 0;
+    }
+    const uint64_t pending = write - read;
+    return pending > capacity_ ? capacity_ : static_cast<size_t>(pending);
+}
+
+void FrameRingBuffer::setOverflowPolicy(OverflowPolicy policy) {
+    policy_.store(static_cast<int32_t>(policy), std::memory_order_relaxed);
+}
+
+OverflowPolicy FrameRingBuffer::getOverflowPolicy() const {
+    return static_cast<OverflowPolicy>(policy_.load(std::memory_order_relaxed));
+}
+
+uint64_t FrameRingBuffer::getPushedCount() const {
+    return pushedCount_.load(std::memory_order_relaxed);
+}
+
+uint64_t FrameRingBuffer::getPoppedCount() const {
+    return poppedCount_.load(std::memory_order_relaxed);
+}
+
+uint64_t FrameRingBuffer::getDroppedCount() const {
+    return droppedCount_.load(std::memory_order_relaxed);
+}
+
+} // namespace deepfilter
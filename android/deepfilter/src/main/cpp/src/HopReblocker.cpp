@@ -0,0 +1,18 @@
+#include "HopReblocker.h"
+
+namespace deepfilter {
+
+bool HopReblocker::init(size_t hopSize) {
+    if (hopSize == 0) {
+        return false;
+    }
+
+    if (hopSize != hopSize_ || staging_ == nullptr) {
+        staging_.reset(new float[hopSize]);
+        hopSize_ = hopSize;
+    }
+    pending_ = 0;
+    return true;
+}
+
+} // namespace deepfilter
@@ -0,0 +1,105 @@
+#include "LatencyHistogram.h"
+
+namespace deepfilter {
+
+LatencyHistogram::LatencyHistogram()
+    : sumUs_(0)
+    , maxUs_(0) {
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        buckets_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t valueUs) {
+    if (valueUs < LINEAR_BUCKETS) {
+        return static_cast<size_t>(valueUs);
+    }
+
+    // 最高位所在区间exponent（>=4），其下3位决定子桶
+    const size_t exponent = 63 - static_cast<size_t>(__builtin_clzll(valueUs));
+    const size_t subBucket = static_cast<size_t>(valueUs >> (exponent - 3)) & (SUB_BUCKETS - 1);
+    const size_t index = LINEAR_BUCKETS + (exponent - 4) * SUB_BUCKETS + subBucket;
+    return index < BUCKET_COUNT ? index : BUCKET_COUNT - 1;
+}
+
+int64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < LINEAR_BUCKETS) {
+        return static_cast<int64_t>(index);
+    }
+    const size_t exponent = 4 + (index - LINEAR_BUCKETS) / SUB_BUCKETS;
+    const uint64_t subBucket = (index - LINEAR_BUCKETS) % SUB_BUCKETS;
+    const uint64_t width = 1ull << (exponent - 3);
+    return static_cast<int64_t>((1ull << exponent) + (subBucket + 1) * width - 1);
+}
+
+void LatencyHistogram::record(int64_t valueUs) {
+    if (valueUs < 0) {
+        valueUs = 0;
+    }
+
+    buckets_[bucketIndex(static_cast<uint64_t>(valueUs))].fetch_add(1, std::memory_order_relaxed);
+    sumUs_.fetch_add(valueUs, std::memory_order_relaxed);
+
+    int64_t currentMax = maxUs_.load(std::memory_order_relaxed);
+    while (valueUs > currentMax &&
+           !maxUs_.compare_exchange_weak(currentMax, valueUs, std::memory_order_relaxed)) {
+    }
+}
+
+LatencySummary LatencyHistogram::snapshot() const {
+    LatencySummary summary;
+
+    // 样本数以各桶计数之和为准，保证分位数计算自洽
+    uint64_t counts[BUCKET_COUNT];
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        total += counts[i];
+    }
+    if (total == 0) {
+        return summary;
+    }
+
+    summary.count = total;
+    summary.maxUs = maxUs_.load(std::memory_order_relaxed);
+    summary.avgUs = sumUs_.load(std::memory_order_relaxed) / static_cast<int64_t>(total);
+
+    // 第ceil(q * total)个样本所在桶
+    const uint64_t p50Rank = (total * 50 + 99) / 100;
+    const uint64_t p95Rank = (total * 95 + 99) / 100;
+    const uint64_t p99Rank = (total * 99 + 99) / 100;
+    uint64_t cumulative = 0;
+    bool p50Done = false;
+    bool p95Done = false;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        cumulative += counts[i];
+        if (!p50Done && cumulative >= p50Rank) {
+            summary.p50Us = bucketUpperBound(i);
+            p50Done = true;
+        }
+        if (!p95Done && cumulative >= p95Rank) {
+            summary.p95Us = bucketUpperBound(i);
+            p95Done = true;
+        }
+        if (cumulative >= p99Rank) {
+            summary.p99Us = bucketUpperBound(i);
+            break;
+        }
+    }
+
+    // 分位数取桶上界，不应超过实测最大值
+    if (summary.p50Us > summary.maxUs) summary.p50Us = summary.maxUs;
+    if (summary.p95Us > summary.maxUs) summary.p95Us = summary.maxUs;
+    if (summary.p99Us > summary.maxUs) summary.p99Us = summary.maxUs;
+    return summary;
+}
+
+void LatencyHistogram::reset() {
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        buckets_[i].store(0, std::memory_order_relaxed);
+    }
+    sumUs_.store(0, std::memory_order_relaxed);
+    maxUs_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace deepfilter
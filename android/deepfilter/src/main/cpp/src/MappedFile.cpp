@@ -0,0 +1,73 @@
+#include "MappedFile.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace deepfilter {
+
+MappedFile::MappedFile()
+    : data_(nullptr)
+    , size_(0)
+    , fd_(-1) {
+    memset(lastError_, 0, sizeof(lastError_));
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const char* path, bool sequential) {
+    close();
+
+    if (path == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "文件路径为空");
+        return false;
+    }
+
+    fd_ = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        snprintf(lastError_, sizeof(lastError_), "打开文件失败: %s (%s)", path, strerror(errno));
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || st.st_size <= 0) {
+        snprintf(lastError_, sizeof(lastError_), "文件为空或无法获取大小: %s", path);
+        close();
+        return false;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (mapped == MAP_FAILED) {
+        snprintf(lastError_, sizeof(lastError_), "映射文件失败: %s (%s)", path, strerror(errno));
+        size_ = 0;
+        close();
+        return false;
+    }
+
+    if (sequential) {
+        madvise(mapped, size_, MADV_SEQUENTIAL);
+    }
+
+    data_ = static_cast<const uint8_t*>(mapped);
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_ != nullptr) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+        data_ = nullptr;
+    }
+    size_ = 0;
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+} // namespace deepfilter
@@ -0,0 +1,228 @@
+#include "ModelCache.h"
+#include "MappedFile.h"
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+namespace deepfilter {
+
+namespace {
+
+const char CACHE_MAGIC[4] = {'D', 'F', 'M', 'C'};
+const size_t HEADER_SIZE = 4 + 4 + 8 + 8;
+
+const uint64_t FNV_OFFSET = 0xcbf29ce484222325ull;
+const uint64_t FNV_PRIME = 0x100000001b3ull;
+
+uint64_t fnv1a(uint64_t h, const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        h ^= data[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+bool hasVariant(const uint8_t* variantBytes, size_t variantSize) {
+    return variantBytes != nullptr && variantSize > 0;
+}
+
+uint32_t readLe32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint64_t readLe64(const uint8_t* p) {
+    return static_cast<uint64_t>(readLe32(p)) | (static_cast<uint64_t>(readLe32(p + 4)) << 32);
+}
+
+void writeLe32(uint8_t* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = static_cast<uint8_t>(v >> (i * 8));
+    }
+}
+
+void writeLe64(uint8_t* p, uint64_t v) {
+    writeLe32(p, static_cast<uint32_t>(v));
+    writeLe32(p + 4, static_cast<uint32_t>(v >> 32));
+}
+
+} // namespace
+
+ModelCache::ModelCache() {
+    memset(lastError_, 0, sizeof(lastError_));
+}
+
+void ModelCache::setDirectory(const char* directory) {
+    directory_ = directory != nullptr ? directory : "";
+    while (directory_.size() > 1 && directory_.back() == '/') {
+        directory_.pop_back();
+    }
+}
+
+uint64_t ModelCache::hash(const uint8_t* data, size_t size) {
+    return fnv1a(FNV_OFFSET, data, size);
+}
+
+const char* ModelCache::precisionName(ModelPrecision precision) {
+    switch (precision) {
+        case ModelPrecision::FP32:
+            return "fp32";
+        case ModelPrecision::FP16:
+            return "fp16";
+        case ModelPrecision::INT8:
+            return "int8";
+    }
+    return "unknown";
+}
+
+uint64_t ModelCache::cacheKey(const uint8_t* tarBytes, size_t tarBytesSize, ModelPrecision precision,
+                              const uint8_t* variantBytes, size_t variantSize) {
+    uint64_t key = hash(tarBytes, tarBytesSize);
+    if (precision == ModelPrecision::FP32 && !hasVariant(variantBytes, variantSize)) {
+        return key;
+    }
+    if (hasVariant(variantBytes, variantSize)) {
+        key = fnv1a(key, variantBytes, variantSize);
+    }
+    const uint8_t tag = static_cast<uint8_t>(precision);
+    return fnv1a(key, &tag, 1);
+}
+
+std::string ModelCache::getCachePath(const uint8_t* tarBytes, size_t tarBytesSize, ModelPrecision precision,
+                                     const uint8_t* variantBytes, size_t variantSize) const {
+    if (directory_.empty() || tarBytes == nullptr) {
+        return std::string();
+    }
+    return pathForKey(cacheKey(tarBytes, tarBytesSize, precision, variantBytes, variantSize));
+}
+
+std::string ModelCache::pathForKey(uint64_t key) const {
+    char name[64];
+    snprintf(name, sizeof(name), "/df_model_%016" PRIx64 ".cache", key);
+    return directory_ + name;
+}
+
+void* ModelCache::loadModel(const uint8_t* tarBytes, size_t tarBytesSize, bool* cacheHit) {
+    return loadModel(tarBytes, tarBytesSize, ModelPrecision::FP32, nullptr, 0, cacheHit);
+}
+
+void* ModelCache::loadModel(const uint8_t* tarBytes, size_t tarBytesSize, ModelPrecision precision,
+                            const uint8_t* variantBytes, size_t variantSize, bool* cacheHit) {
+    if (cacheHit != nullptr) {
+        *cacheHit = false;
+    }
+    if (tarBytes == nullptr || tarBytesSize == 0) {
+        snprintf(lastError_, sizeof(lastError_), "模型文件字节数组为空");
+        return nullptr;
+    }
+
+    const uint64_t key = cacheKey(tarBytes, tarBytesSize, precision, variantBytes, variantSize);
+    const std::string path = directory_.empty() ? std::string() : pathForKey(key);
+
+    if (!path.empty()) {
+        void* model = loadFromCache(path, key);
+        if (model != nullptr) {
+            if (cacheHit != nullptr) {
+                *cacheHit = true;
+            }
+            return model;
+        }
+    }
+
+    // 未启用缓存、未命中或缓存无效：走完整路径（非默认精度先组装所选子网络），成功后重建缓存
+    const uint8_t* source = tarBytes;
+    size_t sourceSize = tarBytesSize;
+    uint8_t* selected = nullptr;
+    if (precision != ModelPrecision::FP32 || hasVariant(variantBytes, variantSize)) {
+        selected = df_model_select_precision(tarBytes, tarBytesSize, variantBytes,
+                                             hasVariant(variantBytes, variantSize) ? variantSize : 0,
+                                             static_cast<int32_t>(precision), &sourceSize);
+        if (selected == nullptr) {
+            snprintf(lastError_, sizeof(lastError_), "模型中缺少%s精度的子网络", precisionName(precision));
+            return nullptr;
+        }
+        source = selected;
+    }
+
+    void* model = df_model_load(source, sourceSize);
+    if (model == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "加载DeepFilterNet模型失败");
+    } else if (!path.empty()) {
+        // 写缓存失败不影响本次加载
+        writeCache(path, key, source, sourceSize);
+    }
+
+    if (selected != nullptr) {
+        df_free_buffer(selected, sourceSize);
+    }
+    return model;
+}
+
+void* ModelCache::loadFromCache(const std::string& path, uint64_t key) {
+    MappedFile file;
+    if (!file.open(path.c_str())) {
+        return nullptr;
+    }
+
+    const uint8_t* data = file.data();
+    const size_t size = file.size();
+    if (size < HEADER_SIZE ||
+        memcmp(data, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        readLe32(data + 4) != FORMAT_VERSION ||
+        readLe64(data + 8) != key ||
+        readLe64(data + 16) != size - HEADER_SIZE) {
+        snprintf(lastError_, sizeof(lastError_), "缓存文件无效或版本不匹配: %s", path.c_str());
+        file.close();
+        unlink(path.c_str());
+        return nullptr;
+    }
+
+    void* model = df_model_load(data + HEADER_SIZE, size - HEADER_SIZE);
+    if (model == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "缓存文件加载失败: %s", path.c_str());
+        file.close();
+        unlink(path.c_str());
+    }
+    return model;
+}
+
+bool ModelCache::writeCache(const std::string& path, uint64_t key, const uint8_t* tarBytes, size_t tarBytesSize) {
+    size_t payloadSize = 0;
+    uint8_t* payload = df_model_repack(tarBytes, tarBytesSize, &payloadSize);
+    if (payload == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "重新打包模型失败");
+        return false;
+    }
+
+    uint8_t header[HEADER_SIZE];
+    memcpy(header, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    writeLe32(header + 4, FORMAT_VERSION);
+    writeLe64(header + 8, key);
+    writeLe64(header + 16, payloadSize);
+
+    // 写入临时文件后重命名，进程中途退出不会留下半个缓存文件
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".tmp.%d", static_cast<int>(getpid()));
+    const std::string tempPath = path + suffix;
+
+    bool success = false;
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (file != nullptr) {
+        success = fwrite(header, 1, HEADER_SIZE, file) == HEADER_SIZE &&
+                  fwrite(payload, 1, payloadSize, file) == payloadSize;
+        success = fclose(file) == 0 && success;
+        success = success && rename(tempPath.c_str(), path.c_str()) == 0;
+        if (!success) {
+            unlink(tempPath.c_str());
+        }
+    }
+    df_free_buffer(payload, payloadSize);
+
+    if (!success) {
+        snprintf(lastError_, sizeof(lastError_), "写入缓存文件失败: %s", path.c_str());
+    }
+    return success;
+}
+
+} // namespace deepfilter
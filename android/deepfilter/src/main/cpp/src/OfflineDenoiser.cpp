@@ -0,0 +1,198 @@
+#include "OfflineDenoiser.h"
+#include "deepfilter_ort.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace deepfilter {
+
+OfflineDenoiser::OfflineDenoiser()
+    : model_(nullptr)
+    , postFilterBeta_(0.0f)
+    , attenLimDb_(100.0f)
+    , dfState_(nullptr)
+    , stateUsed_(false)
+    , frameSize_(0) {
+    memset(lastError_, 0, sizeof(lastError_));
+}
+
+OfflineDenoiser::~OfflineDenoiser() {
+    release();
+}
+
+bool OfflineDenoiser::initialize(
+    const uint8_t* tarBytes,
+    size_t tarBytesSize,
+    float postFilterBeta,
+    float attenLimDb) {
+
+    if (tarBytes == nullptr || tarBytesSize == 0) {
+        snprintf(lastError_, sizeof(lastError_), "模型文件字节数组为空");
+        return false;
+    }
+
+    release();
+
+    model_ = df_model_load(tarBytes, tarBytesSize);
+    if (model_ == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "加载DeepFilterNet模型失败");
+        return false;
+    }
+
+    postFilterBeta_ = postFilterBeta;
+    attenLimDb_ = attenLimDb;
+
+    return createState();
+}
+
+bool OfflineDenoiser::createState() {
+    if (dfState_ != nullptr) {
+        df_destroy(dfState_);
+        dfState_ = nullptr;
+    }
+
+    stateUsed_ = false;
+    dfState_ = df_create_from_model(model_, postFilterBeta_, attenLimDb_);
+    if (dfState_ == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "创建DeepFilterNet实例失败");
+        return false;
+    }
+
+    frameSize_ = df_get_frame_size(dfState_);
+    if (frameSize_ == 0) {
+        snprintf(lastError_, sizeof(lastError_), "无效的帧大小");
+        return false;
+    }
+    return true;
+}
+
+bool OfflineDenoiser::processFile(
+    const char* inputPath,
+    const char* outputPath,
+    const OfflineOptions& options,
+    OfflineResult* result) {
+
+    if (model_ == nullptr || dfState_ == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "降噪器未初始化");
+        return false;
+    }
+    if (options.chunkHops == 0) {
+        snprintf(lastError_, sizeof(lastError_), "chunkHops必须大于0");
+        return false;
+    }
+
+    WavReader reader;
+    if (!reader.open(inputPath)) {
+        snprintf(lastError_, sizeof(lastError_), "%s", reader.getLastError());
+        return false;
+    }
+    if (reader.sampleRate() != SAMPLE_RATE) {
+        snprintf(lastError_, sizeof(lastError_), "输入采样率必须为%dHz，实际为%dHz: %s",
+                 SAMPLE_RATE, reader.sampleRate(), inputPath);
+        return false;
+    }
+
+    // 上一个文件的模型状态（GRU隐状态、重叠缓冲）不能带入下一个文件
+    if (stateUsed_ && !createState()) {
+        return false;
+    }
+    stateUsed_ = true;
+
+    WavWriter writer;
+    if (!writer.open(outputPath, SAMPLE_RATE, 1, options.outputFormat)) {
+        snprintf(lastError_, sizeof(lastError_), "%s", writer.getLastError());
+        return false;
+    }
+
+    const size_t chunkSamples = options.chunkHops * frameSize_;
+    inputChunk_.assign(chunkSamples, 0.0f);
+    outputChunk_.assign(chunkSamples, 0.0f);
+
+    // 延迟补偿：输入结束后再送入delay个零采样，输出丢弃开头delay个采样
+    const size_t delay = options.compensateDelay ? df_get_algorithmic_delay(dfState_) : 0;
+    size_t skipRemaining = delay;
+    size_t flushRemaining = delay;
+    bool inputDone = false;
+
+    OfflineResult local;
+    const auto start = std::chrono::steady_clock::now();
+
+    while (true) {
+        size_t filled = 0;
+        if (!inputDone) {
+            filled = reader.readMono(inputChunk_.data(), chunkSamples);
+            inputDone = filled < chunkSamples;
+        }
+        if (inputDone && flushRemaining > 0) {
+            const size_t zeros = std::min(flushRemaining, chunkSamples - filled);
+            memset(inputChunk_.data() + filled, 0, zeros * sizeof(float));
+            filled += zeros;
+            flushRemaining -= zeros;
+        }
+        if (filled == 0) {
+            break;
+        }
+
+        // 最后一块不足整数个hop时补零，只写出真实长度
+        const size_t hops = (filled + frameSize_ - 1) / frameSize_;
+        const size_t padded = hops * frameSize_;
+        if (padded > filled) {
+            memset(inputChunk_.data() + filled, 0, (padded - filled) * sizeof(float));
+        }
+
+        const int64_t processed = df_process_frames(
+            dfState_, inputChunk_.data(), outputChunk_.data(), padded, nullptr);
+        if (processed != static_cast<int64_t>(hops)) {
+            snprintf(lastError_, sizeof(lastError_), "降噪处理失败: 第%llu个hop",
+                     static_cast<unsigned long long>(local.hops + (processed > 0 ? processed : 0)));
+            writer.close();
+            return false;
+        }
+
+        // 送入的采样比输入多delay个，丢弃开头delay个后写出长度与输入一致
+        const size_t skipped = std::min(skipRemaining, filled);
+        skipRemaining -= skipped;
+        if (filled > skipped && !writer.write(outputChunk_.data() + skipped, filled - skipped)) {
+            snprintf(lastError_, sizeof(lastError_), "%s", writer.getLastError());
+            writer.close();
+            return false;
+        }
+
+        local.hops += hops;
+        local.samples += filled - skipped;
+    }
+
+    if (!writer.close()) {
+        snprintf(lastError_, sizeof(lastError_), "%s", writer.getLastError());
+        return false;
+    }
+
+    local.processingSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    local.audioSeconds = static_cast<double>(local.samples) / SAMPLE_RATE;
+    local.realTimeFactor = local.audioSeconds > 0.0 ? local.processingSeconds / local.audioSeconds : 0.0;
+
+    if (result != nullptr) {
+        *result = local;
+    }
+    return true;
+}
+
+void OfflineDenoiser::release() {
+    if (dfState_ != nullptr) {
+        df_destroy(dfState_);
+        dfState_ = nullptr;
+    }
+    if (model_ != nullptr) {
+        df_model_free(model_);
+        model_ = nullptr;
+    }
+    stateUsed_ = false;
+    frameSize_ = 0;
+    inputChunk_.clear();
+    inputChunk_.shrink_to_fit();
+    outputChunk_.clear();
+    outputChunk_.shrink_to_fit();
+}
+
+} // namespace deepfilter
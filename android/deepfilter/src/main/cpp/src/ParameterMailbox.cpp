@@ -0,0 +1,103 @@
+#include "ParameterMailbox.h"
+
+namespace deepfilter {
+
+ParameterMailbox::ParameterMailbox()
+    : rampHops_(0)
+    , posts_(0)
+    , appliedSteps_(0)
+    , retargets_(0) {
+    for (Slot& slot : slots_) {
+        slot.target.store(0.0f, std::memory_order_relaxed);
+        slot.current.store(0.0f, std::memory_order_relaxed);
+        slot.rampTarget = 0.0f;
+        slot.rampStep = 0.0f;
+        slot.remainingHops = 0;
+    }
+}
+
+bool ParameterMailbox::init(float postFilterBeta, float attenLimDb, int32_t rampHops) {
+    if (rampHops < 0) {
+        return false;
+    }
+
+    const float initial[PARAMETER_COUNT] = {postFilterBeta, attenLimDb};
+    for (size_t i = 0; i < PARAMETER_COUNT; i++) {
+        Slot& slot = slots_[i];
+        slot.target.store(initial[i], std::memory_order_relaxed);
+        slot.current.store(initial[i], std::memory_order_relaxed);
+        slot.rampTarget = initial[i];
+        slot.rampStep = 0.0f;
+        slot.remainingHops = 0;
+    }
+    rampHops_.store(rampHops, std::memory_order_relaxed);
+    posts_.store(0, std::memory_order_relaxed);
+    appliedSteps_.store(0, std::memory_order_relaxed);
+    retargets_.store(0, std::memory_order_relaxed);
+    return true;
+}
+
+void ParameterMailbox::setRampHops(int32_t rampHops) {
+    rampHops_.store(rampHops < 0 ? 0 : rampHops, std::memory_order_relaxed);
+}
+
+void ParameterMailbox::post(DenoiseParameter parameter, float value) {
+    slots_[static_cast<size_t>(parameter)].target.store(value, std::memory_order_relaxed);
+    posts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+float ParameterMailbox::getTarget(DenoiseParameter parameter) const {
+    return slots_[static_cast<size_t>(parameter)].target.load(std::memory_order_relaxed);
+}
+
+uint32_t ParameterMailbox::advance(float values[PARAMETER_COUNT]) {
+    uint32_t changed = 0;
+    for (size_t i = 0; i < PARAMETER_COUNT; i++) {
+        Slot& slot = slots_[i];
+        float current = slot.current.load(std::memory_order_relaxed);
+
+        // 新目标：从当前值开始新斜坡（斜坡途中改目标也不会跳变）
+        const float target = slot.target.load(std::memory_order_relaxed);
+        if (target != slot.rampTarget) {
+            const int32_t rampHops = rampHops_.load(std::memory_order_relaxed);
+            slot.rampTarget = target;
+            slot.remainingHops = rampHops > 0 ? rampHops : 1;
+            slot.rampStep = (target - current) / static_cast<float>(slot.remainingHops);
+            retargets_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (slot.remainingHops > 0) {
+            slot.remainingHops--;
+            // 最后一步直接取终点，消除累加误差
+            current = slot.remainingHops == 0 ? slot.rampTarget : current + slot.rampStep;
+            slot.current.store(current, std::memory_order_relaxed);
+            changed |= 1u << i;
+            appliedSteps_.fetch_add(1, std::memory_order_relaxed);
+        }
+        values[i] = current;
+    }
+    return changed;
+}
+
+bool ParameterMailbox::isSettled() const {
+    for (const Slot& slot : slots_) {
+        if (slot.current.load(std::memory_order_relaxed) != slot.target.load(std::memory_order_relaxed)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ParameterMailboxStats ParameterMailbox::getStats() const {
+    ParameterMailboxStats stats;
+    stats.posts = posts_.load(std::memory_order_relaxed);
+    stats.appliedSteps = appliedSteps_.load(std::memory_order_relaxed);
+    stats.retargets = retargets_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < PARAMETER_COUNT; i++) {
+        stats.target[i] = slots_[i].target.load(std::memory_order_relaxed);
+        stats.current[i] = slots_[i].current.load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+} // namespace deepfilter
@@ -0,0 +1,177 @@
+#include "PlayoutBuffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace deepfilter {
+
+// 缓冲深度平滑的时间常数（秒）：滤掉按hop写入造成的锯齿，只保留长期趋势
+static const double FILL_SMOOTHING_SECONDS = 0.5;
+
+// PI控制器增益（误差以秒计）：临界阻尼，闭环时间常数约10秒，
+// 100ppm偏差在仅有比例项时对应0.5ms的稳态误差，由积分项消除
+static const double CONTROL_KP = 0.2;
+static const double CONTROL_KI = CONTROL_KP * CONTROL_KP / 4.0;
+
+PlayoutBuffer::PlayoutBuffer()
+    : capacity_(0)
+    , mask_(0)
+    , channels_(1)
+    , targetFrames_(0)
+    , sampleRate_(48000.0)
+    , maxCorrection_(0.001)
+    , writePos_(0)
+    , readPos_(0)
+    , priming_(true)
+    , fraction_(0.0)
+    , smoothedFill_(0.0)
+    , integral_(0.0)
+    , renderedFrames_(0)
+    , underruns_(0)
+    , silentFrames_(0)
+    , overflowFrames_(0)
+    , correctionPpm_(0) {
+}
+
+bool PlayoutBuffer::init(int32_t sampleRate, int32_t channelCount, size_t targetFrames,
+                         size_t capacityFrames, double maxCorrectionPpm) {
+    if (sampleRate <= 0 || channelCount <= 0 || targetFrames == 0 ||
+        capacityFrames <= targetFrames || !(maxCorrectionPpm >= 0.0 && maxCorrectionPpm <= 10000.0)) {
+        return false;
+    }
+
+    size_t capacity = 1;
+    while (capacity < capacityFrames) {
+        capacity <<= 1;
+    }
+
+    capacity_ = capacity;
+    mask_ = capacity - 1;
+    channels_ = static_cast<size_t>(channelCount);
+    targetFrames_ = targetFrames;
+    sampleRate_ = static_cast<double>(sampleRate);
+    maxCorrection_ = maxCorrectionPpm * 1e-6;
+    buffer_.assign(capacity_ * channels_, 0.0f);
+    reset();
+    return true;
+}
+
+void PlayoutBuffer::reset() {
+    writePos_.store(0, std::memory_order_relaxed);
+    readPos_.store(0, std::memory_order_relaxed);
+    priming_ = true;
+    fraction_ = 0.0;
+    smoothedFill_ = 0.0;
+    integral_ = 0.0;
+    renderedFrames_.store(0, std::memory_order_relaxed);
+    underruns_.store(0, std::memory_order_relaxed);
+    silentFrames_.store(0, std::memory_order_relaxed);
+    overflowFrames_.store(0, std::memory_order_relaxed);
+    correctionPpm_.store(0, std::memory_order_relaxed);
+}
+
+size_t PlayoutBuffer::write(const float* data, size_t numFrames) {
+    if (capacity_ == 0) {
+        return 0;
+    }
+
+    const uint64_t write = writePos_.load(std::memory_order_relaxed);
+    const uint64_t read = readPos_.load(std::memory_order_acquire);
+    const size_t space = capacity_ - static_cast<size_t>(write - read);
+    const size_t count = std::min(numFrames, space);
+    if (count < numFrames) {
+        overflowFrames_.fetch_add(numFrames - count, std::memory_order_relaxed);
+    }
+
+    // 最多分两段复制（跨越缓冲区末尾）
+    const size_t start = static_cast<size_t>(write & mask_);
+    const size_t first = std::min(count, capacity_ - start);
+    memcpy(buffer_.data() + start * channels_, data, first * channels_ * sizeof(float));
+    if (count > first) {
+        memcpy(buffer_.data(), data + first * channels_, (count - first) * channels_ * sizeof(float));
+    }
+
+    writePos_.store(write + count, std::memory_order_release);
+    return count;
+}
+
+void PlayoutBuffer::render(float* output, size_t numFrames) {
+    if (numFrames == 0) {
+        return;
+    }
+    renderedFrames_.fetch_add(numFrames, std::memory_order_relaxed);
+
+    const uint64_t read = readPos_.load(std::memory_order_relaxed);
+    const uint64_t write = writePos_.load(std::memory_order_acquire);
+    const size_t available = static_cast<size_t>(write - read);
+
+    // 预缓冲：攒到目标深度再开始播放，之前输出静音
+    if (priming_) {
+        if (capacity_ == 0 || available < targetFrames_) {
+            memset(output, 0, numFrames * channels_ * sizeof(float));
+            silentFrames_.fetch_add(numFrames, std::memory_order_relaxed);
+            return;
+        }
+        priming_ = false;
+        fraction_ = 0.0;
+        smoothedFill_ = static_cast<double>(available);
+    }
+
+    // 按平滑后的缓冲深度与目标之差调整读取速率（积分项限幅，防止饱和后继续累积）
+    const double dt = static_cast<double>(numFrames) / sampleRate_;
+    smoothedFill_ += (static_cast<double>(available) - smoothedFill_) * dt / (FILL_SMOOTHING_SECONDS + dt);
+    const double error = (smoothedFill_ - static_cast<double>(targetFrames_)) / sampleRate_;
+    integral_ = std::max(-maxCorrection_, std::min(maxCorrection_, integral_ + CONTROL_KI * error * dt));
+    const double correction = std::max(-maxCorrection_, std::min(maxCorrection_, CONTROL_KP * error + integral_));
+    correctionPpm_.store(static_cast<int32_t>(std::lround(correction * 1e6)), std::memory_order_relaxed);
+
+    // 最后一个输出帧插值需要的两个输入帧都必须已写入；否则欠载，补零后重新预缓冲
+    const double step = 1.0 + correction;
+    const size_t needed = static_cast<size_t>(fraction_ + step * static_cast<double>(numFrames - 1)) + 2;
+    if (needed > available) {
+        memset(output, 0, numFrames * channels_ * sizeof(float));
+        underruns_.fetch_add(1, std::memory_order_relaxed);
+        silentFrames_.fetch_add(numFrames, std::memory_order_relaxed);
+        priming_ = true;
+        return;
+    }
+
+    // 线性插值；修正量为0且没有小数部分时等价于直接复制
+    const float* buffer = buffer_.data();
+    double position = fraction_;
+    for (size_t i = 0; i < numFrames; i++) {
+        const size_t index = static_cast<size_t>(position);
+        const float weight = static_cast<float>(position - static_cast<double>(index));
+        const float* a = buffer + static_cast<size_t>((read + index) & mask_) * channels_;
+        const float* b = buffer + static_cast<size_t>((read + index + 1) & mask_) * channels_;
+        for (size_t c = 0; c < channels_; c++) {
+            output[i * channels_ + c] = a[c] + (b[c] - a[c]) * weight;
+        }
+        position += step;
+    }
+
+    const size_t advance = static_cast<size_t>(position);
+    fraction_ = position - static_cast<double>(advance);
+    readPos_.store(read + advance, std::memory_order_release);
+}
+
+size_t PlayoutBuffer::size() const {
+    const uint64_t read = readPos_.load(std::memory_order_acquire);
+    const uint64_t write = writePos_.load(std::memory_order_acquire);
+    return static_cast<size_t>(write - read);
+}
+
+PlayoutBufferStats PlayoutBuffer::getStats() const {
+    PlayoutBufferStats stats;
+    stats.writtenFrames = writePos_.load(std::memory_order_relaxed);
+    stats.renderedFrames = renderedFrames_.load(std::memory_order_relaxed);
+    stats.underruns = underruns_.load(std::memory_order_relaxed);
+    stats.silentFrames = silentFrames_.load(std::memory_order_relaxed);
+    stats.overflowFrames = overflowFrames_.load(std::memory_order_relaxed);
+    stats.fillFrames = static_cast<int32_t>(size());
+    stats.targetFrames = static_cast<int32_t>(targetFrames_);
+    stats.correctionPpm = correctionPpm_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace deepfilter
@@ -0,0 +1,76 @@
+#include "PushAudioSource.h"
+#include <cstdio>
+#include <cstring>
+
+namespace deepfilter {
+
+PushAudioSource::PushAudioSource()
+    : dataCallback_(nullptr)
+    , userData_(nullptr)
+    , opened_(false)
+    , running_(false) {
+    memset(lastError_, 0, sizeof(lastError_));
+}
+
+PushAudioSource::~PushAudioSource() {
+    close();
+}
+
+bool PushAudioSource::open(const AudioSourceConfig& config,
+                           DataCallback dataCallback,
+                           ErrorCallback /*errorCallback*/,
+                           void* userData) {
+    if (dataCallback == nullptr || config.sampleRate < 0 || config.channelCount <= 0) {
+        snprintf(lastError_, sizeof(lastError_), "音频源参数无效");
+        return false;
+    }
+
+    close();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    if (config_.sampleRate <= 0) {
+        config_.sampleRate = 48000;
+    }
+    dataCallback_ = dataCallback;
+    userData_ = userData;
+    opened_ = true;
+    return true;
+}
+
+bool PushAudioSource::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!opened_) {
+        snprintf(lastError_, sizeof(lastError_), "音频源未打开");
+        return false;
+    }
+    running_.store(true, std::memory_order_release);
+    return true;
+}
+
+bool PushAudioSource::stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_.store(false, std::memory_order_release);
+    return true;
+}
+
+void PushAudioSource::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_.store(false, std::memory_order_release);
+    opened_ = false;
+    dataCallback_ = nullptr;
+    userData_ = nullptr;
+}
+
+bool PushAudioSource::push(const float* samples, int32_t numFrames) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if (numFrames > 0) {
+        dataCallback_(userData_, samples, numFrames);
+    }
+    return true;
+}
+
+} // namespace deepfilter
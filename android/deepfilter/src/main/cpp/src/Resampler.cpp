@@ -0,0 +1,242 @@
+#include "Resampler.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define DF_RESAMPLER_NEON 1
+#elif defined(__SSE__) || defined(__x86_64__)
+#include <xmmintrin.h>
+#define DF_RESAMPLER_SSE 1
+#endif
+
+namespace deepfilter {
+
+namespace {
+
+// 相位数上限（采样率互质部分过大时拒绝，避免系数表过大）
+const uint32_t MAX_PHASES = 4096;
+
+// Kaiser窗参数（约80dB阻带衰减）
+const double KAISER_BETA = 8.0;
+
+// 截止频率相对于较低奈奎斯特频率的比例
+const double ROLLOFF = 0.9;
+
+uint32_t gcd(uint32_t a, uint32_t b) {
+    while (b != 0) {
+        const uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// 第一类零阶修正贝塞尔函数（级数展开）
+double besselI0(double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    const double halfX = x / 2.0;
+    for (int k = 1; k < 50; k++) {
+        term *= (halfX / k) * (halfX / k);
+        sum += term;
+        if (term < sum * 1e-12) {
+            break;
+        }
+    }
+    return sum;
+}
+
+} // namespace
+
+Resampler::Resampler()
+    : inputRate_(0)
+    , outputRate_(0)
+    , upFactor_(1)
+    , downFactor_(1)
+    , taps_(0)
+    , maxInputFrames_(0)
+    , maxOutputFrames_(0)
+    , historySize_(0)
+    , phaseTime_(0) {
+}
+
+bool Resampler::init(int32_t inputRate, int32_t outputRate, size_t maxInputFrames, size_t tapsPerPhase) {
+    if (inputRate <= 0 || outputRate <= 0 || maxInputFrames == 0) {
+        return false;
+    }
+
+    const uint32_t divisor = gcd(static_cast<uint32_t>(inputRate), static_cast<uint32_t>(outputRate));
+    const uint32_t up = static_cast<uint32_t>(outputRate) / divisor;
+    const uint32_t down = static_cast<uint32_t>(inputRate) / divisor;
+    if (up > MAX_PHASES) {
+        return false;
+    }
+
+    inputRate_ = inputRate;
+    outputRate_ = outputRate;
+    upFactor_ = up;
+    downFactor_ = down;
+    maxInputFrames_ = maxInputFrames;
+
+    if (isPassthrough()) {
+        taps_ = 0;
+        maxOutputFrames_ = maxInputFrames;
+        coefficients_.clear();
+        history_.clear();
+        reset();
+        return true;
+    }
+
+    // 抽头数向上取整到4的倍数，便于向量化
+    taps_ = (tapsPerPhase < 8 ? 8 : tapsPerPhase + 3) & ~static_cast<size_t>(3);
+    maxOutputFrames_ = maxInputFrames * up / down + 2;
+
+    // 原型低通滤波器（工作在L倍上采样率下），增益为L以补偿插零
+    const size_t length = taps_ * up;
+    const double cutoff = ROLLOFF * 0.5 / static_cast<double>(up > down ? up : down);
+    const double center = (static_cast<double>(length) - 1.0) / 2.0;
+    const double windowNorm = besselI0(KAISER_BETA);
+    std::vector<double> prototype(length);
+    for (size_t n = 0; n < length; n++) {
+        const double t = static_cast<double>(n) - center;
+        const double x = 2.0 * cutoff * t;
+        const double sinc = std::fabs(x) < 1e-12 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+        const double ratio = 2.0 * static_cast<double>(n) / (static_cast<double>(length) - 1.0) - 1.0;
+        const double window = besselI0(KAISER_BETA * std::sqrt(std::fmax(0.0, 1.0 - ratio * ratio))) / windowNorm;
+        prototype[n] = 2.0 * cutoff * sinc * window * up;
+    }
+
+    // 拆分为L个相位，每个相位内反序存放：output = dot(coefficients[phase], history[base .. base+taps))
+    coefficients_.assign(static_cast<size_t>(up) * taps_, 0.0f);
+    for (uint32_t phase = 0; phase < up; phase++) {
+        for (size_t j = 0; j < taps_; j++) {
+            coefficients_[phase * taps_ + j] = static_cast<float>(prototype[phase + (taps_ - 1 - j) * up]);
+        }
+    }
+
+    history_.assign(taps_ - 1 + maxInputFrames, 0.0f);
+    reset();
+    return true;
+}
+
+void Resampler::reset() {
+    // 以taps-1个零作为初始历史，第一个输入即可产生输出（群延迟见getLatencyFrames）
+    if (!history_.empty()) {
+        std::fill(history_.begin(), history_.end(), 0.0f);
+    }
+    historySize_ = taps_ > 0 ? taps_ - 1 : 0;
+    phaseTime_ = 0;
+}
+
+size_t Resampler::process(const float* input, size_t numFrames, float* output) {
+    if (numFrames > maxInputFrames_) {
+        return 0;
+    }
+
+    if (isPassthrough()) {
+        if (output != input) {
+            memmove(output, input, numFrames * sizeof(float));
+        }
+        return numFrames;
+    }
+
+    memcpy(history_.data() + historySize_, input, numFrames * sizeof(float));
+    historySize_ += numFrames;
+
+    const float* history = history_.data();
+    const float* coefficients = coefficients_.data();
+    size_t produced = 0;
+    while (true) {
+        const size_t base = static_cast<size_t>(phaseTime_ / upFactor_);
+        if (base + taps_ > historySize_) {
+            break;
+        }
+        const size_t phase = static_cast<size_t>(phaseTime_ % upFactor_);
+        output[produced++] = dot(coefficients + phase * taps_, history + base, taps_);
+        phaseTime_ += downFactor_;
+    }
+
+    // 丢弃之后不再需要的历史采样
+    const size_t consumed = static_cast<size_t>(phaseTime_ / upFactor_);
+    if (consumed >= historySize_) {
+        phaseTime_ -= static_cast<uint64_t>(historySize_) * upFactor_;
+        historySize_ = 0;
+    } else if (consumed > 0) {
+        memmove(history_.data(), history_.data() + consumed, (historySize_ - consumed) * sizeof(float));
+        historySize_ -= consumed;
+        phaseTime_ -= static_cast<uint64_t>(consumed) * upFactor_;
+    }
+    return produced;
+}
+
+double Resampler::getLatencyFrames() const {
+    if (isPassthrough()) {
+        return 0.0;
+    }
+    // 原型滤波器群延迟 (N-1)/2 个上采样点，换算为输出采样
+    return (static_cast<double>(taps_ * upFactor_) - 1.0) / (2.0 * downFactor_);
+}
+
+int64_t Resampler::getLatencyUs() const {
+    if (outputRate_ <= 0) {
+        return 0;
+    }
+    return static_cast<int64_t>(std::llround(getLatencyFrames() * 1e6 / outputRate_));
+}
+
+const char* Resampler::simdName() {
+#if defined(DF_RESAMPLER_NEON)
+    return "NEON";
+#elif defined(DF_RESAMPLER_SSE)
+    return "SSE";
+#else
+    return "scalar";
+#endif
+}
+
+float Resampler::dot(const float* a, const float* b, size_t n) {
+#if defined(DF_RESAMPLER_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    if (i < n) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    const float32x4_t acc = vaddq_f32(acc0, acc1);
+#if defined(__aarch64__)
+    return vaddvq_f32(acc);
+#else
+    float32x2_t sum = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    sum = vpadd_f32(sum, sum);
+    return vget_lane_f32(sum, 0);
+#endif
+#elif defined(DF_RESAMPLER_SSE)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    if (i < n) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    __m128 acc = _mm_add_ps(acc0, acc1);
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 0x55));
+    return _mm_cvtss_f32(acc);
+#else
+    float sum = 0.0f;
+    for (size_t i = 0; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+#endif
+}
+
+} // namespace deepfilter
@@ -0,0 +1,308 @@
+#include "SimulatedAudio.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace deepfilter {
+
+PacedAudioSource::PacedAudioSource(double speed)
+    : speed_(speed > 0.0 ? speed : 0.0)
+    , opened_(false)
+    , dataCallback_(nullptr)
+    , userData_(nullptr)
+    , running_(false)
+    , finished_(false)
+    , deliveredFrames_(0) {
+    memset(lastError_, 0, sizeof(lastError_));
+}
+
+PacedAudioSource::~PacedAudioSource() {
+    stop();
+}
+
+bool PacedAudioSource::open(const AudioSourceConfig& config,
+                            DataCallback dataCallback,
+                            ErrorCallback /*errorCallback*/,
+                            void* userData) {
+    if (dataCallback == nullptr || config.sampleRate < 0 || config.channelCount <= 0) {
+        snprintf(lastError_, sizeof(lastError_), "音频源参数无效");
+        return false;
+    }
+
+    close();
+
+    config_ = config;
+    if (!prepare(config_)) {
+        return false;
+    }
+    if (config_.sampleRate <= 0) {
+        config_.sampleRate = 48000;
+    }
+    if (config_.framesPerCallback <= 0) {
+        config_.framesPerCallback = config_.sampleRate / 250;
+    }
+
+    dataCallback_ = dataCallback;
+    userData_ = userData;
+    buffer_.assign(static_cast<size_t>(config_.framesPerCallback) * config_.channelCount, 0.0f);
+    opened_ = true;
+    return true;
+}
+
+bool PacedAudioSource::start() {
+    if (!opened_) {
+        snprintf(lastError_, sizeof(lastError_), "音频源未打开");
+        return false;
+    }
+    if (thread_.joinable()) {
+        return true;
+    }
+
+    finished_.store(false, std::memory_order_relaxed);
+    running_.store(true, std::memory_order_relaxed);
+    thread_ = std::thread(&PacedAudioSource::threadFunc, this);
+    return true;
+}
+
+bool PacedAudioSource::stop() {
+    running_.store(false, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    return true;
+}
+
+void PacedAudioSource::close() {
+    stop();
+    opened_ = false;
+    dataCallback_ = nullptr;
+    userData_ = nullptr;
+}
+
+bool PacedAudioSource::waitUntilFinished(int64_t timeoutMs) {
+    std::unique_lock<std::mutex> lock(finishedMutex_);
+    return finishedCondition_.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                                       [this]() { return finished_.load(std::memory_order_acquire); });
+}
+
+void PacedAudioSource::threadFunc() {
+    const auto startTime = std::chrono::steady_clock::now();
+    uint64_t framesThisRun = 0;
+
+    while (running_.load(std::memory_order_relaxed)) {
+        const int32_t frames = generate(buffer_.data(), config_.framesPerCallback);
+        if (frames <= 0) {
+            break;
+        }
+
+        dataCallback_(userData_, buffer_.data(), frames);
+        framesThisRun += static_cast<uint64_t>(frames);
+        deliveredFrames_.fetch_add(static_cast<uint64_t>(frames), std::memory_order_relaxed);
+
+        if (speed_ > 0.0) {
+            // 按累计帧数计算下一次推送时刻，避免误差累积
+            const double seconds = static_cast<double>(framesThisRun) / config_.sampleRate / speed_;
+            std::this_thread::sleep_until(startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(seconds)));
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(finishedMutex_);
+        finished_.store(true, std::memory_order_release);
+    }
+    finishedCondition_.notify_all();
+}
+
+SyntheticAudioSource::SyntheticAudioSource(double speed, uint64_t totalFrames,
+                                           float frequencyHz, float noiseLevel,
+                                           int32_t nativeSampleRate)
+    : PacedAudioSource(speed)
+    , nativeSampleRate_(nativeSampleRate)
+    , totalFrames_(totalFrames)
+    , position_(0)
+    , frequencyHz_(frequencyHz)
+    , noiseLevel_(noiseLevel)
+    , noiseState_(1) {
+}
+
+bool SyntheticAudioSource::prepare(AudioSourceConfig& config) {
+    if (config.sampleRate == 0) {
+        config.sampleRate = nativeSampleRate_;
+    }
+    position_ = 0;
+    noiseState_ = 1;
+    return true;
+}
+
+int32_t SyntheticAudioSource::generate(float* buffer, int32_t numFrames) {
+    if (totalFrames_ > 0) {
+        if (position_ >= totalFrames_) {
+            return 0;
+        }
+        if (static_cast<uint64_t>(numFrames) > totalFrames_ - position_) {
+            numFrames = static_cast<int32_t>(totalFrames_ - position_);
+        }
+    }
+
+    const double phaseStep = 2.0 * M_PI * frequencyHz_ / config_.sampleRate;
+    const float toneLevel = 0.5f * (1.0f - noiseLevel_);
+    for (int32_t i = 0; i < numFrames; i++) {
+        // 线性同余噪声，结果与平台无关
+        noiseState_ = noiseState_ * 1664525u + 1013904223u;
+        const float noise = (static_cast<float>(noiseState_ >> 8) / 8388608.0f - 1.0f) * noiseLevel_;
+        const float sample = toneLevel * static_cast<float>(std::sin(phaseStep * static_cast<double>(position_ + i))) + noise;
+        for (int32_t c = 0; c < config_.channelCount; c++) {
+            buffer[i * config_.channelCount + c] = sample;
+        }
+    }
+    position_ += static_cast<uint64_t>(numFrames);
+    return numFrames;
+}
+
+FileAudioSource::FileAudioSource(const char* path, double speed, bool loop)
+    : PacedAudioSource(speed)
+    , path_(path != nullptr ? path : "")
+    , loop_(loop) {
+}
+
+bool FileAudioSource::prepare(AudioSourceConfig& config) {
+    if (config.channelCount != 1) {
+        snprintf(lastError_, sizeof(lastError_), "文件音频源只支持单声道输出");
+        return false;
+    }
+    if (!reader_.open(path_.c_str())) {
+        snprintf(lastError_, sizeof(lastError_), "%s", reader_.getLastError());
+        return false;
+    }
+    if (config.sampleRate == 0) {
+        config.sampleRate = reader_.sampleRate();
+    }
+    if (reader_.sampleRate() != config.sampleRate) {
+        snprintf(lastError_, sizeof(lastError_), "采样率不匹配: 文件%dHz，需要%dHz",
+                 reader_.sampleRate(), config.sampleRate);
+        return false;
+    }
+    return true;
+}
+
+int32_t FileAudioSource::generate(float* buffer, int32_t numFrames) {
+    size_t read = reader_.readMono(buffer, static_cast<size_t>(numFrames));
+    if (read == 0 && loop_) {
+        reader_.rewind();
+        read = reader_.readMono(buffer, static_cast<size_t>(numFrames));
+    }
+    return static_cast<int32_t>(read);
+}
+
+PacedAudioOutput::PacedAudioOutput(double speed, double clockSkewPpm, size_t recordFrames)
+    : speed_(speed > 0.0 ? speed : 0.0)
+    , clockSkewPpm_(clockSkewPpm)
+    , recordFrames_(recordFrames)
+    , opened_(false)
+    , renderCallback_(nullptr)
+    , userData_(nullptr)
+    , running_(false)
+    , renderedFrames_(0) {
+    memset(lastError_, 0, sizeof(lastError_));
+}
+
+PacedAudioOutput::~PacedAudioOutput() {
+    stop();
+}
+
+bool PacedAudioOutput::open(const AudioSourceConfig& config,
+                            RenderCallback renderCallback,
+                            ErrorCallback /*errorCallback*/,
+                            void* userData) {
+    if (renderCallback == nullptr || config.sampleRate < 0 || config.channelCount <= 0) {
+        snprintf(lastError_, sizeof(lastError_), "输出流参数无效");
+        return false;
+    }
+
+    close();
+
+    config_ = config;
+    if (config_.sampleRate <= 0) {
+        config_.sampleRate = 48000;
+    }
+    if (config_.framesPerCallback <= 0) {
+        config_.framesPerCallback = config_.sampleRate / 250;
+    }
+
+    renderCallback_ = renderCallback;
+    userData_ = userData;
+    buffer_.assign(static_cast<size_t>(config_.framesPerCallback) * config_.channelCount, 0.0f);
+    recording_.clear();
+    recording_.reserve(recordFrames_ * config_.channelCount);
+    opened_ = true;
+    return true;
+}
+
+bool PacedAudioOutput::start() {
+    if (!opened_) {
+        snprintf(lastError_, sizeof(lastError_), "输出流未打开");
+        return false;
+    }
+    if (thread_.joinable()) {
+        return true;
+    }
+
+    running_.store(true, std::memory_order_relaxed);
+    thread_ = std::thread(&PacedAudioOutput::threadFunc, this);
+    return true;
+}
+
+bool PacedAudioOutput::stop() {
+    running_.store(false, std::memory_order_relaxed);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    return true;
+}
+
+void PacedAudioOutput::close() {
+    stop();
+    opened_ = false;
+    renderCallback_ = nullptr;
+    userData_ = nullptr;
+}
+
+void PacedAudioOutput::threadFunc() {
+    const auto startTime = std::chrono::steady_clock::now();
+    const double rate = config_.sampleRate * (1.0 + clockSkewPpm_ * 1e-6) * speed_;
+    const size_t channels = static_cast<size_t>(config_.channelCount);
+    uint64_t framesThisRun = 0;
+
+    while (running_.load(std::memory_order_relaxed)) {
+        renderCallback_(userData_, buffer_.data(), config_.framesPerCallback);
+        framesThisRun += static_cast<uint64_t>(config_.framesPerCallback);
+        renderedFrames_.fetch_add(static_cast<uint64_t>(config_.framesPerCallback), std::memory_order_relaxed);
+
+        const size_t recordSamples = recordFrames_ * channels;
+        if (recording_.size() < recordSamples) {
+            const size_t count = std::min(buffer_.size(), recordSamples - recording_.size());
+            recording_.insert(recording_.end(), buffer_.begin(), buffer_.begin() + static_cast<std::ptrdiff_t>(count));
+        }
+
+        if (speed_ > 0.0) {
+            const double seconds = static_cast<double>(framesThisRun) / rate;
+            std::this_thread::sleep_until(startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(seconds)));
+        }
+    }
+}
+
+void NullAudioSink::write(const float* audioData, int32_t numFrames, float /*lsnr*/) {
+    uint32_t bits = 0;
+    if (numFrames > 0) {
+        memcpy(&bits, audioData, sizeof(bits));
+    }
+    writes_.fetch_add(1, std::memory_order_relaxed);
+    frames_.fetch_add(static_cast<uint64_t>(numFrames), std::memory_order_relaxed);
+    checksum_.fetch_add(bits, std::memory_order_relaxed);
+}
+
+} // namespace deepfilter
@@ -0,0 +1,435 @@
+#include "StreamEngine.h"
+#include "deepfilter_ort.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace deepfilter {
+
+namespace {
+
+const int32_t SAMPLE_RATE = 48000;
+
+// 单hop耗时滑动平均的权重（1/16）
+const int64_t HOP_COST_EWMA_SHIFT = 4;
+
+} // namespace
+
+StreamEngine::StreamEngine()
+    : model_(nullptr)
+    , postFilterBeta_(0.0f)
+    , attenLimDb_(100.0f)
+    , frameSize_(0)
+    , workerCount_(0)
+    , semaphoreInitialized_(false)
+    , running_(false)
+    , activeStreams_(0)
+    , processedHops_(0)
+    , steals_(0)
+    , rejectedStreams_(0)
+    , hopCostNs_(0) {
+    memset(lastError_, 0, sizeof(lastError_));
+}
+
+StreamEngine::~StreamEngine() {
+    release();
+}
+
+bool StreamEngine::initialize(
+    const uint8_t* tarBytes,
+    size_t tarBytesSize,
+    float postFilterBeta,
+    float attenLimDb,
+    const StreamEngineConfig& config) {
+
+    if (tarBytes == nullptr || tarBytesSize == 0) {
+        snprintf(lastError_, sizeof(lastError_), "模型文件字节数组为空");
+        return false;
+    }
+    if (config.maxStreams == 0 || config.queueHops == 0 || config.maxHopsPerTurn == 0) {
+        snprintf(lastError_, sizeof(lastError_), "引擎配置无效");
+        return false;
+    }
+
+    release();
+
+    // 模型只解压解析一次，之后每路流只创建运行时状态
+    model_ = df_model_load(tarBytes, tarBytesSize);
+    if (model_ == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "加载DeepFilterNet模型失败");
+        return false;
+    }
+
+    // 创建一个探测实例：校验模型并获取hop大小
+    void* probe = df_create_from_model(model_, postFilterBeta, attenLimDb);
+    if (probe == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "创建DeepFilterNet实例失败");
+        release();
+        return false;
+    }
+    frameSize_ = df_get_frame_size(probe);
+    df_destroy(probe);
+    if (frameSize_ == 0) {
+        snprintf(lastError_, sizeof(lastError_), "无效的帧大小");
+        release();
+        return false;
+    }
+
+    postFilterBeta_ = postFilterBeta;
+    attenLimDb_ = attenLimDb;
+    config_ = config;
+
+    workerCount_ = config.workerCount;
+    if (workerCount_ == 0) {
+        workerCount_ = std::thread::hardware_concurrency();
+        if (workerCount_ == 0) {
+            workerCount_ = 1;
+        }
+    }
+
+    streams_.reset(new Stream[config_.maxStreams]);
+    for (size_t i = 0; i < config_.maxStreams; i++) {
+        streams_[i].id = static_cast<int32_t>(i);
+    }
+
+    if (sem_init(&workSemaphore_, 0, 0) != 0) {
+        snprintf(lastError_, sizeof(lastError_), "初始化任务信号量失败");
+        release();
+        return false;
+    }
+    semaphoreInitialized_ = true;
+
+    workers_.reset(new Worker[workerCount_]);
+    running_ = true;
+    for (size_t i = 0; i < workerCount_; i++) {
+        Worker& worker = workers_[i];
+        worker.input.assign(frameSize_, 0.0f);
+        worker.output.assign(frameSize_, 0.0f);
+        worker.frame.data = worker.input.data();
+        worker.frame.numFrames = 0;
+        worker.frame.timestamp = 0;
+        worker.thread = std::thread(&StreamEngine::workerLoop, this, i);
+    }
+
+    return true;
+}
+
+void StreamEngine::release() {
+    if (workers_ != nullptr) {
+        running_ = false;
+        for (size_t i = 0; i < workerCount_; i++) {
+            sem_post(&workSemaphore_);
+        }
+        for (size_t i = 0; i < workerCount_; i++) {
+            if (workers_[i].thread.joinable()) {
+                workers_[i].thread.join();
+            }
+        }
+        workers_.reset();
+    }
+
+    // 工作线程已全部退出，可以直接释放流
+    if (streams_ != nullptr) {
+        for (size_t i = 0; i < config_.maxStreams; i++) {
+            Stream& stream = streams_[i];
+            if (stream.dfState != nullptr) {
+                df_destroy(stream.dfState);
+                stream.dfState = nullptr;
+            }
+        }
+        streams_.reset();
+    }
+
+    if (semaphoreInitialized_) {
+        sem_destroy(&workSemaphore_);
+        semaphoreInitialized_ = false;
+    }
+
+    if (model_ != nullptr) {
+        df_model_free(model_);
+        model_ = nullptr;
+    }
+
+    workerCount_ = 0;
+    activeStreams_ = 0;
+}
+
+int32_t StreamEngine::createStream(StreamCallback callback) {
+    if (!running_) {
+        snprintf(lastError_, sizeof(lastError_), "引擎未初始化");
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+
+    if (!canAdmit()) {
+        rejectedStreams_.fetch_add(1, std::memory_order_relaxed);
+        snprintf(lastError_, sizeof(lastError_), "准入控制拒绝: 当前%zu路流已接近处理能力上限",
+                 activeStreams_.load());
+        return -1;
+    }
+
+    Stream* stream = nullptr;
+    for (size_t i = 0; i < config_.maxStreams; i++) {
+        if (streams_[i].state.load(std::memory_order_acquire) == STREAM_FREE) {
+            stream = &streams_[i];
+            break;
+        }
+    }
+    if (stream == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "流槽位已用尽（最大%zu路）", config_.maxStreams);
+        return -1;
+    }
+
+    stream->dfState = df_create_from_model(model_, postFilterBeta_, attenLimDb_);
+    if (stream->dfState == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "创建DeepFilterNet实例失败");
+        return -1;
+    }
+
+    // 服务端保证已入队数据完整，队列满时丢弃新到达的hop并计数
+    if (!stream->input.init(frameSize_, config_.queueHops, OverflowPolicy::DROP_NEWEST)) {
+        df_destroy(stream->dfState);
+        stream->dfState = nullptr;
+        snprintf(lastError_, sizeof(lastError_), "分配流输入队列失败");
+        return -1;
+    }
+
+    stream->callback = std::move(callback);
+    stream->reblocker.init(frameSize_);
+    stream->hopIndex = 0;
+    stream->processedHops = 0;
+    stream->failedHops = 0;
+    stream->deadlineMisses = 0;
+    stream->totalLatencyUs = 0;
+    stream->maxLatencyUs = 0;
+    stream->scheduled.store(false, std::memory_order_relaxed);
+    stream->state.store(STREAM_ACTIVE, std::memory_order_release);
+
+    activeStreams_.fetch_add(1, std::memory_order_relaxed);
+    return stream->id;
+}
+
+void StreamEngine::destroyStream(int32_t streamId) {
+    Stream* stream = lookup(streamId);
+    if (stream == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(streamsMutex_);
+
+    int32_t expected = STREAM_ACTIVE;
+    if (!stream->state.compare_exchange_strong(expected, STREAM_CLOSING)) {
+        return;
+    }
+
+    // 等待已通过状态检查的pushAudio返回：之后的写入都会看到CLOSING，不再访问reblocker和输入队列
+    while (stream->pushers.load() != 0) {
+        std::this_thread::yield();
+    }
+
+    // 抢占调度标志：成功后该流不在任何队列中，也没有工作线程在处理它
+    bool scheduled = false;
+    while (!stream->scheduled.compare_exchange_weak(scheduled, true, std::memory_order_acq_rel)) {
+        scheduled = false;
+        std::this_thread::yield();
+    }
+
+    df_destroy(stream->dfState);
+    stream->dfState = nullptr;
+    stream->input.release();
+    stream->callback = nullptr;
+    stream->scheduled.store(false, std::memory_order_relaxed);
+    stream->state.store(STREAM_FREE, std::memory_order_release);
+
+    activeStreams_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+int32_t StreamEngine::pushAudio(int32_t streamId, const float* data, size_t numFrames) {
+    Stream* stream = lookup(streamId);
+    if (stream == nullptr || data == nullptr) {
+        return -1;
+    }
+
+    // 先登记再检查状态（均为顺序一致），与destroyStream先改状态再等待登记数归零配对
+    stream->pushers.fetch_add(1);
+    if (stream->state.load() != STREAM_ACTIVE) {
+        stream->pushers.fetch_sub(1, std::memory_order_release);
+        return -1;
+    }
+
+    const int64_t now = nowNs();
+    int32_t queued = 0;
+
+    // 按hop重新分块，不足一个hop的部分留到下次写入
+    stream->reblocker.write(data, numFrames, [&](const float* hop) {
+        if (stream->input.push(hop, static_cast<int32_t>(frameSize_), now)) {
+            queued++;
+        }
+    });
+
+    if (queued > 0) {
+        // 优先放入固定的工作线程队列以保持缓存局部性，其他线程空闲时会窃取
+        schedule(stream, static_cast<size_t>(streamId) % workerCount_);
+    }
+    stream->pushers.fetch_sub(1, std::memory_order_release);
+    return queued;
+}
+
+void StreamEngine::schedule(Stream* stream, size_t preferredWorker) {
+    bool expected = false;
+    if (!stream->scheduled.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    Worker& worker = workers_[preferredWorker];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(stream);
+    }
+    sem_post(&workSemaphore_);
+}
+
+StreamEngine::Stream* StreamEngine::takeTask(size_t workerIndex) {
+    {
+        Worker& own = workers_[workerIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            Stream* stream = own.tasks.front();
+            own.tasks.pop_front();
+            return stream;
+        }
+    }
+
+    for (size_t i = 1; i < workerCount_; i++) {
+        Worker& victim = workers_[(workerIndex + i) % workerCount_];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            Stream* stream = victim.tasks.back();
+            victim.tasks.pop_back();
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return stream;
+        }
+    }
+
+    return nullptr;
+}
+
+void StreamEngine::workerLoop(size_t workerIndex) {
+    Worker& worker = workers_[workerIndex];
+
+    while (running_) {
+        Stream* stream = takeTask(workerIndex);
+        if (stream != nullptr) {
+            runStream(worker, stream);
+            continue;
+        }
+        sem_wait(&workSemaphore_);
+    }
+}
+
+void StreamEngine::runStream(Worker& worker, Stream* stream) {
+    if (stream->state.load(std::memory_order_acquire) == STREAM_ACTIVE) {
+        for (size_t i = 0; i < config_.maxHopsPerTurn; i++) {
+            if (!stream->input.pop(&worker.frame)) {
+                break;
+            }
+
+            const int64_t start = nowNs();
+            const float lsnr = df_process_frame(stream->dfState, worker.frame.data, worker.output.data(),
+                                                static_cast<size_t>(worker.frame.numFrames));
+            const int64_t cost = nowNs() - start;
+
+            // 滑动平均无需精确，多线程并发更新时允许丢失个别样本
+            const int64_t previous = hopCostNs_.load(std::memory_order_relaxed);
+            hopCostNs_.store(previous == 0 ? cost : previous + ((cost - previous) >> HOP_COST_EWMA_SHIFT),
+                             std::memory_order_relaxed);
+
+            // LSNR在噪声较大时本身为负，只有NaN表示处理出错
+            if (std::isnan(lsnr)) {
+                stream->failedHops.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            if (stream->callback != nullptr) {
+                stream->callback(stream->id, stream->hopIndex, worker.output.data(), worker.frame.numFrames, lsnr);
+            }
+            stream->hopIndex++;
+
+            const int64_t latencyUs = (nowNs() - worker.frame.timestamp) / 1000;
+            stream->totalLatencyUs.fetch_add(latencyUs, std::memory_order_relaxed);
+            if (latencyUs > stream->maxLatencyUs.load(std::memory_order_relaxed)) {
+                stream->maxLatencyUs.store(latencyUs, std::memory_order_relaxed);
+            }
+            if (latencyUs > config_.deadlineUs) {
+                stream->deadlineMisses.fetch_add(1, std::memory_order_relaxed);
+            }
+            stream->processedHops.fetch_add(1, std::memory_order_relaxed);
+            processedHops_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // 释放调度标志后再检查一次，避免生产者在处理期间写入的数据无人调度
+    stream->scheduled.store(false, std::memory_order_release);
+    if (stream->state.load(std::memory_order_acquire) == STREAM_ACTIVE && stream->input.size() > 0) {
+        // 放回本线程队列尾部，让同队列的其他流先处理
+        schedule(stream, static_cast<size_t>(&worker - workers_.get()));
+    }
+}
+
+bool StreamEngine::canAdmit() const {
+    const int64_t hopCost = hopCostNs_.load(std::memory_order_relaxed);
+    if (hopCost <= 0) {
+        // 尚无实测数据，只受槽位数限制
+        return true;
+    }
+
+    const double hopPeriodNs = static_cast<double>(frameSize_) * 1e9 / SAMPLE_RATE;
+    const double capacity = static_cast<double>(workerCount_) * hopPeriodNs * config_.maxUtilization /
+                            static_cast<double>(hopCost);
+    return static_cast<double>(activeStreams_.load(std::memory_order_relaxed) + 1) <= capacity;
+}
+
+StreamEngine::Stream* StreamEngine::lookup(int32_t streamId) const {
+    if (streams_ == nullptr || streamId < 0 || static_cast<size_t>(streamId) >= config_.maxStreams) {
+        return nullptr;
+    }
+    return &streams_[static_cast<size_t>(streamId)];
+}
+
+bool StreamEngine::getStreamStats(int32_t streamId, StreamStats* stats) const {
+    Stream* stream = lookup(streamId);
+    if (stream == nullptr || stats == nullptr ||
+        stream->state.load(std::memory_order_acquire) != STREAM_ACTIVE) {
+        return false;
+    }
+
+    stats->processedHops = stream->processedHops.load(std::memory_order_relaxed);
+    stats->droppedHops = stream->input.getDroppedCount();
+    stats->failedHops = stream->failedHops.load(std::memory_order_relaxed);
+    stats->deadlineMisses = stream->deadlineMisses.load(std::memory_order_relaxed);
+    stats->maxLatencyUs = stream->maxLatencyUs.load(std::memory_order_relaxed);
+    stats->avgLatencyUs = stats->processedHops > 0
+        ? stream->totalLatencyUs.load(std::memory_order_relaxed) / static_cast<int64_t>(stats->processedHops)
+        : 0;
+    return true;
+}
+
+StreamEngineStats StreamEngine::getStats() const {
+    StreamEngineStats stats;
+    stats.workerCount = workerCount_;
+    stats.activeStreams = activeStreams_.load(std::memory_order_relaxed);
+    stats.processedHops = processedHops_.load(std::memory_order_relaxed);
+    stats.steals = steals_.load(std::memory_order_relaxed);
+    stats.rejectedStreams = rejectedStreams_.load(std::memory_order_relaxed);
+    stats.hopCostNs = hopCostNs_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+int64_t StreamEngine::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace deepfilter
@@ -0,0 +1,270 @@
+#include "ThreadScheduling.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+
+#define LOG_TAG "ThreadScheduler"
+#include "NativeLog.h"
+
+namespace deepfilter {
+
+ThreadScheduler::ThreadScheduler()
+    : baseMask_(0)
+    , boostMask_(0)
+    , performanceMask_(0)
+    , originalMask_(0)
+    , originalNice_(0)
+    , calmHops_(0)
+    , unknownCoreHops_(0)
+    , performanceCoreHops_(0)
+    , boosts_(0)
+    , failures_(0)
+    , boosted_(false) {
+    for (auto& hops : coreHops_) {
+        hops.store(0, std::memory_order_relaxed);
+    }
+}
+
+bool ThreadScheduler::init(const ThreadSchedulingConfig& config, const CpuTopology& topology) {
+    if (config.niceValue < -20 || config.niceValue > 19 ||
+        config.fifoPriority < 1 || config.fifoPriority > 99 ||
+        config.boostQueueDepth == 0 || config.relaxHops <= 0) {
+        return false;
+    }
+    if (config.affinity == CpuAffinity::CPUSET &&
+        (config.cpuMask == 0 || (topology.cpuMask != 0 && (config.cpuMask & topology.cpuMask) == 0))) {
+        return false;
+    }
+
+    config_ = config;
+    performanceMask_ = topology.performanceMask;
+    switch (config.affinity) {
+    case CpuAffinity::NONE:
+        baseMask_ = 0;
+        break;
+    case CpuAffinity::PERFORMANCE_CORES:
+        baseMask_ = topology.performanceMask;
+        break;
+    case CpuAffinity::CPUSET:
+        baseMask_ = config.cpuMask;
+        break;
+    }
+    // 提升时绑定性能核心；拓扑未知时保持基础亲和性
+    boostMask_ = topology.performanceMask != 0 ? topology.performanceMask : baseMask_;
+
+    reset();
+    return true;
+}
+
+void ThreadScheduler::reset() {
+    calmHops_ = 0;
+    for (auto& hops : coreHops_) {
+        hops.store(0, std::memory_order_relaxed);
+    }
+    unknownCoreHops_.store(0, std::memory_order_relaxed);
+    performanceCoreHops_.store(0, std::memory_order_relaxed);
+    boosts_.store(0, std::memory_order_relaxed);
+    failures_.store(0, std::memory_order_relaxed);
+    boosted_.store(false, std::memory_order_relaxed);
+}
+
+bool ThreadScheduler::applyPriority(ThreadPriority priority, int32_t niceValue) {
+    if (priority == ThreadPriority::FIFO) {
+        sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = config_.fifoPriority;
+        const int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (result == 0) {
+            return true;
+        }
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        LOGW("设置SCHED_FIFO失败（%s），改用nice=%d", strerror(result), niceValue);
+    } else if (priority == ThreadPriority::DEFAULT) {
+        return true;
+    }
+
+    // 从FIFO恢复时先回到SCHED_OTHER；Linux的nice值按线程生效（who=0即调用线程）
+    int policy = SCHED_OTHER;
+    sched_param param;
+    memset(&param, 0, sizeof(param));
+    if (pthread_getschedparam(pthread_self(), &policy, &param) == 0 && policy != SCHED_OTHER) {
+        memset(&param, 0, sizeof(param));
+        pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+    }
+    if (setpriority(PRIO_PROCESS, 0, niceValue) != 0) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        LOGW("设置nice=%d失败: %s", niceValue, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool ThreadScheduler::applyAffinity(uint64_t mask) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int32_t cpu = 0; cpu < CpuTopology::MAX_CPUS; cpu++) {
+        if ((mask >> cpu) & 1u) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        failures_.fetch_add(1, std::memory_order_relaxed);
+        LOGW("设置CPU亲和性0x%llx失败: %s", static_cast<unsigned long long>(mask), strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void ThreadScheduler::applyLevel(bool boosted) {
+    if (boosted) {
+        applyPriority(ThreadPriority::FIFO, config_.niceValue);
+        if (boostMask_ != 0) {
+            applyAffinity(boostMask_);
+        }
+        return;
+    }
+
+    // 恢复基础设置；DEFAULT回到线程启动时的nice值和亲和性
+    if (config_.priority == ThreadPriority::DEFAULT) {
+        applyPriority(ThreadPriority::NICE, originalNice_);
+    } else {
+        applyPriority(config_.priority, config_.niceValue);
+    }
+    const uint64_t mask = baseMask_ != 0 ? baseMask_ : originalMask_;
+    if (mask != 0) {
+        applyAffinity(mask);
+    }
+}
+
+void ThreadScheduler::applyBase() {
+    // 记录线程启动时的设置，DEFAULT/NONE在积压恢复时回到这里
+    errno = 0;
+    const int nice = getpriority(PRIO_PROCESS, 0);
+    originalNice_ = errno == 0 ? nice : 0;
+    originalMask_ = 0;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int32_t cpu = 0; cpu < CpuTopology::MAX_CPUS; cpu++) {
+            if (CPU_ISSET(cpu, &set)) {
+                originalMask_ |= 1ull << cpu;
+            }
+        }
+    }
+
+    applyPriority(config_.priority, config_.niceValue);
+    if (baseMask_ != 0) {
+        applyAffinity(baseMask_);
+    }
+    LOGI("处理线程调度: 优先级=%d, nice=%d, 亲和性=0x%llx, 积压提升=%s",
+         static_cast<int>(config_.priority), config_.niceValue,
+         static_cast<unsigned long long>(baseMask_), config_.boostOnBacklog ? "是" : "否");
+}
+
+void ThreadScheduler::onHop(size_t queueDepth) {
+    const int32_t cpu = currentCpu();
+    if (cpu >= 0 && cpu < CpuTopology::MAX_CPUS) {
+        coreHops_[cpu].fetch_add(1, std::memory_order_relaxed);
+        if ((performanceMask_ >> cpu) & 1u) {
+            performanceCoreHops_.fetch_add(1, std::memory_order_relaxed);
+        }
+    } else {
+        unknownCoreHops_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (!config_.boostOnBacklog) {
+        return;
+    }
+
+    const bool boosted = boosted_.load(std::memory_order_relaxed);
+    if (!boosted) {
+        if (queueDepth >= config_.boostQueueDepth) {
+            boosted_.store(true, std::memory_order_relaxed);
+            boosts_.fetch_add(1, std::memory_order_relaxed);
+            calmHops_ = 0;
+            LOGW("队列积压%zu帧，提升处理线程调度", queueDepth);
+            applyLevel(true);
+        }
+        return;
+    }
+
+    calmHops_ = queueDepth <= 1 ? calmHops_ + 1 : 0;
+    if (calmHops_ >= config_.relaxHops) {
+        boosted_.store(false, std::memory_order_relaxed);
+        calmHops_ = 0;
+        applyLevel(false);
+    }
+}
+
+ThreadSchedulingStats ThreadScheduler::getStats() const {
+    ThreadSchedulingStats stats;
+    for (int32_t cpu = 0; cpu < CpuTopology::MAX_CPUS; cpu++) {
+        stats.coreHops[cpu] = coreHops_[cpu].load(std::memory_order_relaxed);
+    }
+    stats.unknownCoreHops = unknownCoreHops_.load(std::memory_order_relaxed);
+    stats.performanceCoreHops = performanceCoreHops_.load(std::memory_order_relaxed);
+    stats.boosts = boosts_.load(std::memory_order_relaxed);
+    stats.failures = failures_.load(std::memory_order_relaxed);
+    stats.boosted = boosted_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/**
+ * 读取sysfs中的一个无符号整数
+ */
+static bool readSysfsValue(const char* path, uint32_t* value) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        return false;
+    }
+    unsigned long parsed = 0;
+    const bool ok = fscanf(file, "%lu", &parsed) == 1;
+    fclose(file);
+    if (ok) {
+        *value = static_cast<uint32_t>(parsed);
+    }
+    return ok;
+}
+
+CpuTopology ThreadScheduler::detectTopology(const char* sysfsRoot) {
+    CpuTopology topology;
+    char path[256];
+    uint32_t lowest = 0;
+    uint32_t highest = 0;
+
+    for (int32_t cpu = 0; cpu < CpuTopology::MAX_CPUS; cpu++) {
+        // 优先使用cpufreq最大频率，部分内核只提供cpu_capacity（相对算力）
+        uint32_t value = 0;
+        snprintf(path, sizeof(path), "%s/cpu%d/cpufreq/cpuinfo_max_freq", sysfsRoot, cpu);
+        if (!readSysfsValue(path, &value)) {
+            snprintf(path, sizeof(path), "%s/cpu%d/cpu_capacity", sysfsRoot, cpu);
+            if (!readSysfsValue(path, &value)) {
+                continue;
+            }
+        }
+
+        topology.maxFreqKhz[cpu] = value;
+        topology.cpuMask |= 1ull << cpu;
+        topology.cpuCount++;
+        lowest = topology.cpuCount == 1 ? value : (value < lowest ? value : lowest);
+        highest = value > highest ? value : highest;
+    }
+
+    // 较快的核心：最大频率高于最低一档（大核+超大核）；同构时全部核心
+    for (int32_t cpu = 0; cpu < CpuTopology::MAX_CPUS; cpu++) {
+        if (((topology.cpuMask >> cpu) & 1u) &&
+            (topology.maxFreqKhz[cpu] > lowest || lowest == highest)) {
+            topology.performanceMask |= 1ull << cpu;
+        }
+    }
+    return topology;
+}
+
+int32_t ThreadScheduler::currentCpu() {
+    return static_cast<int32_t>(sched_getcpu());
+}
+
+} // namespace deepfilter
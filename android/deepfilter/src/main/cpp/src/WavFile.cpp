@@ -0,0 +1,323 @@
+#include "WavFile.h"
+#include <cstring>
+
+namespace deepfilter {
+
+namespace {
+
+const uint16_t WAVE_FORMAT_PCM = 0x0001;
+const uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+const uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+uint16_t readLe16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readLe32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+void writeLe16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+void writeLe32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    p[2] = static_cast<uint8_t>(v >> 16);
+    p[3] = static_cast<uint8_t>(v >> 24);
+}
+
+float readSample(const uint8_t* p, WavSampleFormat format) {
+    if (format == WavSampleFormat::PCM16) {
+        return static_cast<int16_t>(readLe16(p)) / 32768.0f;
+    }
+    uint32_t bits = readLe32(p);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+size_t bytesPerSample(WavSampleFormat format) {
+    return format == WavSampleFormat::PCM16 ? 2 : 4;
+}
+
+} // namespace
+
+// ===== WavReader =====
+
+WavReader::WavReader()
+    : samples_(nullptr)
+    , frameCount_(0)
+    , position_(0)
+    , sampleRate_(0)
+    , channels_(0)
+    , format_(WavSampleFormat::PCM16) {
+    memset(lastError_, 0, sizeof(lastError_));
+}
+
+WavReader::~WavReader() {
+    close();
+}
+
+bool WavReader::open(const char* path) {
+    close();
+
+    if (!file_.open(path)) {
+        snprintf(lastError_, sizeof(lastError_), "%s", file_.getLastError());
+        return false;
+    }
+
+    const uint8_t* data = file_.data();
+    const size_t size = file_.size();
+    if (size < 12 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WAVE", 4) != 0) {
+        snprintf(lastError_, sizeof(lastError_), "不是RIFF/WAVE文件: %s", path);
+        close();
+        return false;
+    }
+
+    bool haveFormat = false;
+    size_t offset = 12;
+    while (offset + 8 <= size) {
+        const uint8_t* chunk = data + offset;
+        const uint32_t chunkSize = readLe32(chunk + 4);
+        const size_t bodyOffset = offset + 8;
+
+        if (memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16 && bodyOffset + 16 <= size) {
+            const uint8_t* fmt = data + bodyOffset;
+            uint16_t formatTag = readLe16(fmt);
+            channels_ = readLe16(fmt + 2);
+            sampleRate_ = static_cast<int32_t>(readLe32(fmt + 4));
+            const uint16_t bitsPerSample = readLe16(fmt + 14);
+
+            // WAVE_FORMAT_EXTENSIBLE：真实格式位于子格式GUID的前两个字节
+            if (formatTag == WAVE_FORMAT_EXTENSIBLE && chunkSize >= 40 && bodyOffset + 26 <= size) {
+                formatTag = readLe16(fmt + 24);
+            }
+
+            if (formatTag == WAVE_FORMAT_PCM && bitsPerSample == 16) {
+                format_ = WavSampleFormat::PCM16;
+            } else if (formatTag == WAVE_FORMAT_IEEE_FLOAT && bitsPerSample == 32) {
+                format_ = WavSampleFormat::FLOAT32;
+            } else {
+                snprintf(lastError_, sizeof(lastError_),
+                         "不支持的WAV格式: formatTag=%u, bitsPerSample=%u（仅支持PCM16和PCM32F）",
+                         formatTag, bitsPerSample);
+                close();
+                return false;
+            }
+            haveFormat = true;
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            if (!haveFormat || channels_ <= 0) {
+                snprintf(lastError_, sizeof(lastError_), "data块之前缺少fmt块");
+                close();
+                return false;
+            }
+
+            // 录音中断时data块大小可能未回填，以文件实际长度为准
+            size_t dataBytes = chunkSize;
+            if (bodyOffset + dataBytes > size || dataBytes == 0) {
+                dataBytes = size - bodyOffset;
+            }
+
+            samples_ = data + bodyOffset;
+            frameCount_ = dataBytes / (bytesPerSample(format_) * static_cast<size_t>(channels_));
+            position_ = 0;
+            return true;
+        }
+
+        // 块按偶数字节对齐
+        offset = bodyOffset + chunkSize + (chunkSize & 1u);
+    }
+
+    snprintf(lastError_, sizeof(lastError_), "未找到data块: %s", path);
+    close();
+    return false;
+}
+
+void WavReader::close() {
+    file_.close();
+    samples_ = nullptr;
+    frameCount_ = 0;
+    position_ = 0;
+    sampleRate_ = 0;
+    channels_ = 0;
+}
+
+size_t WavReader::read(float* out, size_t maxFrames) {
+    if (samples_ == nullptr || out == nullptr) {
+        return 0;
+    }
+
+    const uint64_t remaining = frameCount_ - position_;
+    const size_t frames = remaining < maxFrames ? static_cast<size_t>(remaining) : maxFrames;
+    const size_t sampleBytes = bytesPerSample(format_);
+    const size_t count = frames * static_cast<size_t>(channels_);
+    const uint8_t* src = samples_ + position_ * static_cast<uint64_t>(channels_) * sampleBytes;
+
+    for (size_t i = 0; i < count; i++) {
+        out[i] = readSample(src + i * sampleBytes, format_);
+    }
+
+    position_ += frames;
+    return frames;
+}
+
+size_t WavReader::readMono(float* out, size_t maxFrames) {
+    if (channels_ == 1) {
+        return read(out, maxFrames);
+    }
+    if (samples_ == nullptr || out == nullptr) {
+        return 0;
+    }
+
+    const uint64_t remaining = frameCount_ - position_;
+    const size_t frames = remaining < maxFrames ? static_cast<size_t>(remaining) : maxFrames;
+    const size_t sampleBytes = bytesPerSample(format_);
+    const size_t channels = static_cast<size_t>(channels_);
+    const float scale = 1.0f / static_cast<float>(channels);
+    const uint8_t* src = samples_ + position_ * channels * sampleBytes;
+
+    for (size_t i = 0; i < frames; i++) {
+        float sum = 0.0f;
+        for (size_t ch = 0; ch < channels; ch++) {
+            sum += readSample(src + (i * channels + ch) * sampleBytes, format_);
+        }
+        out[i] = sum * scale;
+    }
+
+    position_ += frames;
+    return frames;
+}
+
+void WavReader::rewind() {
+    position_ = 0;
+}
+
+// ===== WavWriter =====
+
+WavWriter::WavWriter()
+    : file_(nullptr)
+    , sampleRate_(0)
+    , channels_(0)
+    , format_(WavSampleFormat::PCM16)
+    , framesWritten_(0) {
+    memset(lastError_, 0, sizeof(lastError_));
+}
+
+WavWriter::~WavWriter() {
+    close();
+}
+
+bool WavWriter::open(const char* path, int32_t sampleRate, int32_t channels, WavSampleFormat format) {
+    close();
+
+    if (path == nullptr || sampleRate <= 0 || channels <= 0) {
+        snprintf(lastError_, sizeof(lastError_), "WAV写入参数无效");
+        return false;
+    }
+
+    file_ = fopen(path, "wb");
+    if (file_ == nullptr) {
+        snprintf(lastError_, sizeof(lastError_), "创建文件失败: %s", path);
+        return false;
+    }
+
+    sampleRate_ = sampleRate;
+    channels_ = channels;
+    format_ = format;
+    framesWritten_ = 0;
+
+    // 先写入占位头部，close时回填大小
+    return writeHeader(0);
+}
+
+bool WavWriter::writeHeader(uint32_t dataBytes) {
+    const uint16_t formatTag = format_ == WavSampleFormat::PCM16 ? WAVE_FORMAT_PCM : WAVE_FORMAT_IEEE_FLOAT;
+    const uint16_t bits = static_cast<uint16_t>(bytesPerSample(format_) * 8);
+    const uint16_t blockAlign = static_cast<uint16_t>(bytesPerSample(format_) * static_cast<size_t>(channels_));
+
+    uint8_t header[44];
+    memcpy(header, "RIFF", 4);
+    writeLe32(header + 4, 36 + dataBytes);
+    memcpy(header + 8, "WAVE", 4);
+    memcpy(header + 12, "fmt ", 4);
+    writeLe32(header + 16, 16);
+    writeLe16(header + 20, formatTag);
+    writeLe16(header + 22, static_cast<uint16_t>(channels_));
+    writeLe32(header + 24, static_cast<uint32_t>(sampleRate_));
+    writeLe32(header + 28, static_cast<uint32_t>(sampleRate_) * blockAlign);
+    writeLe16(header + 32, blockAlign);
+    writeLe16(header + 34, bits);
+    memcpy(header + 36, "data", 4);
+    writeLe32(header + 40, dataBytes);
+
+    if (fwrite(header, 1, sizeof(header), file_) != sizeof(header)) {
+        snprintf(lastError_, sizeof(lastError_), "写入WAV头部失败");
+        return false;
+    }
+    return true;
+}
+
+bool WavWriter::write(const float* samples, size_t frames) {
+    if (file_ == nullptr || samples == nullptr) {
+        return false;
+    }
+
+    const size_t sampleBytes = bytesPerSample(format_);
+    const size_t total = frames * static_cast<size_t>(channels_);
+    const size_t perBatch = SCRATCH_BYTES / sampleBytes;
+
+    for (size_t done = 0; done < total; done += perBatch) {
+        const size_t count = total - done < perBatch ? total - done : perBatch;
+        for (size_t i = 0; i < count; i++) {
+            float value = samples[done + i];
+            if (format_ == WavSampleFormat::PCM16) {
+                if (value > 1.0f) {
+                    value = 1.0f;
+                } else if (value < -1.0f) {
+                    value = -1.0f;
+                }
+                const int32_t pcm = static_cast<int32_t>(value * 32767.0f);
+                writeLe16(scratch_ + i * 2, static_cast<uint16_t>(static_cast<int16_t>(pcm)));
+            } else {
+                uint32_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                writeLe32(scratch_ + i * 4, bits);
+            }
+        }
+        if (fwrite(scratch_, sampleBytes, count, file_) != count) {
+            snprintf(lastError_, sizeof(lastError_), "写入WAV数据失败");
+            return false;
+        }
+    }
+
+    framesWritten_ += frames;
+    return true;
+}
+
+bool WavWriter::close() {
+    if (file_ == nullptr) {
+        return true;
+    }
+
+    const uint64_t dataBytes = framesWritten_ * static_cast<uint64_t>(channels_) * bytesPerSample(format_);
+    bool success = true;
+    if (dataBytes > 0xFFFFFFFFull - 36) {
+        snprintf(lastError_, sizeof(lastError_), "输出超过4GB，WAV头部大小字段溢出");
+        success = false;
+    } else if (fseek(file_, 0, SEEK_SET) != 0 || !writeHeader(static_cast<uint32_t>(dataBytes))) {
+        snprintf(lastError_, sizeof(lastError_), "回填WAV头部失败");
+        success = false;
+    }
+
+    if (fclose(file_) != 0) {
+        success = false;
+    }
+    file_ = nullptr;
+    return success;
+}
+
+} // namespace deepfilter
@@ -1,7 +1,9 @@
 #include <jni.h>
 #include <android/log.h>
 #include <cstring>
+#include <memory>
 #include "AudioProcessor.h"
+#include "deepfilter_ort.h"
 
 #define LOG_TAG "DeepFilterJNI"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
@@ -9,27 +11,595 @@
 
 using namespace deepfilter;
 
+namespace {
+
+/**
+ * 处理线程的JVM附着状态
+ * 
+ * 每个线程首次回调Java时附着一次，线程退出时自动分离
+ */
+struct ThreadAttachment {
+    JavaVM* vm = nullptr;
+    JNIEnv* env = nullptr;
+    bool attached = false;
+
+    ~ThreadAttachment() {
+        if (attached && vm != nullptr) {
+            vm->DetachCurrentThread();
+        }
+    }
+};
+
+/**
+ * 获取当前线程的JNIEnv（必要时附着到JVM）
+ */
+JNIEnv* getThreadEnv(JavaVM* vm) {
+    thread_local ThreadAttachment attachment;
+
+    if (attachment.env != nullptr && attachment.vm == vm) {
+        return attachment.env;
+    }
+
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) == JNI_OK) {
+        attachment.vm = vm;
+        attachment.env = env;
+        return env;
+    }
+
+    if (vm->AttachCurrentThread(&env, nullptr) != JNI_OK) {
+        LOGE("处理线程附着到JVM失败");
+        return nullptr;
+    }
+
+    attachment.vm = vm;
+    attachment.env = env;
+    attachment.attached = true;
+    LOGI("处理线程已附着到JVM");
+    return env;
+}
+
+/**
+ * Java回调桥接
+ * 
+ * 持有回调对象（以及直接输出缓冲区）的GlobalRef，
+ * 可在任意线程上调用；销毁时释放GlobalRef
+ */
+class JavaCallbackBridge {
+public:
+    JavaCallbackBridge(JNIEnv* env, jobject target, jmethodID method, jobject buffer)
+        : vm_(nullptr)
+        , target_(env->NewGlobalRef(target))
+        , buffer_(buffer != nullptr ? env->NewGlobalRef(buffer) : nullptr)
+        , method_(method) {
+        env->GetJavaVM(&vm_);
+    }
+
+    ~JavaCallbackBridge() {
+        JNIEnv* env = getThreadEnv(vm_);
+        if (env == nullptr) {
+            return;
+        }
+        if (target_ != nullptr) {
+            env->DeleteGlobalRef(target_);
+        }
+        if (buffer_ != nullptr) {
+            env->DeleteGlobalRef(buffer_);
+        }
+    }
+
+    JavaCallbackBridge(const JavaCallbackBridge&) = delete;
+    JavaCallbackBridge& operator=(const JavaCallbackBridge&) = delete;
+
+    JNIEnv* env() const {
+        return getThreadEnv(vm_);
+    }
+
+    jobject target() const {
+        return target_;
+    }
+
+    jmethodID method() const {
+        return method_;
+    }
+
+    /**
+     * 检查并清除Java回调抛出的异常，避免异常挂起阻塞后续JNI调用
+     */
+    static void clearException(JNIEnv* env) {
+        if (env->ExceptionCheck()) {
+            env->ExceptionDescribe();
+            env->ExceptionClear();
+        }
+    }
+
+private:
+    JavaVM* vm_;
+    jobject target_;
+    jobject buffer_;
+    jmethodID method_;
+};
+
+/**
+ * 把Java的AudioDataCallback包装为AudioProcessor回调（nativeStart/nativeStartDuplex共用）
+ * 
+ * 回调在处理线程（或同步模式下的采集回调线程）上执行：使用GlobalRef和该线程自己的JNIEnv，
+ * 不能捕获当前线程的env和局部引用；多声道时数组为交织布局，长度为每声道帧数 × 声道数
+ */
+bool makeAudioCallback(JNIEnv* env, jobject callback, int32_t channels, AudioProcessor::AudioCallback* out) {
+    jclass callbackClass = env->GetObjectClass(callback);
+    jmethodID onAudioDataMethod = env->GetMethodID(callbackClass, "onAudioData", "([FFF)V");
+    env->DeleteLocalRef(callbackClass);
+    
+    if (onAudioDataMethod == nullptr) {
+        LOGE("找不到onAudioData方法");
+        JavaCallbackBridge::clearException(env);
+        return false;
+    }
+
+    auto bridge = std::make_shared<JavaCallbackBridge>(env, callback, onAudioDataMethod, nullptr);
+    *out = [bridge, channels](const float* audioData, int32_t numFrames, float lsnr) {
+        JNIEnv* threadEnv = bridge->env();
+        if (threadEnv == nullptr) {
+            return;
+        }
+        
+        const jsize samples = numFrames * channels;
+        jfloatArray jAudioData = threadEnv->NewFloatArray(samples);
+        if (jAudioData == nullptr) {
+            LOGE("创建float数组失败");
+            JavaCallbackBridge::clearException(threadEnv);
+            return;
+        }
+        
+        threadEnv->SetFloatArrayRegion(jAudioData, 0, samples, audioData);
+        threadEnv->CallVoidMethod(bridge->target(), bridge->method(), jAudioData,
+                                  static_cast<jfloat>(numFrames), static_cast<jfloat>(lsnr));
+        JavaCallbackBridge::clearException(threadEnv);
+        threadEnv->DeleteLocalRef(jAudioData);
+    };
+    return true;
+}
+
+/**
+ * 把Java的FrameInfoCallback包装为AudioProcessor帧信息回调（nativeStartWithFrameInfo用）
+ * 
+ * 线程和引用规则与makeAudioCallback相同
+ */
+bool makeFrameInfoCallback(JNIEnv* env, jobject callback, int32_t channels, AudioProcessor::FrameCallback* out) {
+    jclass callbackClass = env->GetObjectClass(callback);
+    jmethodID onAudioDataMethod = env->GetMethodID(callbackClass, "onAudioData", "([FIFJJZJZ)V");
+    env->DeleteLocalRef(callbackClass);
+    
+    if (onAudioDataMethod == nullptr) {
+        LOGE("找不到onAudioData方法");
+        JavaCallbackBridge::clearException(env);
+        return false;
+    }
+
+    auto bridge = std::make_shared<JavaCallbackBridge>(env, callback, onAudioDataMethod, nullptr);
+    *out = [bridge, channels](const float* audioData, int32_t numFrames, float lsnr, const FrameInfo& info) {
+        JNIEnv* threadEnv = bridge->env();
+        if (threadEnv == nullptr) {
+            return;
+        }
+        
+        const jsize samples = numFrames * channels;
+        jfloatArray jAudioData = threadEnv->NewFloatArray(samples);
+        if (jAudioData == nullptr) {
+            LOGE("创建float数组失败");
+            JavaCallbackBridge::clearException(threadEnv);
+            return;
+        }
+        
+        threadEnv->SetFloatArrayRegion(jAudioData, 0, samples, audioData);
+        threadEnv->CallVoidMethod(bridge->target(), bridge->method(), jAudioData,
+                                  static_cast<jint>(numFrames), static_cast<jfloat>(lsnr),
+                                  static_cast<jlong>(info.framePosition), static_cast<jlong>(info.timestampNs),
+                                  info.discontinuity ? JNI_TRUE : JNI_FALSE,
+                                  static_cast<jlong>(info.droppedFrames),
+                                  info.hardwareTimestamp ? JNI_TRUE : JNI_FALSE);
+        JavaCallbackBridge::clearException(threadEnv);
+        threadEnv->DeleteLocalRef(jAudioData);
+    };
+    return true;
+}
+
+/**
+ * 取direct ByteBuffer中[offset, offset + length)区间的地址（推送接口用）
+ * 
+ * @param sampleBytes 每个采样点的字节数，区间地址和长度必须按此对齐
+ * @return 区间首地址，缓冲区无效、越界或未对齐时返回nullptr
+ */
+uint8_t* directRegion(JNIEnv* env, jobject buffer, jint offset, jint length, size_t sampleBytes) {
+    if (buffer == nullptr || offset < 0 || length < 0) {
+        return nullptr;
+    }
+    uint8_t* base = static_cast<uint8_t*>(env->GetDirectBufferAddress(buffer));
+    const jlong capacity = env->GetDirectBufferCapacity(buffer);
+    if (base == nullptr || static_cast<jlong>(offset) + length > capacity) {
+        return nullptr;
+    }
+    uint8_t* region = base + offset;
+    if (reinterpret_cast<uintptr_t>(region) % sampleBytes != 0 || static_cast<size_t>(length) % sampleBytes != 0) {
+        return nullptr;
+    }
+    return region;
+}
+
+} // namespace
+
 extern "C" {
 
-// ===== AudioProcessor JNI接口 =====
+// ===== AudioProcessor JNI接口 =====
+
+JNIEXPORT jlong JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeCreate(
+    JNIEnv* env,
+    jobject thiz) {
+    
+    AudioProcessor* processor = new AudioProcessor();
+    return reinterpret_cast<jlong>(processor);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeInitialize(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jbyteArray tarBytes,
+    jfloat postFilterBeta,
+    jfloat attenLimDb) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    
+    if (tarBytes == nullptr) {
+        LOGE("模型文件字节数组为空");
+        return JNI_FALSE;
+    }
+
+    jbyte* tarBytesPtr = env->GetByteArrayElements(tarBytes, nullptr);
+    jsize tarBytesSize = env->GetArrayLength(tarBytes);
+    
+    bool success = processor->initialize(
+        reinterpret_cast<uint8_t*>(tarBytesPtr),
+        static_cast<size_t>(tarBytesSize),
+        postFilterBeta,
+        attenLimDb);
+    
+    env->ReleaseByteArrayElements(tarBytes, tarBytesPtr, JNI_ABORT);
+    
+    if (!success) {
+        LOGE("AudioProcessor初始化失败: %s", processor->getLastError());
+    }
+    
+    return success ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeInitializeFromModel(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jlong modelHandle,
+    jfloat postFilterBeta,
+    jfloat attenLimDb) {
+    
+    if (nativeHandle == 0 || modelHandle == 0) {
+        LOGE("AudioProcessor句柄或模型句柄为空");
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    bool success = processor->initializeFromModel(
+        reinterpret_cast<const void*>(modelHandle),
+        postFilterBeta,
+        attenLimDb);
+    
+    if (!success) {
+        LOGE("AudioProcessor初始化失败: %s", processor->getLastError());
+    }
+    
+    return success ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT void JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeSetModelCacheDir(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jstring directory) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    if (directory == nullptr) {
+        processor->setModelCacheDir(nullptr);
+        return;
+    }
+
+    const char* path = env->GetStringUTFChars(directory, nullptr);
+    processor->setModelCacheDir(path);
+    env->ReleaseStringUTFChars(directory, path);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeSetModelPrecision(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jint precision,
+    jbyteArray variantBytes) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+
+    if (precision < DF_PRECISION_FP32 || precision > DF_PRECISION_INT8) {
+        LOGE("无效的模型精度: %d", precision);
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    if (variantBytes == nullptr) {
+        return processor->setModelPrecision(static_cast<ModelPrecision>(precision), nullptr, 0) ? JNI_TRUE : JNI_FALSE;
+    }
+
+    // setModelPrecision内部复制变体包，返回后即可释放
+    jbyte* variantPtr = env->GetByteArrayElements(variantBytes, nullptr);
+    jsize variantSize = env->GetArrayLength(variantBytes);
+    bool success = processor->setModelPrecision(static_cast<ModelPrecision>(precision),
+                                                reinterpret_cast<uint8_t*>(variantPtr),
+                                                static_cast<size_t>(variantSize));
+    env->ReleaseByteArrayElements(variantBytes, variantPtr, JNI_ABORT);
+    return success ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeSetSampleRates(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jint captureSampleRate,
+    jint outputSampleRate) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return processor->setCaptureSampleRate(captureSampleRate) &&
+           processor->setOutputSampleRate(outputSampleRate) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeSetChannelCount(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jint channelCount) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return processor->setChannelCount(channelCount) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeSetComputeGate(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jboolean enabled,
+    jfloat silenceDbfs,
+    jfloat cleanLsnrDb) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+
+    // 其余参数使用默认值；cleanLsnrDb<=0时只按静音门控，退出阈值比进入阈值低5dB
+    ComputeGateConfig config;
+    config.enabled = enabled == JNI_TRUE;
+    config.silenceDbfs = silenceDbfs;
+    config.bypassClean = cleanLsnrDb > 0.0f;
+    if (config.bypassClean) {
+        config.cleanLsnrDb = cleanLsnrDb;
+        config.cleanExitLsnrDb = cleanLsnrDb - 5.0f;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return processor->setComputeGate(config) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeSetThreadScheduling(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jint priority,
+    jint niceValue,
+    jint affinity,
+    jlong cpuMask,
+    jboolean boostOnBacklog) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+    if (priority < 0 || priority > static_cast<jint>(ThreadPriority::FIFO) ||
+        affinity < 0 || affinity > static_cast<jint>(CpuAffinity::CPUSET)) {
+        LOGE("无效的线程调度策略: priority=%d, affinity=%d", priority, affinity);
+        return JNI_FALSE;
+    }
+
+    // 常量取值与AudioProcessor.PRIORITY_*/AFFINITY_*一致
+    ThreadSchedulingConfig config;
+    config.priority = static_cast<ThreadPriority>(priority);
+    config.niceValue = niceValue;
+    config.affinity = static_cast<CpuAffinity>(affinity);
+    config.cpuMask = static_cast<uint64_t>(cpuMask);
+    config.boostOnBacklog = boostOnBacklog == JNI_TRUE;
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return processor->setThreadScheduling(config) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeSetSynchronousMode(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jboolean enabled,
+    jfloat deadlineRatio,
+    jint maxMissedDeadlines) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return processor->setSynchronousMode(enabled == JNI_TRUE, deadlineRatio, maxMissedDeadlines)
+        ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeSetLatencyProfile(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jint profile) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+
+    if (profile != static_cast<jint>(LatencyProfile::HIGH_QUALITY) &&
+        profile != static_cast<jint>(LatencyProfile::LOW_LATENCY)) {
+        LOGE("无效的延迟档位: %d", profile);
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return processor->setLatencyProfile(static_cast<LatencyProfile>(profile)) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeSetInferenceBackend(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jint backend) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return processor->setInferenceBackend(static_cast<InferenceBackend>(backend)) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeIsBackendAvailable(
+    JNIEnv* env,
+    jclass clazz,
+    jint backend) {
+    
+    return df_backend_available(backend) != 0 ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeLoadModel(
+    JNIEnv* env,
+    jclass clazz,
+    jbyteArray tarBytes) {
+    
+    if (tarBytes == nullptr) {
+        LOGE("模型文件字节数组为空");
+        return 0;
+    }
+
+    jbyte* tarBytesPtr = env->GetByteArrayElements(tarBytes, nullptr);
+    jsize tarBytesSize = env->GetArrayLength(tarBytes);
+    
+    void* model = df_model_load(reinterpret_cast<uint8_t*>(tarBytesPtr), static_cast<size_t>(tarBytesSize));
+    
+    env->ReleaseByteArrayElements(tarBytes, tarBytesPtr, JNI_ABORT);
+    
+    if (model == nullptr) {
+        LOGE("加载DeepFilterNet模型失败");
+    }
+    
+    return reinterpret_cast<jlong>(model);
+}
+
+JNIEXPORT void JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeFreeModel(
+    JNIEnv* env,
+    jclass clazz,
+    jlong modelHandle) {
+    
+    if (modelHandle != 0) {
+        df_model_free(reinterpret_cast<void*>(modelHandle));
+    }
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeStart(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jobject callback) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    
+    if (callback == nullptr) {
+        LOGE("回调对象为空");
+        return JNI_FALSE;
+    }
+
+    AudioProcessor::AudioCallback callbackFunc;
+    if (!makeAudioCallback(env, callback, processor->getChannelCount(), &callbackFunc)) {
+        return JNI_FALSE;
+    }
 
-JNIEXPORT jlong JNICALL
-Java_com_hzexe_audio_ns_AudioProcessor_nativeCreate(
-    JNIEnv* env,
-    jobject thiz) {
+    bool success = processor->start(callbackFunc);
     
-    AudioProcessor* processor = new AudioProcessor();
-    return reinterpret_cast<jlong>(processor);
+    if (!success) {
+        LOGE("AudioProcessor启动失败: %s", processor->getLastError());
+    }
+    
+    return success ? JNI_TRUE : JNI_FALSE;
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_hzexe_audio_ns_AudioProcessor_nativeInitialize(
+Java_com_hzexe_audio_ns_AudioProcessor_nativeStartWithFrameInfo(
     JNIEnv* env,
     jobject thiz,
     jlong nativeHandle,
-    jbyteArray tarBytes,
-    jfloat postFilterBeta,
-    jfloat attenLimDb) {
+    jobject callback) {
     
     if (nativeHandle == 0) {
         LOGE("AudioProcessor句柄为空");
@@ -38,34 +608,62 @@ Java_com_hzexe_audio_ns_AudioProcessor_nativeInitialize(
 
     AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
     
-    if (tarBytes == nullptr) {
-        LOGE("模型文件字节数组为空");
+    if (callback == nullptr) {
+        LOGE("回调对象为空");
         return JNI_FALSE;
     }
 
-    jbyte* tarBytesPtr = env->GetByteArrayElements(tarBytes, nullptr);
-    jsize tarBytesSize = env->GetArrayLength(tarBytes);
+    AudioProcessor::FrameCallback callbackFunc;
+    if (!makeFrameInfoCallback(env, callback, processor->getChannelCount(), &callbackFunc)) {
+        return JNI_FALSE;
+    }
+
+    bool success = processor->startWithFrameInfo(callbackFunc);
     
-    bool success = processor->initialize(
-        reinterpret_cast<uint8_t*>(tarBytesPtr),
-        static_cast<size_t>(tarBytesSize),
-        postFilterBeta,
-        attenLimDb);
+    if (!success) {
+        LOGE("AudioProcessor启动失败: %s", processor->getLastError());
+    }
     
-    env->ReleaseByteArrayElements(tarBytes, tarBytesPtr, JNI_ABORT);
+    return success ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeStartDuplex(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jobject monitor) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+
+    // 监听回调可选；降噪结果始终写入输出流
+    AudioProcessor::AudioCallback monitorFunc;
+    if (monitor != nullptr &&
+        !makeAudioCallback(env, monitor, processor->getChannelCount(), &monitorFunc)) {
+        return JNI_FALSE;
+    }
+
+    bool success = processor->startDuplex(monitorFunc);
     
     if (!success) {
-        LOGE("AudioProcessor初始化失败: %s", processor->getLastError());
+        LOGE("AudioProcessor双工模式启动失败: %s", processor->getLastError());
     }
     
     return success ? JNI_TRUE : JNI_FALSE;
 }
 
 JNIEXPORT jboolean JNICALL
-Java_com_hzexe_audio_ns_AudioProcessor_nativeStart(
+Java_com_hzexe_audio_ns_AudioProcessor_nativeStartDirect(
     JNIEnv* env,
     jobject thiz,
     jlong nativeHandle,
+    jobject outputBuffer,
+    jint slotCount,
     jobject callback) {
     
     if (nativeHandle == 0) {
@@ -75,32 +673,59 @@ Java_com_hzexe_audio_ns_AudioProcessor_nativeStart(
 
     AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
     
-    if (callback == nullptr) {
-        LOGE("回调对象为空");
+    if (outputBuffer == nullptr || slotCount <= 0) {
+        LOGE("直接输出缓冲区为空或槽数量无效");
         return JNI_FALSE;
     }
 
-    jclass callbackClass = env->GetObjectClass(callback);
-    jmethodID onAudioDataMethod = env->GetMethodID(callbackClass, "onAudioData", "([FF)V");
+    float* ring = static_cast<float*>(env->GetDirectBufferAddress(outputBuffer));
+    jlong capacity = env->GetDirectBufferCapacity(outputBuffer);
+    jlong required = static_cast<jlong>(slotCount) * processor->getFrameSize() * processor->getChannelCount() *
+                     static_cast<jlong>(sizeof(float));
     
-    if (onAudioDataMethod == nullptr) {
-        LOGE("找不到onAudioData方法");
+    if (ring == nullptr || capacity < required) {
+        LOGE("直接输出缓冲区无效: 容量=%lld, 需要=%lld",
+             static_cast<long long>(capacity), static_cast<long long>(required));
         return JNI_FALSE;
     }
 
-    auto callbackFunc = [env, callback, onAudioDataMethod](const float* audioData, int32_t numFrames, float lsnr) {
-        jfloatArray jAudioData = env->NewFloatArray(numFrames);
-        if (jAudioData == nullptr) {
-            LOGE("创建float数组失败");
-            return;
-        }
+    AudioProcessor::DirectCallback callbackFunc = nullptr;
+    
+    // callback为空时为轮询模式，只需保持缓冲区的GlobalRef
+    jmethodID onAudioFrameMethod = nullptr;
+    if (callback != nullptr) {
+        jclass callbackClass = env->GetObjectClass(callback);
+        onAudioFrameMethod = env->GetMethodID(callbackClass, "onAudioFrame", "(IIF)V");
+        env->DeleteLocalRef(callbackClass);
         
-        env->SetFloatArrayRegion(jAudioData, 0, numFrames, audioData);
-        env->CallVoidMethod(callback, onAudioDataMethod, jAudioData, static_cast<jfloat>(numFrames), static_cast<jfloat>(lsnr));
-        env->DeleteLocalRef(jAudioData);
-    };
+        if (onAudioFrameMethod == nullptr) {
+            LOGE("找不到onAudioFrame方法");
+            JavaCallbackBridge::clearException(env);
+            return JNI_FALSE;
+        }
+    }
 
-    bool success = processor->start(callbackFunc);
+    auto bridge = std::make_shared<JavaCallbackBridge>(
+        env, callback != nullptr ? callback : outputBuffer, onAudioFrameMethod, outputBuffer);
+
+    if (callback != nullptr) {
+        // 只传递槽索引，不创建Java数组，回调路径无GC分配
+        callbackFunc = [bridge](int32_t slotIndex, int32_t numFrames, float lsnr) {
+            JNIEnv* threadEnv = bridge->env();
+            if (threadEnv == nullptr) {
+                return;
+            }
+            threadEnv->CallVoidMethod(bridge->target(), bridge->method(),
+                                      static_cast<jint>(slotIndex), static_cast<jint>(numFrames),
+                                      static_cast<jfloat>(lsnr));
+            JavaCallbackBridge::clearException(threadEnv);
+        };
+    } else {
+        callbackFunc = [bridge](int32_t, int32_t, float) {
+        };
+    }
+
+    bool success = processor->startDirect(ring, static_cast<size_t>(slotCount), callbackFunc);
     
     if (!success) {
         LOGE("AudioProcessor启动失败: %s", processor->getLastError());
@@ -109,6 +734,20 @@ Java_com_hzexe_audio_ns_AudioProcessor_nativeStart(
     return success ? JNI_TRUE : JNI_FALSE;
 }
 
+JNIEXPORT jlong JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeGetDirectWriteCount(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle) {
+    
+    if (nativeHandle == 0) {
+        return 0;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return static_cast<jlong>(processor->getDirectWriteCount());
+}
+
 JNIEXPORT jboolean JNICALL
 Java_com_hzexe_audio_ns_AudioProcessor_nativeStop(
     JNIEnv* env,
@@ -231,6 +870,22 @@ Java_com_hzexe_audio_ns_AudioProcessor_nativeSetAttenLimDb(
     return success ? JNI_TRUE : JNI_FALSE;
 }
 
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeSetParameterRamp(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jint milliseconds) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return processor->setParameterRamp(milliseconds) ? JNI_TRUE : JNI_FALSE;
+}
+
 JNIEXPORT jint JNICALL
 Java_com_hzexe_audio_ns_AudioProcessor_nativeGetSampleRate(
     JNIEnv* env,
@@ -245,6 +900,20 @@ Java_com_hzexe_audio_ns_AudioProcessor_nativeGetSampleRate(
     return processor->getSampleRate();
 }
 
+JNIEXPORT jint JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeGetCaptureSampleRate(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle) {
+    
+    if (nativeHandle == 0) {
+        return 0;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return processor->getCaptureSampleRate();
+}
+
 JNIEXPORT jint JNICALL
 Java_com_hzexe_audio_ns_AudioProcessor_nativeGetChannelCount(
     JNIEnv* env,
@@ -273,6 +942,91 @@ Java_com_hzexe_audio_ns_AudioProcessor_nativeGetFrameSize(
     return processor->getFrameSize();
 }
 
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeSetPushMode(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jboolean enabled) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return processor->setPushMode(enabled == JNI_TRUE) ? JNI_TRUE : JNI_FALSE;
+}
+
+JNIEXPORT jint JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativePushPcm16(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jobject buffer,
+    jint offset,
+    jint length,
+    jint timeoutMs) {
+    
+    if (nativeHandle == 0) {
+        return -1;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    const size_t frameBytes = sizeof(int16_t) * static_cast<size_t>(processor->getChannelCount());
+    uint8_t* region = directRegion(env, buffer, offset, length, sizeof(int16_t));
+    if (region == nullptr || static_cast<size_t>(length) % frameBytes != 0) {
+        LOGE("推送缓冲区无效: offset=%d, length=%d（需为direct ByteBuffer，按帧对齐）", offset, length);
+        return -1;
+    }
+
+    // 直接读取Java缓冲区，不复制；返回接受的字节数
+    const int32_t accepted = processor->pushPcm16(reinterpret_cast<const int16_t*>(region),
+                                                  static_cast<int32_t>(length / frameBytes), timeoutMs);
+    return accepted < 0 ? -1 : static_cast<jint>(accepted * frameBytes);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativePushFloat(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jobject buffer,
+    jint offset,
+    jint length,
+    jint timeoutMs) {
+    
+    if (nativeHandle == 0) {
+        return -1;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    const size_t frameBytes = sizeof(float) * static_cast<size_t>(processor->getChannelCount());
+    uint8_t* region = directRegion(env, buffer, offset, length, sizeof(float));
+    if (region == nullptr || static_cast<size_t>(length) % frameBytes != 0) {
+        LOGE("推送缓冲区无效: offset=%d, length=%d（需为direct ByteBuffer，按帧对齐）", offset, length);
+        return -1;
+    }
+
+    const int32_t accepted = processor->pushFloat(reinterpret_cast<const float*>(region),
+                                                  static_cast<int32_t>(length / frameBytes), timeoutMs);
+    return accepted < 0 ? -1 : static_cast<jint>(accepted * frameBytes);
+}
+
+JNIEXPORT jint JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeGetPushableFrames(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle) {
+    
+    if (nativeHandle == 0) {
+        return 0;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return static_cast<jint>(processor->getPushableFrames());
+}
+
 JNIEXPORT jint JNICALL
 Java_com_hzexe_audio_ns_AudioProcessor_nativeGetQueueSize(
     JNIEnv* env,
@@ -287,6 +1041,200 @@ Java_com_hzexe_audio_ns_AudioProcessor_nativeGetQueueSize(
     return static_cast<jint>(processor->getQueueSize());
 }
 
+JNIEXPORT void JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeSetOverflowPolicy(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jint policy) {
+    
+    if (nativeHandle == 0) {
+        LOGE("AudioProcessor句柄为空");
+        return;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    processor->setOverflowPolicy(policy == static_cast<jint>(OverflowPolicy::DROP_NEWEST)
+                                 ? OverflowPolicy::DROP_NEWEST
+                                 : OverflowPolicy::DROP_OLDEST);
+}
+
+JNIEXPORT jlong JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeGetDroppedFrameCount(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle) {
+    
+    if (nativeHandle == 0) {
+        return 0;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    return static_cast<jlong>(processor->getDroppedFrameCount());
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeGetStats(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jlongArray out) {
+    
+    if (nativeHandle == 0 || out == nullptr) {
+        return JNI_FALSE;
+    }
+
+    // 布局：4个计数器 + 4个阶段 x (count, p50, p95, p99, max, avg) + 采样率转换延迟 + 门控跳过帧数
+    //       + 同步模式（处理帧数、超时次数、是否回退）+ 推送模式（接受帧数、队列满次数）+ 不连续次数，
+    //       与AudioProcessor.Stats一致
+    const jsize fieldCount = 4 + 4 * 6 + 2 + 3 + 2 + 1;
+    if (env->GetArrayLength(out) < fieldCount) {
+        LOGE("统计数组长度不足: %d", env->GetArrayLength(out));
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    const AudioProcessorStats stats = processor->getStats();
+
+    jlong values[fieldCount];
+    jsize index = 0;
+    values[index++] = static_cast<jlong>(stats.processedFrames);
+    values[index++] = static_cast<jlong>(stats.droppedFrames);
+    values[index++] = static_cast<jlong>(stats.failedFrames);
+    values[index++] = static_cast<jlong>(stats.overBudgetFrames);
+    const LatencySummary* stages[] = {
+        &stats.queueLatency, &stats.processLatency, &stats.callbackLatency, &stats.endToEndLatency
+    };
+    for (const LatencySummary* stage : stages) {
+        values[index++] = static_cast<jlong>(stage->count);
+        values[index++] = stage->p50Us;
+        values[index++] = stage->p95Us;
+        values[index++] = stage->p99Us;
+        values[index++] = stage->maxUs;
+        values[index++] = stage->avgUs;
+    }
+    values[index++] = stats.resamplerLatencyUs;
+    values[index++] = static_cast<jlong>(stats.bypassedFrames);
+    values[index++] = static_cast<jlong>(stats.syncFrames);
+    values[index++] = static_cast<jlong>(stats.missedDeadlines);
+    values[index++] = stats.syncFallback ? 1 : 0;
+    values[index++] = static_cast<jlong>(stats.pushedFrames);
+    values[index++] = static_cast<jlong>(stats.backpressureEvents);
+    values[index++] = static_cast<jlong>(stats.discontinuities);
+
+    env->SetLongArrayRegion(out, 0, fieldCount, values);
+    return JNI_TRUE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeGetSchedulingStats(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jlongArray out) {
+    
+    if (nativeHandle == 0 || out == nullptr) {
+        return JNI_FALSE;
+    }
+
+    // 布局：性能核心掩码、性能核心hop数、未知核心hop数、提升次数、失败次数、是否提升 + 各核心hop数，与AudioProcessor.SchedulingStats一致
+    const jsize fieldCount = 6 + CpuTopology::MAX_CPUS;
+    if (env->GetArrayLength(out) < fieldCount) {
+        LOGE("调度统计数组长度不足: %d", env->GetArrayLength(out));
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    const ThreadSchedulingStats stats = processor->getThreadSchedulingStats();
+
+    jlong values[fieldCount];
+    jsize index = 0;
+    values[index++] = static_cast<jlong>(processor->getCpuTopology().performanceMask);
+    values[index++] = static_cast<jlong>(stats.performanceCoreHops);
+    values[index++] = static_cast<jlong>(stats.unknownCoreHops);
+    values[index++] = static_cast<jlong>(stats.boosts);
+    values[index++] = static_cast<jlong>(stats.failures);
+    values[index++] = stats.boosted ? 1 : 0;
+    for (int32_t cpu = 0; cpu < CpuTopology::MAX_CPUS; cpu++) {
+        values[index++] = static_cast<jlong>(stats.coreHops[cpu]);
+    }
+
+    env->SetLongArrayRegion(out, 0, fieldCount, values);
+    return JNI_TRUE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeGetPlayoutStats(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jlongArray out) {
+    
+    if (nativeHandle == 0 || out == nullptr) {
+        return JNI_FALSE;
+    }
+
+    // 布局：写入帧数、播放帧数、欠载次数、静音帧数、溢出帧数、当前深度、目标深度、漂移修正ppm，与AudioProcessor.PlayoutStats一致
+    const jsize fieldCount = 8;
+    if (env->GetArrayLength(out) < fieldCount) {
+        LOGE("播放统计数组长度不足: %d", env->GetArrayLength(out));
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    const PlayoutBufferStats stats = processor->getPlayoutStats();
+
+    jlong values[fieldCount];
+    jsize index = 0;
+    values[index++] = static_cast<jlong>(stats.writtenFrames);
+    values[index++] = static_cast<jlong>(stats.renderedFrames);
+    values[index++] = static_cast<jlong>(stats.underruns);
+    values[index++] = static_cast<jlong>(stats.silentFrames);
+    values[index++] = static_cast<jlong>(stats.overflowFrames);
+    values[index++] = stats.fillFrames;
+    values[index++] = stats.targetFrames;
+    values[index++] = stats.correctionPpm;
+
+    env->SetLongArrayRegion(out, 0, fieldCount, values);
+    return JNI_TRUE;
+}
+
+JNIEXPORT jboolean JNICALL
+Java_com_hzexe_audio_ns_AudioProcessor_nativeGetPipelineDelay(
+    JNIEnv* env,
+    jobject thiz,
+    jlong nativeHandle,
+    jlongArray out) {
+    
+    if (nativeHandle == 0 || out == nullptr) {
+        return JNI_FALSE;
+    }
+
+    // 布局：采样率、前瞻hop数、算法、分块、排队、重采样、播放缓冲、合计，与AudioProcessor.PipelineDelay一致
+    const jsize fieldCount = 8;
+    if (env->GetArrayLength(out) < fieldCount) {
+        LOGE("延迟数组长度不足: %d", env->GetArrayLength(out));
+        return JNI_FALSE;
+    }
+
+    AudioProcessor* processor = reinterpret_cast<AudioProcessor*>(nativeHandle);
+    const PipelineDelay delay = processor->getPipelineDelay();
+
+    jlong values[fieldCount];
+    jsize index = 0;
+    values[index++] = delay.sampleRate;
+    values[index++] = delay.lookaheadHops;
+    values[index++] = delay.algorithmicFrames;
+    values[index++] = delay.blockingFrames;
+    values[index++] = delay.queueFrames;
+    values[index++] = delay.resamplerFrames;
+    values[index++] = delay.playoutFrames;
+    values[index++] = delay.totalFrames;
+
+    env->SetLongArrayRegion(out, 0, fieldCount, values);
+    return JNI_TRUE;
+}
+
 JNIEXPORT void JNICALL
 Java_com_hzexe_audio_ns_AudioProcessor_nativeDestroy(
     JNIEnv* env,
@@ -0,0 +1,23 @@
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include <iostream>
+
+/**
+ * 主机单元测试共用的断言工具
+ *
+ * EXPECT失败时打印条件和位置并累计到failures，不中断当前测试，
+ * 各测试的main根据failures决定退出码
+ */
+
+static int failures = 0;
+
+#define EXPECT(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "  失败: " << #cond << " (" << __FILE__ << ":" << __LINE__ << ")" << std::endl; \
+            failures++; \
+        } \
+    } while (0)
+
+#endif // TEST_SUPPORT_H
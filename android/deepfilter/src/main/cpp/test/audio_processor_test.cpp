@@ -0,0 +1,1133 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include "AudioProcessor.h"
+#include "SimulatedAudio.h"
+#include "TestSupport.h"
+
+/**
+ * AudioProcessor主机测试工具
+ *
+ * 链接直通桩（df_stub.cpp），用模拟音频源驱动与设备上相同的
+ * 环形缓冲区、处理线程和回调路径
+ */
+
+using namespace deepfilter;
+
+static const uint8_t fakeModel[] = {1, 2, 3, 4};
+
+// 桩专用：设置处理接口返回的LSNR（见df_stub.cpp）
+extern "C" void df_stub_set_lsnr(float lsnr);
+
+/**
+ * 采样值等于全局采样序号的音频源，用于校验重新分块后hop的完整性和顺序
+ *
+ * 多声道时按交织顺序编号（第n帧声道c的值为n * 声道数 + c）；
+ * 回调大小（burst）与hop大小无关，默认4ms（192帧）
+ */
+class CountingSource : public PacedAudioSource {
+public:
+    CountingSource(double speed, int64_t totalSamples)
+        : PacedAudioSource(speed), totalSamples_(totalSamples), position_(0) {}
+    ~CountingSource() override { stop(); }
+
+protected:
+    int32_t generate(float* buffer, int32_t numFrames) override {
+        const int32_t channels = config_.channelCount;
+        int32_t count = 0;
+        while (count < numFrames && position_ < totalSamples_) {
+            for (int32_t c = 0; c < channels; c++) {
+                buffer[count * channels + c] = static_cast<float>(position_ * channels + c);
+            }
+            position_++;
+            count++;
+        }
+        return count;
+    }
+
+private:
+    int64_t totalSamples_;
+    int64_t position_;
+};
+
+/**
+ * 生成若干帧后在自己的数据线程上报告设备断开的音频源（模拟AAudio回调线程上的错误回调）
+ */
+class DisconnectingSource : public PacedAudioSource {
+public:
+    explicit DisconnectingSource(int64_t disconnectAfter)
+        : PacedAudioSource(5.0), disconnectAfter_(disconnectAfter), position_(0),
+          errorCallback_(nullptr), errorUserData_(nullptr) {}
+    ~DisconnectingSource() override { stop(); }
+
+    bool open(const AudioSourceConfig& config,
+              DataCallback dataCallback,
+              ErrorCallback errorCallback,
+              void* userData) override {
+        errorCallback_ = errorCallback;
+        errorUserData_ = userData;
+        return PacedAudioSource::open(config, dataCallback, errorCallback, userData);
+    }
+
+protected:
+    int32_t generate(float* buffer, int32_t numFrames) override {
+        if (position_ >= disconnectAfter_) {
+            if (errorCallback_ != nullptr) {
+                errorCallback_(errorUserData_, true, "设备已断开");
+                errorCallback_ = nullptr;
+            }
+            return 0;
+        }
+        std::fill(buffer, buffer + static_cast<size_t>(numFrames) * config_.channelCount, 0.0f);
+        position_ += numFrames;
+        return numFrames;
+    }
+
+private:
+    int64_t disconnectAfter_;
+    int64_t position_;
+    ErrorCallback errorCallback_;
+    void* errorUserData_;
+};
+
+/**
+ * 等待处理线程处理完所有已入队的帧
+ */
+static bool waitDrained(AudioProcessor& processor, uint64_t pushedHops) {
+    for (int i = 0; i < 2000; i++) {
+        AudioProcessorStats stats = processor.getStats();
+        if (stats.processedFrames + stats.droppedFrames + stats.failedFrames >= pushedHops) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+/**
+ * 主机构建必须显式设置音频源
+ */
+void testRequiresSource() {
+    std::cout << "测试未设置音频源..." << std::endl;
+
+    AudioProcessor processor;
+    EXPECT(!processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+    EXPECT(!processor.isInitialized());
+}
+
+/**
+ * 不限速推送：每一帧要么被处理要么被计为丢弃，输出帧完整且按序
+ */
+void testUnpacedPipeline() {
+    std::cout << "测试不限速管线..." << std::endl;
+
+    // 480帧hop x 2000，采样序号在float中可精确表示；最后追加半个hop验证不完整hop不入队
+    const int32_t totalHops = 2000;
+    const int32_t hopSize = 480;
+    CountingSource* source = new CountingSource(0.0, static_cast<int64_t>(totalHops) * hopSize + hopSize / 2);
+
+    AudioProcessor processor;
+    EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+    EXPECT(processor.isInitialized());
+    EXPECT(processor.getFrameSize() == hopSize);
+
+    int64_t lastStart = -1;
+    uint64_t corrupted = 0;
+    uint64_t outOfOrder = 0;
+    uint64_t callbacks = 0;
+    EXPECT(processor.start([&](const float* audioData, int32_t numFrames, float /*lsnr*/) {
+        callbacks++;
+        // 每个hop必须是从hop边界开始的连续采样
+        const int64_t start = static_cast<int64_t>(audioData[0]);
+        if (numFrames != hopSize || start % hopSize != 0) {
+            corrupted++;
+        } else {
+            for (int32_t i = 0; i < numFrames; i++) {
+                if (audioData[i] != static_cast<float>(start + i)) {
+                    corrupted++;
+                    break;
+                }
+            }
+        }
+        if (start <= lastStart) {
+            outOfOrder++;
+        }
+        lastStart = start;
+    }));
+    EXPECT(!processor.setAudioSource(nullptr));
+
+    EXPECT(source->waitUntilFinished(10000));
+    EXPECT(waitDrained(processor, totalHops));
+    EXPECT(processor.stop());
+
+    AudioProcessorStats stats = processor.getStats();
+    EXPECT(source->getDeliveredFrames() == static_cast<uint64_t>(totalHops) * hopSize + hopSize / 2);
+    EXPECT(stats.processedFrames + stats.droppedFrames == static_cast<uint64_t>(totalHops));
+    EXPECT(stats.processedFrames == callbacks);
+    EXPECT(stats.failedFrames == 0);
+    EXPECT(stats.endToEndLatency.count == stats.processedFrames);
+    EXPECT(stats.processLatency.count == stats.processedFrames);
+    EXPECT(stats.queueLatency.p50Us <= stats.endToEndLatency.maxUs);
+    EXPECT(corrupted == 0);
+    EXPECT(outOfOrder == 0);
+
+    std::cout << "  处理 " << stats.processedFrames << " 帧，丢弃 " << stats.droppedFrames
+              << " 帧，端到端p99 " << stats.endToEndLatency.p99Us << " us" << std::endl;
+
+    processor.release();
+    EXPECT(!processor.isInitialized());
+}
+
+/**
+ * 实时节奏推送：耗时不少于音频时长，结果写入NullAudioSink；启用积压提升并检查逐hop核心计数
+ */
+void testPacedPipeline() {
+    std::cout << "测试实时节奏管线..." << std::endl;
+
+    const uint64_t totalFrames = 48000 / 5;     // 200ms
+    SyntheticAudioSource* source = new SyntheticAudioSource(1.0, totalFrames);
+    NullAudioSink sink;
+
+    AudioProcessor processor;
+    ThreadSchedulingConfig scheduling;
+    scheduling.fifoPriority = 100;
+    EXPECT(!processor.setThreadScheduling(scheduling));
+    scheduling.fifoPriority = 2;
+    scheduling.boostOnBacklog = true;
+    EXPECT(processor.setThreadScheduling(scheduling));
+    EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT(processor.start(&sink));
+    EXPECT(source->waitUntilFinished(10000));
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const uint64_t totalHops = totalFrames / static_cast<uint64_t>(processor.getFrameSize());
+    EXPECT(waitDrained(processor, totalHops));
+    EXPECT(processor.stop());
+
+    AudioProcessorStats stats = processor.getStats();
+    EXPECT(elapsedMs >= 190.0);
+    EXPECT(stats.processedFrames + stats.droppedFrames == totalHops);
+    EXPECT(sink.getWriteCount() == stats.processedFrames);
+    EXPECT(sink.getFrameCount() == stats.processedFrames * static_cast<uint64_t>(processor.getFrameSize()));
+
+    // 每个hop都记录了运行的核心
+    const ThreadSchedulingStats schedulingStats = processor.getThreadSchedulingStats();
+    uint64_t coreHops = schedulingStats.unknownCoreHops;
+    for (int32_t cpu = 0; cpu < CpuTopology::MAX_CPUS; cpu++) {
+        coreHops += schedulingStats.coreHops[cpu];
+    }
+    EXPECT(coreHops == stats.processedFrames + stats.failedFrames);
+
+    // 再次启动时统计清零
+    EXPECT(processor.start(&sink));
+    EXPECT(processor.stop());
+    EXPECT(processor.getStats().processedFrames == 0);
+}
+
+/**
+ * 16kHz采集、16kHz输出：采集回调转换到48kHz，降噪结果再转换回16kHz
+ */
+void testResampledPipeline() {
+    std::cout << "测试采样率转换管线..." << std::endl;
+
+    // 1秒16kHz、1kHz纯音（原生采样率16kHz），20倍速推送
+    const uint64_t totalFrames = 16000;
+    SyntheticAudioSource* source = new SyntheticAudioSource(20.0, totalFrames, 1000.0f, 0.0f, 16000);
+
+    AudioProcessor processor;
+    EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+    EXPECT(processor.setOutputSampleRate(16000));
+    EXPECT(!processor.setCaptureSampleRate(-1));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+    EXPECT(processor.getCaptureSampleRate() == 16000);
+    EXPECT(processor.getSampleRate() == 16000);
+    EXPECT(processor.getFrameSize() == 480);
+
+    // 输出需要转换时不支持直接输出模式
+    std::vector<float> ring(static_cast<size_t>(processor.getFrameSize()) * 4);
+    EXPECT(!processor.startDirect(ring.data(), 4, nullptr));
+
+    std::vector<float> output;
+    output.reserve(totalFrames + 1024);
+    uint64_t oversized = 0;
+    EXPECT(processor.start([&](const float* audioData, int32_t numFrames, float /*lsnr*/) {
+        // 每帧480个48kHz采样对应约160个16kHz采样
+        if (numFrames < 159 || numFrames > 161) {
+            oversized++;
+        }
+        output.insert(output.end(), audioData, audioData + numFrames);
+    }));
+
+    EXPECT(source->waitUntilFinished(10000));
+    // 16000帧转换为约48000帧（扣除滤波器延迟），即99~100个hop
+    EXPECT(waitDrained(processor, 99));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT(processor.stop());
+
+    // 20倍速推送时处理线程在负载较高的主机上可能落后，队列溢出丢帧；这里只核对帧数守恒
+    AudioProcessorStats stats = processor.getStats();
+    const uint64_t hops = stats.processedFrames + stats.droppedFrames;
+    EXPECT(hops >= 99 && hops <= 100);
+    EXPECT(stats.processedFrames > 0);
+    EXPECT(stats.resamplerLatencyUs > 0 && stats.resamplerLatencyUs < 5000);
+    EXPECT(oversized == 0);
+    EXPECT(std::fabs(static_cast<double>(output.size()) - stats.processedFrames * 160.0) <= 2.0);
+
+    // 跳过开头的滤波器过渡段后，两次转换的幅度保持不变（纯音幅度0.5，RMS约0.354）
+    double power = 0.0;
+    size_t count = 0;
+    for (size_t i = 1600; i < output.size(); i++) {
+        power += static_cast<double>(output[i]) * output[i];
+        count++;
+    }
+    const double rms = count > 0 ? std::sqrt(power / count) : 0.0;
+    std::cout << "  输出 " << output.size() << " 帧，RMS " << rms
+              << "，转换延迟 " << stats.resamplerLatencyUs << " us" << std::endl;
+    EXPECT(std::fabs(rms - 0.5 / std::sqrt(2.0)) < 0.01);
+}
+
+/**
+ * 双声道采集：交织数据按hop整体入队，回调数据保持交织顺序
+ */
+void testMultiChannelPipeline() {
+    std::cout << "测试多声道管线..." << std::endl;
+
+    const int32_t channels = 2;
+    const int32_t totalHops = 500;
+    const int32_t hopSize = 480;
+    CountingSource* source = new CountingSource(0.0, static_cast<int64_t>(totalHops) * hopSize);
+
+    AudioProcessor processor;
+    EXPECT(!processor.setChannelCount(0));
+    EXPECT(!processor.setChannelCount(17));
+    EXPECT(processor.setChannelCount(channels));
+    EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+    EXPECT(processor.getChannelCount() == channels);
+    EXPECT(processor.getFrameSize() == hopSize);
+    EXPECT(processor.getCaptureSampleRate() == 48000);
+
+    const int64_t hopSamples = static_cast<int64_t>(hopSize) * channels;
+    uint64_t corrupted = 0;
+    uint64_t callbacks = 0;
+    EXPECT(processor.start([&](const float* audioData, int32_t numFrames, float /*lsnr*/) {
+        callbacks++;
+        const int64_t start = static_cast<int64_t>(audioData[0]);
+        if (numFrames != hopSize || start % hopSamples != 0) {
+            corrupted++;
+            return;
+        }
+        for (int64_t i = 0; i < hopSamples; i++) {
+            if (audioData[i] != static_cast<float>(start + i)) {
+                corrupted++;
+                break;
+            }
+        }
+    }));
+
+    EXPECT(source->waitUntilFinished(10000));
+    EXPECT(waitDrained(processor, totalHops));
+    EXPECT(processor.stop());
+
+    AudioProcessorStats stats = processor.getStats();
+    EXPECT(stats.processedFrames + stats.droppedFrames == static_cast<uint64_t>(totalHops));
+    EXPECT(stats.processedFrames == callbacks);
+    EXPECT(stats.failedFrames == 0);
+    EXPECT(corrupted == 0);
+    processor.release();
+
+    // 多声道不支持采样率转换
+    AudioProcessor resampled;
+    EXPECT(resampled.setChannelCount(channels));
+    EXPECT(resampled.setOutputSampleRate(16000));
+    EXPECT(resampled.setAudioSource(std::unique_ptr<AudioSource>(new CountingSource(0.0, hopSize))));
+    EXPECT(!resampled.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+}
+
+/**
+ * 计算门控：数字静音输入（20倍速推送）在holdHops个hop后旁路，回调数量不变
+ */
+void testGatedPipeline() {
+    std::cout << "测试计算门控管线..." << std::endl;
+
+    // 5倍速推送：处理线程与其他测试争用CPU时队列也不会溢出
+    const uint64_t totalHops = 100;
+    const uint64_t totalFrames = totalHops * 480;
+    SyntheticAudioSource* source = new SyntheticAudioSource(5.0, totalFrames, 0.0f, 0.0f);
+
+    ComputeGateConfig config;
+    config.enabled = true;
+    config.holdHops = 10;
+
+    AudioProcessor processor;
+    ComputeGateConfig invalid;
+    invalid.probeIntervalHops = 0;
+    EXPECT(!processor.setComputeGate(invalid));
+    EXPECT(processor.setComputeGate(config));
+    EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+    uint64_t callbacks = 0;
+    uint64_t nonSilent = 0;
+    EXPECT(processor.start([&](const float* audioData, int32_t numFrames, float /*lsnr*/) {
+        callbacks++;
+        for (int32_t i = 0; i < numFrames; i++) {
+            if (audioData[i] != 0.0f) {
+                nonSilent++;
+                break;
+            }
+        }
+    }));
+
+    EXPECT(source->waitUntilFinished(10000));
+    EXPECT(waitDrained(processor, totalHops));
+    EXPECT(processor.stop());
+
+    AudioProcessorStats stats = processor.getStats();
+    ComputeGateStats gateStats = processor.getComputeGateStats();
+    std::cout << "  处理 " << stats.processedFrames << " 帧，旁路 " << stats.bypassedFrames << " 帧" << std::endl;
+    EXPECT(stats.droppedFrames == 0);
+    EXPECT(stats.processedFrames == totalHops);
+    EXPECT(callbacks == totalHops);
+    EXPECT(nonSilent == 0);
+    // 前holdHops-1个hop推理，第holdHops个hop推理并淡出，其余全部旁路
+    EXPECT(stats.bypassedFrames == totalHops - static_cast<uint64_t>(config.holdHops));
+    EXPECT(gateStats.silentHops == stats.bypassedFrames);
+    EXPECT(gateStats.transitions == 1);
+}
+
+/**
+ * 同步模式：hop在采集回调线程上直接降噪输出；回调超时后回退到处理线程，帧不丢不乱
+ */
+void testSynchronousPipeline() {
+    std::cout << "测试同步处理模式..." << std::endl;
+
+    const int32_t totalHops = 300;
+    const int32_t hopSize = 480;
+
+    AudioProcessor invalid;
+    EXPECT(!invalid.setSynchronousMode(true, 0.0f, 3));
+    EXPECT(!invalid.setSynchronousMode(true, 0.8f, 0));
+
+    // 处理开销远小于回调时长：全部hop在采集回调中处理
+    {
+        CountingSource* source = new CountingSource(20.0, static_cast<int64_t>(totalHops) * hopSize);
+        AudioProcessor processor;
+        EXPECT(processor.setSynchronousMode(true));
+        EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+        EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+        std::thread::id callbackThread;
+        uint64_t threadSwitches = 0;
+        uint64_t outOfOrder = 0;
+        float expected = 0.0f;
+        EXPECT(processor.start([&](const float* audioData, int32_t numFrames, float /*lsnr*/) {
+            if (callbackThread != std::this_thread::get_id()) {
+                callbackThread = std::this_thread::get_id();
+                threadSwitches++;
+            }
+            if (audioData[0] != expected) {
+                outOfOrder++;
+            }
+            expected = audioData[0] + static_cast<float>(numFrames);
+        }));
+        EXPECT(processor.isSynchronousActive());
+        EXPECT(source->waitUntilFinished(10000));
+        EXPECT(processor.stop());
+
+        AudioProcessorStats stats = processor.getStats();
+        EXPECT(stats.processedFrames == static_cast<uint64_t>(totalHops));
+        EXPECT(stats.syncFrames == stats.processedFrames);
+        EXPECT(stats.droppedFrames == 0);
+        EXPECT(!stats.syncFallback);
+        EXPECT(threadSwitches == 1);
+        EXPECT(outOfOrder == 0);
+        // 同步处理不经过队列
+        EXPECT(stats.queueLatency.maxUs < 1000);
+    }
+
+    // 输出回调耗时超过采集回调时长：连续超时3次后回退到异步处理
+    // 2倍速推送，阻塞期间积压的数据追赶时不会溢出队列
+    {
+        const int32_t fallbackHops = 100;
+        CountingSource* source = new CountingSource(2.0, static_cast<int64_t>(fallbackHops) * hopSize);
+        AudioProcessor processor;
+        EXPECT(processor.setSynchronousMode(true, 0.8f, 3));
+        EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+        EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+        uint64_t callbacks = 0;
+        uint64_t outOfOrder = 0;
+        float expected = 0.0f;
+        EXPECT(processor.start([&](const float* audioData, int32_t numFrames, float /*lsnr*/) {
+            if (callbacks++ < 3) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(6));
+            }
+            if (audioData[0] != expected) {
+                outOfOrder++;
+            }
+            expected = audioData[0] + static_cast<float>(numFrames);
+        }));
+        EXPECT(source->waitUntilFinished(10000));
+        EXPECT(waitDrained(processor, fallbackHops));
+        EXPECT(processor.stop());
+
+        AudioProcessorStats stats = processor.getStats();
+        std::cout << "  同步处理 " << stats.syncFrames << " 帧，超时 " << stats.missedDeadlines
+                  << " 次，共处理 " << stats.processedFrames << " 帧" << std::endl;
+        EXPECT(stats.syncFallback);
+        EXPECT(!processor.isSynchronousActive());
+        EXPECT(stats.missedDeadlines >= 3);
+        EXPECT(stats.syncFrames == 3);
+        EXPECT(stats.processedFrames == static_cast<uint64_t>(fallbackHops));
+        EXPECT(stats.droppedFrames == 0);
+        EXPECT(outOfOrder == 0);
+    }
+}
+
+/**
+ * 双工模式：降噪结果经播放缓冲区送入输出流，输出时钟比采集快500ppm
+ */
+void testDuplexPipeline() {
+    std::cout << "测试双工模式..." << std::endl;
+
+    const int32_t totalHops = 100;
+    const int32_t hopSize = 480;
+    const int64_t totalSamples = static_cast<int64_t>(totalHops) * hopSize;
+
+    // 主机构建必须显式设置输出流
+    {
+        AudioProcessor processor;
+        EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(new CountingSource(2.0, totalSamples))));
+        EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+        EXPECT(!processor.startDuplex());
+        EXPECT(!processor.isProcessing());
+    }
+
+    CountingSource* source = new CountingSource(2.0, totalSamples);
+    PacedAudioOutput* output = new PacedAudioOutput(2.0, 500.0, static_cast<size_t>(totalSamples) * 2);
+    AudioProcessor processor;
+    EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+    EXPECT(processor.setAudioOutput(std::unique_ptr<AudioOutput>(output)));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+    uint64_t monitorFrames = 0;
+    EXPECT(processor.startDuplex([&](const float* /*audioData*/, int32_t numFrames, float /*lsnr*/) {
+        monitorFrames += static_cast<uint64_t>(numFrames);
+    }));
+    EXPECT(source->waitUntilFinished(10000));
+    EXPECT(waitDrained(processor, totalHops));
+
+    // 等待输出流读完播放缓冲区（剩余不足一个burst时欠载）
+    for (int i = 0; i < 5000 && processor.getPlayoutStats().fillFrames > 200; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT(processor.stop());
+
+    const AudioProcessorStats stats = processor.getStats();
+    const PlayoutBufferStats playout = processor.getPlayoutStats();
+    std::cout << "  播放 " << playout.renderedFrames << " 帧，静音 " << playout.silentFrames
+              << " 帧，欠载 " << playout.underruns << " 次，修正 " << playout.correctionPpm
+              << "ppm，目标深度 " << playout.targetFrames << " 帧" << std::endl;
+    EXPECT(stats.processedFrames == static_cast<uint64_t>(totalHops));
+    EXPECT(monitorFrames == static_cast<uint64_t>(totalSamples));
+    EXPECT(playout.writtenFrames == static_cast<uint64_t>(totalSamples));
+    EXPECT(playout.overflowFrames == 0);
+    EXPECT(playout.targetFrames == hopSize + 2 * 192);
+    EXPECT(playout.renderedFrames == output->getRenderedFrames());
+
+    // 输出为采样序号的（插值）斜坡：从头开始，相邻非静音采样相差约1，没有跳跃或重复，并播放到接近末尾
+    const std::vector<float>& recording = output->getRecording();
+    float first = -1.0f;
+    float last = 0.0f;
+    uint64_t discontinuities = 0;
+    for (size_t i = 1; i < recording.size(); i++) {
+        if (recording[i] > 0.0f && first < 0.0f) {
+            first = recording[i];
+        }
+        if (recording[i] > 0.0f && recording[i - 1] > 0.0f &&
+            std::fabs(recording[i] - recording[i - 1] - 1.0f) > 0.02f) {
+            discontinuities++;
+        }
+        last = std::max(last, recording[i]);
+    }
+    EXPECT(first > 0.0f && first <= 1.01f);
+    EXPECT(discontinuities == 0);
+    // 停止时播放缓冲区最多剩余200帧（不足一个burst的部分不会被读走），另留一个burst的余量给插值和时钟修正
+    EXPECT(last >= static_cast<float>(totalSamples - 200 - 192));
+}
+
+/**
+ * 管线延迟分解和延迟档位
+ */
+void testLatencyProfiles() {
+    std::cout << "测试延迟档位..." << std::endl;
+
+    const int32_t totalHops = 100;
+    const int32_t hopSize = 480;
+    const int64_t totalSamples = static_cast<int64_t>(totalHops) * hopSize;
+
+    // 未初始化时全部为0；直通桩没有算法延迟，16kHz输出时分块和重采样按输出采样率换算
+    {
+        AudioProcessor processor;
+        EXPECT(processor.getPipelineDelay().totalFrames == 0);
+        EXPECT(processor.getLatencyProfile() == LatencyProfile::HIGH_QUALITY);
+
+        EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(
+            new SyntheticAudioSource(20.0, 16000, 1000.0f, 0.0f, 16000))));
+        EXPECT(processor.setOutputSampleRate(16000));
+        EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+        const PipelineDelay delay = processor.getPipelineDelay();
+        const int64_t resamplerFrames = processor.getStats().resamplerLatencyUs * 16000 / 1000000;
+        EXPECT(delay.sampleRate == 16000);
+        EXPECT(delay.lookaheadHops == 0);
+        EXPECT(delay.algorithmicFrames == 0);
+        EXPECT(delay.blockingFrames == 160);
+        EXPECT(delay.queueFrames == 0);
+        EXPECT(delay.resamplerFrames == resamplerFrames && resamplerFrames > 0);
+        EXPECT(delay.playoutFrames == 0);
+        EXPECT(delay.totalFrames == delay.blockingFrames + delay.resamplerFrames);
+    }
+
+    // 档位只切换同步模式开关，调用方设置的截止比例和回退阈值在切换后保留
+    {
+        AudioProcessor processor;
+        EXPECT(processor.setSynchronousMode(false, 0.5f, 7));
+        EXPECT(processor.setLatencyProfile(LatencyProfile::LOW_LATENCY));
+        EXPECT(processor.getSynchronousDeadlineRatio() == 0.5f);
+        EXPECT(processor.getSynchronousMaxMissedDeadlines() == 7);
+        EXPECT(processor.setLatencyProfile(LatencyProfile::HIGH_QUALITY));
+        EXPECT(processor.getSynchronousDeadlineRatio() == 0.5f);
+        EXPECT(processor.getSynchronousMaxMissedDeadlines() == 7);
+    }
+
+    // 低延迟档位的双工模式：同步处理，播放缓冲目标为一个hop加一个burst，排队为0
+    {
+        CountingSource* source = new CountingSource(2.0, totalSamples);
+        PacedAudioOutput* output = new PacedAudioOutput(2.0);
+        AudioProcessor processor;
+        EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+        EXPECT(processor.setAudioOutput(std::unique_ptr<AudioOutput>(output)));
+        EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+        EXPECT(processor.setLatencyProfile(LatencyProfile::LOW_LATENCY));
+        EXPECT(processor.getLatencyProfile() == LatencyProfile::LOW_LATENCY);
+
+        EXPECT(processor.startDuplex());
+        EXPECT(!processor.setLatencyProfile(LatencyProfile::HIGH_QUALITY));
+        EXPECT(processor.isSynchronousActive());
+
+        const PipelineDelay delay = processor.getPipelineDelay();
+        EXPECT(delay.sampleRate == 48000);
+        EXPECT(delay.blockingFrames == hopSize);
+        EXPECT(delay.queueFrames == 0);
+        EXPECT(delay.resamplerFrames == 0);
+        EXPECT(delay.playoutFrames == hopSize + 192);
+        EXPECT(delay.totalFrames == hopSize + hopSize + 192);
+
+        EXPECT(source->waitUntilFinished(10000));
+        EXPECT(processor.stop());
+        EXPECT(processor.getPlayoutStats().targetFrames == hopSize + 192);
+        EXPECT(processor.getStats().syncFrames > 0);
+
+        // 停止后播放缓冲不再计入；切回高质量档位后恢复异步处理
+        EXPECT(processor.getPipelineDelay().playoutFrames == 0);
+        EXPECT(processor.setLatencyProfile(LatencyProfile::HIGH_QUALITY));
+        EXPECT(processor.start([](const float* /*audioData*/, int32_t /*numFrames*/, float /*lsnr*/) {}));
+        EXPECT(!processor.isSynchronousActive());
+        EXPECT(processor.stop());
+    }
+}
+
+/**
+ * 整个采集期间从多个线程高频调整降噪参数：写入经邮箱合并，在hop边界生效，帧不丢不乱
+ */
+void testParameterUpdates() {
+    std::cout << "测试参数更新..." << std::endl;
+
+    const int32_t totalHops = 100;
+    const int32_t hopSize = 480;
+
+    AudioProcessor processor;
+    EXPECT(!processor.setPostFilterBeta(0.02f));     // 未初始化
+    EXPECT(!processor.setParameterRamp(-1));
+    // 实时节奏：测试检查的是参数合并下发，不是处理线程能否跟上加速的采集
+    CountingSource* source = new CountingSource(1.0, static_cast<int64_t>(totalHops) * hopSize);
+    EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+    EXPECT(processor.setParameterRamp(30));
+    EXPECT(!processor.setPostFilterBeta(-1.0f));
+    EXPECT(!processor.setAttenLimDb(NAN));
+
+    uint64_t outOfOrder = 0;
+    float expected = 0.0f;
+    EXPECT(processor.start([&](const float* audioData, int32_t numFrames, float /*lsnr*/) {
+        if (audioData[0] != expected) {
+            outOfOrder++;
+        }
+        expected = audioData[0] + static_cast<float>(numFrames);
+    }));
+
+    // 两个写入线程不停写入，直到采集结束：每个hop开始时都有新的目标值
+    std::atomic<bool> running(true);
+    std::thread slider([&]() {
+        for (int i = 0; running.load(std::memory_order_relaxed); i++) {
+            processor.setAttenLimDb(static_cast<float>(i % 100));
+        }
+    });
+    std::thread controller([&]() {
+        for (int i = 0; running.load(std::memory_order_relaxed); i++) {
+            processor.setPostFilterBeta(0.001f * static_cast<float>(i % 50));
+        }
+    });
+    EXPECT(source->waitUntilFinished(10000));
+    running = false;
+    slider.join();
+    controller.join();
+    EXPECT(processor.setAttenLimDb(12.0f));
+    EXPECT(processor.setPostFilterBeta(0.02f));
+
+    EXPECT(waitDrained(processor, totalHops));
+    EXPECT(processor.stop());
+
+    const AudioProcessorStats stats = processor.getStats();
+    const ParameterMailboxStats parameters = processor.getParameterStats();
+    std::cout << "  写入 " << parameters.posts << " 次，新目标 " << parameters.retargets
+              << " 次，下发 " << parameters.appliedSteps << " 次" << std::endl;
+    EXPECT(stats.processedFrames == static_cast<uint64_t>(totalHops));
+    EXPECT(stats.droppedFrames == 0);
+    EXPECT(outOfOrder == 0);
+    // 每个hop至多读取每个参数一次新目标、下发一步，其余写入被合并；
+    // 主机繁忙时处理线程会连续处理积压的hop（期间读不到新目标），只要求写入贯穿整个采集过程
+    EXPECT(parameters.posts > 2 * static_cast<uint64_t>(totalHops));
+    EXPECT(parameters.retargets >= static_cast<uint64_t>(totalHops) / 4);
+    EXPECT(parameters.appliedSteps > 0);
+    EXPECT(parameters.appliedSteps <= 2 * static_cast<uint64_t>(totalHops));
+    // 采集结束后的写入只更新目标值，斜坡收敛由parameter_mailbox_test覆盖
+    EXPECT(parameters.target[static_cast<size_t>(DenoiseParameter::ATTEN_LIM_DB)] == 12.0f);
+    EXPECT(parameters.target[static_cast<size_t>(DenoiseParameter::POST_FILTER_BETA)] == 0.02f);
+    const float attenLimDb = parameters.current[static_cast<size_t>(DenoiseParameter::ATTEN_LIM_DB)];
+    const float beta = parameters.current[static_cast<size_t>(DenoiseParameter::POST_FILTER_BETA)];
+    EXPECT(attenLimDb >= 0.0f && attenLimDb <= 100.0f);
+    EXPECT(beta >= 0.0f && beta <= 0.05f);
+}
+
+/**
+ * 模型精度：initialize按所选精度组装模型，无效的精度在设置时即被拒绝
+ */
+void testModelPrecision() {
+    std::cout << "测试模型精度..." << std::endl;
+
+    static const uint8_t variant[] = {5, 6};
+    AudioProcessor processor;
+    EXPECT(processor.getModelPrecision() == ModelPrecision::FP32);
+    EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(new SyntheticAudioSource(1.0, 480))));
+    EXPECT(processor.setModelPrecision(ModelPrecision::INT8, variant, sizeof(variant)));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+    EXPECT(processor.getFrameSize() == 480);
+
+    EXPECT(!processor.setModelPrecision(static_cast<ModelPrecision>(7), nullptr, 0));
+    EXPECT(processor.getModelPrecision() == ModelPrecision::INT8);
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+    EXPECT(processor.setModelPrecision(ModelPrecision::FP32, nullptr, 0));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+}
+
+/**
+ * 推理后端：未知的后端编号在设置时即被拒绝，保持原来的选择
+ */
+void testInferenceBackend() {
+    std::cout << "测试推理后端..." << std::endl;
+
+    AudioProcessor processor;
+    EXPECT(processor.getInferenceBackend() == InferenceBackend::TRACT);
+    EXPECT(!processor.setInferenceBackend(static_cast<InferenceBackend>(1)));     // 未分配的后端编号
+    EXPECT(processor.getInferenceBackend() == InferenceBackend::TRACT);
+    EXPECT(processor.setInferenceBackend(InferenceBackend::TRACT));
+    EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(new SyntheticAudioSource(1.0, 480))));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+}
+
+/**
+ * 推送模式：调用方推送数据，队列满时推送只接受放得下的部分；按返回值重推时不丢帧、不乱序
+ */
+void testPushMode() {
+    std::cout << "测试推送模式..." << std::endl;
+
+    const int32_t hopSize = 480;
+    const int32_t totalFrames = 100 * hopSize;
+    std::vector<float> input(totalFrames);
+    for (int32_t i = 0; i < totalFrames; i++) {
+        input[i] = static_cast<float>(i);
+    }
+
+    AudioProcessor processor;
+    EXPECT(processor.pushFloat(input.data(), hopSize, 0) == -1);  // 未处于推送模式
+    EXPECT(processor.setPushMode(true));
+    EXPECT(processor.isPushMode());
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+    EXPECT(processor.getCaptureSampleRate() == 48000);
+    EXPECT(processor.pushFloat(input.data(), hopSize, 0) == -1);  // 未启动
+    EXPECT(processor.getPushableFrames() == 0);
+
+    // 回调比推送慢，队列会被填满
+    uint64_t outOfOrder = 0;
+    float expected = 0.0f;
+    std::atomic<int64_t> received(0);
+    EXPECT(processor.start([&](const float* audioData, int32_t numFrames, float /*lsnr*/) {
+        if (audioData[0] != expected) {
+            outOfOrder++;
+        }
+        expected = audioData[0] + static_cast<float>(numFrames);
+        received.fetch_add(numFrames);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }));
+    EXPECT(processor.getPushableFrames() == 10 * hopSize);
+
+    // 前一半不等待：按返回值重推剩余部分
+    const int32_t chunk = 1000;
+    int32_t offset = 0;
+    int32_t retries = 0;
+    while (offset < totalFrames / 2) {
+        const int32_t count = std::min(chunk, totalFrames / 2 - offset);
+        const int32_t accepted = processor.pushFloat(input.data() + offset, count, 0);
+        EXPECT(accepted >= 0 && accepted <= count);
+        offset += accepted;
+        if (accepted < count) {
+            retries++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    // 后一半限时等待：一次调用全部接受
+    EXPECT(processor.pushFloat(input.data() + offset, totalFrames - offset, 5000) == totalFrames - offset);
+
+    EXPECT(waitDrained(processor, totalFrames / hopSize));
+    EXPECT(processor.stop());
+    EXPECT(processor.pushFloat(input.data(), hopSize, 100) == -1);
+
+    const AudioProcessorStats stats = processor.getStats();
+    std::cout << "  队列满 " << stats.backpressureEvents << " 次，重推 " << retries << " 次" << std::endl;
+    EXPECT(received.load() == totalFrames);
+    EXPECT(outOfOrder == 0);
+    EXPECT(stats.droppedFrames == 0);
+    EXPECT(stats.pushedFrames == static_cast<uint64_t>(totalFrames));
+    EXPECT(retries > 0);
+    EXPECT(stats.backpressureEvents >= static_cast<uint64_t>(retries));
+
+    // 16kHz PCM16：推送端转换为f32并重采样到48kHz，按返回值重推时不丢帧
+    AudioProcessor resampled;
+    EXPECT(resampled.setPushMode(true));
+    EXPECT(resampled.setCaptureSampleRate(16000));
+    EXPECT(resampled.setOutputSampleRate(16000));
+    EXPECT(resampled.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+    std::atomic<int64_t> resampledFrames(0);
+    EXPECT(resampled.start([&](const float* /*audioData*/, int32_t numFrames, float /*lsnr*/) {
+        resampledFrames.fetch_add(numFrames);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }));
+    const int32_t pcmFrames = 160 * 60;
+    std::vector<int16_t> pcm(pcmFrames, 1000);
+    offset = 0;
+    while (offset < pcmFrames) {
+        const int32_t count = std::min(1234, pcmFrames - offset);
+        const int32_t accepted = resampled.pushPcm16(pcm.data() + offset, count, 0);
+        EXPECT(accepted >= 0);
+        offset += accepted;
+        if (accepted < count) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    EXPECT(waitDrained(resampled, static_cast<uint64_t>(pcmFrames) * 3 / hopSize));
+    EXPECT(resampled.stop());
+    const AudioProcessorStats resampledStats = resampled.getStats();
+    EXPECT(resampledStats.droppedFrames == 0);
+    EXPECT(resampledStats.pushedFrames == static_cast<uint64_t>(pcmFrames));
+
+    // 关闭推送模式后主机构建没有默认音频源
+    EXPECT(resampled.setPushMode(false));
+    EXPECT(!resampled.isPushMode());
+    EXPECT(!resampled.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+}
+
+/**
+ * 提供固定采集时间戳的计数音频源：第0帧在TIMESTAMP_BASE_NS时刻被采集
+ */
+class TimestampedSource : public CountingSource {
+public:
+    static const int64_t TIMESTAMP_BASE_NS = 1000000000000LL;
+
+    TimestampedSource(double speed, int64_t totalSamples) : CountingSource(speed, totalSamples) {}
+
+    bool getTimestamp(int64_t* framePosition, int64_t* timeNs) const override {
+        *framePosition = 0;
+        *timeNs = TIMESTAMP_BASE_NS;
+        return true;
+    }
+};
+
+/**
+ * 帧位置和时间戳：位置与采集采样序号一致，时间戳按音频源时间戳换算；
+ * 队列溢出丢帧后的第一块标记为不连续，缺少的帧数与丢弃统计一致
+ */
+void testFrameInfo() {
+    std::cout << "测试帧位置和时间戳..." << std::endl;
+
+    const int32_t hopSize = 480;
+    const int32_t totalHops = 2000;
+
+    // 不限速推送、回调较慢：队列溢出丢帧
+    TimestampedSource* source = new TimestampedSource(0.0, static_cast<int64_t>(totalHops) * hopSize);
+    AudioProcessor processor;
+    EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+    int64_t nextPosition = 0;
+    uint64_t wrongPosition = 0;
+    uint64_t wrongTimestamp = 0;
+    uint64_t wrongGap = 0;
+    uint64_t softwareTimestamps = 0;
+    uint64_t discontinuities = 0;
+    int64_t droppedFrames = 0;
+    EXPECT(processor.startWithFrameInfo([&](const float* audioData, int32_t numFrames, float /*lsnr*/,
+                                            const FrameInfo& info) {
+        // 直通桩无算法延迟，块的位置即第一个采样的序号
+        if (info.framePosition != static_cast<int64_t>(audioData[0])) {
+            wrongPosition++;
+        }
+        if (!info.hardwareTimestamp) {
+            softwareTimestamps++;
+        } else if (info.timestampNs != TimestampedSource::TIMESTAMP_BASE_NS +
+                                           info.framePosition * 1000000000LL / 48000) {
+            wrongTimestamp++;
+        }
+        if (info.discontinuity != (info.framePosition != nextPosition) ||
+            info.droppedFrames != info.framePosition - nextPosition) {
+            wrongGap++;
+        }
+        if (info.discontinuity) {
+            discontinuities++;
+            droppedFrames += info.droppedFrames;
+        }
+        nextPosition = info.framePosition + numFrames;
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }));
+    EXPECT(source->waitUntilFinished(10000));
+    EXPECT(waitDrained(processor, totalHops));
+    EXPECT(processor.stop());
+
+    const AudioProcessorStats stats = processor.getStats();
+    std::cout << "  丢弃 " << stats.droppedFrames << " 帧，不连续 " << stats.discontinuities << " 次" << std::endl;
+    EXPECT(stats.droppedFrames > 0);
+    EXPECT(stats.discontinuities == discontinuities);
+    EXPECT(discontinuities > 0);
+    EXPECT(droppedFrames == static_cast<int64_t>(stats.droppedFrames) * hopSize);
+    EXPECT(wrongPosition == 0);
+    EXPECT(wrongTimestamp == 0);
+    EXPECT(wrongGap == 0);
+    EXPECT(softwareTimestamps == 0);
+
+    // 实时节奏、音频源不提供时间戳：按到达时刻估计，位置连续、时间单调递增；
+    // LSNR为负（噪声较重的正常输入）不是丢帧，不报告不连续
+    const int32_t pacedHops = 50;
+    CountingSource* pacedSource = new CountingSource(5.0, static_cast<int64_t>(pacedHops) * hopSize);
+    AudioProcessor paced;
+    EXPECT(paced.setAudioSource(std::unique_ptr<AudioSource>(pacedSource)));
+    EXPECT(paced.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+    int64_t lastTimestamp = 0;
+    uint64_t nonMonotonic = 0;
+    uint64_t pacedDiscontinuities = 0;
+    uint64_t hardwareTimestamps = 0;
+    nextPosition = 0;
+    df_stub_set_lsnr(-10.0f);
+    EXPECT(paced.startWithFrameInfo([&](const float* /*audioData*/, int32_t numFrames, float /*lsnr*/,
+                                        const FrameInfo& info) {
+        if (info.discontinuity || info.framePosition != nextPosition) {
+            pacedDiscontinuities++;
+        }
+        if (info.hardwareTimestamp) {
+            hardwareTimestamps++;
+        }
+        if (info.timestampNs <= lastTimestamp) {
+            nonMonotonic++;
+        }
+        lastTimestamp = info.timestampNs;
+        nextPosition = info.framePosition + numFrames;
+    }));
+    EXPECT(pacedSource->waitUntilFinished(10000));
+    EXPECT(waitDrained(paced, pacedHops));
+    EXPECT(paced.stop());
+    df_stub_set_lsnr(0.0f);
+
+    const AudioProcessorStats pacedStats = paced.getStats();
+    EXPECT(pacedStats.droppedFrames == 0);
+    EXPECT(pacedStats.failedFrames == 0);
+    EXPECT(pacedStats.discontinuities == 0);
+    EXPECT(pacedDiscontinuities == 0);
+    EXPECT(hardwareTimestamps == 0);
+    EXPECT(nonMonotonic == 0);
+    EXPECT(nextPosition == static_cast<int64_t>(pacedHops) * hopSize);
+}
+
+/**
+ * 负LSNR（噪声较大的正常输入）：每个hop照常回调，不计为失败
+ */
+void testNegativeLsnr() {
+    std::cout << "测试负LSNR..." << std::endl;
+
+    const int32_t totalHops = 50;
+    const int32_t hopSize = 480;
+    CountingSource* source = new CountingSource(5.0, static_cast<int64_t>(totalHops) * hopSize);
+
+    AudioProcessor processor;
+    EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+    df_stub_set_lsnr(-10.0f);
+    std::atomic<uint64_t> callbacks(0);
+    std::atomic<uint64_t> wrongLsnr(0);
+    EXPECT(processor.start([&](const float* /*audioData*/, int32_t /*numFrames*/, float lsnr) {
+        callbacks++;
+        if (lsnr != -10.0f) {
+            wrongLsnr++;
+        }
+    }));
+    EXPECT(source->waitUntilFinished(10000));
+    EXPECT(waitDrained(processor, totalHops));
+    EXPECT(processor.stop());
+    df_stub_set_lsnr(0.0f);
+
+    const AudioProcessorStats stats = processor.getStats();
+    EXPECT(stats.failedFrames == 0);
+    EXPECT(stats.droppedFrames == 0);
+    EXPECT(stats.processedFrames == static_cast<uint64_t>(totalHops));
+    EXPECT(callbacks.load() == static_cast<uint64_t>(totalHops));
+    EXPECT(wrongLsnr.load() == 0);
+}
+
+/**
+ * 设备断开：错误回调在音频源线程上触发，处理器在单独的线程上停止，之后可以重新启动
+ */
+void testDisconnectStop() {
+    std::cout << "测试设备断开停止..." << std::endl;
+
+    DisconnectingSource* source = new DisconnectingSource(480 * 10);
+
+    AudioProcessor processor;
+    EXPECT(processor.setAudioSource(std::unique_ptr<AudioSource>(source)));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+    auto callback = [](const float* /*audioData*/, int32_t /*numFrames*/, float /*lsnr*/) {};
+    EXPECT(processor.start(callback));
+
+    bool stopped = false;
+    for (int i = 0; i < 5000 && !stopped; i++) {
+        stopped = !processor.isProcessing();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT(stopped);
+
+    // 重新启动会先等待停止线程结束
+    EXPECT(processor.start(callback));
+    EXPECT(processor.stop());
+}
+
+/**
+ * 计算门控探测到负LSNR：探测hop照常经过门控，恢复推理（负LSNR是噪声最重的情况，不能一直旁路）
+ */
+void testGateProbeNegativeLsnr() {
+    std::cout << "测试门控探测负LSNR..." << std::endl;
+
+    const int32_t hopSize = 480;
+    ComputeGateConfig config;
+    config.enabled = true;
+    config.lsnrHistoryHops = 3;
+    config.holdHops = 2;
+    config.probeIntervalHops = 4;
+
+    AudioProcessor processor;
+    EXPECT(processor.setComputeGate(config));
+    EXPECT(processor.setPushMode(true));
+    EXPECT(processor.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+    std::vector<float> hop(hopSize, 0.1f);
+    std::atomic<uint64_t> callbacks(0);
+    std::atomic<float> lastLsnr(0.0f);
+    EXPECT(processor.start([&](const float* /*audioData*/, int32_t /*numFrames*/, float lsnr) {
+        callbacks++;
+        lastLsnr.store(lsnr);
+    }));
+
+    // 逐hop推送并等待处理完，LSNR按hop切换
+    uint64_t pushed = 0;
+    auto pushHops = [&](int32_t count, float lsnr) {
+        df_stub_set_lsnr(lsnr);
+        for (int32_t i = 0; i < count; i++) {
+            EXPECT(processor.pushFloat(hop.data(), hopSize, 1000) == hopSize);
+            EXPECT(waitDrained(processor, ++pushed));
+        }
+    };
+
+    // 干净语音：LSNR历史填满后再holdHops个hop进入旁路
+    pushHops(config.lsnrHistoryHops + config.holdHops, 35.0f);
+    EXPECT(processor.getComputeGateStats().transitions == 1);
+
+    // 旁路中噪声变重：第probeIntervalHops个hop探测到负LSNR，下一个hop恢复推理
+    pushHops(config.probeIntervalHops + 5, -10.0f);
+    EXPECT(processor.stop());
+    df_stub_set_lsnr(0.0f);
+
+    const AudioProcessorStats stats = processor.getStats();
+    const ComputeGateStats gateStats = processor.getComputeGateStats();
+    EXPECT(stats.failedFrames == 0);
+    EXPECT(callbacks.load() == pushed);
+    EXPECT(gateStats.probeHops == 1);
+    EXPECT(gateStats.transitions == 2);
+    EXPECT(stats.bypassedFrames == static_cast<uint64_t>(config.probeIntervalHops - 1));
+    EXPECT(lastLsnr.load() == -10.0f);
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  AudioProcessor主机测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testRequiresSource();
+    testUnpacedPipeline();
+    testPacedPipeline();
+    testResampledPipeline();
+    testMultiChannelPipeline();
+    testGatedPipeline();
+    testSynchronousPipeline();
+    testDuplexPipeline();
+    testLatencyProfiles();
+    testParameterUpdates();
+    testModelPrecision();
+    testInferenceBackend();
+    testPushMode();
+    testFrameInfo();
+    testNegativeLsnr();
+    testGateProbeNegativeLsnr();
+    testDisconnectStop();
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
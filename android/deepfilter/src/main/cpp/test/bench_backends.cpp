@@ -0,0 +1,184 @@
+#include <iostream>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "deepfilter_ort.h"
+#include "LatencyHistogram.h"
+#include "golden_clips.h"
+
+/**
+ * 推理后端逐hop耗时对比（Linux主机）
+ *
+ * 同一模型分别创建各推理后端的实例，在金标准片段（见golden_clips.h）上逐hop交替调用
+ * （同一hop依次交给每个后端），CPU频率和温度变化对各后端的影响相同；
+ * 报告各后端逐hop耗时分布和实时率，以及输出相对tract的信噪比（确认后端之间结果一致）
+ *
+ * 用法: bench_backends <模型tar.gz路径> [--rounds <轮数>]
+ *   目前只有tract后端，此时只报告tract自身的耗时；新后端分配DF_BACKEND_*编号后加入candidates
+ */
+
+using namespace deepfilter;
+
+/**
+ * 单个后端的运行状态和结果
+ */
+struct BackendRun {
+    int32_t backend;
+    const char* name;
+    void* state = nullptr;
+    LatencyHistogram hopLatency;
+    double processSeconds = 0.0;
+    double errorEnergy = 0.0;       // 输出与tract输出之差的能量
+    double referenceEnergy = 0.0;   // tract输出能量
+    std::vector<float> output;
+};
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+static void destroyStates(std::deque<BackendRun>& runs) {
+    for (BackendRun& run : runs) {
+        df_destroy(run.state);
+        run.state = nullptr;
+    }
+}
+
+/**
+ * 主函数
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "用法: " << argv[0] << " <模型tar.gz路径> [--rounds <轮数>]" << std::endl;
+        return 1;
+    }
+
+    int rounds = 3;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--rounds") == 0) {
+            rounds = atoi(argv[i + 1]);
+        } else {
+            std::cout << "未知参数: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<uint8_t> tar;
+    if (!readFile(argv[1], tar) || tar.empty()) {
+        std::cout << "读取模型文件失败: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  推理后端对比" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    void* model = df_model_load(tar.data(), tar.size());
+    if (model == nullptr) {
+        std::cout << "加载模型失败" << std::endl;
+        return 1;
+    }
+
+    // LatencyHistogram不可复制/移动，就地构造
+    std::deque<BackendRun> runs;
+    const struct { int32_t backend; const char* name; } candidates[] = {
+        {DF_BACKEND_TRACT, "tract"},
+    };
+    for (const auto& candidate : candidates) {
+        if (df_backend_available(candidate.backend) == 0) {
+            std::cout << "  [" << candidate.name << "] 不可用（未包含在本构建中）" << std::endl;
+            continue;
+        }
+        runs.emplace_back();
+        runs.back().backend = candidate.backend;
+        runs.back().name = candidate.name;
+    }
+    if (runs.empty() || runs.front().backend != DF_BACKEND_TRACT) {
+        std::cout << "tract后端不可用" << std::endl;
+        df_model_free(model);
+        return 1;
+    }
+
+    size_t hopSize = 0;
+    double audioSeconds = 0.0;
+    for (int round = 0; round < rounds; round++) {
+        for (size_t c = 0; c < sizeof(CLIPS) / sizeof(CLIPS[0]); c++) {
+            // 每段为每个后端新建实例，结果与片段顺序无关
+            for (BackendRun& run : runs) {
+                run.state = df_create_from_model_backend(model, 1, 0.0f, 100.0f, run.backend);
+                if (run.state == nullptr) {
+                    std::cout << "创建" << run.name << "实例失败" << std::endl;
+                    destroyStates(runs);
+                    df_model_free(model);
+                    return 1;
+                }
+            }
+            hopSize = df_get_frame_size(runs.front().state);
+            const std::vector<float> input = synthesizeClip(CLIPS[c], hopSize, 1000u + static_cast<uint32_t>(c) * 17u);
+            for (BackendRun& run : runs) {
+                run.output.assign(input.size(), 0.0f);
+            }
+
+            for (size_t offset = 0; offset + hopSize <= input.size(); offset += hopSize) {
+                for (BackendRun& run : runs) {
+                    float lsnr = 0.0f;
+                    const auto start = std::chrono::steady_clock::now();
+                    const int64_t processed = df_process_frames(run.state, input.data() + offset,
+                                                                run.output.data() + offset, hopSize, &lsnr);
+                    const auto elapsed = std::chrono::steady_clock::now() - start;
+                    if (processed != 1) {
+                        std::cout << run.name << ": df_process_frames失败" << std::endl;
+                        destroyStates(runs);
+                        df_model_free(model);
+                        return 1;
+                    }
+                    run.hopLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+                    run.processSeconds += std::chrono::duration<double>(elapsed).count();
+                }
+            }
+
+            const std::vector<float>& reference = runs.front().output;
+            for (BackendRun& run : runs) {
+                for (size_t i = 0; i < reference.size(); i++) {
+                    const double diff = static_cast<double>(run.output[i]) - reference[i];
+                    run.errorEnergy += diff * diff;
+                    run.referenceEnergy += static_cast<double>(reference[i]) * reference[i];
+                }
+            }
+            destroyStates(runs);
+            audioSeconds += static_cast<double>(input.size()) / SAMPLE_RATE;
+        }
+    }
+    df_model_free(model);
+
+    const double hopUs = hopSize * 1000000.0 / SAMPLE_RATE;
+    const double tractSeconds = runs.front().processSeconds;
+    for (BackendRun& run : runs) {
+        const LatencySummary latency = run.hopLatency.snapshot();
+        std::cout << "  [" << run.name << "] 逐hop耗时: p50 " << latency.p50Us << " us, p95 " << latency.p95Us
+                  << " us, p99 " << latency.p99Us << " us, max " << latency.maxUs << " us（hop时长 " << hopUs
+                  << " us）" << std::endl;
+        std::cout << "    实时率 " << run.processSeconds / audioSeconds << "，相对tract "
+                  << tractSeconds / run.processSeconds << "x";
+        if (run.backend != DF_BACKEND_TRACT) {
+            const double snrDb = run.errorEnergy > 0.0 ? 10.0 * std::log10(run.referenceEnergy / run.errorEnergy)
+                                                       : INFINITY;
+            std::cout << "，输出相对tract信噪比 " << snrDb << " dB";
+        }
+        std::cout << "（" << latency.count << " hops）" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "AudioProcessor.h"
+#include "MappedFile.h"
+#include "SimulatedAudio.h"
+
+/**
+ * 延迟档位基准测试
+ *
+ * 以实时节奏运行双工管线（模拟音频源 -> 降噪 -> 播放缓冲 -> 模拟输出流），
+ * 对每个模型分别运行高质量和低延迟两种档位，输出延迟分解（算法/分块/重采样/播放缓冲）、
+ * 实测端到端延迟（采集回调到写入播放缓冲）和实时率（单hop推理耗时 / hop时长）
+ *
+ * 用法: bench_latency_profiles <模型tar.gz路径> [--ll-model <零前瞻模型tar.gz路径>] [--seconds <秒数>]
+ *   --ll-model 指定时额外测试零前瞻模型（如DeepFilterNet3_ll）
+ */
+
+using namespace deepfilter;
+
+static double framesToMs(int64_t frames, int32_t sampleRate) {
+    return sampleRate > 0 ? static_cast<double>(frames) * 1000.0 / sampleRate : 0.0;
+}
+
+/**
+ * 以指定档位运行一次
+ *
+ * @return true-成功
+ */
+static bool runProfile(const char* label, const MappedFile& model, LatencyProfile profile, double seconds) {
+    const uint64_t totalFrames = static_cast<uint64_t>(seconds * 48000.0);
+    SyntheticAudioSource* source = new SyntheticAudioSource(1.0, totalFrames);
+
+    AudioProcessor processor;
+    processor.setAudioSource(std::unique_ptr<AudioSource>(source));
+    processor.setAudioOutput(std::unique_ptr<AudioOutput>(new PacedAudioOutput(1.0)));
+    if (!processor.initialize(model.data(), model.size(), 0.0f, 100.0f)) {
+        std::cout << "初始化失败: " << processor.getLastError() << std::endl;
+        return false;
+    }
+    if (!processor.setLatencyProfile(profile)) {
+        std::cout << "设置延迟档位失败: " << processor.getLastError() << std::endl;
+        return false;
+    }
+
+    if (!processor.startDuplex()) {
+        std::cout << "启动失败: " << processor.getLastError() << std::endl;
+        return false;
+    }
+    // 队列积压随时间变化，固定部分在启动后即可确定
+    const PipelineDelay delay = processor.getPipelineDelay();
+    source->waitUntilFinished(24 * 3600 * 1000LL);
+    processor.stop();
+
+    const AudioProcessorStats stats = processor.getStats();
+    const PlayoutBufferStats playout = processor.getPlayoutStats();
+    const double hopUs = processor.getFrameSize() * 1000000.0 / 48000.0;
+    const int32_t rate = delay.sampleRate;
+    const int64_t fixedFrames = delay.totalFrames - delay.queueFrames;
+
+    std::cout << "  [" << label << (profile == LatencyProfile::LOW_LATENCY ? " / 低延迟" : " / 高质量") << "]"
+              << (stats.syncFallback ? "（同步模式已回退）" : "") << std::endl;
+    std::cout << "    固定延迟 " << framesToMs(fixedFrames, rate) << " ms = 算法 "
+              << framesToMs(delay.algorithmicFrames, rate) << " ms（前瞻 " << delay.lookaheadHops << " hop）+ 分块 "
+              << framesToMs(delay.blockingFrames, rate) << " ms + 重采样 "
+              << framesToMs(delay.resamplerFrames, rate) << " ms + 播放缓冲 "
+              << framesToMs(delay.playoutFrames, rate) << " ms" << std::endl;
+    std::cout << "    排队+推理: p50 " << stats.endToEndLatency.p50Us / 1000.0 << " ms, p99 "
+              << stats.endToEndLatency.p99Us / 1000.0 << " ms；合计约 "
+              << framesToMs(fixedFrames, rate) + stats.endToEndLatency.p50Us / 1000.0 << " ms (p50)" << std::endl;
+    std::cout << "    实时率: p50 " << stats.processLatency.p50Us / hopUs << ", p99 "
+              << stats.processLatency.p99Us / hopUs << "；处理 " << stats.processedFrames << " 帧（同步 "
+              << stats.syncFrames << "），丢弃 " << stats.droppedFrames << " 帧，欠载 " << playout.underruns
+              << " 次" << std::endl;
+    return true;
+}
+
+/**
+ * 主函数
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "用法: " << argv[0]
+                  << " <模型tar.gz路径> [--ll-model <零前瞻模型tar.gz路径>] [--seconds <秒数>]" << std::endl;
+        return 1;
+    }
+
+    const char* llModelPath = nullptr;
+    double seconds = 10.0;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--ll-model") == 0) {
+            llModelPath = argv[i + 1];
+        } else if (strcmp(argv[i], "--seconds") == 0) {
+            seconds = atof(argv[i + 1]);
+        } else {
+            std::cout << "未知参数: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<std::pair<std::string, std::unique_ptr<MappedFile>>> models;
+    models.emplace_back("默认模型", new MappedFile());
+    if (llModelPath != nullptr) {
+        models.emplace_back("零前瞻模型", new MappedFile());
+    }
+    for (size_t i = 0; i < models.size(); i++) {
+        const char* path = i == 0 ? argv[1] : llModelPath;
+        if (!models[i].second->open(path, false)) {
+            std::cout << models[i].second->getLastError() << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  延迟档位基准测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    for (const auto& model : models) {
+        for (LatencyProfile profile : {LatencyProfile::HIGH_QUALITY, LatencyProfile::LOW_LATENCY}) {
+            if (!runProfile(model.first.c_str(), *model.second, profile, seconds)) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
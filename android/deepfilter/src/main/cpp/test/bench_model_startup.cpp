@@ -0,0 +1,165 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <unistd.h>
+#include "MappedFile.h"
+#include "ModelCache.h"
+#include "deepfilter_ort.h"
+
+/**
+ * 模型冷/热启动基准测试
+ *
+ * 测量与AudioProcessor::initialize相同的模型加载路径（ModelCache加载 + 创建实例 + 首个hop），
+ * 分别在缓存不存在（冷）和缓存命中（热）时的耗时，并分阶段统计：
+ * - 加载模型：解压tar.gz并读取配置和ONNX字节（命中缓存时跳过解压，只剩内存映射和复制）
+ * - 创建实例：ONNX解析、图优化和流式转换（不在缓存范围内，命中与否都执行）
+ * - 首个hop：首帧降噪输出
+ *
+ * 用法: bench_model_startup <模型tar.gz路径> [重复次数]
+ */
+
+using namespace deepfilter;
+
+/**
+ * 一次初始化各阶段的耗时（毫秒）
+ */
+struct StartupTiming {
+    double loadMs = 0.0;
+    double createMs = 0.0;
+    double firstHopMs = 0.0;
+
+    double total() const { return loadMs + createMs + firstHopMs; }
+
+    void add(const StartupTiming& other) {
+        loadMs += other.loadMs;
+        createMs += other.createMs;
+        firstHopMs += other.firstHopMs;
+    }
+};
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * 执行一次初始化，记录各阶段耗时，失败返回false
+ */
+static bool initializeOnce(ModelCache& cache, const MappedFile& model, bool* hit, StartupTiming* timing) {
+    auto start = std::chrono::steady_clock::now();
+    void* handle = cache.loadModel(model.data(), model.size(), hit);
+    if (handle == nullptr) {
+        std::cout << "加载模型失败: " << cache.getLastError() << std::endl;
+        return false;
+    }
+    timing->loadMs = elapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    void* state = df_create_from_model(handle, 0.0f, 100.0f);
+    df_model_free(handle);
+    if (state == nullptr) {
+        std::cout << "创建DeepFilterNet实例失败" << std::endl;
+        return false;
+    }
+    timing->createMs = elapsedMs(start);
+
+    // 计入首个hop，得到“首帧降噪输出”时间
+    start = std::chrono::steady_clock::now();
+    float input[1024] = {0.0f};
+    float output[1024];
+    const size_t hop = df_get_frame_size(state);
+    if (hop <= 1024) {
+        df_process_frame(state, input, output, hop);
+    }
+    timing->firstHopMs = elapsedMs(start);
+
+    df_destroy(state);
+    return true;
+}
+
+/**
+ * 打印一种场景的平均分阶段耗时
+ */
+static void printStages(const char* name, const StartupTiming& sum, int repeats) {
+    std::cout << "  " << name << ": 加载模型 " << sum.loadMs / repeats << " ms, 创建实例 "
+              << sum.createMs / repeats << " ms, 首个hop " << sum.firstHopMs / repeats << " ms, 合计 "
+              << sum.total() / repeats << " ms" << std::endl;
+}
+
+/**
+ * 主函数
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "用法: " << argv[0] << " <模型tar.gz路径> [重复次数]" << std::endl;
+        return 1;
+    }
+
+    const int repeats = argc > 2 ? atoi(argv[2]) : 5;
+
+    MappedFile model;
+    if (!model.open(argv[1], false)) {
+        std::cout << model.getLastError() << std::endl;
+        return 1;
+    }
+
+    char directory[] = "/tmp/bench_model_startup_XXXXXX";
+    if (mkdtemp(directory) == nullptr) {
+        std::cout << "创建临时缓存目录失败" << std::endl;
+        return 1;
+    }
+
+    ModelCache cache;
+    cache.setDirectory(directory);
+    const std::string cachePath = cache.getCachePath(model.data(), model.size());
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  模型冷/热启动基准测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    ModelCache noCache;
+    StartupTiming uncachedTotal;
+    StartupTiming coldTotal;
+    StartupTiming warmTotal;
+    for (int i = 0; i < repeats; i++) {
+        bool hit = false;
+        StartupTiming uncached;
+        StartupTiming cold;
+        StartupTiming warm;
+        if (!initializeOnce(noCache, model, &hit, &uncached)) {
+            return 1;
+        }
+
+        // 冷启动：删除缓存，加载并重建缓存
+        unlink(cachePath.c_str());
+        if (!initializeOnce(cache, model, &hit, &cold) || hit) {
+            return 1;
+        }
+
+        // 热启动：命中缓存
+        if (!initializeOnce(cache, model, &hit, &warm) || !hit) {
+            std::cout << "缓存未命中: " << cache.getLastError() << std::endl;
+            return 1;
+        }
+
+        uncachedTotal.add(uncached);
+        coldTotal.add(cold);
+        warmTotal.add(warm);
+        std::cout << "  第" << i + 1 << "次: 无缓存 " << uncached.total() << " ms, 冷(建缓存) " << cold.total()
+                  << " ms, 热(命中) " << warm.total() << " ms" << std::endl;
+    }
+
+    std::cout << "  平均（分阶段）:" << std::endl;
+    printStages("无缓存", uncachedTotal, repeats);
+    printStages("冷    ", coldTotal, repeats);
+    printStages("热    ", warmTotal, repeats);
+    std::cout << "  命中缓存跳过: gzip解压（加载模型 " << uncachedTotal.loadMs / repeats << " -> "
+              << warmTotal.loadMs / repeats << " ms）" << std::endl;
+    std::cout << "  命中缓存仍执行: ONNX解析、图优化和流式转换（创建实例）、首个hop" << std::endl;
+    std::cout << "  热启动加速 " << uncachedTotal.total() / warmTotal.total() << "x" << std::endl;
+
+    unlink(cachePath.c_str());
+    rmdir(directory);
+    return 0;
+}
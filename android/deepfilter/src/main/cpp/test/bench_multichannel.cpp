@@ -0,0 +1,151 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include "deepfilter_ort.h"
+
+/**
+ * 多声道降噪基准测试
+ *
+ * 对比同一段N声道交织音频的两种处理方式：
+ * 1. 一个N声道实例（df_create_from_model_ex），每个hop调用一次df_process_frame_interleaved
+ * 2. N个单声道实例，每个hop先拆分声道，再逐个实例调用df_process_frame
+ *
+ * 用法: bench_multichannel <模型tar.gz路径> [声道数] [音频秒数]
+ */
+
+/**
+ * 读取模型文件
+ */
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+/**
+ * 输出一项测试结果
+ */
+static void report(const char* name, size_t hops, double seconds, double audioSeconds) {
+    std::cout << "  " << name << ": " << hops << " hops, "
+              << seconds * 1000.0 << " ms, "
+              << static_cast<double>(hops) / seconds << " hops/sec, "
+              << "RTF=" << seconds / audioSeconds << std::endl;
+}
+
+/**
+ * 主函数
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "用法: " << argv[0] << " <模型tar.gz路径> [声道数] [音频秒数]" << std::endl;
+        return 1;
+    }
+
+    const size_t channels = argc > 2 ? static_cast<size_t>(atoi(argv[2])) : 2;
+    const double audioSeconds = argc > 3 ? atof(argv[3]) : 10.0;
+    if (channels == 0) {
+        std::cout << "声道数无效" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> modelBytes;
+    if (!readFile(argv[1], modelBytes)) {
+        std::cout << "读取模型文件失败: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    void* model = df_model_load(modelBytes.data(), modelBytes.size());
+    if (model == nullptr) {
+        std::cout << "加载模型失败" << std::endl;
+        return 1;
+    }
+
+    void* batchedState = df_create_from_model_ex(model, channels, 0.0f, 100.0f);
+    std::vector<void*> monoStates(channels, nullptr);
+    for (size_t c = 0; c < channels; c++) {
+        monoStates[c] = df_create_from_model(model, 0.0f, 100.0f);
+    }
+    df_model_free(model);
+    if (batchedState == nullptr) {
+        std::cout << "创建" << channels << "声道实例失败" << std::endl;
+        return 1;
+    }
+    for (void* state : monoStates) {
+        if (state == nullptr) {
+            std::cout << "创建单声道实例失败" << std::endl;
+            return 1;
+        }
+    }
+
+    const size_t hopSize = df_get_frame_size(batchedState);
+    const size_t hopSamples = hopSize * channels;
+    const size_t totalHops = static_cast<size_t>(audioSeconds * 48000.0) / hopSize;
+    const size_t totalSamples = totalHops * hopSamples;
+
+    // 固定种子的交织白噪声输入，各声道相互独立
+    std::vector<float> input(totalSamples);
+    std::mt19937 rng(42);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    for (auto& sample : input) {
+        sample = noise(rng);
+    }
+    std::vector<float> output(totalSamples);
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  多声道降噪基准测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "  声道数: " << channels << ", hop大小: " << hopSize << ", 总hop数: " << totalHops << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < totalHops; i++) {
+        if (std::isnan(df_process_frame_interleaved(batchedState, input.data() + i * hopSamples,
+                                                    output.data() + i * hopSamples, hopSize))) {
+            std::cout << "df_process_frame_interleaved失败: hop " << i << std::endl;
+            return 1;
+        }
+    }
+    const double batchedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // 独立实例需要在调用方拆分和合并声道，计入耗时
+    std::vector<float> channelIn(hopSize);
+    std::vector<float> channelOut(hopSize);
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < totalHops; i++) {
+        const float* hopIn = input.data() + i * hopSamples;
+        float* hopOut = output.data() + i * hopSamples;
+        for (size_t c = 0; c < channels; c++) {
+            for (size_t n = 0; n < hopSize; n++) {
+                channelIn[n] = hopIn[n * channels + c];
+            }
+            if (std::isnan(df_process_frame(monoStates[c], channelIn.data(), channelOut.data(), hopSize))) {
+                std::cout << "df_process_frame失败: hop " << i << ", 声道 " << c << std::endl;
+                return 1;
+            }
+            for (size_t n = 0; n < hopSize; n++) {
+                hopOut[n * channels + c] = channelOut[n];
+            }
+        }
+    }
+    const double independentSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double processedSeconds = static_cast<double>(totalHops * hopSize) / 48000.0;
+    report("单实例多声道", totalHops, batchedSeconds, processedSeconds);
+    report("多个单声道实例", totalHops, independentSeconds, processedSeconds);
+    std::cout << "  加速比: " << independentSeconds / batchedSeconds << "x" << std::endl;
+
+    df_destroy(batchedState);
+    for (void* state : monoStates) {
+        df_destroy(state);
+    }
+    return 0;
+}
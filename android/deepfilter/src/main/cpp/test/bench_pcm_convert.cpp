@@ -0,0 +1,116 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include "deepfilter_ort.h"
+
+/**
+ * PCM格式转换内核基准测试
+ *
+ * 对比deepfilter-ort向量化内核（df_pcm16_to_f32 / df_f32_to_pcm16）与逐点标量转换的吞吐量，
+ * 并校验两者结果逐位一致
+ *
+ * 用法: bench_pcm_convert [每块采样点数] [总采样点数（百万）]
+ */
+
+/**
+ * 逐点标量参考实现（与内核语义相同）
+ */
+static void referencePcm16ToF32(const int16_t* input, float* output, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        output[i] = static_cast<float>(input[i]) / 32768.0f;
+    }
+}
+
+static void referenceF32ToPcm16(const float* input, int16_t* output, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        float scaled = input[i] * 32768.0f;
+        scaled = scaled >= -32768.0f ? scaled : -32768.0f;
+        scaled = scaled <= 32767.0f ? scaled : 32767.0f;
+        output[i] = static_cast<int16_t>(std::nearbyint(scaled));
+    }
+}
+
+/**
+ * 按块重复调用转换函数，返回吞吐量（百万采样点/秒）
+ */
+template <typename In, typename Out, typename Fn>
+static double measure(Fn convert, const std::vector<In>& input, std::vector<Out>& output,
+                      size_t blockSize, size_t totalSamples) {
+    const size_t blocks = input.size() / blockSize;
+    const auto start = std::chrono::steady_clock::now();
+    size_t done = 0;
+    size_t block = 0;
+    while (done < totalSamples) {
+        convert(input.data() + block * blockSize, output.data() + block * blockSize, blockSize);
+        done += blockSize;
+        block = (block + 1) % blocks;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return static_cast<double>(done) / seconds / 1e6;
+}
+
+/**
+ * 输出一项测试结果
+ */
+static void report(const char* name, double simd, double scalar) {
+    std::cout << "  " << name << ": 向量化 " << simd << " M采样/秒, 标量 " << scalar
+              << " M采样/秒, 加速比 " << simd / scalar << "x" << std::endl;
+}
+
+/**
+ * 主函数
+ */
+int main(int argc, char** argv) {
+    const size_t blockSize = argc > 1 ? static_cast<size_t>(atoi(argv[1])) : 480;
+    const size_t totalSamples = static_cast<size_t>((argc > 2 ? atof(argv[2]) : 200.0) * 1e6);
+    if (blockSize == 0) {
+        std::cout << "用法: " << argv[0] << " [每块采样点数] [总采样点数（百万）]" << std::endl;
+        return 1;
+    }
+
+    // 约1MB工作集，块数取整；输入为固定种子的白噪声（含超出[-1, 1)的值，覆盖饱和路径）
+    const size_t blocks = (262144 + blockSize - 1) / blockSize;
+    const size_t samples = blocks * blockSize;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pcmDist(-32768, 32767);
+    std::normal_distribution<float> floatDist(0.0f, 0.5f);
+
+    std::vector<int16_t> pcm(samples);
+    std::vector<float> floats(samples);
+    for (size_t i = 0; i < samples; i++) {
+        pcm[i] = static_cast<int16_t>(pcmDist(rng));
+        floats[i] = floatDist(rng);
+    }
+
+    // 正确性：与标量参考逐位比较
+    std::vector<float> floatOut(samples);
+    std::vector<float> floatRef(samples);
+    std::vector<int16_t> pcmOut(samples);
+    std::vector<int16_t> pcmRef(samples);
+    df_pcm16_to_f32(pcm.data(), floatOut.data(), samples);
+    referencePcm16ToF32(pcm.data(), floatRef.data(), samples);
+    df_f32_to_pcm16(floats.data(), pcmOut.data(), samples);
+    referenceF32ToPcm16(floats.data(), pcmRef.data(), samples);
+    if (floatOut != floatRef || pcmOut != pcmRef) {
+        std::cout << "转换结果与标量参考不一致" << std::endl;
+        return 1;
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  PCM格式转换基准测试（" << df_pcm_simd_name() << "）" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "  每块采样点数: " << blockSize << ", 总采样点数: " << totalSamples << std::endl;
+
+    const double toFloatSimd = measure(df_pcm16_to_f32, pcm, floatOut, blockSize, totalSamples);
+    const double toFloatScalar = measure(referencePcm16ToF32, pcm, floatRef, blockSize, totalSamples);
+    const double toPcmSimd = measure(df_f32_to_pcm16, floats, pcmOut, blockSize, totalSamples);
+    const double toPcmScalar = measure(referenceF32ToPcm16, floats, pcmRef, blockSize, totalSamples);
+
+    report("PCM16 -> f32", toFloatSimd, toFloatScalar);
+    report("f32 -> PCM16", toPcmSimd, toPcmScalar);
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include <iostream>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "AudioProcessor.h"
+#include "MappedFile.h"
+#include "SimulatedAudio.h"
+
+/**
+ * 采集->降噪->回调完整管线基准测试
+ *
+ * 用模拟音频源驱动与设备上相同的AudioProcessor管线（环形缓冲区、处理线程、回调），
+ * 分别以不限速和实时节奏运行，输出吞吐量、丢帧数和各阶段延迟分布
+ *
+ * 用法: bench_pipeline <模型tar.gz路径> [--wav <48kHz WAV>] [--seconds <合成信号秒数>] [--speed <倍速>]
+ *                      [--priority default|nice|fifo] [--affinity none|perf|<核心掩码,如0xf0>] [--boost 0|1]
+ *   --speed 0 表示不限速；不指定时依次运行不限速和实时两种配置
+ *   调度参数作用于处理线程，结果中输出各核心处理的hop数
+ */
+
+using namespace deepfilter;
+
+static void printLatency(const char* name, const LatencySummary& latency) {
+    std::cout << "    " << name << ": p50 " << latency.p50Us << " us, p95 " << latency.p95Us
+              << " us, p99 " << latency.p99Us << " us, max " << latency.maxUs << " us" << std::endl;
+}
+
+/**
+ * 以指定速度运行一次
+ *
+ * @return true-成功
+ */
+static bool runOnce(const MappedFile& model, const char* wavPath, double seconds, double speed,
+                    const ThreadSchedulingConfig& scheduling) {
+    PacedAudioSource* source = nullptr;
+    if (wavPath != nullptr) {
+        source = new FileAudioSource(wavPath, speed, false);
+    } else {
+        source = new SyntheticAudioSource(speed, static_cast<uint64_t>(seconds * 48000.0));
+    }
+
+    AudioProcessor processor;
+    processor.setAudioSource(std::unique_ptr<AudioSource>(source));
+    if (!processor.setThreadScheduling(scheduling)) {
+        std::cout << "线程调度设置失败: " << processor.getLastError() << std::endl;
+        return false;
+    }
+    if (!processor.initialize(model.data(), model.size(), 0.0f, 100.0f)) {
+        std::cout << "初始化失败: " << processor.getLastError() << std::endl;
+        return false;
+    }
+
+    NullAudioSink sink;
+    const auto start = std::chrono::steady_clock::now();
+    if (!processor.start(&sink)) {
+        std::cout << "启动失败: " << processor.getLastError() << std::endl;
+        return false;
+    }
+
+    source->waitUntilFinished(24 * 3600 * 1000LL);
+    const uint64_t pushedHops = (source->getDeliveredFrames() + processor.getFrameSize() - 1) /
+                                static_cast<uint64_t>(processor.getFrameSize());
+    while (true) {
+        AudioProcessorStats stats = processor.getStats();
+        if (stats.processedFrames + stats.droppedFrames + stats.failedFrames >= pushedHops) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    processor.stop();
+
+    const AudioProcessorStats stats = processor.getStats();
+    const double audioSeconds = static_cast<double>(source->getDeliveredFrames()) / 48000.0;
+
+    if (speed > 0.0) {
+        std::cout << "  [" << speed << "x]";
+    } else {
+        std::cout << "  [不限速]";
+    }
+    std::cout << " 音频 "
+              << audioSeconds << " s, 耗时 " << elapsed << " s, 吞吐 "
+              << static_cast<double>(stats.processedFrames) / elapsed << " hops/s" << std::endl;
+    std::cout << "    处理 " << stats.processedFrames << " 帧，丢弃 " << stats.droppedFrames
+              << " 帧，失败 " << stats.failedFrames << " 帧，超预算 " << stats.overBudgetFrames << " 帧" << std::endl;
+    printLatency("排队", stats.queueLatency);
+    printLatency("降噪", stats.processLatency);
+    printLatency("回调", stats.callbackLatency);
+    printLatency("端到端", stats.endToEndLatency);
+
+    const ThreadSchedulingStats schedulingStats = processor.getThreadSchedulingStats();
+    std::cout << "    核心:";
+    for (int32_t cpu = 0; cpu < CpuTopology::MAX_CPUS; cpu++) {
+        if (schedulingStats.coreHops[cpu] > 0) {
+            std::cout << " cpu" << cpu << "=" << schedulingStats.coreHops[cpu];
+        }
+    }
+    std::cout << "，性能核心 " << schedulingStats.performanceCoreHops << " hops，积压提升 " << schedulingStats.boosts
+              << " 次，设置失败 " << schedulingStats.failures << " 次" << std::endl;
+    return true;
+}
+
+/**
+ * 主函数
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "用法: " << argv[0]
+                  << " <模型tar.gz路径> [--wav <48kHz WAV>] [--seconds <秒数>] [--speed <倍速>]"
+                  << " [--priority default|nice|fifo] [--affinity none|perf|<核心掩码>] [--boost 0|1]" << std::endl;
+        return 1;
+    }
+
+    const char* wavPath = nullptr;
+    double seconds = 10.0;
+    std::vector<double> speeds = {0.0, 1.0};
+    ThreadSchedulingConfig scheduling;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--wav") == 0) {
+            wavPath = argv[i + 1];
+        } else if (strcmp(argv[i], "--seconds") == 0) {
+            seconds = atof(argv[i + 1]);
+        } else if (strcmp(argv[i], "--speed") == 0) {
+            speeds = {atof(argv[i + 1])};
+        } else if (strcmp(argv[i], "--priority") == 0) {
+            const char* value = argv[i + 1];
+            scheduling.priority = strcmp(value, "fifo") == 0 ? ThreadPriority::FIFO
+                                : strcmp(value, "nice") == 0 ? ThreadPriority::NICE
+                                : ThreadPriority::DEFAULT;
+        } else if (strcmp(argv[i], "--affinity") == 0) {
+            const char* value = argv[i + 1];
+            if (strcmp(value, "perf") == 0) {
+                scheduling.affinity = CpuAffinity::PERFORMANCE_CORES;
+            } else if (strcmp(value, "none") != 0) {
+                scheduling.affinity = CpuAffinity::CPUSET;
+                scheduling.cpuMask = strtoull(value, nullptr, 0);
+            }
+        } else if (strcmp(argv[i], "--boost") == 0) {
+            scheduling.boostOnBacklog = atoi(argv[i + 1]) != 0;
+        } else {
+            std::cout << "未知参数: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    MappedFile model;
+    if (!model.open(argv[1], false)) {
+        std::cout << model.getLastError() << std::endl;
+        return 1;
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  采集->降噪->回调管线基准测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    for (double speed : speeds) {
+        if (!runOnce(model, wavPath, seconds, speed, scheduling)) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,298 @@
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "deepfilter_ort.h"
+#include "LatencyHistogram.h"
+#include "ModelCache.h"
+#include "golden_clips.h"
+
+/**
+ * 模型精度（FP32/FP16/INT8）精度-速度基准测试
+ *
+ * 在金标准片段（见golden_clips.h）上逐hop运行各精度的模型，以FP32输出为参考报告：
+ * 1. 速度：模型加载耗时、逐hop推理耗时分布和实时率
+ * 2. 精度：输出相对FP32的信噪比（逐采样误差）、逐hop能量最大偏差、LSNR平均偏差，
+ *    以及落在金标准容差（能量±1dB、LSNR±2dB）内的hop比例
+ * 结果用于按设备档位选择精度：实时率有余量的设备用FP32，低端设备在精度可接受时改用FP16/INT8
+ *
+ * 用法: bench_precision <模型tar.gz路径> [--variant <变体包tar.gz路径>] [--precisions fp32,fp16,int8]
+ *   模型中缺少某个精度的子网络时该精度标记为不可用，不影响其他精度
+ */
+
+using namespace deepfilter;
+
+static const float SILENCE_DB = -70.0f;
+static const float TOLERANCE_DB = 1.0f;
+static const float TOLERANCE_LSNR = 2.0f;
+
+/**
+ * 单个精度的运行结果
+ */
+struct PrecisionRun {
+    ModelPrecision precision;
+    bool available = false;
+    double loadMs = 0.0;
+    size_t modelBytes = 0;
+    LatencySummary latency;
+    double realTimeFactor = 0.0;
+    std::vector<std::vector<float>> outputs;    // 每段输出
+    std::vector<std::vector<float>> lsnr;       // 每段逐hop LSNR
+};
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+static float hopRmsDb(const float* samples, size_t hopSize) {
+    double sum = 0.0;
+    for (size_t i = 0; i < hopSize; i++) {
+        sum += static_cast<double>(samples[i]) * samples[i];
+    }
+    return static_cast<float>(10.0 * std::log10(sum / hopSize + 1e-12));
+}
+
+/**
+ * 加载指定精度的模型（与AudioProcessor::initialize相同：FP32且没有变体包时直接加载）
+ */
+static void* loadModel(const std::vector<uint8_t>& tar, const std::vector<uint8_t>& variant,
+                       ModelPrecision precision, size_t* modelBytes) {
+    *modelBytes = tar.size();
+    if (precision == ModelPrecision::FP32 && variant.empty()) {
+        return df_model_load(tar.data(), tar.size());
+    }
+
+    size_t selectedSize = 0;
+    uint8_t* selected = df_model_select_precision(tar.data(), tar.size(), variant.empty() ? nullptr : variant.data(),
+                                                  variant.size(), static_cast<int32_t>(precision), &selectedSize);
+    if (selected == nullptr) {
+        return nullptr;
+    }
+    *modelBytes = selectedSize;
+    void* model = df_model_load(selected, selectedSize);
+    df_free_buffer(selected, selectedSize);
+    return model;
+}
+
+/**
+ * 在所有片段上运行一个精度
+ *
+ * @return false-运行失败（不可用的精度返回true，available为false）
+ */
+static bool runPrecision(const std::vector<uint8_t>& tar, const std::vector<uint8_t>& variant,
+                         const std::vector<std::vector<float>>& inputs, size_t hopSize, PrecisionRun& run) {
+    const auto loadStart = std::chrono::steady_clock::now();
+    void* model = loadModel(tar, variant, run.precision, &run.modelBytes);
+    run.loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+    if (model == nullptr) {
+        return true;
+    }
+    run.available = true;
+
+    LatencyHistogram hopLatency;
+    double processSeconds = 0.0;
+    double audioSeconds = 0.0;
+    for (const std::vector<float>& input : inputs) {
+        // 每段使用新实例，结果与片段顺序无关
+        void* state = df_create_from_model(model, 0.0f, 100.0f);
+        if (state == nullptr || df_get_frame_size(state) != hopSize) {
+            std::cout << "创建DeepFilterNet实例失败（" << ModelCache::precisionName(run.precision) << "）" << std::endl;
+            df_destroy(state);
+            df_model_free(model);
+            return false;
+        }
+
+        std::vector<float> output(input.size());
+        std::vector<float> lsnr(input.size() / hopSize);
+        for (size_t h = 0; h < lsnr.size(); h++) {
+            const auto start = std::chrono::steady_clock::now();
+            const int64_t processed = df_process_frames(state, input.data() + h * hopSize,
+                                                        output.data() + h * hopSize, hopSize, &lsnr[h]);
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            if (processed != 1) {
+                std::cout << "df_process_frames失败，hop " << h << std::endl;
+                df_destroy(state);
+                df_model_free(model);
+                return false;
+            }
+            hopLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+            processSeconds += std::chrono::duration<double>(elapsed).count();
+        }
+        df_destroy(state);
+        audioSeconds += static_cast<double>(input.size()) / SAMPLE_RATE;
+        run.outputs.push_back(std::move(output));
+        run.lsnr.push_back(std::move(lsnr));
+    }
+    df_model_free(model);
+
+    run.latency = hopLatency.snapshot();
+    run.realTimeFactor = processSeconds / audioSeconds;
+    return true;
+}
+
+/**
+ * 输出相对FP32参考的精度
+ */
+static void reportAccuracy(const PrecisionRun& run, const PrecisionRun& reference, size_t hopSize) {
+    for (size_t c = 0; c < run.outputs.size(); c++) {
+        const std::vector<float>& actual = run.outputs[c];
+        const std::vector<float>& expected = reference.outputs[c];
+
+        double signal = 0.0;
+        double error = 0.0;
+        for (size_t i = 0; i < actual.size(); i++) {
+            const double diff = static_cast<double>(actual[i]) - expected[i];
+            signal += static_cast<double>(expected[i]) * expected[i];
+            error += diff * diff;
+        }
+
+        float maxDiffDb = 0.0f;
+        double sumDiffLsnr = 0.0;
+        size_t withinTolerance = 0;
+        const size_t hops = run.lsnr[c].size();
+        for (size_t h = 0; h < hops; h++) {
+            const float actualDb = hopRmsDb(actual.data() + h * hopSize, hopSize);
+            const float expectedDb = hopRmsDb(expected.data() + h * hopSize, hopSize);
+            const bool silent = actualDb < SILENCE_DB && expectedDb < SILENCE_DB;
+            const float diffDb = silent ? 0.0f : std::fabs(actualDb - expectedDb);
+            const float diffLsnr = std::fabs(run.lsnr[c][h] - reference.lsnr[c][h]);
+            maxDiffDb = std::max(maxDiffDb, diffDb);
+            sumDiffLsnr += diffLsnr;
+            if (diffDb <= TOLERANCE_DB && diffLsnr <= TOLERANCE_LSNR) {
+                withinTolerance++;
+            }
+        }
+
+        const double snrDb = error > 0.0 ? 10.0 * std::log10(signal / error) : INFINITY;
+        std::cout << "    " << CLIPS[c].name << ": 相对FP32信噪比 " << snrDb << " dB，能量最大偏差 " << maxDiffDb
+                  << " dB，LSNR平均偏差 " << sumDiffLsnr / hops << " dB，容差内 "
+                  << 100.0 * withinTolerance / hops << "%" << std::endl;
+    }
+}
+
+static bool parsePrecisions(const char* list, std::vector<ModelPrecision>& precisions) {
+    precisions.clear();
+    std::string remaining = list;
+    while (!remaining.empty()) {
+        const size_t comma = remaining.find(',');
+        const std::string name = remaining.substr(0, comma);
+        remaining = comma == std::string::npos ? std::string() : remaining.substr(comma + 1);
+        bool found = false;
+        for (ModelPrecision precision : {ModelPrecision::FP32, ModelPrecision::FP16, ModelPrecision::INT8}) {
+            if (name == ModelCache::precisionName(precision)) {
+                precisions.push_back(precision);
+                found = true;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return !precisions.empty();
+}
+
+/**
+ * 主函数
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "用法: " << argv[0]
+                  << " <模型tar.gz路径> [--variant <变体包tar.gz路径>] [--precisions fp32,fp16,int8]" << std::endl;
+        return 1;
+    }
+
+    std::vector<uint8_t> tar;
+    std::vector<uint8_t> variant;
+    std::vector<ModelPrecision> precisions = {ModelPrecision::FP32, ModelPrecision::FP16, ModelPrecision::INT8};
+    if (!readFile(argv[1], tar) || tar.empty()) {
+        std::cout << "读取模型文件失败: " << argv[1] << std::endl;
+        return 1;
+    }
+    for (int i = 2; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--variant") == 0) {
+            if (!readFile(argv[i + 1], variant)) {
+                std::cout << "读取变体包失败: " << argv[i + 1] << std::endl;
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--precisions") == 0) {
+            if (!parsePrecisions(argv[i + 1], precisions)) {
+                std::cout << "无效的精度列表: " << argv[i + 1] << std::endl;
+                return 1;
+            }
+        } else {
+            std::cout << "未知参数: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+    // FP32始终运行，作为精度参考
+    if (std::find(precisions.begin(), precisions.end(), ModelPrecision::FP32) == precisions.end()) {
+        precisions.insert(precisions.begin(), ModelPrecision::FP32);
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  模型精度基准测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    // 先用FP32实例取hop大小，各片段输入对所有精度相同
+    void* probeModel = df_model_load(tar.data(), tar.size());
+    void* probe = probeModel != nullptr ? df_create_from_model(probeModel, 0.0f, 100.0f) : nullptr;
+    if (probe == nullptr) {
+        std::cout << "加载模型失败" << std::endl;
+        df_model_free(probeModel);
+        return 1;
+    }
+    const size_t hopSize = df_get_frame_size(probe);
+    df_destroy(probe);
+    df_model_free(probeModel);
+
+    std::vector<std::vector<float>> inputs;
+    for (size_t c = 0; c < sizeof(CLIPS) / sizeof(CLIPS[0]); c++) {
+        inputs.push_back(synthesizeClip(CLIPS[c], hopSize, 1000u + static_cast<uint32_t>(c) * 17u));
+    }
+
+    std::vector<PrecisionRun> runs;
+    for (ModelPrecision precision : precisions) {
+        PrecisionRun run;
+        run.precision = precision;
+        if (!runPrecision(tar, variant, inputs, hopSize, run)) {
+            return 1;
+        }
+        runs.push_back(std::move(run));
+    }
+
+    const PrecisionRun& reference = runs.front();
+    if (!reference.available) {
+        std::cout << "FP32模型不可用" << std::endl;
+        return 1;
+    }
+
+    const double hopUs = hopSize * 1000000.0 / SAMPLE_RATE;
+    for (const PrecisionRun& run : runs) {
+        std::cout << "  [" << ModelCache::precisionName(run.precision) << "]";
+        if (!run.available) {
+            std::cout << " 不可用（模型和变体包中缺少该精度的子网络）" << std::endl;
+            continue;
+        }
+        std::cout << " 模型 " << run.modelBytes / 1024 << " KB，加载 " << run.loadMs << " ms" << std::endl;
+        std::cout << "    逐hop耗时: p50 " << run.latency.p50Us << " us, p99 " << run.latency.p99Us << " us, max "
+                  << run.latency.maxUs << " us（hop时长 " << hopUs << " us）；实时率 " << run.realTimeFactor
+                  << "（相对FP32 " << reference.realTimeFactor / run.realTimeFactor << "x）" << std::endl;
+        if (&run != &reference) {
+            reportAccuracy(run, reference, hopSize);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include "deepfilter_ort.h"
+
+/**
+ * df_process_frames吞吐量基准测试
+ *
+ * 对比逐hop调用df_process_frame与一次调用df_process_frames的吞吐量（hops/sec）
+ *
+ * 用法: bench_process_frames <模型tar.gz路径> [音频秒数] [每批hop数]
+ */
+
+/**
+ * 读取模型文件
+ */
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+/**
+ * 输出一项测试结果
+ */
+static void report(const char* name, size_t hops, double seconds, double audioSeconds) {
+    std::cout << "  " << name << ": " << hops << " hops, "
+              << seconds * 1000.0 << " ms, "
+              << static_cast<double>(hops) / seconds << " hops/sec, "
+              << "RTF=" << seconds / audioSeconds << std::endl;
+}
+
+/**
+ * 主函数
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "用法: " << argv[0] << " <模型tar.gz路径> [音频秒数] [每批hop数]" << std::endl;
+        return 1;
+    }
+
+    const double audioSeconds = argc > 2 ? atof(argv[2]) : 10.0;
+    const size_t batchHops = argc > 3 ? static_cast<size_t>(atoi(argv[3])) : 100;
+
+    std::vector<uint8_t> model;
+    if (!readFile(argv[1], model)) {
+        std::cout << "读取模型文件失败: " << argv[1] << std::endl;
+        return 1;
+    }
+
+    void* loopState = df_create(model.data(), model.size(), 0.0f, 100.0f);
+    void* batchState = df_create(model.data(), model.size(), 0.0f, 100.0f);
+    if (loopState == nullptr || batchState == nullptr) {
+        std::cout << "创建DeepFilterNet实例失败" << std::endl;
+        return 1;
+    }
+
+    const size_t hopSize = df_get_frame_size(loopState);
+    const size_t totalHops = static_cast<size_t>(audioSeconds * 48000.0) / hopSize / batchHops * batchHops;
+    const size_t totalSamples = totalHops * hopSize;
+
+    // 固定种子的白噪声输入，保证两种方式处理相同数据
+    std::vector<float> input(totalSamples);
+    std::mt19937 rng(42);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    for (auto& sample : input) {
+        sample = noise(rng);
+    }
+    std::vector<float> output(totalSamples);
+    std::vector<float> lsnr(batchHops);
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  df_process_frames基准测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "  hop大小: " << hopSize << ", 总hop数: " << totalHops
+              << ", 每批hop数: " << batchHops << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < totalHops; i++) {
+        if (std::isnan(df_process_frame(loopState, input.data() + i * hopSize, output.data() + i * hopSize, hopSize))) {
+            std::cout << "df_process_frame失败: hop " << i << std::endl;
+            return 1;
+        }
+    }
+    double loopSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < totalHops; i += batchHops) {
+        int64_t processed = df_process_frames(batchState, input.data() + i * hopSize,
+                                              output.data() + i * hopSize, batchHops * hopSize, lsnr.data());
+        if (processed != static_cast<int64_t>(batchHops)) {
+            std::cout << "df_process_frames失败: 批起始hop " << i << std::endl;
+            return 1;
+        }
+    }
+    double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double processedSeconds = static_cast<double>(totalSamples) / 48000.0;
+    report("df_process_frame 循环", totalHops, loopSeconds, processedSeconds);
+    report("df_process_frames 批量", totalHops, batchSeconds, processedSeconds);
+    std::cout << "  加速比: " << loopSeconds / batchSeconds << "x" << std::endl;
+
+    df_destroy(loopState);
+    df_destroy(batchState);
+    return 0;
+}
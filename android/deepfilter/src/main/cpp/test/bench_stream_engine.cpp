@@ -0,0 +1,153 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <cstdint>
+#include <cstdlib>
+#include "MappedFile.h"
+#include "StreamEngine.h"
+
+/**
+ * StreamEngine多核扩展性基准测试
+ *
+ * 工作线程数从1翻倍到硬件并发数，每种配置下以最快速度向所有流写入相同长度的音频，
+ * 输出吞吐量（hops/sec）、相对单线程的加速比、可实时承载的流数和延迟
+ *
+ * 用法: bench_stream_engine <模型tar.gz路径> [流数] [每路音频秒数]
+ */
+
+using namespace deepfilter;
+
+/**
+ * 运行一种工作线程配置
+ *
+ * @return 吞吐量（hops/sec），失败返回0
+ */
+static double runConfig(const MappedFile& model, size_t workers, size_t streamCount, double audioSeconds) {
+    StreamEngine engine;
+    StreamEngineConfig config;
+    config.workerCount = workers;
+    config.maxStreams = streamCount;
+    config.queueHops = 64;
+    if (!engine.initialize(model.data(), model.size(), 0.0f, 100.0f, config)) {
+        std::cout << "初始化引擎失败: " << engine.getLastError() << std::endl;
+        return 0.0;
+    }
+
+    const size_t hop = engine.getFrameSize();
+    const size_t hopsPerStream = static_cast<size_t>(audioSeconds * 48000.0) / hop;
+
+    std::vector<int32_t> ids;
+    const auto createStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < streamCount; i++) {
+        int32_t id = engine.createStream(nullptr);
+        if (id < 0) {
+            std::cout << "创建流失败: " << engine.getLastError() << std::endl;
+            return 0.0;
+        }
+        ids.push_back(id);
+    }
+    const double createMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - createStart).count();
+
+    std::vector<float> input(hop);
+    std::mt19937 rng(42);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    for (auto& sample : input) {
+        sample = noise(rng);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // 按hop轮询写入所有流，队列满（返回0）时让出CPU后重试同一hop
+    for (size_t h = 0; h < hopsPerStream; h++) {
+        for (int32_t id : ids) {
+            while (engine.pushAudio(id, input.data(), hop) == 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    const uint64_t totalHops = static_cast<uint64_t>(hopsPerStream) * streamCount;
+    while (engine.getStats().processedHops < totalHops) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int64_t maxLatencyUs = 0;
+    int64_t sumAvgLatencyUs = 0;
+    for (int32_t id : ids) {
+        StreamStats stats;
+        if (engine.getStreamStats(id, &stats)) {
+            maxLatencyUs = stats.maxLatencyUs > maxLatencyUs ? stats.maxLatencyUs : maxLatencyUs;
+            sumAvgLatencyUs += stats.avgLatencyUs;
+        }
+    }
+
+    const StreamEngineStats stats = engine.getStats();
+    const double hopsPerSec = static_cast<double>(totalHops) / seconds;
+    const double realtimeStreams = hopsPerSec / (48000.0 / static_cast<double>(hop));
+    std::cout << "  " << workers << " 线程: "
+              << hopsPerSec << " hops/sec, "
+              << "实时可承载约 " << static_cast<int64_t>(realtimeStreams) << " 路, "
+              << "单hop " << stats.hopCostNs / 1000 << " us, "
+              << "建流 " << createMs / static_cast<double>(streamCount) << " ms/路, "
+              << "窃取 " << stats.steals << " 次, "
+              << "平均延迟 " << sumAvgLatencyUs / static_cast<int64_t>(streamCount) / 1000 << " ms, "
+              << "最大延迟 " << maxLatencyUs / 1000 << " ms" << std::endl;
+
+    engine.release();
+    return hopsPerSec;
+}
+
+/**
+ * 主函数
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "用法: " << argv[0] << " <模型tar.gz路径> [流数] [每路音频秒数]" << std::endl;
+        return 1;
+    }
+
+    const size_t streamCount = argc > 2 ? static_cast<size_t>(atoi(argv[2])) : 64;
+    const double audioSeconds = argc > 3 ? atof(argv[3]) : 5.0;
+
+    MappedFile model;
+    if (!model.open(argv[1], false)) {
+        std::cout << model.getLastError() << std::endl;
+        return 1;
+    }
+
+    size_t maxWorkers = std::thread::hardware_concurrency();
+    if (maxWorkers == 0) {
+        maxWorkers = 1;
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  StreamEngine多核扩展性基准测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+    std::cout << "  流数: " << streamCount << ", 每路音频: " << audioSeconds
+              << " s, 硬件并发数: " << maxWorkers << std::endl;
+
+    double baseline = 0.0;
+    for (size_t workers = 1; ; workers *= 2) {
+        if (workers > maxWorkers) {
+            workers = maxWorkers;
+        }
+        const double hopsPerSec = runConfig(model, workers, streamCount, audioSeconds);
+        if (hopsPerSec <= 0.0) {
+            return 1;
+        }
+        if (baseline == 0.0) {
+            baseline = hopsPerSec;
+        } else {
+            std::cout << "    加速比: " << hopsPerSec / baseline << "x" << std::endl;
+        }
+        if (workers == maxWorkers) {
+            break;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,311 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include "ComputeGate.h"
+#include "TestSupport.h"
+#include "deepfilter_ort.h"
+
+// 直通桩的测试接口（见df_stub.cpp）
+extern "C" void df_stub_set_delay(size_t samples);
+
+/**
+ * ComputeGate测试工具
+ *
+ * 不依赖模型，用固定的"模型输出"和LSNR驱动门控状态机，验证：
+ * 1. 静音持续holdHops个hop后进入旁路，进入时交叉淡化
+ * 2. 旁路输出为输入乘以静音增益，非静音hop立即恢复推理并预热
+ * 3. 干净语音旁路期间定期探测，探测LSNR下降后恢复推理
+ * 4. 多声道交织数据按帧过渡，统计计数正确
+ * 5. 有算法延迟的模型（直通桩）：旁路信号与模型输出对齐，进入和退出旁路时输出逐采样连续
+ */
+
+using namespace deepfilter;
+
+static const size_t kFrameSize = 64;
+
+/**
+ * 运行一个hop：模型输出固定为modelValue，返回最终输出和处理方式
+ */
+static GateMode runHop(ComputeGate& gate, const std::vector<float>& input, std::vector<float>& output,
+                       float modelValue, float lsnr, size_t* warmup = nullptr) {
+    const GateMode mode = gate.beginHop(input.data());
+    if (warmup != nullptr) {
+        *warmup = gate.getWarmupHopCount();
+    }
+    if (ComputeGate::runsModel(mode)) {
+        for (auto& sample : output) {
+            sample = modelValue;
+        }
+    }
+    gate.endHop(input.data(), output.data(), lsnr);
+    return mode;
+}
+
+/**
+ * 静音进入旁路、旁路增益、非静音恢复
+ */
+static void testSilenceBypass() {
+    std::cout << "[测试] 静音旁路" << std::endl;
+
+    ComputeGateConfig config;
+    config.enabled = true;
+    config.bypassClean = false;
+    config.holdHops = 4;
+    config.warmupHops = 2;
+    config.silenceGainDb = -20.0f;
+
+    ComputeGate gate;
+    EXPECT(gate.init(config, kFrameSize, 1));
+
+    std::vector<float> silence(kFrameSize, 1e-5f);
+    std::vector<float> output(kFrameSize);
+
+    // 前holdHops-1个hop照常推理
+    for (int32_t i = 0; i < config.holdHops - 1; i++) {
+        EXPECT(runHop(gate, silence, output, 0.5f, 10.0f) == GateMode::PROCESS);
+        EXPECT(output[0] == 0.5f);
+    }
+    EXPECT(!gate.isBypassing());
+
+    // 第holdHops个hop运行模型并交叉淡化到旁路信号
+    EXPECT(runHop(gate, silence, output, 0.5f, 10.0f) == GateMode::FADE_OUT);
+    EXPECT(gate.isBypassing());
+    EXPECT(output[0] > output[kFrameSize - 1]);
+    EXPECT(std::fabs(output[0] - 0.5f) < 0.01f);
+    EXPECT(output[kFrameSize - 1] < 0.01f);
+
+    // 旁路：输出为输入×(-20dB)
+    for (int i = 0; i < 5; i++) {
+        EXPECT(runHop(gate, silence, output, 0.5f, 10.0f) == GateMode::BYPASS);
+        EXPECT(std::fabs(output[kFrameSize / 2] - 1e-6f) < 1e-9f);
+    }
+
+    // 非静音：立即恢复，预热最近跳过的hop（不超过warmupHops）
+    std::vector<float> loud(kFrameSize, 0.3f);
+    size_t warmup = 0;
+    EXPECT(runHop(gate, loud, output, 0.5f, 10.0f, &warmup) == GateMode::FADE_IN);
+    EXPECT(warmup == static_cast<size_t>(config.warmupHops));
+    EXPECT(!gate.isBypassing());
+    EXPECT(std::fabs(output[kFrameSize - 1] - 0.5f) < 0.01f);
+    EXPECT(runHop(gate, loud, output, 0.5f, 10.0f, &warmup) == GateMode::PROCESS);
+    EXPECT(warmup == 0);
+    EXPECT(output[0] == 0.5f);
+
+    ComputeGateStats stats = gate.getStats();
+    EXPECT(stats.totalHops == static_cast<uint64_t>(config.holdHops) + 5 + 2);
+    EXPECT(stats.bypassedHops == 5);
+    EXPECT(stats.silentHops == 5);
+    EXPECT(stats.transitions == 2);
+    EXPECT(stats.warmupHops == 2);
+    EXPECT(stats.probeHops == 0);
+}
+
+/**
+ * 干净语音旁路：定期探测，探测LSNR下降后恢复
+ */
+static void testCleanBypassProbe() {
+    std::cout << "[测试] 干净语音旁路与探测" << std::endl;
+
+    ComputeGateConfig config;
+    config.enabled = true;
+    config.lsnrHistoryHops = 3;
+    config.holdHops = 2;
+    config.probeIntervalHops = 4;
+    config.cleanLsnrDb = 30.0f;
+    config.cleanExitLsnrDb = 25.0f;
+
+    ComputeGate gate;
+    EXPECT(gate.init(config, kFrameSize, 1));
+
+    std::vector<float> speech(kFrameSize, 0.1f);
+    std::vector<float> output(kFrameSize);
+
+    // LSNR历史填满后再连续holdHops个hop才进入旁路
+    int hops = 0;
+    while (!gate.isBypassing() && hops < 20) {
+        runHop(gate, speech, output, 0.05f, 35.0f);
+        hops++;
+    }
+    EXPECT(gate.isBypassing());
+    EXPECT(hops == config.lsnrHistoryHops + config.holdHops);
+
+    // 干净旁路增益为0dB，每probeIntervalHops个hop探测一次
+    int bypassed = 0;
+    GateMode mode = GateMode::BYPASS;
+    while ((mode = runHop(gate, speech, output, 0.05f, 35.0f)) == GateMode::BYPASS) {
+        EXPECT(output[0] == 0.1f);
+        bypassed++;
+    }
+    EXPECT(mode == GateMode::PROBE);
+    EXPECT(bypassed == config.probeIntervalHops - 1);
+    EXPECT(output[0] == 0.1f);
+    EXPECT(gate.isBypassing());
+
+    // 探测到LSNR下降：下一个hop恢复推理
+    while ((mode = runHop(gate, speech, output, 0.05f, 10.0f)) == GateMode::BYPASS) {
+    }
+    EXPECT(mode == GateMode::PROBE);
+    EXPECT(runHop(gate, speech, output, 0.05f, 10.0f) == GateMode::FADE_IN);
+    EXPECT(!gate.isBypassing());
+
+    // 能量突增也立即恢复
+    ComputeGate gate2;
+    EXPECT(gate2.init(config, kFrameSize, 1));
+    while (!gate2.isBypassing()) {
+        runHop(gate2, speech, output, 0.05f, 35.0f);
+    }
+    std::vector<float> burst(kFrameSize, 0.8f);
+    EXPECT(runHop(gate2, burst, output, 0.05f, 35.0f) == GateMode::FADE_IN);
+
+    ComputeGateStats stats = gate.getStats();
+    EXPECT(stats.probeHops == 2);
+    EXPECT(stats.silentHops == 0);
+    EXPECT(stats.transitions == 2);
+}
+
+/**
+ * 多声道交织数据与参数校验
+ */
+static void testMultiChannelAndConfig() {
+    std::cout << "[测试] 多声道与参数校验" << std::endl;
+
+    ComputeGate invalid;
+    ComputeGateConfig bad;
+    bad.holdHops = 0;
+    EXPECT(!invalid.init(bad, kFrameSize, 1));
+    EXPECT(!invalid.init(ComputeGateConfig(), 0, 1));
+    EXPECT(!invalid.init(ComputeGateConfig(), kFrameSize, 0));
+
+    ComputeGateConfig config;
+    config.enabled = true;
+    config.bypassClean = false;
+    config.holdHops = 1;
+    config.warmupHops = 0;
+
+    ComputeGate gate;
+    EXPECT(gate.init(config, kFrameSize, 2));
+
+    std::vector<float> silence(kFrameSize * 2, 0.0f);
+    std::vector<float> output(kFrameSize * 2);
+    EXPECT(runHop(gate, silence, output, 0.5f, 10.0f) == GateMode::FADE_OUT);
+    // 同一帧的两个声道使用相同的淡化系数
+    bool framesMatch = true;
+    for (size_t i = 0; i < kFrameSize; i++) {
+        if (output[i * 2] != output[i * 2 + 1]) {
+            framesMatch = false;
+        }
+    }
+    EXPECT(framesMatch);
+    EXPECT(output[kFrameSize * 2 - 1] < 0.01f);
+
+    size_t warmup = 1;
+    runHop(gate, silence, output, 0.5f, 10.0f);
+    std::vector<float> loud(kFrameSize * 2, 0.3f);
+    EXPECT(runHop(gate, loud, output, 0.5f, 10.0f, &warmup) == GateMode::FADE_IN);
+    EXPECT(warmup == 0);
+
+    gate.reset();
+    EXPECT(!gate.isBypassing());
+    EXPECT(gate.getStats().totalHops == 0);
+}
+
+/**
+ * 有算法延迟的模型：旁路信号经过同样的延迟，FADE_OUT、BYPASS、FADE_IN期间输出始终等于延迟后的输入
+ */
+static void testDelayAlignedBypass() {
+    std::cout << "[测试] 算法延迟对齐" << std::endl;
+
+    // 与DeepFilterNet3相同：(960 - 480) + 2 * 480，即3个hop
+    const size_t frameSize = 480;
+    const size_t delay = 1440;
+    df_stub_set_delay(delay);
+    const uint8_t fakeModel[4] = {1, 2, 3, 4};
+    void* state = df_create(fakeModel, sizeof(fakeModel), 0.0f, 100.0f);
+    EXPECT(state != nullptr);
+    EXPECT(df_get_algorithmic_delay(state) == delay);
+
+    // 旁路增益为0dB，对齐时模型输出和旁路信号完全相同，任何错位都会出现在输出里
+    ComputeGateConfig config;
+    config.enabled = true;
+    config.bypassClean = false;
+    config.holdHops = 2;
+    config.warmupHops = 2;
+    config.silenceGainDb = 0.0f;
+
+    ComputeGate gate;
+    EXPECT(gate.init(config, frameSize, 1, df_get_algorithmic_delay(state)));
+
+    // 响、静（进入旁路）、响（退出旁路）三段正弦，幅度在hop边界切换
+    const size_t hops = 24;
+    std::vector<float> signal(hops * frameSize);
+    for (size_t n = 0; n < signal.size(); n++) {
+        const size_t hop = n / frameSize;
+        const float amplitude = (hop >= 6 && hop < 16) ? 1e-4f : 0.3f;
+        signal[n] = amplitude * std::sin(0.05f * static_cast<float>(n));
+    }
+
+    std::vector<float> output(signal.size(), 0.0f);
+    bool sawFadeOut = false;
+    bool sawBypass = false;
+    bool sawFadeIn = false;
+    size_t fadeInWarmup = 0;
+    for (size_t hop = 0; hop < hops; hop++) {
+        const float* input = signal.data() + hop * frameSize;
+        float* out = output.data() + hop * frameSize;
+        const GateMode mode = gate.beginHop(input);
+        for (size_t w = 0; w < gate.getWarmupHopCount(); w++) {
+            df_process_frame(state, gate.getWarmupHop(w), gate.getWarmupOutput(), frameSize);
+        }
+        float lsnr = 0.0f;
+        if (ComputeGate::runsModel(mode)) {
+            lsnr = df_process_frame(state, input, out, frameSize);
+        }
+        gate.endHop(input, out, lsnr);
+
+        sawFadeOut = sawFadeOut || mode == GateMode::FADE_OUT;
+        sawBypass = sawBypass || mode == GateMode::BYPASS;
+        if (mode == GateMode::FADE_IN) {
+            sawFadeIn = true;
+            fadeInWarmup = gate.getWarmupHopCount();
+        }
+    }
+    EXPECT(sawFadeOut);
+    EXPECT(sawBypass);
+    EXPECT(sawFadeIn);
+    // warmupHops小于延迟对应的hop数时按延迟预热
+    EXPECT(fadeInWarmup == delay / frameSize);
+
+    float maxError = 0.0f;
+    for (size_t n = 0; n < output.size(); n++) {
+        const float expected = n >= delay ? signal[n - delay] : 0.0f;
+        maxError = std::max(maxError, std::fabs(output[n] - expected));
+    }
+    EXPECT(maxError < 1e-6f);
+
+    df_destroy(state);
+    df_stub_set_delay(0);
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ComputeGate测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testSilenceBypass();
+    testCleanBypassProbe();
+    testMultiChannelAndConfig();
+    testDelayAlignedBypass();
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include "deepfilter_ort.h"
+
+/**
+ * deepfilter-ort C接口的直通桩实现
+ *
+ * 主机测试不依赖Rust模型：输出等于输入，LSNR默认为0（测试可用df_stub_set_lsnr修改），
+ * 默认没有算法延迟（测试可用df_stub_set_delay让新建实例的输出延迟固定采样数），
+ * 用于验证文件读写、分块和调度等管线逻辑；与真实接口一致，失败时返回NaN
+ */
+
+namespace {
+
+const size_t STUB_FRAME_SIZE = 480;
+
+struct StubModel {
+    size_t tarSize;
+};
+
+struct StubState {
+    float postFilterBeta;
+    float attenLimDb;
+    size_t channels;
+    std::vector<float> delayLine;   // 尚未输出的采样（每声道delay个，交错存放）
+};
+
+const size_t STUB_MAX_CHANNELS = 16;
+
+// 各处理接口返回的LSNR（所有实例共用）
+std::atomic<float> stubLsnr(0.0f);
+
+// 新建实例的算法延迟（每声道采样点数）
+std::atomic<size_t> stubDelay(0);
+
+StubState* newState(float postFilterBeta, float attenLimDb, size_t channels) {
+    StubState* state = new StubState{postFilterBeta, attenLimDb, channels, {}};
+    state->delayLine.assign(stubDelay.load(std::memory_order_relaxed) * channels, 0.0f);
+    return state;
+}
+
+// 输出延迟delayLine.size()个交错采样：输出 = (延迟线 + 本次数据)的前n个，剩余留在延迟线
+void applyDelay(StubState* state, float* data, size_t n) {
+    std::vector<float>& line = state->delayLine;
+    if (line.empty()) {
+        return;
+    }
+    std::vector<float> joined(line);
+    joined.insert(joined.end(), data, data + n);
+    memcpy(data, joined.data(), n * sizeof(float));
+    line.assign(joined.begin() + static_cast<std::ptrdiff_t>(n), joined.end());
+}
+
+} // namespace
+
+extern "C" {
+
+void* df_model_load(const uint8_t* tar_buf, size_t tar_size) {
+    if (tar_buf == nullptr || tar_size == 0) {
+        return nullptr;
+    }
+    return new StubModel{tar_size};
+}
+
+void* df_create_from_model_ex(const void* model, size_t n_ch, float post_filter_beta, float atten_lim_db) {
+    if (model == nullptr || n_ch == 0 || n_ch > STUB_MAX_CHANNELS) {
+        return nullptr;
+    }
+    return newState(post_filter_beta, atten_lim_db, n_ch);
+}
+
+// 桩实现只模拟tract后端
+void* df_create_from_model_backend(const void* model, size_t n_ch, float post_filter_beta, float atten_lim_db,
+                                   int32_t backend) {
+    if (backend != DF_BACKEND_TRACT) {
+        return nullptr;
+    }
+    return df_create_from_model_ex(model, n_ch, post_filter_beta, atten_lim_db);
+}
+
+int32_t df_backend_available(int32_t backend) {
+    return backend == DF_BACKEND_TRACT ? 1 : 0;
+}
+
+int32_t df_get_backend(void* state) {
+    return state != nullptr ? DF_BACKEND_TRACT : -1;
+}
+
+void* df_create_from_model(const void* model, float post_filter_beta, float atten_lim_db) {
+    return df_create_from_model_ex(model, 1, post_filter_beta, atten_lim_db);
+}
+
+void df_model_free(void* model) {
+    delete static_cast<StubModel*>(model);
+}
+
+uint8_t* df_model_repack(const uint8_t* tar_buf, size_t tar_size, size_t* out_size) {
+    if (tar_buf == nullptr || tar_size == 0 || out_size == nullptr) {
+        return nullptr;
+    }
+    uint8_t* copy = new uint8_t[tar_size];
+    memcpy(copy, tar_buf, tar_size);
+    *out_size = tar_size;
+    return copy;
+}
+
+// 桩实现不解析tar：输出为主包加变体包的拼接，不同精度/变体得到不同的字节（用于缓存键测试）
+uint8_t* df_model_select_precision(const uint8_t* tar_buf, size_t tar_size, const uint8_t* variant_buf,
+                                   size_t variant_size, int32_t precision, size_t* out_size) {
+    if (tar_buf == nullptr || tar_size == 0 || out_size == nullptr ||
+        precision < DF_PRECISION_FP32 || precision > DF_PRECISION_INT8) {
+        return nullptr;
+    }
+    const size_t extra = variant_buf != nullptr ? variant_size : 0;
+    uint8_t* selected = new uint8_t[tar_size + extra + 1];
+    memcpy(selected, tar_buf, tar_size);
+    if (extra > 0) {
+        memcpy(selected + tar_size, variant_buf, extra);
+    }
+    selected[tar_size + extra] = static_cast<uint8_t>(precision);
+    *out_size = tar_size + extra + 1;
+    return selected;
+}
+
+void df_free_buffer(uint8_t* buf, size_t) {
+    delete[] buf;
+}
+
+void* df_create_ex(const uint8_t* tar_buf, size_t tar_size, size_t n_ch,
+                   float post_filter_beta, float atten_lim_db) {
+    if (tar_buf == nullptr || tar_size == 0 || n_ch == 0 || n_ch > STUB_MAX_CHANNELS) {
+        return nullptr;
+    }
+    return newState(post_filter_beta, atten_lim_db, n_ch);
+}
+
+void* df_create(const uint8_t* tar_buf, size_t tar_size, float post_filter_beta, float atten_lim_db) {
+    return df_create_ex(tar_buf, tar_size, 1, post_filter_beta, atten_lim_db);
+}
+
+void df_destroy(void* state) {
+    delete static_cast<StubState*>(state);
+}
+
+float df_process_frame(void* state, const float* input, float* output, size_t frame_size) {
+    if (state == nullptr || input == nullptr || output == nullptr ||
+        frame_size != STUB_FRAME_SIZE * static_cast<StubState*>(state)->channels) {
+        return NAN;
+    }
+    memmove(output, input, frame_size * sizeof(float));
+    applyDelay(static_cast<StubState*>(state), output, frame_size);
+    return stubLsnr.load(std::memory_order_relaxed);
+}
+
+float df_process_frame_interleaved(void* state, const float* input, float* output, size_t n_frames) {
+    if (state == nullptr || n_frames != STUB_FRAME_SIZE) {
+        return NAN;
+    }
+    return df_process_frame(state, input, output, n_frames * static_cast<StubState*>(state)->channels);
+}
+
+int64_t df_process_frames(void* state, const float* input, float* output, size_t n_samples, float* lsnr) {
+    if (state == nullptr || input == nullptr || output == nullptr) {
+        return -1;
+    }
+    const size_t hopSamples = STUB_FRAME_SIZE * static_cast<StubState*>(state)->channels;
+    if (n_samples % hopSamples != 0) {
+        return -1;
+    }
+    const size_t hops = n_samples / hopSamples;
+    memmove(output, input, n_samples * sizeof(float));
+    applyDelay(static_cast<StubState*>(state), output, n_samples);
+    if (lsnr != nullptr) {
+        for (size_t i = 0; i < hops; i++) {
+            lsnr[i] = stubLsnr.load(std::memory_order_relaxed);
+        }
+    }
+    return static_cast<int64_t>(hops);
+}
+
+void df_set_post_filter_beta(void* state, float beta) {
+    if (state != nullptr) {
+        static_cast<StubState*>(state)->postFilterBeta = beta;
+    }
+}
+
+void df_set_atten_lim(void* state, float lim_db) {
+    if (state != nullptr) {
+        static_cast<StubState*>(state)->attenLimDb = lim_db;
+    }
+}
+
+size_t df_get_frame_size(void* state) {
+    return state != nullptr ? STUB_FRAME_SIZE : 0;
+}
+
+size_t df_get_channel_count(void* state) {
+    return state != nullptr ? static_cast<StubState*>(state)->channels : 0;
+}
+
+size_t df_get_lookahead(void* /*state*/) {
+    return 0;
+}
+
+// 直通桩的算法延迟只来自df_stub_set_delay
+size_t df_get_algorithmic_delay(void* state) {
+    if (state == nullptr) {
+        return 0;
+    }
+    const StubState* stub = static_cast<StubState*>(state);
+    return stub->delayLine.size() / stub->channels;
+}
+
+void df_pcm16_to_f32(const int16_t* input, float* output, size_t n_samples) {
+    for (size_t i = 0; i < n_samples; i++) {
+        output[i] = input[i] / 32768.0f;
+    }
+}
+
+/**
+ * 设置桩返回的LSNR（仅主机测试使用，不属于deepfilter-ort接口）
+ */
+void df_stub_set_lsnr(float lsnr) {
+    stubLsnr.store(lsnr, std::memory_order_relaxed);
+}
+
+/**
+ * 设置之后新建实例的算法延迟（仅主机测试使用，不属于deepfilter-ort接口）
+ */
+void df_stub_set_delay(size_t samples) {
+    stubDelay.store(samples, std::memory_order_relaxed);
+}
+
+} // extern "C"
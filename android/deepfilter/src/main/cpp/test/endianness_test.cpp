@@ -1,6 +1,7 @@
 #include <iostream>
 #include <iomanip>
 #include <cstdint>
+#include <cmath>
 
 /**
  * 字节序测试工具
@@ -0,0 +1,187 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include "FramePool.h"
+#include "FrameRingBuffer.h"
+#include "TestSupport.h"
+
+/**
+ * FramePool测试工具
+ *
+ * 验证帧池的对齐、借出/归还和计数器，
+ * 并通过替换全局operator new统计稳态运行时的堆分配次数
+ */
+
+using namespace deepfilter;
+
+static std::atomic<uint64_t> globalAllocations(0);
+
+void* operator new(size_t size) {
+    globalAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    globalAllocations.fetch_add(1, std::memory_order_relaxed);
+    return malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+/**
+ * 测试对齐和耗尽计数
+ */
+void testAcquireRelease() {
+    std::cout << "测试借出/归还..." << std::endl;
+
+    FramePool pool;
+    EXPECT(pool.init(480, 4));
+
+    AudioFrame* frames[4];
+    for (int i = 0; i < 4; i++) {
+        frames[i] = pool.acquireFrame();
+        EXPECT(frames[i] != nullptr);
+        EXPECT(reinterpret_cast<uintptr_t>(frames[i]->data) % FramePool::CACHE_LINE_SIZE == 0);
+    }
+    EXPECT(pool.acquireFrame() == nullptr);
+
+    FramePoolStats stats = pool.getStats();
+    EXPECT(stats.capacity == 4);
+    EXPECT(stats.inUse == 4);
+    EXPECT(stats.exhaustedCount == 1);
+
+    for (int i = 0; i < 4; i++) {
+        pool.releaseFrame(frames[i]);
+    }
+    stats = pool.getStats();
+    EXPECT(stats.inUse == 0);
+    EXPECT(stats.releaseCount == 4);
+}
+
+/**
+ * 并发借出/归还：两个线程交替借还，帧不会被重复借出
+ */
+void testConcurrent() {
+    std::cout << "测试并发借出/归还..." << std::endl;
+
+    FramePool pool;
+    EXPECT(pool.init(64, 8));
+
+    std::atomic<bool> duplicated(false);
+    auto worker = [&](float marker) {
+        for (int i = 0; i < 100000; i++) {
+            AudioFrame* frame = pool.acquireFrame();
+            if (frame == nullptr) {
+                continue;
+            }
+            frame->data[0] = marker;
+            std::this_thread::yield();
+            if (frame->data[0] != marker) {
+                duplicated = true;
+            }
+            pool.releaseFrame(frame);
+        }
+    };
+
+    std::thread a(worker, 1.0f);
+    std::thread b(worker, 2.0f);
+    a.join();
+    b.join();
+
+    EXPECT(!duplicated);
+    EXPECT(pool.getStats().inUse == 0);
+}
+
+/**
+ * 稳态零堆分配：模拟一次采集会话（写入环形缓冲区、读取、借还工作帧）
+ */
+void testSteadyStateAllocations() {
+    std::cout << "测试稳态零堆分配..." << std::endl;
+
+    const size_t frameSize = 480;
+    const size_t queueSize = 10;
+
+    FramePool pool;
+    FrameRingBuffer ring;
+    EXPECT(pool.init(frameSize, queueSize + 2));
+    EXPECT(ring.init(pool, queueSize, OverflowPolicy::DROP_OLDEST));
+
+    AudioFrame* work = pool.acquireFrame();
+    AudioFrame* output = pool.acquireFrame();
+    EXPECT(work != nullptr && output != nullptr);
+    EXPECT(pool.acquireFrame() == nullptr);
+
+    std::vector<float> capture(frameSize, 0.5f);
+    const uint64_t poolAllocationsBefore = pool.getStats().heapAllocations;
+    const uint64_t allocationsBefore = globalAllocations.load();
+
+    for (int hop = 0; hop < 10000; hop++) {
+        ring.push(capture.data(), static_cast<int32_t>(frameSize), hop);
+        if (hop % 3 != 0) {
+            while (ring.pop(work)) {
+                for (size_t i = 0; i < frameSize; i++) {
+                    output->data[i] = work->data[i] * 0.5f;
+                }
+            }
+        }
+    }
+
+    EXPECT(globalAllocations.load() == allocationsBefore);
+    EXPECT(pool.getStats().heapAllocations == poolAllocationsBefore);
+
+    ring.release();
+    pool.releaseFrame(work);
+    pool.releaseFrame(output);
+    EXPECT(pool.getStats().inUse == 0);
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  FramePool测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testAcquireRelease();
+    testConcurrent();
+    testSteadyStateAllocations();
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
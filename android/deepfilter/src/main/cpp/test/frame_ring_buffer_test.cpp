@@ -0,0 +1,207 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include "FrameRingBuffer.h"
+#include "TestSupport.h"
+
+/**
+ * FrameRingBuffer测试工具
+ *
+ * 在Linux主机上验证单生产者/单消费者环形缓冲区的正确性，
+ * 不依赖AAudio或Android运行环境
+ */
+
+using namespace deepfilter;
+
+static void fillFrame(std::vector<float>& frame, uint64_t seq) {
+    for (auto& sample : frame) {
+        sample = static_cast<float>(seq);
+    }
+}
+
+/**
+ * 测试基本的写入/读取顺序
+ */
+void testPushPop() {
+    std::cout << "测试基本读写..." << std::endl;
+
+    FrameRingBuffer ring;
+    EXPECT(ring.init(480, 4, OverflowPolicy::DROP_OLDEST));
+
+    std::vector<float> in(480);
+    std::vector<float> out(480);
+    AudioFrame frame = {out.data(), 0, 0, -1};
+
+    EXPECT(!ring.pop(&frame));
+
+    for (uint64_t i = 0; i < 3; i++) {
+        fillFrame(in, i);
+        EXPECT(ring.push(in.data(), 480, static_cast<int64_t>(i * 10), static_cast<int64_t>(i * 480)));
+    }
+    EXPECT(ring.size() == 3);
+
+    for (uint64_t i = 0; i < 3; i++) {
+        EXPECT(ring.pop(&frame));
+        EXPECT(frame.numFrames == 480);
+        EXPECT(frame.timestamp == static_cast<int64_t>(i * 10));
+        EXPECT(frame.position == static_cast<int64_t>(i * 480));
+        EXPECT(out[0] == static_cast<float>(i) && out[479] == static_cast<float>(i));
+    }
+    EXPECT(ring.size() == 0);
+    EXPECT(ring.getDroppedCount() == 0);
+}
+
+/**
+ * 测试DROP_OLDEST策略：保留最新的capacity帧
+ */
+void testDropOldest() {
+    std::cout << "测试DROP_OLDEST策略..." << std::endl;
+
+    FrameRingBuffer ring;
+    EXPECT(ring.init(16, 4, OverflowPolicy::DROP_OLDEST));
+
+    std::vector<float> in(16);
+    std::vector<float> out(16);
+    AudioFrame frame = {out.data(), 0, 0, -1};
+
+    for (uint64_t i = 0; i < 10; i++) {
+        fillFrame(in, i);
+        EXPECT(ring.push(in.data(), 16, 0, static_cast<int64_t>(i * 16)));
+    }
+    EXPECT(ring.size() == 4);
+
+    // 被覆盖的帧在位置上留下缺口，消费者据此识别不连续
+    for (uint64_t i = 6; i < 10; i++) {
+        EXPECT(ring.pop(&frame));
+        EXPECT(out[0] == static_cast<float>(i));
+        EXPECT(frame.position == static_cast<int64_t>(i * 16));
+    }
+    EXPECT(!ring.pop(&frame));
+    EXPECT(ring.getDroppedCount() == 6);
+}
+
+/**
+ * 测试DROP_NEWEST策略：保留最早的capacity帧
+ */
+void testDropNewest() {
+    std::cout << "测试DROP_NEWEST策略..." << std::endl;
+
+    FrameRingBuffer ring;
+    EXPECT(ring.init(16, 4, OverflowPolicy::DROP_NEWEST));
+
+    std::vector<float> in(16);
+    std::vector<float> out(16);
+    AudioFrame frame = {out.data(), 0, 0, -1};
+
+    for (uint64_t i = 0; i < 10; i++) {
+        fillFrame(in, i);
+        EXPECT(ring.push(in.data(), 16, 0, static_cast<int64_t>(i * 16)) == (i < 4));
+    }
+    EXPECT(ring.getDroppedCount() == 6);
+
+    for (uint64_t i = 0; i < 4; i++) {
+        EXPECT(ring.pop(&frame));
+        EXPECT(out[0] == static_cast<float>(i));
+        EXPECT(frame.position == static_cast<int64_t>(i * 16));
+    }
+    EXPECT(!ring.pop(&frame));
+}
+
+/**
+ * 并发压力测试：生产者高速写入，消费者检查帧完整性和顺序，
+ * 最终写入数 = 读取数 + 丢弃数
+ */
+void testConcurrent(OverflowPolicy policy, const char* name) {
+    std::cout << "测试并发读写(" << name << ")..." << std::endl;
+
+    const size_t frameSize = 256;
+    const uint64_t totalFrames = 200000;
+
+    FrameRingBuffer ring;
+    EXPECT(ring.init(frameSize, 8, policy));
+
+    std::atomic<bool> producerDone(false);
+    uint64_t attempted = 0;
+
+    std::thread producer([&]() {
+        std::vector<float> in(frameSize);
+        for (uint64_t i = 1; i <= totalFrames; i++) {
+            fillFrame(in, i);
+            ring.push(in.data(), static_cast<int32_t>(frameSize), static_cast<int64_t>(i),
+                      static_cast<int64_t>(i * frameSize));
+            attempted++;
+        }
+        producerDone = true;
+    });
+
+    std::vector<float> out(frameSize);
+    AudioFrame frame = {out.data(), 0, 0, -1};
+    uint64_t lastSeq = 0;
+    uint64_t received = 0;
+    bool torn = false;
+    bool outOfOrder = false;
+
+    while (true) {
+        bool done = producerDone.load();
+        while (ring.pop(&frame)) {
+            uint64_t seq = static_cast<uint64_t>(frame.timestamp);
+            if (frame.position != static_cast<int64_t>(seq * frameSize)) {
+                torn = true;
+            }
+            for (size_t i = 0; i < frameSize; i++) {
+                if (out[i] != static_cast<float>(seq)) {
+                    torn = true;
+                    break;
+                }
+            }
+            if (seq <= lastSeq) {
+                outOfOrder = true;
+            }
+            lastSeq = seq;
+            received++;
+        }
+        if (done) {
+            break;
+        }
+    }
+    producer.join();
+
+    EXPECT(!torn);
+    EXPECT(!outOfOrder);
+    EXPECT(received == ring.getPoppedCount());
+    EXPECT(attempted == totalFrames);
+    if (policy == OverflowPolicy::DROP_NEWEST) {
+        EXPECT(ring.getPushedCount() + ring.getDroppedCount() == totalFrames);
+        EXPECT(ring.getPushedCount() == received);
+    } else {
+        EXPECT(ring.getPushedCount() == totalFrames);
+        EXPECT(received + ring.getDroppedCount() == totalFrames);
+    }
+
+    std::cout << "  接收: " << received << ", 丢弃: " << ring.getDroppedCount() << std::endl;
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  FrameRingBuffer测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testPushPop();
+    testDropOldest();
+    testDropNewest();
+    testConcurrent(OverflowPolicy::DROP_OLDEST, "DROP_OLDEST");
+    testConcurrent(OverflowPolicy::DROP_NEWEST, "DROP_NEWEST");
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
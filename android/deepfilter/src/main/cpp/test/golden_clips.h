@@ -0,0 +1,185 @@
+#ifndef GOLDEN_CLIPS_H
+#define GOLDEN_CLIPS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 金标准测试片段合成（golden_regression和bench_precision共用）
+ *
+ * 固定种子合成带噪语音（浊音谐波 + 白噪声/粉红噪声/工频嗡声，不同信噪比），
+ * 不依赖音频文件，各平台生成的采样完全一致
+ */
+
+namespace deepfilter {
+
+static const int SAMPLE_RATE = 48000;
+
+/**
+ * 固定种子的线性同余随机数（各平台结果一致，不依赖标准库分布的实现）
+ */
+class Lcg {
+public:
+    explicit Lcg(uint32_t seed) : state_(seed) {}
+
+    /**
+     * [-1, 1)均匀分布
+     */
+    float next() {
+        state_ = state_ * 1664525u + 1013904223u;
+        return static_cast<float>(state_ >> 8) / 8388608.0f - 1.0f;
+    }
+
+private:
+    uint32_t state_;
+};
+
+/**
+ * 合成语音：200ms浊音音节 + 100ms停顿，基频110~180Hz缓慢变化，
+ * 谐波幅度按三个共振峰（每个音节不同）加权
+ */
+inline std::vector<float> synthesizeSpeech(size_t numSamples, uint32_t seed) {
+    static const float formants[][3] = {
+        {700.0f, 1220.0f, 2600.0f},     // a
+        {300.0f, 2300.0f, 3000.0f},     // i
+        {350.0f, 800.0f, 2400.0f},      // u
+        {500.0f, 1900.0f, 2500.0f},     // e
+    };
+    const size_t syllable = SAMPLE_RATE * 200 / 1000;
+    const size_t period = SAMPLE_RATE * 300 / 1000;
+    const int maxHarmonics = 40;
+
+    std::vector<float> speech(numSamples, 0.0f);
+    Lcg rng(seed);
+    double phase = 0.0;
+    for (size_t start = 0; start < numSamples; start += period) {
+        const float* formant = formants[static_cast<size_t>((rng.next() + 1.0f) * 2.0f) % 4];
+        const double f0Start = 110.0 + 35.0 * (rng.next() + 1.0f);
+        const double f0End = f0Start * (0.85 + 0.1 * (rng.next() + 1.0f));
+        for (size_t i = 0; i < syllable && start + i < numSamples; i++) {
+            const double t = static_cast<double>(i) / syllable;
+            const double f0 = f0Start + (f0End - f0Start) * t;
+            phase += 2.0 * M_PI * f0 / SAMPLE_RATE;
+            if (phase > 2.0 * M_PI) {
+                phase -= 2.0 * M_PI;
+            }
+            double sample = 0.0;
+            for (int k = 1; k <= maxHarmonics && k * f0 < 4000.0; k++) {
+                const double frequency = k * f0;
+                double gain = 0.0;
+                for (int f = 0; f < 3; f++) {
+                    const double distance = (frequency - formant[f]) / (80.0 + 0.05 * formant[f]);
+                    gain += std::exp(-0.5 * distance * distance) / (f + 1);
+                }
+                sample += gain * std::sin(k * phase) / k;
+            }
+            // 音节包络：起止各20ms升余弦
+            const double edge = std::min(t, 1.0 - t) * 200.0 / 20.0;
+            const double envelope = edge < 1.0 ? 0.5 - 0.5 * std::cos(M_PI * edge) : 1.0;
+            speech[start + i] = static_cast<float>(0.3 * envelope * sample);
+        }
+    }
+    return speech;
+}
+
+/**
+ * 噪声类型
+ */
+enum class NoiseType {
+    WHITE,
+    PINK,
+    HUM     // 50Hz及其谐波 + 少量白噪声
+};
+
+inline std::vector<float> synthesizeNoise(size_t numSamples, NoiseType type, uint32_t seed) {
+    std::vector<float> noise(numSamples);
+    Lcg rng(seed);
+    // 粉红噪声：Paul Kellet的一阶滤波器组近似
+    float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f, b3 = 0.0f, b4 = 0.0f, b5 = 0.0f, b6 = 0.0f;
+    for (size_t i = 0; i < numSamples; i++) {
+        const float white = rng.next();
+        switch (type) {
+            case NoiseType::WHITE:
+                noise[i] = white;
+                break;
+            case NoiseType::PINK:
+                b0 = 0.99886f * b0 + white * 0.0555179f;
+                b1 = 0.99332f * b1 + white * 0.0750759f;
+                b2 = 0.96900f * b2 + white * 0.1538520f;
+                b3 = 0.86650f * b3 + white * 0.3104856f;
+                b4 = 0.55000f * b4 + white * 0.5329522f;
+                b5 = -0.7616f * b5 - white * 0.0168980f;
+                noise[i] = b0 + b1 + b2 + b3 + b4 + b5 + b6 + white * 0.5362f;
+                b6 = white * 0.115926f;
+                break;
+            case NoiseType::HUM: {
+                const double t = static_cast<double>(i) / SAMPLE_RATE;
+                double hum = 0.0;
+                for (int k = 1; k <= 7; k += 2) {
+                    hum += std::sin(2.0 * M_PI * 50.0 * k * t) / k;
+                }
+                noise[i] = static_cast<float>(hum) + 0.05f * white;
+                break;
+            }
+        }
+    }
+    return noise;
+}
+
+inline double energy(const std::vector<float>& signal) {
+    double sum = 0.0;
+    for (float sample : signal) {
+        sum += static_cast<double>(sample) * sample;
+    }
+    return sum;
+}
+
+/**
+ * 测试片段
+ */
+struct Clip {
+    const char* name;
+    NoiseType noise;
+    float snrDb;            // 语音/噪声能量比；NAN表示只有噪声
+    float noiseLevelDb;     // 只有噪声时的噪声RMS（dBFS）
+};
+
+static const Clip CLIPS[] = {
+    {"speech_white_5db", NoiseType::WHITE, 5.0f, 0.0f},
+    {"speech_pink_0db", NoiseType::PINK, 0.0f, 0.0f},
+    {"speech_hum_10db", NoiseType::HUM, 10.0f, 0.0f},
+    {"noise_pink_only", NoiseType::PINK, NAN, -30.0f},
+};
+
+static const double CLIP_SECONDS = 4.0;
+
+/**
+ * 合成一段带噪语音（长度为hop的整数倍）
+ */
+inline std::vector<float> synthesizeClip(const Clip& clip, size_t hopSize, uint32_t seed) {
+    const size_t numSamples = static_cast<size_t>(CLIP_SECONDS * SAMPLE_RATE) / hopSize * hopSize;
+    std::vector<float> noise = synthesizeNoise(numSamples, clip.noise, seed + 1);
+    const double noiseRms = std::sqrt(energy(noise) / numSamples);
+
+    std::vector<float> mixed(numSamples, 0.0f);
+    if (std::isnan(clip.snrDb)) {
+        const double gain = std::pow(10.0, clip.noiseLevelDb / 20.0) / noiseRms;
+        for (size_t i = 0; i < numSamples; i++) {
+            mixed[i] = static_cast<float>(noise[i] * gain);
+        }
+        return mixed;
+    }
+
+    std::vector<float> speech = synthesizeSpeech(numSamples, seed);
+    const double gain = std::sqrt(energy(speech) / energy(noise) / std::pow(10.0, clip.snrDb / 10.0));
+    for (size_t i = 0; i < numSamples; i++) {
+        mixed[i] = static_cast<float>(speech[i] + noise[i] * gain);
+    }
+    return mixed;
+}
+
+} // namespace deepfilter
+
+#endif // GOLDEN_CLIPS_H
@@ -0,0 +1,281 @@
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <sys/resource.h>
+#include "deepfilter_ort.h"
+#include "LatencyHistogram.h"
+#include "golden_clips.h"
+
+/**
+ * 金标准输出回归测试与吞吐量基准
+ *
+ * 1. 用固定种子合成几段带噪语音（见golden_clips.h），逐hop通过C接口（df_process_frames）降噪
+ * 2. 每段输出记录为逐hop能量（dB）和LSNR的指纹，与金标准目录中的同名文件在容差内比较；
+ *    只比较指纹而不是逐采样比较，tract版本或CPU指令集不同导致的浮点末位差异不会误报，
+ *    模型或推理实现的实际变化（降噪量、语音损伤、LSNR估计）会超出容差
+ * 3. 报告逐hop推理耗时分布、实时率和进程峰值RSS
+ *
+ * 用法: golden_regression <模型tar.gz路径> <金标准目录> [--update] [--tolerance-db <dB>] [--tolerance-lsnr <dB>]
+ *   --update 重新生成金标准（模型或tract有意升级后运行，并审阅差异后提交）
+ *
+ * 返回值：0-通过，1-超出容差或运行失败，77-模型或金标准不存在（跳过）
+ */
+
+using namespace deepfilter;
+
+static const int EXIT_SKIP = 77;
+static const float SILENCE_DB = -70.0f;     // 低于该能量的hop只要求两边都低于该值
+
+/**
+ * 逐hop指纹
+ */
+struct HopFingerprint {
+    float rmsDb;
+    float lsnr;
+};
+
+static std::string goldenPath(const std::string& directory, const char* clipName) {
+    return directory + "/" + clipName + ".txt";
+}
+
+static bool writeGolden(const std::string& path, const char* clipName, size_t hopSize,
+                        const std::vector<HopFingerprint>& hops) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    file << "# golden_regression v1 clip=" << clipName << " hop=" << hopSize << " hops=" << hops.size() << "\n";
+    file << "# hop rms_db lsnr\n";
+    char line[64];
+    for (size_t i = 0; i < hops.size(); i++) {
+        snprintf(line, sizeof(line), "%zu %.2f %.2f\n", i, hops[i].rmsDb, hops[i].lsnr);
+        file << line;
+    }
+    return static_cast<bool>(file);
+}
+
+static bool readGolden(const std::string& path, std::vector<HopFingerprint>& hops) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    hops.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        size_t index = 0;
+        HopFingerprint hop;
+        if (!(fields >> index >> hop.rmsDb >> hop.lsnr) || index != hops.size()) {
+            return false;
+        }
+        hops.push_back(hop);
+    }
+    return true;
+}
+
+/**
+ * 与金标准比较
+ *
+ * @return 超出容差的hop数
+ */
+static size_t compareGolden(const char* clipName, const std::vector<HopFingerprint>& actual,
+                            const std::vector<HopFingerprint>& golden, float toleranceDb, float toleranceLsnr) {
+    if (actual.size() != golden.size()) {
+        std::cout << "    hop数不一致: " << actual.size() << " / 金标准 " << golden.size() << std::endl;
+        return std::max(actual.size(), golden.size());
+    }
+
+    size_t mismatches = 0;
+    float maxDiffDb = 0.0f;
+    float maxDiffLsnr = 0.0f;
+    for (size_t i = 0; i < actual.size(); i++) {
+        const bool silent = actual[i].rmsDb < SILENCE_DB && golden[i].rmsDb < SILENCE_DB;
+        const float diffDb = silent ? 0.0f : std::fabs(actual[i].rmsDb - golden[i].rmsDb);
+        const float diffLsnr = std::fabs(actual[i].lsnr - golden[i].lsnr);
+        maxDiffDb = std::max(maxDiffDb, diffDb);
+        maxDiffLsnr = std::max(maxDiffLsnr, diffLsnr);
+        if (diffDb > toleranceDb || diffLsnr > toleranceLsnr) {
+            if (mismatches < 5) {
+                std::cout << "    hop " << i << ": 能量 " << actual[i].rmsDb << " dB / 金标准 " << golden[i].rmsDb
+                          << " dB，LSNR " << actual[i].lsnr << " / 金标准 " << golden[i].lsnr << std::endl;
+            }
+            mismatches++;
+        }
+    }
+    std::cout << "    " << clipName << ": 最大能量偏差 " << maxDiffDb << " dB，最大LSNR偏差 " << maxDiffLsnr
+              << " dB，超出容差 " << mismatches << " hop" << std::endl;
+    return mismatches;
+}
+
+/**
+ * 进程峰值RSS（KB）
+ */
+static long peakRssKb() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return -1;
+    }
+    return usage.ru_maxrss;
+}
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+/**
+ * 主函数
+ */
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cout << "用法: " << argv[0] << " <模型tar.gz路径> <金标准目录> [--update]"
+                  << " [--tolerance-db <dB>] [--tolerance-lsnr <dB>]" << std::endl;
+        return 1;
+    }
+
+    const std::string goldenDir = argv[2];
+    bool update = false;
+    float toleranceDb = 1.0f;
+    float toleranceLsnr = 2.0f;
+    for (int i = 3; i < argc; i++) {
+        if (strcmp(argv[i], "--update") == 0) {
+            update = true;
+        } else if (strcmp(argv[i], "--tolerance-db") == 0 && i + 1 < argc) {
+            toleranceDb = static_cast<float>(atof(argv[++i]));
+        } else if (strcmp(argv[i], "--tolerance-lsnr") == 0 && i + 1 < argc) {
+            toleranceLsnr = static_cast<float>(atof(argv[++i]));
+        } else {
+            std::cout << "未知参数: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "========================================" << std::endl;
+    std::cout << "  金标准输出回归测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    std::vector<uint8_t> model;
+    if (!readFile(argv[1], model) || model.empty()) {
+        std::cout << "跳过: 模型文件不存在: " << argv[1] << std::endl;
+        return EXIT_SKIP;
+    }
+    if (!update) {
+        for (const Clip& clip : CLIPS) {
+            std::ifstream file(goldenPath(goldenDir, clip.name));
+            if (!file) {
+                std::cout << "跳过: 金标准不存在: " << goldenPath(goldenDir, clip.name)
+                          << "（用 --update 生成）" << std::endl;
+                return EXIT_SKIP;
+            }
+        }
+    }
+
+    const long rssBeforeKb = peakRssKb();
+    void* dfModel = df_model_load(model.data(), model.size());
+    if (dfModel == nullptr) {
+        std::cout << "加载模型失败" << std::endl;
+        return 1;
+    }
+
+    LatencyHistogram hopLatency;
+    double processSeconds = 0.0;
+    double audioSeconds = 0.0;
+    size_t totalMismatches = 0;
+    size_t hopSize = 0;
+
+    for (size_t c = 0; c < sizeof(CLIPS) / sizeof(CLIPS[0]); c++) {
+        const Clip& clip = CLIPS[c];
+        // 每段使用新实例，结果与片段顺序无关
+        void* state = df_create_from_model(dfModel, 0.0f, 100.0f);
+        if (state == nullptr) {
+            std::cout << "创建DeepFilterNet实例失败" << std::endl;
+            df_model_free(dfModel);
+            return 1;
+        }
+        hopSize = df_get_frame_size(state);
+
+        const std::vector<float> input = synthesizeClip(clip, hopSize, 1000u + static_cast<uint32_t>(c) * 17u);
+        std::vector<float> output(input.size());
+        std::vector<HopFingerprint> hops(input.size() / hopSize);
+
+        for (size_t h = 0; h < hops.size(); h++) {
+            float lsnr = 0.0f;
+            const auto start = std::chrono::steady_clock::now();
+            const int64_t processed = df_process_frames(state, input.data() + h * hopSize,
+                                                        output.data() + h * hopSize, hopSize, &lsnr);
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            if (processed != 1) {
+                std::cout << clip.name << ": df_process_frames失败，hop " << h << std::endl;
+                df_destroy(state);
+                df_model_free(dfModel);
+                return 1;
+            }
+            hopLatency.record(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+            processSeconds += std::chrono::duration<double>(elapsed).count();
+
+            double sum = 0.0;
+            for (size_t i = 0; i < hopSize; i++) {
+                const double sample = output[h * hopSize + i];
+                sum += sample * sample;
+            }
+            hops[h].rmsDb = static_cast<float>(10.0 * std::log10(sum / hopSize + 1e-12));
+            hops[h].lsnr = lsnr;
+        }
+        df_destroy(state);
+        audioSeconds += static_cast<double>(input.size()) / SAMPLE_RATE;
+
+        const std::string path = goldenPath(goldenDir, clip.name);
+        if (update) {
+            if (!writeGolden(path, clip.name, hopSize, hops)) {
+                std::cout << "写入金标准失败: " << path << std::endl;
+                df_model_free(dfModel);
+                return 1;
+            }
+            std::cout << "  已更新: " << path << std::endl;
+            continue;
+        }
+
+        std::vector<HopFingerprint> golden;
+        if (!readGolden(path, golden)) {
+            std::cout << "  金标准格式错误: " << path << std::endl;
+            totalMismatches++;
+            continue;
+        }
+        totalMismatches += compareGolden(clip.name, hops, golden, toleranceDb, toleranceLsnr);
+    }
+    df_model_free(dfModel);
+
+    const LatencySummary latency = hopLatency.snapshot();
+    const double hopUs = hopSize * 1000000.0 / SAMPLE_RATE;
+    std::cout << "  逐hop耗时: p50 " << latency.p50Us << " us, p95 " << latency.p95Us << " us, p99 "
+              << latency.p99Us << " us, max " << latency.maxUs << " us（hop时长 " << hopUs << " us）" << std::endl;
+    std::cout << "  实时率: " << processSeconds / audioSeconds << "（" << latency.count << " hops，音频 "
+              << audioSeconds << " s）" << std::endl;
+    std::cout << "  峰值RSS: " << peakRssKb() << " KB（加载模型前 " << rssBeforeKb << " KB）" << std::endl;
+
+    if (totalMismatches > 0) {
+        std::cout << "测试失败: " << totalMismatches << " 个hop超出容差（能量±" << toleranceDb << " dB，LSNR±"
+                  << toleranceLsnr << " dB）" << std::endl;
+        return 1;
+    }
+    std::cout << (update ? "金标准已更新" : "测试通过") << std::endl;
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include "HopReblocker.h"
+#include "TestSupport.h"
+
+/**
+ * HopReblocker测试工具
+ *
+ * 用各种回调大小（小于、等于、大于hop，以及不规则序列）写入连续编号的采样，
+ * 验证输出hop连续、不丢不重，剩余采样保留到下次写入
+ */
+
+using namespace deepfilter;
+
+/**
+ * 按给定回调大小序列写入total个采样，检查输出
+ */
+static void runSequence(size_t hopSize, const std::vector<size_t>& burstSizes, size_t total) {
+    HopReblocker reblocker;
+    EXPECT(reblocker.init(hopSize));
+
+    std::vector<float> input(total);
+    for (size_t i = 0; i < total; i++) {
+        input[i] = static_cast<float>(i);
+    }
+
+    size_t expectedNext = 0;
+    size_t hops = 0;
+    bool contiguous = true;
+    size_t offset = 0;
+    size_t burstIndex = 0;
+    while (offset < total) {
+        size_t burst = burstSizes[burstIndex++ % burstSizes.size()];
+        if (burst > total - offset) {
+            burst = total - offset;
+        }
+        const size_t emitted = reblocker.write(input.data() + offset, burst, [&](const float* hop) {
+            for (size_t i = 0; i < hopSize; i++) {
+                if (hop[i] != static_cast<float>(expectedNext + i)) {
+                    contiguous = false;
+                    break;
+                }
+            }
+            expectedNext += hopSize;
+            hops++;
+        });
+        offset += burst;
+        EXPECT(emitted <= burst / hopSize + 1);
+        EXPECT(reblocker.pending() == offset - hops * hopSize);
+    }
+
+    EXPECT(contiguous);
+    EXPECT(hops == total / hopSize);
+    EXPECT(reblocker.pending() == total % hopSize);
+}
+
+/**
+ * 不同回调大小组合
+ */
+void testBurstSizes() {
+    std::cout << "测试不同回调大小..." << std::endl;
+
+    runSequence(480, {192}, 48000);                 // 常见AAudio burst小于hop
+    runSequence(480, {96}, 48000 + 17);
+    runSequence(480, {480}, 48000);                 // 与hop相同
+    runSequence(480, {1024}, 48000 + 333);          // 大于hop
+    runSequence(480, {1, 479, 481, 960, 7}, 96000); // 不规则序列
+    runSequence(1, {3, 5}, 100);
+}
+
+/**
+ * 暂存为空且输入整hop时直接传递输入指针
+ */
+void testZeroCopy() {
+    std::cout << "测试整hop直传..." << std::endl;
+
+    HopReblocker reblocker;
+    EXPECT(reblocker.init(4));
+    float data[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+    std::vector<const float*> pointers;
+    reblocker.write(data, 8, [&](const float* hop) { pointers.push_back(hop); });
+    EXPECT(pointers.size() == 2);
+    EXPECT(pointers.size() == 2 && pointers[0] == data && pointers[1] == data + 4);
+
+    // 有暂存时第一个hop来自暂存区
+    pointers.clear();
+    reblocker.write(data, 2, [&](const float* hop) { pointers.push_back(hop); });
+    EXPECT(pointers.empty());
+    reblocker.write(data + 2, 6, [&](const float* hop) { pointers.push_back(hop); });
+    EXPECT(pointers.size() == 2);
+    EXPECT(pointers.size() == 2 && pointers[0] != data && pointers[1] == data + 4);
+
+    reblocker.reset();
+    EXPECT(reblocker.pending() == 0);
+    EXPECT(!reblocker.init(0));
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  HopReblocker测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testBurstSizes();
+    testZeroCopy();
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
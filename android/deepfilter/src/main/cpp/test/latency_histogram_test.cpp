@@ -0,0 +1,131 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include "LatencyHistogram.h"
+#include "TestSupport.h"
+
+/**
+ * LatencyHistogram测试工具
+ *
+ * 验证分桶边界、分位数精度、最大值/平均值和多线程并发记录
+ */
+
+using namespace deepfilter;
+
+/**
+ * 每个值都落在上界不小于它、且相对误差不超过12.5%的桶中
+ */
+void testBuckets() {
+    std::cout << "测试分桶边界..." << std::endl;
+
+    size_t previous = 0;
+    for (uint64_t value = 0; value < 1000000; value += (value < 4096 ? 1 : 97)) {
+        const size_t index = LatencyHistogram::bucketIndex(value);
+        const int64_t upper = LatencyHistogram::bucketUpperBound(index);
+        EXPECT(index < LatencyHistogram::BUCKET_COUNT);
+        EXPECT(index >= previous);
+        EXPECT(upper >= static_cast<int64_t>(value));
+        EXPECT(static_cast<double>(upper - static_cast<int64_t>(value)) <= value * 0.125 + 1e-9);
+        if (index > 0) {
+            EXPECT(LatencyHistogram::bucketUpperBound(index - 1) < static_cast<int64_t>(value));
+        }
+        previous = index;
+    }
+
+    EXPECT(LatencyHistogram::bucketIndex(UINT64_MAX) == LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+/**
+ * 均匀分布样本的分位数
+ */
+void testPercentiles() {
+    std::cout << "测试分位数..." << std::endl;
+
+    LatencyHistogram histogram;
+    LatencySummary empty = histogram.snapshot();
+    EXPECT(empty.count == 0 && empty.p99Us == 0 && empty.maxUs == 0);
+
+    for (int64_t value = 1; value <= 10000; value++) {
+        histogram.record(value);
+    }
+    histogram.record(-5);   // 负值按0记录
+
+    LatencySummary summary = histogram.snapshot();
+    EXPECT(summary.count == 10001);
+    EXPECT(summary.maxUs == 10000);
+    EXPECT(summary.avgUs == 5000);
+    EXPECT(summary.p50Us >= 5000 && summary.p50Us <= 5000 * 1.125);
+    EXPECT(summary.p95Us >= 9500 && summary.p95Us <= 9500 * 1.125);
+    EXPECT(summary.p99Us >= 9900 && summary.p99Us <= 10000);
+    EXPECT(summary.p50Us <= summary.p95Us && summary.p95Us <= summary.p99Us);
+
+    histogram.reset();
+    summary = histogram.snapshot();
+    EXPECT(summary.count == 0 && summary.maxUs == 0);
+
+    // 单个离群值只影响max，不影响p50
+    for (int i = 0; i < 999; i++) {
+        histogram.record(100);
+    }
+    histogram.record(250000);
+    summary = histogram.snapshot();
+    EXPECT(summary.p50Us >= 100 && summary.p50Us <= 112);
+    EXPECT(summary.p99Us <= 112);
+    EXPECT(summary.maxUs == 250000);
+}
+
+/**
+ * 多线程并发记录，样本不丢失
+ */
+void testConcurrentRecord() {
+    std::cout << "测试并发记录..." << std::endl;
+
+    LatencyHistogram histogram;
+    const int threadCount = 4;
+    const int perThread = 100000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&histogram, t]() {
+            for (int i = 0; i < perThread; i++) {
+                histogram.record(t * 1000 + (i % 1000));
+            }
+        });
+    }
+
+    // 与写入并发读取
+    for (int i = 0; i < 100; i++) {
+        LatencySummary partial = histogram.snapshot();
+        EXPECT(partial.p50Us <= partial.maxUs);
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    LatencySummary summary = histogram.snapshot();
+    EXPECT(summary.count == static_cast<uint64_t>(threadCount * perThread));
+    EXPECT(summary.maxUs == (threadCount - 1) * 1000 + 999);
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  LatencyHistogram测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testBuckets();
+    testPercentiles();
+    testConcurrentRecord();
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
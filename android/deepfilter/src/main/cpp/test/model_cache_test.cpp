@@ -0,0 +1,193 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include "ModelCache.h"
+#include "deepfilter_ort.h"
+#include "TestSupport.h"
+
+/**
+ * ModelCache测试工具
+ *
+ * 链接直通桩（df_stub.cpp）运行，验证缓存未命中/命中、版本不匹配、
+ * 文件截断时的回退和重建，以及不同精度/变体包使用不同的缓存文件
+ */
+
+using namespace deepfilter;
+
+static bool fileExists(const std::string& path) {
+    return access(path.c_str(), F_OK) == 0;
+}
+
+/**
+ * 加载一次并返回是否命中
+ */
+static bool loadOnce(ModelCache& cache, const std::vector<uint8_t>& model, bool* loaded) {
+    bool hit = false;
+    void* handle = cache.loadModel(model.data(), model.size(), &hit);
+    *loaded = handle != nullptr;
+    df_model_free(handle);
+    return hit;
+}
+
+/**
+ * 未设置目录时直接加载
+ */
+void testDisabled() {
+    std::cout << "测试禁用缓存..." << std::endl;
+
+    std::vector<uint8_t> model(1024, 7);
+    ModelCache cache;
+    bool loaded = false;
+    EXPECT(!loadOnce(cache, model, &loaded));
+    EXPECT(loaded);
+    EXPECT(cache.getCachePath(model.data(), model.size()).empty());
+    EXPECT(cache.loadModel(nullptr, 0, nullptr) == nullptr);
+}
+
+/**
+ * 首次未命中并写入缓存，之后命中；损坏的缓存被丢弃并重建
+ */
+void testMissHitAndRecovery(const std::string& directory) {
+    std::cout << "测试缓存命中和回退..." << std::endl;
+
+    std::vector<uint8_t> model(64 * 1024);
+    for (size_t i = 0; i < model.size(); i++) {
+        model[i] = static_cast<uint8_t>(i * 31);
+    }
+
+    ModelCache cache;
+    cache.setDirectory((directory + "/").c_str());
+    const std::string path = cache.getCachePath(model.data(), model.size());
+    EXPECT(path.find(directory + "/df_model_") == 0);
+
+    bool loaded = false;
+    EXPECT(!loadOnce(cache, model, &loaded));
+    EXPECT(loaded);
+    EXPECT(fileExists(path));
+    EXPECT(loadOnce(cache, model, &loaded));
+    EXPECT(loaded);
+
+    // 版本字段被修改：视为未命中并重建
+    FILE* file = fopen(path.c_str(), "r+b");
+    EXPECT(file != nullptr);
+    if (file != nullptr) {
+        const uint8_t badVersion[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+        fseek(file, 4, SEEK_SET);
+        fwrite(badVersion, 1, sizeof(badVersion), file);
+        fclose(file);
+    }
+    EXPECT(!loadOnce(cache, model, &loaded));
+    EXPECT(loaded);
+    EXPECT(loadOnce(cache, model, &loaded));
+
+    // 文件被截断：长度校验失败，回退并重建
+    EXPECT(truncate(path.c_str(), 100) == 0);
+    EXPECT(!loadOnce(cache, model, &loaded));
+    EXPECT(loaded);
+    EXPECT(loadOnce(cache, model, &loaded));
+
+    // 不同模型使用不同缓存文件
+    std::vector<uint8_t> other(model);
+    other[100] ^= 1;
+    EXPECT(cache.getCachePath(other.data(), other.size()) != path);
+    EXPECT(!loadOnce(cache, other, &loaded));
+    EXPECT(loadOnce(cache, model, &loaded));
+
+    unlink(path.c_str());
+    unlink(cache.getCachePath(other.data(), other.size()).c_str());
+}
+
+/**
+ * 按精度加载：每种精度和变体包组合单独缓存，FP32且没有变体包时与原路径相同
+ */
+void testPrecision(const std::string& directory) {
+    std::cout << "测试模型精度..." << std::endl;
+
+    std::vector<uint8_t> model(4096, 5);
+    std::vector<uint8_t> variant(512, 9);
+    ModelCache cache;
+    cache.setDirectory(directory.c_str());
+
+    const std::string fp32Path = cache.getCachePath(model.data(), model.size());
+    EXPECT(cache.getCachePath(model.data(), model.size(), ModelPrecision::FP32, nullptr, 0) == fp32Path);
+    const std::string int8Path = cache.getCachePath(model.data(), model.size(), ModelPrecision::INT8);
+    const std::string fp16Path = cache.getCachePath(model.data(), model.size(), ModelPrecision::FP16,
+                                                    variant.data(), variant.size());
+    EXPECT(int8Path != fp32Path);
+    EXPECT(fp16Path != fp32Path && fp16Path != int8Path);
+
+    bool hit = true;
+    void* handle = cache.loadModel(model.data(), model.size(), ModelPrecision::INT8, nullptr, 0, &hit);
+    EXPECT(handle != nullptr && !hit);
+    df_model_free(handle);
+    EXPECT(fileExists(int8Path));
+    EXPECT(!fileExists(fp32Path));
+
+    handle = cache.loadModel(model.data(), model.size(), ModelPrecision::INT8, nullptr, 0, &hit);
+    EXPECT(handle != nullptr && hit);
+    df_model_free(handle);
+
+    handle = cache.loadModel(model.data(), model.size(), ModelPrecision::FP16, variant.data(), variant.size(), &hit);
+    EXPECT(handle != nullptr && !hit);
+    df_model_free(handle);
+    EXPECT(fileExists(fp16Path));
+
+    // 组装失败（桩实现对未知精度返回空）：报错，不写缓存
+    ModelCache uncached;
+    EXPECT(uncached.loadModel(model.data(), model.size(), static_cast<ModelPrecision>(7), nullptr, 0, &hit) == nullptr);
+    EXPECT(strstr(uncached.getLastError(), "精度") != nullptr);
+
+    EXPECT(strcmp(ModelCache::precisionName(ModelPrecision::INT8), "int8") == 0);
+
+    unlink(int8Path.c_str());
+    unlink(fp16Path.c_str());
+}
+
+/**
+ * 缓存目录不可写时仍能加载
+ */
+void testUnwritableDirectory() {
+    std::cout << "测试缓存目录不可写..." << std::endl;
+
+    std::vector<uint8_t> model(256, 3);
+    ModelCache cache;
+    cache.setDirectory("/nonexistent/cache/dir");
+    bool loaded = false;
+    EXPECT(!loadOnce(cache, model, &loaded));
+    EXPECT(loaded);
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ModelCache测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    char directory[] = "/tmp/model_cache_test_XXXXXX";
+    if (mkdtemp(directory) == nullptr) {
+        std::cout << "创建临时目录失败" << std::endl;
+        return 1;
+    }
+
+    testDisabled();
+    testMissHitAndRecovery(directory);
+    testPrecision(directory);
+    testUnwritableDirectory();
+
+    rmdir(directory);
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
@@ -0,0 +1,186 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unistd.h>
+#include "OfflineDenoiser.h"
+#include "WavFile.h"
+#include "TestSupport.h"
+
+/**
+ * OfflineDenoiser测试工具
+ *
+ * 链接直通桩（df_stub.cpp）运行，验证分块、末尾补零、
+ * 输出长度与输入一致、算法延迟补偿以及同一实例连续处理多个文件
+ */
+
+using namespace deepfilter;
+
+// 桩专用：设置之后新建实例的算法延迟（见df_stub.cpp）
+extern "C" void df_stub_set_delay(size_t samples);
+
+static std::string tempPath(const char* name) {
+    return std::string("/tmp/offline_denoiser_test_") + std::to_string(getpid()) + "_" + name + ".wav";
+}
+
+static bool writeInput(const std::string& path, int32_t sampleRate, size_t frames) {
+    std::vector<float> samples(frames);
+    for (size_t i = 0; i < frames; i++) {
+        samples[i] = 0.25f * std::sin(static_cast<float>(i) * 0.05f);
+    }
+    WavWriter writer;
+    return writer.open(path.c_str(), sampleRate, 1, WavSampleFormat::FLOAT32) &&
+           writer.write(samples.data(), frames) &&
+           writer.close();
+}
+
+/**
+ * 不是hop整数倍、且跨多个块的输入：输出长度与输入一致，直通桩下内容相同
+ */
+void testProcessFile() {
+    std::cout << "测试文件降噪..." << std::endl;
+
+    const uint8_t fakeModel[4] = {1, 2, 3, 4};
+    OfflineDenoiser denoiser;
+    EXPECT(denoiser.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+    EXPECT(denoiser.getFrameSize() == 480);
+
+    const std::string input = tempPath("in");
+    const std::string output = tempPath("out");
+    const size_t frames = 480 * 25 + 77;
+    EXPECT(writeInput(input, 48000, frames));
+
+    OfflineOptions options;
+    options.chunkHops = 4;
+    options.outputFormat = WavSampleFormat::FLOAT32;
+
+    for (int pass = 0; pass < 2; pass++) {
+        OfflineResult result;
+        EXPECT(denoiser.processFile(input.c_str(), output.c_str(), options, &result));
+        EXPECT(result.samples == frames);
+        EXPECT(result.hops == 26);
+        EXPECT(result.audioSeconds > 0.0);
+
+        WavReader in;
+        WavReader out;
+        EXPECT(in.open(input.c_str()));
+        EXPECT(out.open(output.c_str()));
+        EXPECT(out.sampleRate() == 48000);
+        EXPECT(out.channels() == 1);
+        EXPECT(out.frameCount() == frames);
+
+        std::vector<float> a(frames);
+        std::vector<float> b(frames);
+        EXPECT(in.read(a.data(), frames) == frames);
+        EXPECT(out.read(b.data(), frames) == frames);
+        EXPECT(a == b);
+    }
+
+    unlink(input.c_str());
+    unlink(output.c_str());
+}
+
+/**
+ * 有算法延迟的模型：默认补偿后输出与输入对齐且尾部完整，关闭补偿时输出滞后delay个采样
+ */
+void testDelayCompensation() {
+    std::cout << "测试算法延迟补偿..." << std::endl;
+
+    // 与DeepFilterNet3相同：(960 - 480) + 2 * 480
+    const size_t delay = 1440;
+    df_stub_set_delay(delay);
+
+    const uint8_t fakeModel[4] = {1, 2, 3, 4};
+    OfflineDenoiser denoiser;
+    EXPECT(denoiser.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+
+    const std::string input = tempPath("delay_in");
+    const std::string output = tempPath("delay_out");
+    // 末尾不足一个hop，且延迟跨越块边界
+    const size_t frames = 480 * 9 + 123;
+    EXPECT(writeInput(input, 48000, frames));
+
+    std::vector<float> a(frames);
+    WavReader in;
+    EXPECT(in.open(input.c_str()));
+    EXPECT(in.read(a.data(), frames) == frames);
+
+    OfflineOptions options;
+    options.chunkHops = 2;
+    options.outputFormat = WavSampleFormat::FLOAT32;
+
+    for (int compensate = 0; compensate < 2; compensate++) {
+        options.compensateDelay = compensate != 0;
+        OfflineResult result;
+        EXPECT(denoiser.processFile(input.c_str(), output.c_str(), options, &result));
+        EXPECT(result.samples == frames);
+
+        WavReader out;
+        EXPECT(out.open(output.c_str()));
+        EXPECT(out.frameCount() == frames);
+        std::vector<float> b(frames);
+        EXPECT(out.read(b.data(), frames) == frames);
+
+        if (options.compensateDelay) {
+            EXPECT(result.hops == (frames + delay + 479) / 480);
+            EXPECT(a == b);
+        } else {
+            EXPECT(result.hops == 10);
+            bool shifted = true;
+            for (size_t i = 0; i < frames; i++) {
+                const float expected = i < delay ? 0.0f : a[i - delay];
+                shifted = shifted && b[i] == expected;
+            }
+            EXPECT(shifted);
+        }
+    }
+
+    df_stub_set_delay(0);
+    unlink(input.c_str());
+    unlink(output.c_str());
+}
+
+/**
+ * 非48kHz输入和未初始化调用应失败
+ */
+void testRejectsInvalidInput() {
+    std::cout << "测试无效输入..." << std::endl;
+
+    const std::string input = tempPath("16k");
+    const std::string output = tempPath("16k_out");
+    EXPECT(writeInput(input, 16000, 1600));
+
+    OfflineDenoiser denoiser;
+    OfflineOptions options;
+    EXPECT(!denoiser.processFile(input.c_str(), output.c_str(), options, nullptr));
+
+    const uint8_t fakeModel[4] = {1, 2, 3, 4};
+    EXPECT(denoiser.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f));
+    EXPECT(!denoiser.processFile(input.c_str(), output.c_str(), options, nullptr));
+    EXPECT(!denoiser.initialize(nullptr, 0, 0.0f, 100.0f));
+
+    unlink(input.c_str());
+    unlink(output.c_str());
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  OfflineDenoiser测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testProcessFile();
+    testDelayCompensation();
+    testRejectsInvalidInput();
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
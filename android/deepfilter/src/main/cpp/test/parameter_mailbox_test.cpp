@@ -0,0 +1,185 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include "ParameterMailbox.h"
+#include "TestSupport.h"
+
+/**
+ * ParameterMailbox测试工具
+ *
+ * 1. 验证斜坡：线性过渡、斜坡途中改目标、斜坡长度为0时直接生效
+ * 2. 压力测试：两个写线程高频写入目标值，处理线程逐hop推进，
+ *    检查每步变化不超过斜坡步长上限、值不越界，写入停止后收敛到最后写入的值
+ */
+
+using namespace deepfilter;
+
+static const size_t BETA = static_cast<size_t>(DenoiseParameter::POST_FILTER_BETA);
+static const size_t ATTEN = static_cast<size_t>(DenoiseParameter::ATTEN_LIM_DB);
+
+static bool near(float a, float b) {
+    return std::fabs(a - b) < 1e-4f;
+}
+
+/**
+ * 线性斜坡
+ */
+static void testRamp() {
+    std::cout << "[测试] 线性斜坡" << std::endl;
+
+    ParameterMailbox mailbox;
+    EXPECT(!mailbox.init(0.0f, 100.0f, -1));
+    EXPECT(mailbox.init(0.0f, 100.0f, 4));
+    EXPECT(mailbox.isSettled());
+
+    float values[ParameterMailbox::PARAMETER_COUNT];
+    EXPECT(mailbox.advance(values) == 0);
+    EXPECT(values[BETA] == 0.0f && values[ATTEN] == 100.0f);
+
+    // 4个hop从100dB线性过渡到20dB，beta不变
+    mailbox.post(DenoiseParameter::ATTEN_LIM_DB, 20.0f);
+    EXPECT(!mailbox.isSettled());
+    const float expected[] = {80.0f, 60.0f, 40.0f, 20.0f};
+    for (float value : expected) {
+        EXPECT(mailbox.advance(values) == (1u << ATTEN));
+        EXPECT(near(values[ATTEN], value));
+        EXPECT(values[BETA] == 0.0f);
+    }
+    EXPECT(values[ATTEN] == 20.0f);
+    EXPECT(mailbox.advance(values) == 0);
+    EXPECT(mailbox.isSettled());
+
+    // 斜坡途中改目标：从当前值重新开始，不跳变
+    mailbox.post(DenoiseParameter::POST_FILTER_BETA, 0.08f);
+    mailbox.advance(values);
+    EXPECT(near(values[BETA], 0.02f));
+    mailbox.post(DenoiseParameter::POST_FILTER_BETA, 0.0f);
+    mailbox.advance(values);
+    EXPECT(near(values[BETA], 0.015f));
+    for (int i = 0; i < 3; i++) {
+        mailbox.advance(values);
+    }
+    EXPECT(values[BETA] == 0.0f);
+
+    // 同一hop内多次写入只取最后一次
+    mailbox.post(DenoiseParameter::ATTEN_LIM_DB, 50.0f);
+    mailbox.post(DenoiseParameter::ATTEN_LIM_DB, 24.0f);
+    mailbox.advance(values);
+    EXPECT(near(values[ATTEN], 21.0f));
+
+    // 斜坡长度为0：下一个hop直接生效
+    mailbox.setRampHops(0);
+    mailbox.post(DenoiseParameter::ATTEN_LIM_DB, 6.0f);
+    EXPECT(mailbox.advance(values) == (1u << ATTEN));
+    EXPECT(values[ATTEN] == 6.0f);
+    EXPECT(mailbox.getRampHops() == 0);
+
+    const ParameterMailboxStats stats = mailbox.getStats();
+    EXPECT(stats.posts == 6);
+    EXPECT(stats.retargets == 5);
+    EXPECT(stats.current[ATTEN] == 6.0f);
+    EXPECT(stats.target[BETA] == 0.0f);
+}
+
+/**
+ * 高频并发写入
+ */
+static void testConcurrentPosts() {
+    std::cout << "[测试] 并发写入压力测试" << std::endl;
+
+    const int32_t rampHops = 5;
+    const float maxAtten = 100.0f;
+    const float maxBeta = 0.1f;
+    ParameterMailbox mailbox;
+    EXPECT(mailbox.init(0.0f, maxAtten, rampHops));
+
+    // 两个写线程：模拟UI滑块（锯齿）和自动响度控制（随机）
+    std::atomic<bool> running(true);
+    std::atomic<uint64_t> posted(0);
+    std::thread slider([&]() {
+        for (uint32_t i = 0; running.load(std::memory_order_relaxed); i++) {
+            mailbox.post(DenoiseParameter::ATTEN_LIM_DB, static_cast<float>(i % 101));
+            mailbox.post(DenoiseParameter::POST_FILTER_BETA, maxBeta * static_cast<float>(i % 11) / 10.0f);
+            posted.fetch_add(2, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+    });
+    std::thread controller([&]() {
+        uint32_t seed = 12345;
+        while (running.load(std::memory_order_relaxed)) {
+            seed = seed * 1664525u + 1013904223u;
+            mailbox.post(DenoiseParameter::ATTEN_LIM_DB, static_cast<float>(seed >> 16) / 65535.0f * maxAtten);
+            posted.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+    });
+
+    // 处理线程：每步变化不超过满量程 / rampHops（斜坡从任意当前值出发到任意目标的最大步长）
+    const int32_t hops = 5000;
+    float values[ParameterMailbox::PARAMETER_COUNT];
+    float previous[ParameterMailbox::PARAMETER_COUNT] = {0.0f, maxAtten};
+    uint64_t oversizedSteps = 0;
+    uint64_t outOfRange = 0;
+    uint64_t changedHops = 0;
+    for (int32_t h = 0; h < hops; h++) {
+        if (mailbox.advance(values) != 0) {
+            changedHops++;
+        }
+        if (std::fabs(values[ATTEN] - previous[ATTEN]) > maxAtten / rampHops + 1e-3f ||
+            std::fabs(values[BETA] - previous[BETA]) > maxBeta / rampHops + 1e-6f) {
+            oversizedSteps++;
+        }
+        if (values[ATTEN] < 0.0f || values[ATTEN] > maxAtten || values[BETA] < 0.0f || values[BETA] > maxBeta + 1e-6f) {
+            outOfRange++;
+        }
+        previous[ATTEN] = values[ATTEN];
+        previous[BETA] = values[BETA];
+        // 让出CPU，单核机器上写线程也能在hop之间穿插写入
+        std::this_thread::yield();
+    }
+    running = false;
+    slider.join();
+    controller.join();
+
+    // 写入停止后rampHops个hop内收敛到最后写入的值
+    const float finalAtten = mailbox.getTarget(DenoiseParameter::ATTEN_LIM_DB);
+    const float finalBeta = mailbox.getTarget(DenoiseParameter::POST_FILTER_BETA);
+    for (int32_t h = 0; h < rampHops + 1; h++) {
+        mailbox.advance(values);
+    }
+
+    const ParameterMailboxStats stats = mailbox.getStats();
+    std::cout << "  写入 " << stats.posts << " 次，处理 " << hops << " hop，下发 " << stats.appliedSteps
+              << " 次，新目标 " << stats.retargets << " 次" << std::endl;
+    EXPECT(stats.posts == posted.load());
+    EXPECT(oversizedSteps == 0);
+    EXPECT(outOfRange == 0);
+    EXPECT(changedHops > 0);
+    EXPECT(stats.retargets > 100);
+    EXPECT(values[ATTEN] == finalAtten);
+    EXPECT(values[BETA] == finalBeta);
+    EXPECT(mailbox.isSettled());
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ParameterMailbox测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testRamp();
+    testConcurrentPosts();
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
@@ -0,0 +1,242 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include "PlayoutBuffer.h"
+#include "TestSupport.h"
+
+/**
+ * PlayoutBuffer测试工具
+ *
+ * 不依赖音频设备，用确定性的事件模拟驱动生产者和消费者，验证：
+ * 1. 修正量为0时输出与输入逐采样一致（多声道交织）
+ * 2. 预缓冲、欠载后补零并重新预缓冲、缓冲区满时丢弃并计数
+ * 3. 写入端时钟比读取端快或慢几百ppm时，读取速率修正收敛到时钟偏差，
+ *    长时间运行不欠载、不溢出，输出波形连续；关闭补偿时同样的偏差会欠载
+ */
+
+using namespace deepfilter;
+
+/**
+ * 不做速率修正时的直通
+ */
+static void testPassthrough() {
+    std::cout << "[测试] 直通" << std::endl;
+
+    PlayoutBuffer buffer;
+    EXPECT(buffer.init(48000, 2, 256, 1024, 0.0));
+
+    // 每帧两个声道：(n, -n)
+    std::vector<float> input(600 * 2);
+    for (size_t i = 0; i < 600; i++) {
+        input[i * 2] = static_cast<float>(i);
+        input[i * 2 + 1] = -static_cast<float>(i);
+    }
+    EXPECT(buffer.write(input.data(), 300) == 300);
+    EXPECT(buffer.write(input.data() + 300 * 2, 300) == 300);
+
+    // 插值需要多看一帧，共可读出599帧
+    std::vector<float> output(100 * 2);
+    bool exact = true;
+    for (size_t block = 0; block < 5; block++) {
+        buffer.render(output.data(), 100);
+        for (size_t i = 0; i < 100 * 2; i++) {
+            if (output[i] != input[block * 100 * 2 + i]) {
+                exact = false;
+            }
+        }
+    }
+    EXPECT(exact);
+
+    const PlayoutBufferStats stats = buffer.getStats();
+    EXPECT(stats.writtenFrames == 600);
+    EXPECT(stats.renderedFrames == 500);
+    EXPECT(stats.fillFrames == 100);
+    EXPECT(stats.underruns == 0);
+    EXPECT(stats.silentFrames == 0);
+    EXPECT(stats.correctionPpm == 0);
+}
+
+/**
+ * 预缓冲、欠载和溢出
+ */
+static void testPrimingUnderrunOverflow() {
+    std::cout << "[测试] 预缓冲/欠载/溢出" << std::endl;
+
+    PlayoutBuffer buffer;
+    EXPECT(!buffer.init(48000, 1, 0, 1024));
+    EXPECT(!buffer.init(48000, 1, 1024, 1024));
+    EXPECT(!buffer.init(0, 1, 256, 1024));
+    EXPECT(buffer.init(48000, 1, 256, 1000, 0.0));
+
+    std::vector<float> ones(2048, 1.0f);
+    std::vector<float> output(64, -1.0f);
+
+    // 未达到目标深度前输出静音
+    buffer.render(output.data(), 64);
+    EXPECT(output[0] == 0.0f && output[63] == 0.0f);
+    buffer.write(ones.data(), 255);
+    buffer.render(output.data(), 64);
+    EXPECT(output[63] == 0.0f);
+    EXPECT(buffer.getStats().silentFrames == 128);
+
+    // 达到目标后开始播放
+    buffer.write(ones.data(), 1);
+    buffer.render(output.data(), 64);
+    EXPECT(output[0] == 1.0f && output[63] == 1.0f);
+
+    // 剩余数据不足一次回调加插值所需的一帧时欠载，补零并重新预缓冲（剩余数据保留）
+    for (int i = 0; i < 2; i++) {
+        buffer.render(output.data(), 64);
+    }
+    EXPECT(buffer.getStats().underruns == 0);
+    buffer.render(output.data(), 64);
+    EXPECT(output[0] == 0.0f);
+    PlayoutBufferStats stats = buffer.getStats();
+    EXPECT(stats.underruns == 1);
+    EXPECT(stats.silentFrames == 192);
+    EXPECT(stats.fillFrames == 64);
+
+    // 容量向上取整为1024帧，写满后丢弃新数据
+    EXPECT(buffer.write(ones.data(), 2000) == 960);
+    stats = buffer.getStats();
+    EXPECT(stats.overflowFrames == 1040);
+    EXPECT(stats.fillFrames == 1024);
+
+    buffer.reset();
+    stats = buffer.getStats();
+    EXPECT(stats.writtenFrames == 0);
+    EXPECT(stats.overflowFrames == 0);
+    EXPECT(stats.fillFrames == 0);
+}
+
+/**
+ * 漂移模拟结果
+ */
+struct DriftResult {
+    PlayoutBufferStats stats;
+    int32_t minFill;            // 收敛后（最后一半时间）的最小缓冲深度
+    int32_t maxFill;
+    double meanCorrectionPpm;   // 收敛后读取速率修正的平均值
+    float maxJump;              // 收敛后相邻输出采样的最大差值
+};
+
+/**
+ * 按事件时间交替调用write和render：写入端每次480帧（一个hop），时钟偏差skewPpm；
+ * 读取端每次192帧（4ms burst），时钟准确。
+ * 按hop写入使缓冲深度呈锯齿状，渲染时刻相对写入的相位随偏差缓慢移动，
+ * 修正量会围绕时钟偏差小幅摆动，因此比较收敛后的平均值
+ */
+static DriftResult simulateDrift(double skewPpm, double maxCorrectionPpm, double seconds) {
+    const int32_t sampleRate = 48000;
+    const size_t hop = 480;
+    const size_t burst = 192;
+    const double frequency = 50.0;      // 低频正弦，相邻采样差值小，欠载补零会造成明显跳变
+
+    PlayoutBuffer buffer;
+    buffer.init(sampleRate, 1, hop + 2 * burst, 4096, maxCorrectionPpm);
+
+    std::vector<float> hopData(hop);
+    std::vector<float> output(burst);
+    const double writeInterval = static_cast<double>(hop) / (sampleRate * (1.0 + skewPpm * 1e-6));
+    const double renderInterval = static_cast<double>(burst) / sampleRate;
+    uint64_t written = 0;
+    uint64_t writes = 0;
+    uint64_t renders = 0;
+    float previous = 0.0f;
+
+    DriftResult result;
+    result.minFill = INT32_MAX;
+    result.maxFill = 0;
+    result.maxJump = 0.0f;
+    double correctionSum = 0.0;
+    uint64_t correctionCount = 0;
+
+    while (static_cast<double>(renders) * renderInterval < seconds) {
+        if (static_cast<double>(writes) * writeInterval <= static_cast<double>(renders) * renderInterval) {
+            for (size_t i = 0; i < hop; i++) {
+                hopData[i] = static_cast<float>(std::sin(2.0 * M_PI * frequency * static_cast<double>(written + i) / sampleRate));
+            }
+            buffer.write(hopData.data(), hop);
+            written += hop;
+            writes++;
+            continue;
+        }
+
+        buffer.render(output.data(), burst);
+        renders++;
+        if (static_cast<double>(renders) * renderInterval > seconds / 2) {
+            const PlayoutBufferStats stats = buffer.getStats();
+            result.minFill = std::min(result.minFill, stats.fillFrames);
+            result.maxFill = std::max(result.maxFill, stats.fillFrames);
+            correctionSum += stats.correctionPpm;
+            correctionCount++;
+            for (size_t i = 0; i < burst; i++) {
+                result.maxJump = std::max(result.maxJump, std::fabs(output[i] - previous));
+                previous = output[i];
+            }
+        } else {
+            previous = output[burst - 1];
+        }
+    }
+
+    result.stats = buffer.getStats();
+    result.meanCorrectionPpm = correctionCount > 0 ? correctionSum / static_cast<double>(correctionCount) : 0.0;
+    return result;
+}
+
+/**
+ * 时钟漂移补偿
+ */
+static void testDriftCompensation() {
+    std::cout << "[测试] 时钟漂移补偿" << std::endl;
+
+    // 50Hz正弦相邻采样的最大差值约0.0065
+    const float continuousJump = 0.01f;
+
+    for (double skew : {300.0, -300.0, 800.0}) {
+        const DriftResult result = simulateDrift(skew, 1000.0, 240.0);
+        std::cout << "  偏差" << skew << "ppm: 平均修正=" << result.meanCorrectionPpm
+                  << "ppm, 深度=" << result.minFill << "~" << result.maxFill
+                  << ", 欠载=" << result.stats.underruns
+                  << ", 溢出=" << result.stats.overflowFrames << std::endl;
+        EXPECT(std::fabs(result.meanCorrectionPpm - skew) <= 20.0);
+        EXPECT(result.stats.underruns == 0);
+        EXPECT(result.stats.overflowFrames == 0);
+        EXPECT(result.minFill >= 192);
+        EXPECT(result.maxFill <= 864 + 480);
+        EXPECT(result.maxJump < continuousJump);
+    }
+
+    // 偏差超出修正上限时无法补偿，最终欠载
+    const DriftResult limited = simulateDrift(-1500.0, 1000.0, 120.0);
+    EXPECT(limited.stats.underruns > 0);
+
+    // 关闭补偿时写入端较慢会逐渐排空
+    const DriftResult uncompensated = simulateDrift(-300.0, 0.0, 120.0);
+    std::cout << "  无补偿 -300ppm: 欠载=" << uncompensated.stats.underruns << std::endl;
+    EXPECT(uncompensated.stats.underruns > 0);
+    EXPECT(uncompensated.maxJump > continuousJump);
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  PlayoutBuffer测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testPassthrough();
+    testPrimingUnderrunOverflow();
+    testDriftCompensation();
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
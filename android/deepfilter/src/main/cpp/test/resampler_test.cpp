@@ -0,0 +1,209 @@
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include "Resampler.h"
+#include "TestSupport.h"
+
+/**
+ * Resampler测试工具
+ *
+ * 验证常见采样率之间转换的输出长度、正弦波保真度、抗混叠、分块一致性、延迟报告和直通模式
+ */
+
+using namespace deepfilter;
+
+/**
+ * 按固定块大小流式处理整段信号
+ */
+static std::vector<float> resampleAll(Resampler& resampler, const std::vector<float>& input, size_t blockSize) {
+    std::vector<float> output;
+    std::vector<float> block(resampler.getMaxOutputFrames());
+    for (size_t offset = 0; offset < input.size(); offset += blockSize) {
+        const size_t count = input.size() - offset < blockSize ? input.size() - offset : blockSize;
+        const size_t produced = resampler.process(input.data() + offset, count, block.data());
+        output.insert(output.end(), block.begin(), block.begin() + produced);
+    }
+    return output;
+}
+
+static std::vector<float> sine(int32_t rate, double frequency, size_t frames) {
+    std::vector<float> signal(frames);
+    for (size_t i = 0; i < frames; i++) {
+        signal[i] = static_cast<float>(0.5 * std::sin(2.0 * M_PI * frequency * i / rate));
+    }
+    return signal;
+}
+
+/**
+ * 正弦波转换后与理想正弦（按报告的延迟对齐）比较，返回SNR（dB）
+ */
+static double sineSnr(int32_t inputRate, int32_t outputRate, double frequency) {
+    Resampler resampler;
+    if (!resampler.init(inputRate, outputRate, 1024)) {
+        return 0.0;
+    }
+
+    std::vector<float> output = resampleAll(resampler, sine(inputRate, frequency, inputRate), 1024);
+
+    const double latency = resampler.getLatencyFrames();
+    double signalPower = 0.0;
+    double errorPower = 0.0;
+    // 跳过开头的滤波器过渡段
+    const size_t skip = static_cast<size_t>(latency) * 2 + 16;
+    for (size_t n = skip; n < output.size(); n++) {
+        const double expected = 0.5 * std::sin(2.0 * M_PI * frequency * (n - latency) / outputRate);
+        signalPower += expected * expected;
+        errorPower += (output[n] - expected) * (output[n] - expected);
+    }
+    return 10.0 * std::log10(signalPower / (errorPower + 1e-20));
+}
+
+/**
+ * 输出长度与采样率比例一致（扣除滤波器延迟）
+ */
+void testOutputLength() {
+    std::cout << "测试输出长度..." << std::endl;
+
+    const int32_t pairs[][2] = {{44100, 48000}, {48000, 44100}, {16000, 48000}, {48000, 16000}, {8000, 48000}};
+    for (const auto& pair : pairs) {
+        Resampler resampler;
+        EXPECT(resampler.init(pair[0], pair[1], 192));
+        EXPECT(!resampler.isPassthrough());
+        EXPECT(resampler.getInputRate() == pair[0] && resampler.getOutputRate() == pair[1]);
+        std::vector<float> input(static_cast<size_t>(pair[0]) * 2, 0.1f);
+        std::vector<float> output = resampleAll(resampler, input, 192);
+        const double expected = static_cast<double>(input.size()) * pair[1] / pair[0];
+        EXPECT(std::fabs(static_cast<double>(output.size()) - expected) <= 2.0);
+    }
+}
+
+/**
+ * 通带内正弦波保真度
+ */
+void testSineFidelity() {
+    std::cout << "测试正弦波保真度..." << std::endl;
+
+    const double snr44 = sineSnr(44100, 48000, 1000.0);
+    const double snr16 = sineSnr(16000, 48000, 1000.0);
+    const double snrDown = sineSnr(48000, 16000, 1000.0);
+    std::cout << "  SNR: 44.1k->48k " << snr44 << " dB, 16k->48k " << snr16
+              << " dB, 48k->16k " << snrDown << " dB (" << Resampler::simdName() << ")" << std::endl;
+    EXPECT(snr44 > 60.0);
+    EXPECT(snr16 > 60.0);
+    EXPECT(snrDown > 60.0);
+}
+
+/**
+ * 降采样时高于目标奈奎斯特频率的成分被抑制
+ */
+void testAntiAliasing() {
+    std::cout << "测试抗混叠..." << std::endl;
+
+    Resampler resampler;
+    EXPECT(resampler.init(48000, 16000, 1024));
+    // 12kHz高于16kHz的奈奎斯特频率（8kHz），转换后应接近静音
+    std::vector<float> output = resampleAll(resampler, sine(48000, 12000.0, 48000), 1024);
+    double power = 0.0;
+    for (size_t n = 200; n < output.size(); n++) {
+        power += output[n] * output[n];
+    }
+    power /= static_cast<double>(output.size() - 200);
+    const double attenuationDb = 10.0 * std::log10(power / 0.125 + 1e-20);
+    std::cout << "  12kHz衰减: " << attenuationDb << " dB" << std::endl;
+    EXPECT(attenuationDb < -60.0);
+}
+
+/**
+ * 不同分块大小的结果完全相同
+ */
+void testBlockInvariance() {
+    std::cout << "测试分块一致性..." << std::endl;
+
+    std::vector<float> input = sine(44100, 440.0, 44100 / 2);
+    Resampler a;
+    Resampler b;
+    Resampler c;
+    EXPECT(a.init(44100, 48000, 1024));
+    EXPECT(b.init(44100, 48000, 1024));
+    EXPECT(c.init(44100, 48000, 1024));
+    std::vector<float> whole = resampleAll(a, input, 1024);
+    std::vector<float> single = resampleAll(b, input, 1);
+    std::vector<float> odd = resampleAll(c, input, 333);
+    EXPECT(whole == single);
+    EXPECT(whole == odd);
+
+    // reset后重新开始得到相同结果
+    a.reset();
+    EXPECT(resampleAll(a, input, 1024) == whole);
+}
+
+/**
+ * 冲激响应峰值位于报告的延迟处
+ */
+void testLatency() {
+    std::cout << "测试延迟报告..." << std::endl;
+
+    Resampler resampler;
+    EXPECT(resampler.init(16000, 48000, 256));
+    std::vector<float> impulse(256, 0.0f);
+    impulse[0] = 1.0f;
+    std::vector<float> output = resampleAll(resampler, impulse, 256);
+    size_t peak = 0;
+    for (size_t i = 1; i < output.size(); i++) {
+        if (std::fabs(output[i]) > std::fabs(output[peak])) {
+            peak = i;
+        }
+    }
+    EXPECT(std::fabs(static_cast<double>(peak) - resampler.getLatencyFrames()) <= 1.0);
+    EXPECT(resampler.getLatencyUs() > 0 && resampler.getLatencyUs() < 2000);
+
+    // 超过最大输入块时拒绝
+    std::vector<float> large(257, 0.0f);
+    std::vector<float> out(resampler.getMaxOutputFrames() * 2);
+    EXPECT(resampler.process(large.data(), large.size(), out.data()) == 0);
+}
+
+/**
+ * 相同采样率直通与参数校验
+ */
+void testPassthrough() {
+    std::cout << "测试直通..." << std::endl;
+
+    Resampler resampler;
+    EXPECT(resampler.init(48000, 48000, 480));
+    EXPECT(resampler.isPassthrough());
+    EXPECT(resampler.getLatencyFrames() == 0.0);
+    std::vector<float> input = sine(48000, 1000.0, 480);
+    std::vector<float> output(480);
+    EXPECT(resampler.process(input.data(), input.size(), output.data()) == 480);
+    EXPECT(output == input);
+
+    EXPECT(!resampler.init(0, 48000, 480));
+    EXPECT(!resampler.init(48000, 48000, 0));
+    EXPECT(!resampler.init(47999, 48000, 480));    // 相位数过多
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  Resampler测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testOutputLength();
+    testSineFidelity();
+    testAntiAliasing();
+    testBlockInvariance();
+    testLatency();
+    testPassthrough();
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
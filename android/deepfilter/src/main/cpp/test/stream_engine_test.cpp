@@ -0,0 +1,242 @@
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "StreamEngine.h"
+#include "TestSupport.h"
+
+/**
+ * StreamEngine测试工具
+ *
+ * 链接直通桩（df_stub.cpp）运行，验证多路流并发时每路流的hop顺序、
+ * 同一路流回调不并发、流销毁/复用和准入控制
+ */
+
+using namespace deepfilter;
+
+static const uint8_t fakeModel[4] = {1, 2, 3, 4};
+
+static bool waitForHops(const StreamEngine& engine, uint64_t hops) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (engine.getStats().processedHops < hops) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+/**
+ * 多个生产者线程以非hop对齐的块写入，每路流的输出必须按序且完整
+ */
+void testHopOrder() {
+    std::cout << "测试多路流hop顺序..." << std::endl;
+
+    const int32_t streamCount = 32;
+    const uint64_t hopsPerStream = 200;
+
+    struct Tracker {
+        std::atomic<uint64_t> nextHop{0};
+        std::atomic<bool> inCallback{false};
+        std::atomic<bool> outOfOrder{false};
+        std::atomic<bool> concurrent{false};
+    };
+    std::vector<Tracker> trackers(streamCount);
+
+    StreamEngine engine;
+    StreamEngineConfig config;
+    config.workerCount = 4;
+    config.maxStreams = streamCount;
+    config.queueHops = hopsPerStream;
+    EXPECT(engine.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f, config));
+    const size_t hop = engine.getFrameSize();
+
+    std::vector<int32_t> ids;
+    for (int32_t i = 0; i < streamCount; i++) {
+        int32_t id = engine.createStream([&trackers, hop](int32_t streamId, uint64_t hopIndex,
+                                                          const float* audio, int32_t numFrames, float) {
+            Tracker& tracker = trackers[static_cast<size_t>(streamId)];
+            if (tracker.inCallback.exchange(true)) {
+                tracker.concurrent = true;
+            }
+            // 直通桩输出等于输入，输入采样值编码了hop序号
+            const uint64_t expected = tracker.nextHop.load();
+            if (hopIndex != expected || numFrames != static_cast<int32_t>(hop) ||
+                audio[0] != static_cast<float>(expected) || audio[hop - 1] != static_cast<float>(expected)) {
+                tracker.outOfOrder = true;
+            }
+            tracker.nextHop = expected + 1;
+            tracker.inCallback = false;
+        });
+        EXPECT(id >= 0);
+        ids.push_back(id);
+    }
+
+    std::vector<std::thread> producers;
+    for (int32_t p = 0; p < 4; p++) {
+        producers.emplace_back([&, p]() {
+            std::vector<float> audio(hop * hopsPerStream);
+            for (size_t i = 0; i < audio.size(); i++) {
+                audio[i] = static_cast<float>(i / hop);
+            }
+            // 每个生产者负责一部分流，按300采样点一块写入
+            for (size_t offset = 0; offset < audio.size(); offset += 300) {
+                const size_t chunk = audio.size() - offset < 300 ? audio.size() - offset : 300;
+                for (int32_t s = p; s < streamCount; s += 4) {
+                    engine.pushAudio(ids[static_cast<size_t>(s)], audio.data() + offset, chunk);
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT(waitForHops(engine, streamCount * hopsPerStream));
+
+    for (int32_t i = 0; i < streamCount; i++) {
+        EXPECT(!trackers[static_cast<size_t>(i)].outOfOrder);
+        EXPECT(!trackers[static_cast<size_t>(i)].concurrent);
+        EXPECT(trackers[static_cast<size_t>(i)].nextHop == hopsPerStream);
+
+        StreamStats stats;
+        EXPECT(engine.getStreamStats(ids[static_cast<size_t>(i)], &stats));
+        EXPECT(stats.processedHops == hopsPerStream);
+        EXPECT(stats.droppedHops == 0);
+    }
+
+    StreamEngineStats stats = engine.getStats();
+    EXPECT(stats.workerCount == 4);
+    EXPECT(stats.activeStreams == static_cast<size_t>(streamCount));
+    engine.release();
+}
+
+/**
+ * 处理过程中销毁流，槽位可被复用；无效ID被拒绝
+ */
+void testDestroyAndReuse() {
+    std::cout << "测试流销毁和复用..." << std::endl;
+
+    StreamEngine engine;
+    StreamEngineConfig config;
+    config.workerCount = 2;
+    config.maxStreams = 2;
+    EXPECT(engine.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f, config));
+
+    std::vector<float> audio(engine.getFrameSize() * 16, 0.1f);
+    for (int round = 0; round < 200; round++) {
+        int32_t id = engine.createStream([](int32_t, uint64_t, const float*, int32_t, float) {});
+        EXPECT(id >= 0);
+        engine.pushAudio(id, audio.data(), audio.size());
+        engine.destroyStream(id);
+        EXPECT(engine.pushAudio(id, audio.data(), audio.size()) == -1);
+    }
+
+    EXPECT(engine.createStream(nullptr) >= 0);
+    EXPECT(engine.createStream(nullptr) >= 0);
+    EXPECT(engine.createStream(nullptr) == -1);
+    EXPECT(engine.pushAudio(-1, audio.data(), audio.size()) == -1);
+    EXPECT(engine.pushAudio(99, audio.data(), audio.size()) == -1);
+    EXPECT(engine.getStats().activeStreams == 2);
+    engine.release();
+}
+
+/**
+ * 生产者线程持续写入时反复销毁并重建同一槽位的流：销毁等待进行中的写入，不会访问已释放的队列
+ */
+void testDestroyDuringPush() {
+    std::cout << "测试写入期间销毁流..." << std::endl;
+
+    StreamEngine engine;
+    StreamEngineConfig config;
+    config.workerCount = 2;
+    config.maxStreams = 1;
+    EXPECT(engine.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f, config));
+
+    int32_t id = engine.createStream([](int32_t, uint64_t, const float*, int32_t, float) {});
+    EXPECT(id == 0);
+
+    // 每次写入不足一个hop，保证reblocker里总有暂存数据
+    std::vector<float> audio(engine.getFrameSize() * 3 / 2, 0.1f);
+    std::atomic<bool> running(true);
+    std::atomic<uint64_t> accepted(0);
+    std::atomic<uint64_t> rejected(0);
+    std::thread producer([&]() {
+        while (running.load(std::memory_order_relaxed)) {
+            if (engine.pushAudio(0, audio.data(), audio.size()) < 0) {
+                rejected++;
+            } else {
+                accepted++;
+            }
+        }
+    });
+
+    for (int round = 0; round < 500; round++) {
+        // 等新流至少被写入一次，让销毁与写入交叠
+        const uint64_t before = accepted.load();
+        while (accepted.load() == before) {
+            std::this_thread::yield();
+        }
+        engine.destroyStream(id);
+        id = engine.createStream([](int32_t, uint64_t, const float*, int32_t, float) {});
+        EXPECT(id == 0);
+    }
+    running = false;
+    producer.join();
+
+    std::cout << "  写入成功 " << accepted.load() << " 次，被拒绝 " << rejected.load() << " 次" << std::endl;
+    EXPECT(accepted.load() >= 500);
+    EXPECT(engine.getStats().activeStreams == 1);
+    engine.release();
+}
+
+/**
+ * 有实测单hop耗时后，超出处理能力的新流被拒绝
+ */
+void testAdmissionControl() {
+    std::cout << "测试准入控制..." << std::endl;
+
+    StreamEngine engine;
+    StreamEngineConfig config;
+    config.workerCount = 1;
+    config.maxUtilization = 1e-9;
+    EXPECT(engine.initialize(fakeModel, sizeof(fakeModel), 0.0f, 100.0f, config));
+
+    // 尚无实测数据时允许创建
+    int32_t id = engine.createStream(nullptr);
+    EXPECT(id >= 0);
+
+    std::vector<float> audio(engine.getFrameSize() * 8, 0.1f);
+    engine.pushAudio(id, audio.data(), audio.size());
+    EXPECT(waitForHops(engine, 8));
+
+    EXPECT(engine.getStats().hopCostNs > 0);
+    EXPECT(engine.createStream(nullptr) == -1);
+    EXPECT(engine.getStats().rejectedStreams == 1);
+    engine.release();
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  StreamEngine测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testHopOrder();
+    testDestroyAndReuse();
+    testDestroyDuringPush();
+    testAdmissionControl();
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
@@ -0,0 +1,295 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdint>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ThreadScheduling.h"
+#include "TestSupport.h"
+
+/**
+ * ThreadScheduler测试工具
+ *
+ * 1. 用伪造的sysfs目录树验证性能核心识别（cpufreq、cpu_capacity、同构、读取失败）
+ * 2. 在独立线程上应用nice值和CPU亲和性，验证设置生效、逐hop核心计数正确
+ * 3. 验证队列积压提升和恢复的状态切换（系统调用可能因权限失败，只检查状态和计数）
+ */
+
+using namespace deepfilter;
+
+/**
+ * 伪造的sysfs CPU目录
+ */
+class FakeSysfs {
+public:
+    FakeSysfs() {
+        char directory[] = "/tmp/thread_scheduling_test_XXXXXX";
+        if (mkdtemp(directory) != nullptr) {
+            root_ = directory;
+        }
+    }
+
+    ~FakeSysfs() {
+        for (auto it = files_.rbegin(); it != files_.rend(); ++it) {
+            unlink(it->c_str());
+        }
+        for (auto it = directories_.rbegin(); it != directories_.rend(); ++it) {
+            rmdir(it->c_str());
+        }
+        rmdir(root_.c_str());
+    }
+
+    const char* root() const { return root_.c_str(); }
+
+    /**
+     * 写入cpuN下的一个文件（relativePath如"cpufreq/cpuinfo_max_freq"）
+     */
+    void write(int cpu, const std::string& relativePath, uint32_t value) {
+        std::string directory = root_ + "/cpu" + std::to_string(cpu);
+        makeDirectory(directory);
+        const size_t slash = relativePath.find('/');
+        if (slash != std::string::npos) {
+            makeDirectory(directory + "/" + relativePath.substr(0, slash));
+        }
+        const std::string path = directory + "/" + relativePath;
+        std::ofstream(path) << value << "\n";
+        files_.push_back(path);
+    }
+
+private:
+    void makeDirectory(const std::string& path) {
+        if (mkdir(path.c_str(), 0755) == 0) {
+            directories_.push_back(path);
+        }
+    }
+
+    std::string root_;
+    std::vector<std::string> files_;
+    std::vector<std::string> directories_;
+};
+
+/**
+ * 性能核心识别
+ */
+static void testDetectTopology() {
+    std::cout << "[测试] CPU拓扑识别" << std::endl;
+
+    // 4小核 + 3大核 + 1超大核
+    {
+        FakeSysfs sysfs;
+        const uint32_t freqs[] = {1800000, 1800000, 1800000, 1800000, 2400000, 2400000, 2400000, 3000000};
+        for (int cpu = 0; cpu < 8; cpu++) {
+            sysfs.write(cpu, "cpufreq/cpuinfo_max_freq", freqs[cpu]);
+        }
+        const CpuTopology topology = ThreadScheduler::detectTopology(sysfs.root());
+        EXPECT(topology.cpuCount == 8);
+        EXPECT(topology.cpuMask == 0xFFu);
+        EXPECT(topology.performanceMask == 0xF0u);
+        EXPECT(topology.maxFreqKhz[7] == 3000000u);
+    }
+
+    // 没有cpufreq时使用cpu_capacity，核心编号不连续
+    {
+        FakeSysfs sysfs;
+        sysfs.write(0, "cpu_capacity", 400);
+        sysfs.write(1, "cpu_capacity", 400);
+        sysfs.write(4, "cpu_capacity", 1024);
+        sysfs.write(5, "cpu_capacity", 1024);
+        const CpuTopology topology = ThreadScheduler::detectTopology(sysfs.root());
+        EXPECT(topology.cpuCount == 4);
+        EXPECT(topology.cpuMask == 0x33u);
+        EXPECT(topology.performanceMask == 0x30u);
+    }
+
+    // 同构：全部核心都是性能核心
+    {
+        FakeSysfs sysfs;
+        for (int cpu = 0; cpu < 4; cpu++) {
+            sysfs.write(cpu, "cpufreq/cpuinfo_max_freq", 2000000);
+        }
+        const CpuTopology topology = ThreadScheduler::detectTopology(sysfs.root());
+        EXPECT(topology.performanceMask == 0x0Fu);
+    }
+
+    // 目录不存在
+    const CpuTopology missing = ThreadScheduler::detectTopology("/nonexistent/cpu");
+    EXPECT(missing.cpuCount == 0);
+    EXPECT(missing.performanceMask == 0);
+}
+
+/**
+ * 参数校验
+ */
+static void testConfigValidation() {
+    std::cout << "[测试] 参数校验" << std::endl;
+
+    CpuTopology topology;
+    topology.cpuCount = 2;
+    topology.cpuMask = 0x3;
+    topology.performanceMask = 0x2;
+
+    ThreadScheduler scheduler;
+    ThreadSchedulingConfig config;
+    EXPECT(scheduler.init(config, topology));
+
+    config.niceValue = 20;
+    EXPECT(!scheduler.init(config, topology));
+    config.niceValue = -16;
+    config.fifoPriority = 0;
+    EXPECT(!scheduler.init(config, topology));
+    config.fifoPriority = 2;
+    config.affinity = CpuAffinity::CPUSET;
+    config.cpuMask = 0;
+    EXPECT(!scheduler.init(config, topology));
+    config.cpuMask = 0x4;   // 不含已知核心
+    EXPECT(!scheduler.init(config, topology));
+    config.cpuMask = 0x1;
+    EXPECT(scheduler.init(config, topology));
+    config.boostQueueDepth = 0;
+    EXPECT(!scheduler.init(config, topology));
+}
+
+/**
+ * 在独立线程上应用nice值和亲和性
+ */
+static void testApplyOnThread() {
+    std::cout << "[测试] 应用调度设置" << std::endl;
+
+    // 绑定到当前允许的第一个核心
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    EXPECT(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+    int firstCpu = -1;
+    for (int cpu = 0; cpu < CpuTopology::MAX_CPUS && firstCpu < 0; cpu++) {
+        if (CPU_ISSET(cpu, &allowed)) {
+            firstCpu = cpu;
+        }
+    }
+    EXPECT(firstCpu >= 0);
+    if (firstCpu < 0) {
+        return;
+    }
+
+    CpuTopology topology = ThreadScheduler::detectTopology();
+    ThreadSchedulingConfig config;
+    config.priority = ThreadPriority::NICE;
+    config.niceValue = 5;   // 普通用户也可以调低优先级
+    config.affinity = CpuAffinity::CPUSET;
+    config.cpuMask = 1ull << firstCpu;
+
+    ThreadScheduler scheduler;
+    EXPECT(scheduler.init(config, topology));
+
+    const int hops = 50;
+    int nice = 0;
+    bool pinned = true;
+    std::thread worker([&]() {
+        scheduler.applyBase();
+        nice = getpriority(PRIO_PROCESS, 0);
+        for (int i = 0; i < hops; i++) {
+            scheduler.onHop(0);
+            if (ThreadScheduler::currentCpu() != firstCpu) {
+                pinned = false;
+            }
+        }
+    });
+    worker.join();
+
+    const ThreadSchedulingStats stats = scheduler.getStats();
+    EXPECT(nice == 5);
+    EXPECT(pinned);
+    EXPECT(stats.failures == 0);
+    EXPECT(stats.coreHops[firstCpu] == static_cast<uint64_t>(hops));
+    EXPECT(stats.unknownCoreHops == 0);
+    EXPECT(stats.boosts == 0);
+
+    uint64_t total = stats.unknownCoreHops;
+    for (int cpu = 0; cpu < CpuTopology::MAX_CPUS; cpu++) {
+        total += stats.coreHops[cpu];
+    }
+    EXPECT(total == static_cast<uint64_t>(hops));
+
+    scheduler.reset();
+    EXPECT(scheduler.getStats().coreHops[firstCpu] == 0);
+}
+
+/**
+ * 队列积压提升与恢复
+ */
+static void testBoostOnBacklog() {
+    std::cout << "[测试] 积压提升" << std::endl;
+
+    ThreadSchedulingConfig config;
+    config.boostOnBacklog = true;
+    config.boostQueueDepth = 4;
+    config.relaxHops = 10;
+
+    ThreadScheduler scheduler;
+    EXPECT(scheduler.init(config, ThreadScheduler::detectTopology()));
+
+    ThreadSchedulingStats before;
+    ThreadSchedulingStats boosted;
+    ThreadSchedulingStats relaxed;
+    int policyAfterRelax = -1;
+    std::thread worker([&]() {
+        scheduler.applyBase();
+        for (int i = 0; i < 5; i++) {
+            scheduler.onHop(3);
+        }
+        before = scheduler.getStats();
+
+        scheduler.onHop(6);
+        boosted = scheduler.getStats();
+
+        // 积压未完全消除时不恢复
+        for (int i = 0; i < 9; i++) {
+            scheduler.onHop(1);
+        }
+        scheduler.onHop(2);
+        for (int i = 0; i < 9; i++) {
+            scheduler.onHop(0);
+        }
+        EXPECT(scheduler.getStats().boosted);
+        scheduler.onHop(0);
+        relaxed = scheduler.getStats();
+
+        sched_param param;
+        pthread_getschedparam(pthread_self(), &policyAfterRelax, &param);
+    });
+    worker.join();
+
+    EXPECT(!before.boosted);
+    EXPECT(before.boosts == 0);
+    EXPECT(boosted.boosted);
+    EXPECT(boosted.boosts == 1);
+    EXPECT(!relaxed.boosted);
+    EXPECT(relaxed.boosts == 1);
+    EXPECT(policyAfterRelax == SCHED_OTHER);
+    std::cout << "  提升时系统调用失败 " << relaxed.failures << " 次（无实时调度权限时正常）" << std::endl;
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  ThreadScheduler测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testDetectTopology();
+    testConfigValidation();
+    testApplyOnThread();
+    testBoostOnBacklog();
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unistd.h>
+#include "WavFile.h"
+#include "TestSupport.h"
+
+/**
+ * WavReader/WavWriter测试工具
+ *
+ * 验证PCM16和PCM32F的写入/读取往返、分块读取、下混和头部回填
+ */
+
+using namespace deepfilter;
+
+static std::string tempPath(const char* name) {
+    return std::string("/tmp/wav_file_test_") + std::to_string(getpid()) + "_" + name + ".wav";
+}
+
+/**
+ * 写入后按小块读回，校验格式、长度和采样值
+ */
+void testRoundTrip(WavSampleFormat format, float tolerance) {
+    std::cout << "测试往返读写（" << (format == WavSampleFormat::PCM16 ? "PCM16" : "PCM32F") << "）..." << std::endl;
+
+    const std::string path = tempPath(format == WavSampleFormat::PCM16 ? "pcm16" : "f32");
+    const size_t frames = 48000 + 123;
+    std::vector<float> samples(frames * 2);
+    for (size_t i = 0; i < frames; i++) {
+        samples[i * 2] = 0.5f * std::sin(static_cast<float>(i) * 0.01f);
+        samples[i * 2 + 1] = -samples[i * 2];
+    }
+
+    WavWriter writer;
+    EXPECT(writer.open(path.c_str(), 48000, 2, format));
+    // 分两次写入，验证追加写入和头部回填
+    EXPECT(writer.write(samples.data(), 1000));
+    EXPECT(writer.write(samples.data() + 2000, frames - 1000));
+    EXPECT(writer.framesWritten() == frames);
+    EXPECT(writer.close());
+
+    WavReader reader;
+    EXPECT(reader.open(path.c_str()));
+    EXPECT(reader.sampleRate() == 48000);
+    EXPECT(reader.channels() == 2);
+    EXPECT(reader.format() == format);
+    EXPECT(reader.frameCount() == frames);
+
+    std::vector<float> chunk(512 * 2);
+    size_t position = 0;
+    float maxError = 0.0f;
+    while (true) {
+        const size_t read = reader.read(chunk.data(), 512);
+        if (read == 0) {
+            break;
+        }
+        for (size_t i = 0; i < read * 2; i++) {
+            maxError = std::fmax(maxError, std::fabs(chunk[i] - samples[position * 2 + i]));
+        }
+        position += read;
+    }
+    EXPECT(position == frames);
+    EXPECT(maxError <= tolerance);
+    EXPECT(reader.framesRemaining() == 0);
+
+    // 立体声两路互为相反数，下混后应为0
+    reader.rewind();
+    std::vector<float> mono(frames);
+    EXPECT(reader.readMono(mono.data(), frames) == frames);
+    float maxMono = 0.0f;
+    for (float sample : mono) {
+        maxMono = std::fmax(maxMono, std::fabs(sample));
+    }
+    EXPECT(maxMono <= tolerance);
+
+    reader.close();
+    unlink(path.c_str());
+}
+
+/**
+ * PCM16写入时超出[-1, 1]的采样应被限幅而不是回绕
+ */
+void testClipping() {
+    std::cout << "测试PCM16限幅..." << std::endl;
+
+    const std::string path = tempPath("clip");
+    const float samples[4] = {2.0f, -2.0f, 1.0f, -1.0f};
+
+    WavWriter writer;
+    EXPECT(writer.open(path.c_str(), 16000, 1, WavSampleFormat::PCM16));
+    EXPECT(writer.write(samples, 4));
+    EXPECT(writer.close());
+
+    WavReader reader;
+    EXPECT(reader.open(path.c_str()));
+    float out[4] = {0};
+    EXPECT(reader.read(out, 4) == 4);
+    EXPECT(out[0] > 0.99f && out[1] < -0.99f);
+    EXPECT(out[2] > 0.99f && out[3] < -0.99f);
+
+    reader.close();
+    unlink(path.c_str());
+}
+
+/**
+ * 非WAV文件应打开失败并给出错误信息
+ */
+void testInvalidFile() {
+    std::cout << "测试无效文件..." << std::endl;
+
+    const std::string path = tempPath("invalid");
+    FILE* file = fopen(path.c_str(), "wb");
+    EXPECT(file != nullptr);
+    if (file != nullptr) {
+        fputs("not a wav file at all", file);
+        fclose(file);
+    }
+
+    WavReader reader;
+    EXPECT(!reader.open(path.c_str()));
+    EXPECT(strlen(reader.getLastError()) > 0);
+    EXPECT(!reader.open("/nonexistent/input.wav"));
+
+    unlink(path.c_str());
+}
+
+/**
+ * 主函数
+ */
+int main() {
+    std::cout << "========================================" << std::endl;
+    std::cout << "  WavFile测试" << std::endl;
+    std::cout << "========================================" << std::endl;
+
+    testRoundTrip(WavSampleFormat::PCM16, 1.0f / 16384.0f);
+    testRoundTrip(WavSampleFormat::FLOAT32, 0.0f);
+    testClipping();
+    testInvalidFile();
+
+    if (failures > 0) {
+        std::cout << "测试失败: " << failures << " 项" << std::endl;
+        return 1;
+    }
+
+    std::cout << "测试通过" << std::endl;
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include "MappedFile.h"
+#include "OfflineDenoiser.h"
+
+/**
+ * 离线WAV降噪命令行工具
+ *
+ * 在Linux主机上对录音文件批量降噪，输出实时率（RTF）
+ *
+ * 用法: df_offline [选项] <模型tar.gz路径> <输入.wav> <输出.wav> [<输入.wav> <输出.wav> ...]
+ *   --beta <值>       后滤波器beta参数（默认0.0）
+ *   --atten <dB>      衰减限制（默认100.0）
+ *   --chunk <hop数>   每批处理的hop数（默认100）
+ *   --float           输出PCM32F（默认PCM16）
+ *   --keep-delay      不补偿模型算法延迟，输出与流式处理一样滞后（默认对齐输入）
+ */
+
+using namespace deepfilter;
+
+static void printUsage(const char* program) {
+    std::cout << "用法: " << program
+              << " [--beta 值] [--atten dB] [--chunk hop数] [--float] [--keep-delay]"
+              << " <模型tar.gz路径> <输入.wav> <输出.wav> [<输入.wav> <输出.wav> ...]" << std::endl;
+}
+
+/**
+ * 主函数
+ */
+int main(int argc, char** argv) {
+    float beta = 0.0f;
+    float attenLimDb = 100.0f;
+    OfflineOptions options;
+
+    int argIndex = 1;
+    while (argIndex < argc && strncmp(argv[argIndex], "--", 2) == 0) {
+        const std::string option = argv[argIndex];
+        if (option == "--float") {
+            options.outputFormat = WavSampleFormat::FLOAT32;
+            argIndex++;
+            continue;
+        }
+        if (option == "--keep-delay") {
+            options.compensateDelay = false;
+            argIndex++;
+            continue;
+        }
+        if (argIndex + 1 >= argc) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        const char* value = argv[argIndex + 1];
+        if (option == "--beta") {
+            beta = static_cast<float>(atof(value));
+        } else if (option == "--atten") {
+            attenLimDb = static_cast<float>(atof(value));
+        } else if (option == "--chunk") {
+            options.chunkHops = static_cast<size_t>(atoi(value));
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+        argIndex += 2;
+    }
+
+    const int remaining = argc - argIndex;
+    if (remaining < 3 || (remaining - 1) % 2 != 0) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // 模型通过内存映射传给df_create，避免额外复制
+    MappedFile model;
+    if (!model.open(argv[argIndex], false)) {
+        std::cout << model.getLastError() << std::endl;
+        return 1;
+    }
+
+    OfflineDenoiser denoiser;
+    if (!denoiser.initialize(model.data(), model.size(), beta, attenLimDb)) {
+        std::cout << denoiser.getLastError() << std::endl;
+        return 1;
+    }
+
+    int failed = 0;
+    double totalAudio = 0.0;
+    double totalProcessing = 0.0;
+    for (int i = argIndex + 1; i + 1 < argc; i += 2) {
+        OfflineResult result;
+        if (!denoiser.processFile(argv[i], argv[i + 1], options, &result)) {
+            std::cout << "失败: " << argv[i] << ": " << denoiser.getLastError() << std::endl;
+            failed++;
+            continue;
+        }
+        totalAudio += result.audioSeconds;
+        totalProcessing += result.processingSeconds;
+        std::cout << argv[i] << " -> " << argv[i + 1] << ": "
+                  << result.audioSeconds << " s音频, "
+                  << result.processingSeconds << " s处理, "
+                  << "RTF=" << result.realTimeFactor << std::endl;
+    }
+
+    if (totalAudio > 0.0) {
+        std::cout << "合计: " << totalAudio << " s音频, " << totalProcessing << " s处理, "
+                  << "RTF=" << totalProcessing / totalAudio << std::endl;
+    }
+
+    return failed > 0 ? 1 : 0;
+}
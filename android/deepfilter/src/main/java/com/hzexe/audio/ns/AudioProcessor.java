@@ -1,6 +1,11 @@
 package com.hzexe.audio.ns;
 
 import android.util.Log;
+import java.io.File;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
 
 /**
  * 音频处理器类
@@ -10,15 +15,97 @@ import android.util.Log;
  * 2. 实现录制后立即降噪的完整流程
  * 3. 支持配置降噪参数（tar_bytes、post_filter_beta、atten_lim_db）
  * 4. 提供实时音频降噪处理接口
- * 5. 音频格式固定：48kHz、单声道、PCM_FLOAT
+ * 5. 音频格式：PCM_FLOAT，默认单声道；支持多声道（多麦克风）交织采集，见 {@link #setChannelCount(int)}
+ * 6. 可选计算门控：静音或干净语音时跳过模型推理以节省CPU，见 {@link #setComputeGate(boolean, float, float)}
+ * 7. 处理线程可配置优先级和CPU亲和性，队列积压时自动提升，见 {@link #setThreadScheduling(int, int, int, long, boolean)}
+ * 8. 可选同步模式：在采集回调中直接降噪输出以获得最低延迟，超时自动回退，见 {@link #setSynchronousMode(boolean, float, int)}
+ * 9. 双工（监听）模式：降噪结果直接送入AAudio输出流播放，自动补偿采集与播放的时钟漂移，见 {@link #startDuplex(AudioDataCallback)}
+ * 10. 报告模型算法延迟和管线延迟分解，可在低延迟/高质量档位间切换，见 {@link #setLatencyProfile(int)}、{@link #getPipelineDelay()}
+ * 11. 降噪参数可在处理中从任意线程无锁调整，在hop边界按斜坡平滑过渡，见 {@link #setParameterRamp(int)}
+ * 12. 可选FP16/INT8量化模型变体，低端设备或高密度部署时以少量精度换取推理速度，见 {@link #setModelPrecision(int, byte[])}
+ * 13. 推理后端在initialize时选择，见 {@link #setInferenceBackend(int)}
+ * 14. 推送模式：应用已有AudioRecord/WebRTC采集时，把PCM16/float数据推送给同一套异步降噪引擎，
+ *     队列满时按返回值反压，见 {@link #setPushMode(boolean)}、{@link #pushPcm16(ByteBuffer, int, int, int)}
+ * 15. 结果可附带采集帧位置和纳秒采集时间戳（已扣除模型延迟），丢帧时标记不连续，用于音画同步和回声消除对齐，
+ *     见 {@link #startWithFrameInfo(FrameInfoCallback)}
  * 
  * @author hzexe
- * @version 2.0
+ * @version 2.11
  */
 public class AudioProcessor {
     
     private static final String TAG = "AudioProcessor";
     
+    /**
+     * 队列溢出策略：丢弃最旧的帧（默认）
+     */
+    public static final int OVERFLOW_DROP_OLDEST = 0;
+    
+    /**
+     * 队列溢出策略：丢弃最新到达的帧
+     */
+    public static final int OVERFLOW_DROP_NEWEST = 1;
+    
+    /**
+     * 推理后端：tract（默认，目前唯一的后端）
+     */
+    public static final int BACKEND_TRACT = 0;
+    
+    /**
+     * 模型精度：FP32（默认，原始模型）
+     */
+    public static final int PRECISION_FP32 = 0;
+    
+    /**
+     * 模型精度：FP16（子网络为*_fp16.onnx）
+     */
+    public static final int PRECISION_FP16 = 1;
+    
+    /**
+     * 模型精度：INT8训练后量化（子网络为*_int8.onnx）
+     */
+    public static final int PRECISION_INT8 = 2;
+    
+    /**
+     * 延迟档位：高质量（默认，异步处理，播放缓冲为一个hop加两个burst）
+     */
+    public static final int LATENCY_PROFILE_HIGH_QUALITY = 0;
+    
+    /**
+     * 延迟档位：低延迟（同步处理，超时回退异步；播放缓冲为一个hop加一个burst）
+     */
+    public static final int LATENCY_PROFILE_LOW_LATENCY = 1;
+    
+    /**
+     * 处理线程优先级：不修改
+     */
+    public static final int PRIORITY_DEFAULT = 0;
+    
+    /**
+     * 处理线程优先级：SCHED_OTHER + nice值
+     */
+    public static final int PRIORITY_NICE = 1;
+    
+    /**
+     * 处理线程优先级：SCHED_FIFO（没有权限时退回nice值）
+     */
+    public static final int PRIORITY_FIFO = 2;
+    
+    /**
+     * 处理线程亲和性：不限制
+     */
+    public static final int AFFINITY_NONE = 0;
+    
+    /**
+     * 处理线程亲和性：性能核心（按各核心最大频率自动识别）
+     */
+    public static final int AFFINITY_PERFORMANCE_CORES = 1;
+    
+    /**
+     * 处理线程亲和性：cpuMask指定的核心
+     */
+    public static final int AFFINITY_CPUSET = 2;
+    
     // 原生句柄
     private long nativeHandle;
     
@@ -28,6 +115,15 @@ public class AudioProcessor {
     // 音频数据回调接口
     private AudioDataCallback callback;
     
+    // 带位置和时间信息的回调接口
+    private FrameInfoCallback frameInfoCallback;
+    
+    // 直接输出模式：与原生层共享的输出环（direct ByteBuffer，本机字节序）
+    private ByteBuffer directBuffer;
+    
+    // 直接输出模式的槽数量
+    private int directSlotCount;
+    
     // 静态初始化块：加载JNI库
     static {
         try {
@@ -45,13 +141,53 @@ public class AudioProcessor {
         /**
          * 降噪音频数据回调
          * 
-         * @param audioData 降噪后的音频数据（f32格式，单声道）
-         * @param numFrames 帧数
+         * @param audioData 降噪后的音频数据（f32格式，多声道时为交织布局，长度为 numFrames × 声道数）
+         * @param numFrames 每声道帧数
          * @param lsnr LSNR值（信噪比）
          */
         void onAudioData(float[] audioData, float numFrames, float lsnr);
     }
     
+    /**
+     * 带采集位置和时间信息的降噪音频数据回调接口
+     */
+    public interface FrameInfoCallback {
+        /**
+         * 降噪音频数据回调
+         * 
+         * 位置和时间指向与本块第一个输出采样对应的输入采样（已扣除模型算法延迟和采样率转换延迟），
+         * 启动后的前几块对应启动前的预卷，framePosition可能为负
+         * 
+         * @param audioData 降噪后的音频数据（f32格式，多声道时为交织布局，长度为 numFrames × 声道数）
+         * @param numFrames 每声道帧数
+         * @param lsnr LSNR值（信噪比）
+         * @param framePosition 对应的采集帧位置（采集采样率，本次start之后第一帧为0）
+         * @param timestampNs 该帧的采集时间（CLOCK_MONOTONIC纳秒，与 {@link System#nanoTime()} 同一时基）
+         * @param discontinuity 与上一块之间是否有帧未输出（队列溢出丢弃或处理失败）
+         * @param droppedFrames 与上一块之间未输出的帧数（采集采样率）
+         * @param hardwareTimestamp timestampNs是否来自AAudio硬件时间戳；false表示按回调到达时刻估计
+         */
+        void onAudioData(float[] audioData, int numFrames, float lsnr, long framePosition, long timestampNs,
+                         boolean discontinuity, long droppedFrames, boolean hardwareTimestamp);
+    }
+    
+    /**
+     * 直接输出模式回调接口
+     * 
+     * 降噪数据已由原生层写入 {@link #getDirectBuffer()} 的第 slotIndex 个槽，
+     * 回调不创建任何Java对象。数据在被后续 slotCount - 1 帧覆盖之前有效。
+     */
+    public interface DirectAudioCallback {
+        /**
+         * 降噪音频帧写入通知（在原生处理线程上调用；同步模式下在音频采集回调线程上调用）
+         * 
+         * @param slotIndex 槽索引，数据起始位置为 slotIndex * getFrameSize() * getChannelCount() 个float
+         * @param numFrames 每声道帧数
+         * @param lsnr LSNR值（信噪比）
+         */
+        void onAudioFrame(int slotIndex, int numFrames, float lsnr);
+    }
+    
     /**
      * 构造函数
      */
@@ -96,223 +232,1070 @@ public class AudioProcessor {
     }
     
     /**
-     * 开始录制和降噪处理
+     * 设置模型解压缓存目录（需在initialize之前调用）
      * 
-     * @param callback 降噪音频数据回调函数
-     * @return true-开始成功，false-开始失败
+     * 首次initialize把模型重新打包为不压缩格式写入该目录，之后的启动命中缓存时
+     * 通过内存映射加载，省去解压；缓存无效或版本不匹配时自动回退并重建。
+     * 只缓存解压结果：ONNX解析和图优化每次initialize仍会执行，通常占启动耗时的大部分
+     * 
+     * @param directory 缓存目录（如context.getCacheDir()），null表示禁用缓存
      */
-    public boolean start(AudioDataCallback callback) {
-        if (!initialized) {
-            Log.e(TAG, "AudioProcessor未初始化，无法开始处理");
+    public void setModelCacheDir(File directory) {
+        if (nativeHandle == 0) {
+            Log.e(TAG, "原生句柄为空，无法设置模型缓存目录");
+            return;
+        }
+        nativeSetModelCacheDir(nativeHandle, directory != null ? directory.getAbsolutePath() : null);
+    }
+    
+    /**
+     * 当前原生库是否包含指定的推理后端
+     * 
+     * @param backend 推理后端编号，如 BACKEND_TRACT
+     * @return true-包含
+     */
+    public static boolean isBackendAvailable(int backend) {
+        return nativeIsBackendAvailable(backend);
+    }
+    
+    /**
+     * 设置推理后端（需在initialize之前调用）
+     * 
+     * 降噪接口与后端无关；各后端在目标设备上的逐hop耗时见主机基准bench_backends
+     * 
+     * @param backend 推理后端编号，目前只有 BACKEND_TRACT
+     * @return true-设置成功，false-原生库不包含该后端或正在处理中
+     */
+    public boolean setInferenceBackend(int backend) {
+        if (nativeHandle == 0) {
+            Log.e(TAG, "原生句柄为空，无法设置推理后端");
             return false;
         }
-        
-        if (callback == null) {
-            Log.e(TAG, "回调函数为空");
+        boolean success = nativeSetInferenceBackend(nativeHandle, backend);
+        if (!success) {
+            Log.e(TAG, "设置推理后端失败: " + nativeGetLastError(nativeHandle));
+        }
+        return success;
+    }
+    
+    /**
+     * 设置模型精度（需在initialize之前调用，对共享模型初始化无效）
+     * 
+     * 非FP32时从模型tar.gz或变体包中选择量化子网络（enc/erb_dec/df_dec的_fp16或_int8变体），
+     * 变体包为同格式的tar.gz，可只包含量化后的.onnx文件；组装后的模型按精度单独缓存。
+     * 缺少所选精度的子网络时initialize失败。各精度在目标设备上的速度和精度差异见bench_precision
+     * 
+     * @param precision PRECISION_FP32、PRECISION_FP16 或 PRECISION_INT8
+     * @param variantTarBytes 变体包（null表示变体在模型tar.gz中）
+     * @return true-设置成功，false-参数无效或正在处理中
+     */
+    public boolean setModelPrecision(int precision, byte[] variantTarBytes) {
+        if (nativeHandle == 0) {
+            Log.e(TAG, "原生句柄为空，无法设置模型精度");
             return false;
         }
-        
-        this.callback = callback;
-        
-        boolean success = nativeStart(nativeHandle, this);
-        
-        if (success) {
-            Log.d(TAG, "AudioProcessor开始录制和降噪处理");
-        } else {
-            String error = nativeGetLastError(nativeHandle);
-            Log.e(TAG, "AudioProcessor开始处理失败: " + error);
+        boolean success = nativeSetModelPrecision(nativeHandle, precision, variantTarBytes);
+        if (!success) {
+            Log.e(TAG, "设置模型精度失败: " + precision);
         }
-        
         return success;
     }
     
     /**
-     * 停止录制和降噪处理
+     * 设置采集和输出采样率（需在initialize之前调用）
      * 
-     * @return true-停止成功，false-停止失败
+     * 默认按设备原生采样率采集（避免系统重采样，更容易进入低延迟路径），在原生层转换为模型的48kHz；
+     * 输出采样率与48kHz不同时，回调数据在原生层转换后交付，每次回调的帧数随之变化。
+     * 转换引入的固定延迟见Stats.resamplerLatencyUs
+     * 
+     * @param captureSampleRate 采集采样率（Hz），0表示设备原生采样率
+     * @param outputSampleRate 输出采样率（Hz），0表示48000
+     * @return true-设置成功，false-参数无效或正在处理中
      */
-    public boolean stop() {
-        if (!initialized) {
-            Log.w(TAG, "AudioProcessor未初始化");
-            return true;
+    public boolean setSampleRates(int captureSampleRate, int outputSampleRate) {
+        if (nativeHandle == 0) {
+            Log.e(TAG, "原生句柄为空，无法设置采样率");
+            return false;
         }
-        
-        boolean success = nativeStop(nativeHandle);
-        
-        if (success) {
-            Log.d(TAG, "AudioProcessor停止录制和降噪处理");
-        } else {
-            String error = nativeGetLastError(nativeHandle);
-            Log.e(TAG, "AudioProcessor停止处理失败: " + error);
+        boolean success = nativeSetSampleRates(nativeHandle, captureSampleRate, outputSampleRate);
+        if (!success) {
+            Log.e(TAG, "设置采样率失败: " + nativeGetLastError(nativeHandle));
         }
-        
         return success;
     }
     
     /**
-     * 检查是否正在处理
+     * 设置推送模式（需在initialize之前调用）
      * 
-     * @return true-正在处理，false-未处理
+     * 启用后不打开AAudio采集流，音频由 {@link #pushPcm16(ByteBuffer, int, int, int)} /
+     * {@link #pushFloat(ByteBuffer, int, int, int)} 送入，之后的重采样、分块、队列、处理线程和回调与采集模式相同。
+     * 推送数据的采样率由 {@link #setSampleRates(int, int)} 的采集采样率指定（0表示48000），
+     * 声道数由 {@link #setChannelCount(int)} 指定
+     * 
+     * @param enabled 是否启用，关闭后恢复AAudio采集
+     * @return true-设置成功，false-正在处理中
      */
-    public boolean isProcessing() {
+    public boolean setPushMode(boolean enabled) {
         if (nativeHandle == 0) {
+            Log.e(TAG, "原生句柄为空，无法设置推送模式");
             return false;
         }
-        return nativeIsProcessing(nativeHandle);
+        boolean success = nativeSetPushMode(nativeHandle, enabled);
+        if (!success) {
+            Log.e(TAG, "设置推送模式失败: " + nativeGetLastError(nativeHandle));
+        }
+        return success;
     }
     
     /**
-     * 释放资源
+     * 推送PCM16音频（推送模式，start之后调用；同一时刻只能有一个线程推送）
+     * 
+     * 直接读取DirectByteBuffer，转换为float在原生层完成，不复制到Java数组。
+     * 队列满时只接受放得下的前一部分：timeoutMs为0时立即返回，否则等待处理线程腾出空间直到全部接受或超时。
+     * 返回值小于length时，未接受的数据由调用方稍后重新推送（例如下一次AudioRecord.read之前），不会被丢弃
+     * 
+     * @param buffer 音频数据（DirectByteBuffer，PCM16，本机字节序，多声道时为交织布局）
+     * @param offset 数据在缓冲区中的偏移量（字节，2字节对齐）
+     * @param length 数据长度（字节，每帧 2 × 声道数 字节的整数倍）
+     * @param timeoutMs 队列满时最长等待时间（毫秒），0表示不等待
+     * @return 接受的字节数，-1表示未处于推送模式、未启动或参数无效
      */
-    public void release() {
-        if (nativeHandle != 0) {
-            stop();
-            nativeRelease(nativeHandle);
-            initialized = false;
-            callback = null;
-            Log.d(TAG, "AudioProcessor资源已释放");
+    public int pushPcm16(ByteBuffer buffer, int offset, int length, int timeoutMs) {
+        if (nativeHandle == 0 || buffer == null) {
+            return -1;
         }
+        return nativePushPcm16(nativeHandle, buffer, offset, length, timeoutMs);
     }
     
     /**
-     * 检查是否已初始化
+     * 推送float音频（见 {@link #pushPcm16(ByteBuffer, int, int, int)}）
      * 
-     * @return true-已初始化，false-未初始化
+     * @param buffer 音频数据（DirectByteBuffer，PCM_FLOAT，本机字节序，多声道时为交织布局）
+     * @param offset 数据在缓冲区中的偏移量（字节，4字节对齐）
+     * @param length 数据长度（字节，每帧 4 × 声道数 字节的整数倍）
+     * @param timeoutMs 队列满时最长等待时间（毫秒），0表示不等待
+     * @return 接受的字节数，-1表示未处于推送模式、未启动或参数无效
      */
-    public boolean isInitialized() {
-        if (nativeHandle == 0) {
-            return false;
+    public int pushFloat(ByteBuffer buffer, int offset, int length, int timeoutMs) {
+        if (nativeHandle == 0 || buffer == null) {
+            return -1;
         }
-        return nativeIsInitialized(nativeHandle);
+        return nativePushFloat(nativeHandle, buffer, offset, length, timeoutMs);
     }
     
     /**
-     * 获取最后的错误信息
+     * 当前不等待即可推送的帧数（每声道，按队列空闲空间保守估计；在推送线程上调用）
      * 
-     * @return 错误信息字符串
+     * @return 帧数，未处于推送模式或未启动时返回0
      */
-    public String getLastError() {
+    public int getPushableFrames() {
         if (nativeHandle == 0) {
-            return "原生句柄为空";
+            return 0;
         }
-        return nativeGetLastError(nativeHandle);
+        return nativeGetPushableFrames(nativeHandle);
     }
     
     /**
-     * 设置后滤波器beta参数
+     * 设置采集声道数（需在initialize之前调用）
      * 
-     * @param beta beta参数值
-     * @return true-设置成功，false-设置失败
+     * 大于1时按交织格式同时采集多个麦克风，所有声道在一次推理中降噪，回调数据同样为交织布局。
+     * 多声道时不做采样率转换：采集固定请求48kHz，setSampleRates只能使用0或48000
+     * 
+     * @param channelCount 声道数（1~16），设备不支持时initialize失败
+     * @return true-设置成功，false-参数无效或正在处理中
      */
-    public boolean setPostFilterBeta(float beta) {
-        if (!initialized) {
-            Log.e(TAG, "AudioProcessor未初始化，无法设置参数");
-            return false;
-        }
-        
-        if (beta < 0.0f) {
-            Log.e(TAG, "beta参数值无效: " + beta);
+    public boolean setChannelCount(int channelCount) {
+        if (nativeHandle == 0) {
+            Log.e(TAG, "原生句柄为空，无法设置声道数");
             return false;
         }
-        
-        boolean success = nativeSetPostFilterBeta(nativeHandle, beta);
-        
-        if (success) {
-            Log.d(TAG, "设置后滤波器beta参数: " + beta);
-        } else {
-            Log.e(TAG, "设置后滤波器beta参数失败: " + nativeGetLastError(nativeHandle));
+        boolean success = nativeSetChannelCount(nativeHandle, channelCount);
+        if (!success) {
+            Log.e(TAG, "设置声道数失败: " + nativeGetLastError(nativeHandle));
         }
-        
         return success;
     }
     
     /**
-     * 设置衰减限制
+     * 设置计算门控（处理中不可修改，下次start时生效）
      * 
-     * @param attenLimDb 衰减限制（dB）
-     * @return true-设置成功，false-设置失败
+     * 启用后静音（hop能量低于silenceDbfs）或干净语音（最近的LSNR持续不低于cleanLsnrDb）时跳过模型推理，
+     * 输出改为旁路的输入（静音段衰减20dB），进入和退出旁路时在一个hop内交叉淡化。
+     * 旁路的输入按模型算法延迟对齐，{@link #getPipelineDelay()} 在旁路期间同样准确。
+     * 跳过的帧数见 {@link Stats#bypassedFrames}，可与process延迟一起评估CPU节省
+     * 
+     * @param enabled 是否启用
+     * @param silenceDbfs 静音阈值（dBFS），如-60
+     * @param cleanLsnrDb 干净语音LSNR阈值（dB），如30；不大于0时只按静音门控
+     * @return true-设置成功，false-参数无效或正在处理中
      */
-    public boolean setAttenLimDb(float attenLimDb) {
-        if (!initialized) {
-            Log.e(TAG, "AudioProcessor未初始化，无法设置参数");
-            return false;
-        }
-        
-        if (attenLimDb < 0.0f) {
-            Log.e(TAG, "衰减限制值无效: " + attenLimDb);
+    public boolean setComputeGate(boolean enabled, float silenceDbfs, float cleanLsnrDb) {
+        if (nativeHandle == 0) {
+            Log.e(TAG, "原生句柄为空，无法设置计算门控");
             return false;
         }
-        
-        boolean success = nativeSetAttenLimDb(nativeHandle, attenLimDb);
-        
-        if (success) {
-            Log.d(TAG, "设置衰减限制: " + attenLimDb + " dB");
-        } else {
-            Log.e(TAG, "设置衰减限制失败: " + nativeGetLastError(nativeHandle));
+        boolean success = nativeSetComputeGate(nativeHandle, enabled, silenceDbfs, cleanLsnrDb);
+        if (!success) {
+            Log.e(TAG, "设置计算门控失败: " + nativeGetLastError(nativeHandle));
         }
-        
         return success;
     }
     
     /**
-     * 获取当前采样率
+     * 设置处理线程调度（处理中不可修改，下次start时生效）
      * 
-     * @return 采样率（Hz），固定为48000
+     * big.LITTLE设备上处理线程可能被调度到小核，导致队列溢出丢帧。可提高优先级并绑定到性能核心；
+     * 启用boostOnBacklog时队列积压到4帧自动提升为FIFO并绑定性能核心，积压消除后恢复。
+     * 各核心处理的hop数见 {@link #getSchedulingStats()}
+     * 
+     * @param priority 优先级策略（PRIORITY_DEFAULT/PRIORITY_NICE/PRIORITY_FIFO）
+     * @param niceValue nice值（-20~19），如-16（与Process.THREAD_PRIORITY_AUDIO相同）
+     * @param affinity 亲和性策略（AFFINITY_NONE/AFFINITY_PERFORMANCE_CORES/AFFINITY_CPUSET）
+     * @param cpuMask AFFINITY_CPUSET时的核心掩码，第n位表示CPU n
+     * @param boostOnBacklog 队列积压时是否自动提升
+     * @return true-设置成功，false-参数无效或正在处理中
      */
-    public int getSampleRate() {
+    public boolean setThreadScheduling(int priority, int niceValue, int affinity, long cpuMask, boolean boostOnBacklog) {
         if (nativeHandle == 0) {
-            return 0;
+            Log.e(TAG, "原生句柄为空，无法设置线程调度");
+            return false;
         }
-        return nativeGetSampleRate(nativeHandle);
+        boolean success = nativeSetThreadScheduling(nativeHandle, priority, niceValue, affinity, cpuMask, boostOnBacklog);
+        if (!success) {
+            Log.e(TAG, "设置线程调度失败: " + nativeGetLastError(nativeHandle));
+        }
+        return success;
     }
     
     /**
-     * 获取当前声道数
+     * 设置同步处理模式（处理中不可修改，下次start时生效）
      * 
-     * @return 声道数，固定为1
+     * 启用后每攒满一个hop即在AAudio采集回调中直接降噪并回调，省去队列排队和线程唤醒（至少一个hop的延迟）。
+     * 回调因此在音频回调线程上执行，必须尽快返回、不得分配大量对象或阻塞，建议配合直接输出模式（startDirect）。
+     * 单次采集回调耗时超过回调时长 × deadlineRatio记为超时，每100个hop内超时达到maxMissedDeadlines次时
+     * 自动回退到异步处理，见 {@link Stats#syncFallback}
+     * 
+     * @param enabled 是否启用
+     * @param deadlineRatio 截止时间占采集回调时长的比例（0~1]，如0.8
+     * @param maxMissedDeadlines 触发回退的超时次数，如3
+     * @return true-设置成功，false-参数无效或正在处理中
      */
-    public int getChannelCount() {
+    public boolean setSynchronousMode(boolean enabled, float deadlineRatio, int maxMissedDeadlines) {
         if (nativeHandle == 0) {
-            return 0;
+            Log.e(TAG, "原生句柄为空，无法设置同步模式");
+            return false;
         }
-        return nativeGetChannelCount(nativeHandle);
+        boolean success = nativeSetSynchronousMode(nativeHandle, enabled, deadlineRatio, maxMissedDeadlines);
+        if (!success) {
+            Log.e(TAG, "设置同步模式失败: " + nativeGetLastError(nativeHandle));
+        }
+        return success;
     }
     
     /**
-     * 获取当前帧大小
+     * 设置延迟档位（处理中不可修改，下次start时生效）
      * 
-     * @return 帧大小（采样点数）
+     * {@link #LATENCY_PROFILE_LOW_LATENCY} 启用同步模式并减小双工播放缓冲；
+     * {@link #LATENCY_PROFILE_HIGH_QUALITY} 恢复异步处理。档位只切换同步模式的开关，
+     * 之前通过 {@link #setSynchronousMode(boolean, float, int)} 设置的截止比例和回退阈值保持不变（默认0.8和3次）。
+     * 模型前瞻固化在模型中，不随档位变化：DeepFilterNet3 有 2 个hop（20ms）前瞻，
+     * 要进一步降低延迟需改用零前瞻模型（如 DeepFilterNet3_ll），见 {@link #getPipelineDelay()}
+     * 
+     * @param profile LATENCY_PROFILE_HIGH_QUALITY 或 LATENCY_PROFILE_LOW_LATENCY
+     * @return true-设置成功，false-参数无效或正在处理中
      */
-    public int getFrameSize() {
+    public boolean setLatencyProfile(int profile) {
         if (nativeHandle == 0) {
-            return 0;
+            Log.e(TAG, "原生句柄为空，无法设置延迟档位");
+            return false;
         }
-        return nativeGetFrameSize(nativeHandle);
+        boolean success = nativeSetLatencyProfile(nativeHandle, profile);
+        if (!success) {
+            Log.e(TAG, "设置延迟档位失败: " + nativeGetLastError(nativeHandle));
+        }
+        return success;
     }
     
     /**
-     * 获取队列大小
+     * 从共享模型初始化音频处理器
      * 
-     * @return 当前队列中的帧数
+     * 模型通过loadModel只解压解析一次，多个处理器共用；初始化完成后模型即可释放
+     * 
+     * @param modelHandle loadModel返回的模型句柄
+     * @param postFilterBeta 后滤波器beta参数（控制降噪强度）
+     * @param attenLimDb 衰减限制（dB）
+     * @return true-初始化成功，false-初始化失败
      */
-    public int getQueueSize() {
+    public boolean initialize(long modelHandle, float postFilterBeta, float attenLimDb) {
         if (nativeHandle == 0) {
-            return 0;
+            Log.e(TAG, "原生句柄为空，无法初始化");
+            return false;
         }
-        return nativeGetQueueSize(nativeHandle);
+        
+        if (modelHandle == 0) {
+            Log.e(TAG, "模型句柄为空");
+            return false;
+        }
+        
+        boolean success = nativeInitializeFromModel(nativeHandle, modelHandle, postFilterBeta, attenLimDb);
+        
+        if (success) {
+            initialized = true;
+            Log.d(TAG, String.format("AudioProcessor初始化成功（共享模型）: postFilterBeta=%.2f, attenLimDb=%.2f",
+                    postFilterBeta, attenLimDb));
+        } else {
+            String error = nativeGetLastError(nativeHandle);
+            Log.e(TAG, "AudioProcessor初始化失败: " + error);
+        }
+        
+        return success;
     }
     
-    // ===== JNI原生方法声明 =====
-    
     /**
-     * 创建AudioProcessor实例
+     * 加载共享模型
      * 
-     * @return 原生句柄（0表示失败）
+     * @param tarBytes 模型文件字节数组（tar.gz格式）
+     * @return 模型句柄（0表示失败），不再使用时调用freeModel释放
      */
-    private native long nativeCreate();
+    public static long loadModel(byte[] tarBytes) {
+        if (tarBytes == null || tarBytes.length == 0) {
+            Log.e(TAG, "模型文件字节数组为空");
+            return 0;
+        }
+        return nativeLoadModel(tarBytes);
+    }
     
     /**
-     * 初始化音频处理器
+     * 释放共享模型（已初始化的处理器不受影响）
+     * 
+     * @param modelHandle 模型句柄
+     */
+    public static void freeModel(long modelHandle) {
+        if (modelHandle != 0) {
+            nativeFreeModel(modelHandle);
+        }
+    }
+    
+    /**
+     * 开始录制和降噪处理
+     * 
+     * @param callback 降噪音频数据回调函数
+     * @return true-开始成功，false-开始失败
+     */
+    public boolean start(AudioDataCallback callback) {
+        if (!initialized) {
+            Log.e(TAG, "AudioProcessor未初始化，无法开始处理");
+            return false;
+        }
+        
+        if (callback == null) {
+            Log.e(TAG, "回调函数为空");
+            return false;
+        }
+        
+        this.callback = callback;
+        
+        boolean success = nativeStart(nativeHandle, callback);
+        
+        if (success) {
+            Log.d(TAG, "AudioProcessor开始录制和降噪处理");
+        } else {
+            String error = nativeGetLastError(nativeHandle);
+            Log.e(TAG, "AudioProcessor开始处理失败: " + error);
+        }
+        
+        return success;
+    }
+    
+    /**
+     * 开始录制和降噪处理，每块结果附带采集帧位置和采集时间
+     * 
+     * 时间戳由处理线程定期从AAudioStream_getTimestamp取得，跟随麦克风时钟与系统单调时钟之间的漂移；
+     * 流刚启动、推送模式或同步模式下按回调到达时刻估计（hardwareTimestamp为false）。
+     * 丢帧后的第一块discontinuity为true，droppedFrames给出缺少的帧数，累计次数见 {@link Stats#discontinuities}
+     * 
+     * @param callback 降噪音频数据回调函数
+     * @return true-开始成功，false-开始失败
+     */
+    public boolean startWithFrameInfo(FrameInfoCallback callback) {
+        if (!initialized) {
+            Log.e(TAG, "AudioProcessor未初始化，无法开始处理");
+            return false;
+        }
+        
+        if (callback == null) {
+            Log.e(TAG, "回调函数为空");
+            return false;
+        }
+        
+        this.frameInfoCallback = callback;
+        
+        boolean success = nativeStartWithFrameInfo(nativeHandle, callback);
+        
+        if (success) {
+            Log.d(TAG, "AudioProcessor开始录制和降噪处理（附带帧位置和时间戳）");
+        } else {
+            String error = nativeGetLastError(nativeHandle);
+            Log.e(TAG, "AudioProcessor开始处理失败: " + error);
+        }
+        
+        return success;
+    }
+    
+    /**
+     * 以双工（监听）模式开始录制和降噪处理
+     * 
+     * 降噪结果由原生层经无锁播放缓冲区写入低延迟AAudio输出流（按输出采样率和声道数打开），
+     * 不经过Java层；播放缓冲区按深度微调读取速率，补偿麦克风与扬声器/耳机之间的时钟漂移。
+     * 附加延迟约为一个hop加两个输出burst（低延迟档位为一个），见 {@link #getPlayoutStats()}
+     * 
+     * @param monitor 降噪结果的附加回调（可为null）；启用同步模式时在音频回调线程上调用，不得阻塞
+     * @return true-开始成功，false-开始失败
+     */
+    public boolean startDuplex(AudioDataCallback monitor) {
+        if (!initialized) {
+            Log.e(TAG, "AudioProcessor未初始化，无法开始处理");
+            return false;
+        }
+        
+        this.callback = monitor;
+        
+        boolean success = nativeStartDuplex(nativeHandle, monitor);
+        
+        if (success) {
+            Log.d(TAG, "AudioProcessor开始录制和降噪处理（双工模式）");
+        } else {
+            String error = nativeGetLastError(nativeHandle);
+            Log.e(TAG, "AudioProcessor开始处理失败: " + error);
+        }
+        
+        return success;
+    }
+    
+    /**
+     * 以直接输出模式开始录制和降噪处理
+     * 
+     * 分配 slotCount 个槽的 direct ByteBuffer 与原生层共享，降噪数据由原生层直接写入，
+     * 避免每帧创建float[]带来的GC压力。
+     * 
+     * @param slotCount 槽数量（建议不少于4）
+     * @param callback 写入通知回调；为null时调用方通过 {@link #getDirectWriteCount()} 轮询
+     * @return true-开始成功，false-开始失败
+     */
+    public boolean startDirect(int slotCount, DirectAudioCallback callback) {
+        if (!initialized) {
+            Log.e(TAG, "AudioProcessor未初始化，无法开始处理");
+            return false;
+        }
+        
+        if (slotCount <= 0) {
+            Log.e(TAG, "槽数量无效: " + slotCount);
+            return false;
+        }
+        
+        int slotSamples = getFrameSize() * getChannelCount();
+        if (directBuffer == null || directSlotCount != slotCount || directBuffer.capacity() != slotCount * slotSamples * 4) {
+            directBuffer = ByteBuffer.allocateDirect(slotCount * slotSamples * 4).order(ByteOrder.nativeOrder());
+            directSlotCount = slotCount;
+        }
+        
+        boolean success = nativeStartDirect(nativeHandle, directBuffer, slotCount, callback);
+        
+        if (success) {
+            Log.d(TAG, "AudioProcessor开始录制和降噪处理（直接输出模式，槽数量=" + slotCount + "）");
+        } else {
+            String error = nativeGetLastError(nativeHandle);
+            Log.e(TAG, "AudioProcessor开始处理失败: " + error);
+        }
+        
+        return success;
+    }
+    
+    /**
+     * 获取直接输出模式的共享缓冲区
+     * 
+     * @return direct ByteBuffer（本机字节序），未使用直接输出模式时为null
+     */
+    public ByteBuffer getDirectBuffer() {
+        return directBuffer;
+    }
+    
+    /**
+     * 获取直接输出模式的共享缓冲区的float视图
+     * 
+     * @return FloatBuffer视图，未使用直接输出模式时为null
+     */
+    public FloatBuffer getDirectFloatBuffer() {
+        return directBuffer != null ? directBuffer.asFloatBuffer() : null;
+    }
+    
+    /**
+     * 获取直接输出模式下已写入的槽总数（用于轮询）
+     * 
+     * 最新数据位于槽 (count - 1) % slotCount
+     * 
+     * @return 已写入的槽总数
+     */
+    public long getDirectWriteCount() {
+        if (nativeHandle == 0) {
+            return 0;
+        }
+        return nativeGetDirectWriteCount(nativeHandle);
+    }
+    
+    /**
+     * 停止录制和降噪处理
+     * 
+     * @return true-停止成功，false-停止失败
+     */
+    public boolean stop() {
+        if (!initialized) {
+            Log.w(TAG, "AudioProcessor未初始化");
+            return true;
+        }
+        
+        boolean success = nativeStop(nativeHandle);
+        
+        if (success) {
+            Log.d(TAG, "AudioProcessor停止录制和降噪处理");
+        } else {
+            String error = nativeGetLastError(nativeHandle);
+            Log.e(TAG, "AudioProcessor停止处理失败: " + error);
+        }
+        
+        return success;
+    }
+    
+    /**
+     * 检查是否正在处理
+     * 
+     * @return true-正在处理，false-未处理
+     */
+    public boolean isProcessing() {
+        if (nativeHandle == 0) {
+            return false;
+        }
+        return nativeIsProcessing(nativeHandle);
+    }
+    
+    /**
+     * 释放资源
+     */
+    public void release() {
+        if (nativeHandle != 0) {
+            stop();
+            nativeRelease(nativeHandle);
+            initialized = false;
+            callback = null;
+            frameInfoCallback = null;
+            directBuffer = null;
+            directSlotCount = 0;
+            Log.d(TAG, "AudioProcessor资源已释放");
+        }
+    }
+    
+    /**
+     * 检查是否已初始化
+     * 
+     * @return true-已初始化，false-未初始化
+     */
+    public boolean isInitialized() {
+        if (nativeHandle == 0) {
+            return false;
+        }
+        return nativeIsInitialized(nativeHandle);
+    }
+    
+    /**
+     * 获取最后的错误信息
+     * 
+     * @return 错误信息字符串
+     */
+    public String getLastError() {
+        if (nativeHandle == 0) {
+            return "原生句柄为空";
+        }
+        return nativeGetLastError(nativeHandle);
+    }
+    
+    /**
+     * 设置后滤波器beta参数
+     * 
+     * 任意线程可调用，不加锁（可用于UI滑块或自动控制逐帧调用）：新值在下一个hop开始前由处理线程读取，
+     * 在斜坡时长内逐hop过渡，见 {@link #setParameterRamp(int)}；多次调用以最后一次为准
+     * 
+     * @param beta beta参数值
+     * @return true-设置成功，false-设置失败
+     */
+    public boolean setPostFilterBeta(float beta) {
+        if (!initialized) {
+            Log.e(TAG, "AudioProcessor未初始化，无法设置参数");
+            return false;
+        }
+        
+        if (beta < 0.0f) {
+            Log.e(TAG, "beta参数值无效: " + beta);
+            return false;
+        }
+        
+        boolean success = nativeSetPostFilterBeta(nativeHandle, beta);
+        
+        if (!success) {
+            Log.e(TAG, "设置后滤波器beta参数失败: " + nativeGetLastError(nativeHandle));
+        }
+        
+        return success;
+    }
+    
+    /**
+     * 设置衰减限制
+     * 
+     * 与 {@link #setPostFilterBeta(float)} 相同：任意线程可调用，在hop边界按斜坡平滑过渡
+     * 
+     * @param attenLimDb 衰减限制（dB）
+     * @return true-设置成功，false-设置失败
+     */
+    public boolean setAttenLimDb(float attenLimDb) {
+        if (!initialized) {
+            Log.e(TAG, "AudioProcessor未初始化，无法设置参数");
+            return false;
+        }
+        
+        if (attenLimDb < 0.0f) {
+            Log.e(TAG, "衰减限制值无效: " + attenLimDb);
+            return false;
+        }
+        
+        boolean success = nativeSetAttenLimDb(nativeHandle, attenLimDb);
+        
+        if (!success) {
+            Log.e(TAG, "设置衰减限制失败: " + nativeGetLastError(nativeHandle));
+        }
+        
+        return success;
+    }
+    
+    /**
+     * 设置参数斜坡时长
+     * 
+     * 后滤波器beta和衰减限制变化时，在该时长内逐hop线性过渡到新值，避免参数跳变产生拉链噪声；
+     * 斜坡途中再次修改时从当前值重新开始。任意时刻可调用，下一次参数变化时生效
+     * 
+     * @param milliseconds 斜坡时长（毫秒，按hop向上取整），0表示下一个hop直接生效；默认50ms
+     * @return true-设置成功，false-参数无效
+     */
+    public boolean setParameterRamp(int milliseconds) {
+        if (nativeHandle == 0) {
+            Log.e(TAG, "原生句柄为空，无法设置参数斜坡");
+            return false;
+        }
+        boolean success = nativeSetParameterRamp(nativeHandle, milliseconds);
+        if (!success) {
+            Log.e(TAG, "设置参数斜坡失败: " + nativeGetLastError(nativeHandle));
+        }
+        return success;
+    }
+    
+    /**
+     * 获取输出采样率（回调数据的采样率）
+     * 
+     * @return 采样率（Hz），默认48000
+     */
+    public int getSampleRate() {
+        if (nativeHandle == 0) {
+            return 0;
+        }
+        return nativeGetSampleRate(nativeHandle);
+    }
+    
+    /**
+     * 获取实际采集采样率
+     * 
+     * @return 采样率（Hz），未初始化时返回0
+     */
+    public int getCaptureSampleRate() {
+        if (nativeHandle == 0) {
+            return 0;
+        }
+        return nativeGetCaptureSampleRate(nativeHandle);
+    }
+    
+    /**
+     * 获取当前声道数
+     * 
+     * @return 声道数，默认1
+     */
+    public int getChannelCount() {
+        if (nativeHandle == 0) {
+            return 0;
+        }
+        return nativeGetChannelCount(nativeHandle);
+    }
+    
+    /**
+     * 获取当前帧大小
+     * 
+     * @return 帧大小（每声道采样点数）
+     */
+    public int getFrameSize() {
+        if (nativeHandle == 0) {
+            return 0;
+        }
+        return nativeGetFrameSize(nativeHandle);
+    }
+    
+    /**
+     * 获取队列大小
+     * 
+     * @return 当前队列中的帧数
+     */
+    public int getQueueSize() {
+        if (nativeHandle == 0) {
+            return 0;
+        }
+        return nativeGetQueueSize(nativeHandle);
+    }
+    
+    /**
+     * 设置队列溢出策略
+     * 
+     * @param policy {@link #OVERFLOW_DROP_OLDEST} 或 {@link #OVERFLOW_DROP_NEWEST}
+     */
+    public void setOverflowPolicy(int policy) {
+        if (nativeHandle == 0) {
+            return;
+        }
+        nativeSetOverflowPolicy(nativeHandle, policy);
+    }
+    
+    /**
+     * 获取因队列溢出而丢弃的帧数
+     * 
+     * @return 丢弃帧数（每次start时清零）
+     */
+    public long getDroppedFrameCount() {
+        if (nativeHandle == 0) {
+            return 0;
+        }
+        return nativeGetDroppedFrameCount(nativeHandle);
+    }
+    
+    /**
+     * 单个处理阶段的延迟分布（单位：微秒）
+     */
+    public static final class Latency {
+        public long count;
+        public long p50Us;
+        public long p95Us;
+        public long p99Us;
+        public long maxUs;
+        public long avgUs;
+        
+        @Override
+        public String toString() {
+            return "n=" + count + " p50=" + p50Us + " p95=" + p95Us + " p99=" + p99Us
+                    + " max=" + maxUs + " avg=" + avgUs;
+        }
+    }
+    
+    /**
+     * 运行统计快照（每次start时清零）
+     */
+    public static final class Stats {
+        /** 已降噪的帧数 */
+        public long processedFrames;
+        /** 队列溢出丢弃的帧数 */
+        public long droppedFrames;
+        /** 降噪出错的帧数（LSNR为负是正常的噪声估计，不计入） */
+        public long failedFrames;
+        /** 降噪耗时超过帧时长（实时预算）的帧数 */
+        public long overBudgetFrames;
+        /** 采集回调到处理线程出队 */
+        public final Latency queue = new Latency();
+        /** 降噪耗时 */
+        public final Latency process = new Latency();
+        /** 结果回调耗时 */
+        public final Latency callback = new Latency();
+        /** 采集回调到结果回调返回 */
+        public final Latency endToEnd = new Latency();
+        /** 采样率转换引入的固定延迟（输入+输出，微秒，未计入上面各阶段） */
+        public long resamplerLatencyUs;
+        /** 计算门控跳过模型推理的帧数（已计入processedFrames） */
+        public long bypassedFrames;
+        /** 同步模式下在采集回调中处理的帧数（已计入processedFrames） */
+        public long syncFrames;
+        /** 同步模式下采集回调超过截止时间的次数 */
+        public long missedDeadlines;
+        /** 同步模式是否已因超时回退到异步处理 */
+        public boolean syncFallback;
+        /** 推送模式下接受的帧数（每声道） */
+        public long pushedFrames;
+        /** 推送模式下因队列满未能全部接受的推送次数 */
+        public long backpressureEvents;
+        /** 输出与上一块不连续的次数（队列溢出丢帧或处理失败） */
+        public long discontinuities;
+        
+        @Override
+        public String toString() {
+            return "processed=" + processedFrames + " dropped=" + droppedFrames
+                    + " failed=" + failedFrames + " overBudget=" + overBudgetFrames
+                    + " bypassed=" + bypassedFrames
+                    + " sync=" + syncFrames + " missedDeadlines=" + missedDeadlines
+                    + (syncFallback ? " (fallback)" : "")
+                    + " pushed=" + pushedFrames + " backpressure=" + backpressureEvents
+                    + " discontinuities=" + discontinuities
+                    + " resamplerLatencyUs=" + resamplerLatencyUs
+                    + "\n  queue: " + queue + "\n  process: " + process
+                    + "\n  callback: " + callback + "\n  endToEnd: " + endToEnd;
+        }
+    }
+    
+    private static final int STATS_FIELD_COUNT = 4 + 4 * 6 + 2 + 3 + 2 + 1;
+    
+    /**
+     * 获取运行统计快照（各阶段延迟p50/p95/p99/max及丢帧、失败计数）
+     * 
+     * 可在任意线程调用，不阻塞处理线程，适合定期上报
+     * 
+     * @return 统计快照，未初始化时返回null
+     */
+    public Stats getStats() {
+        if (nativeHandle == 0) {
+            return null;
+        }
+        long[] values = new long[STATS_FIELD_COUNT];
+        if (!nativeGetStats(nativeHandle, values)) {
+            return null;
+        }
+        
+        Stats stats = new Stats();
+        int index = 0;
+        stats.processedFrames = values[index++];
+        stats.droppedFrames = values[index++];
+        stats.failedFrames = values[index++];
+        stats.overBudgetFrames = values[index++];
+        for (Latency stage : new Latency[] {stats.queue, stats.process, stats.callback, stats.endToEnd}) {
+            stage.count = values[index++];
+            stage.p50Us = values[index++];
+            stage.p95Us = values[index++];
+            stage.p99Us = values[index++];
+            stage.maxUs = values[index++];
+            stage.avgUs = values[index++];
+        }
+        stats.resamplerLatencyUs = values[index++];
+        stats.bypassedFrames = values[index++];
+        stats.syncFrames = values[index++];
+        stats.missedDeadlines = values[index++];
+        stats.syncFallback = values[index++] != 0;
+        stats.pushedFrames = values[index++];
+        stats.backpressureEvents = values[index++];
+        stats.discontinuities = values[index++];
+        return stats;
+    }
+    
+    /**
+     * 处理线程调度统计（每次start时清零）
+     */
+    public static final class SchedulingStats {
+        /** 各核心上处理的hop数（下标为CPU编号） */
+        public long[] coreHops;
+        /** 在性能核心上处理的hop数 */
+        public long performanceCoreHops;
+        /** 无法获取当前核心的hop数 */
+        public long unknownCoreHops;
+        /** 识别到的性能核心掩码 */
+        public long performanceCoreMask;
+        /** 因队列积压提升的次数 */
+        public long boosts;
+        /** 调度/亲和性设置失败次数（无实时调度权限时FIFO会失败） */
+        public long failures;
+        /** 当前是否处于提升状态 */
+        public boolean boosted;
+        
+        @Override
+        public String toString() {
+            StringBuilder cores = new StringBuilder();
+            for (int cpu = 0; cpu < coreHops.length; cpu++) {
+                if (coreHops[cpu] > 0) {
+                    cores.append(" cpu").append(cpu).append('=').append(coreHops[cpu]);
+                }
+            }
+            return "performanceCoreHops=" + performanceCoreHops + " unknown=" + unknownCoreHops
+                    + " performanceMask=0x" + Long.toHexString(performanceCoreMask)
+                    + " boosts=" + boosts + " failures=" + failures + " boosted=" + boosted
+                    + "\n  cores:" + cores;
+        }
+    }
+    
+    private static final int MAX_CPUS = 64;
+    private static final int SCHEDULING_FIELD_COUNT = 6 + MAX_CPUS;
+    
+    /**
+     * 获取处理线程调度统计（逐hop记录的运行核心、积压提升次数）
+     * 
+     * @return 统计快照，未初始化时返回null
+     */
+    public SchedulingStats getSchedulingStats() {
+        if (nativeHandle == 0) {
+            return null;
+        }
+        long[] values = new long[SCHEDULING_FIELD_COUNT];
+        if (!nativeGetSchedulingStats(nativeHandle, values)) {
+            return null;
+        }
+        
+        SchedulingStats stats = new SchedulingStats();
+        int index = 0;
+        stats.performanceCoreMask = values[index++];
+        stats.performanceCoreHops = values[index++];
+        stats.unknownCoreHops = values[index++];
+        stats.boosts = values[index++];
+        stats.failures = values[index++];
+        stats.boosted = values[index++] != 0;
+        stats.coreHops = new long[MAX_CPUS];
+        System.arraycopy(values, index, stats.coreHops, 0, MAX_CPUS);
+        return stats;
+    }
+    
+    /**
+     * 双工模式播放缓冲区统计（每次startDuplex时清零）
+     */
+    public static final class PlayoutStats {
+        /** 写入播放缓冲区的帧数 */
+        public long writtenFrames;
+        /** 输出流播放的帧数（含静音） */
+        public long renderedFrames;
+        /** 欠载次数（每次欠载后重新预缓冲） */
+        public long underruns;
+        /** 预缓冲和欠载时播放的静音帧数 */
+        public long silentFrames;
+        /** 缓冲区满时丢弃的帧数 */
+        public long overflowFrames;
+        /** 当前缓冲帧数 */
+        public long fillFrames;
+        /** 目标缓冲帧数（双工模式的附加延迟） */
+        public long targetFrames;
+        /** 当前读取速率修正（ppm），稳态时约等于采集与播放设备的时钟偏差 */
+        public long correctionPpm;
+        
+        @Override
+        public String toString() {
+            return "written=" + writtenFrames + " rendered=" + renderedFrames
+                    + " underruns=" + underruns + " silent=" + silentFrames + " overflow=" + overflowFrames
+                    + " fill=" + fillFrames + "/" + targetFrames + " correction=" + correctionPpm + "ppm";
+        }
+    }
+    
+    private static final int PLAYOUT_FIELD_COUNT = 8;
+    
+    /**
+     * 获取双工模式播放缓冲区统计
+     * 
+     * @return 统计快照，未初始化时返回null
+     */
+    public PlayoutStats getPlayoutStats() {
+        if (nativeHandle == 0) {
+            return null;
+        }
+        long[] values = new long[PLAYOUT_FIELD_COUNT];
+        if (!nativeGetPlayoutStats(nativeHandle, values)) {
+            return null;
+        }
+        
+        PlayoutStats stats = new PlayoutStats();
+        int index = 0;
+        stats.writtenFrames = values[index++];
+        stats.renderedFrames = values[index++];
+        stats.underruns = values[index++];
+        stats.silentFrames = values[index++];
+        stats.overflowFrames = values[index++];
+        stats.fillFrames = values[index++];
+        stats.targetFrames = values[index++];
+        stats.correctionPpm = values[index++];
+        return stats;
+    }
+    
+    /**
+     * 管线延迟分解（帧数均为每声道采样点数，按输出采样率）
+     * 
+     * 推理和回调耗时不计入，实测端到端延迟见 {@link Stats}
+     */
+    public static final class PipelineDelay {
+        /** 帧数对应的采样率（输出采样率） */
+        public long sampleRate;
+        /** 模型前瞻（hop数，零前瞻模型为0） */
+        public long lookaheadHops;
+        /** 模型算法延迟：STFT窗口重叠 + 前瞻 */
+        public long algorithmicFrames;
+        /** 采集端攒满一个hop的分块延迟 */
+        public long blockingFrames;
+        /** 当前队列中积压的hop（同步处理时为0） */
+        public long queueFrames;
+        /** 采样率转换延迟 */
+        public long resamplerFrames;
+        /** 双工模式播放缓冲目标深度（非双工为0） */
+        public long playoutFrames;
+        /** 以上之和 */
+        public long totalFrames;
+        
+        /**
+         * 总延迟（毫秒）
+         */
+        public double totalMs() {
+            return sampleRate > 0 ? totalFrames * 1000.0 / sampleRate : 0.0;
+        }
+        
+        @Override
+        public String toString() {
+            return "total=" + totalFrames + " (" + String.format("%.1f", totalMs()) + "ms)"
+                    + " algorithmic=" + algorithmicFrames + " lookahead=" + lookaheadHops + "hops"
+                    + " blocking=" + blockingFrames + " queue=" + queueFrames
+                    + " resampler=" + resamplerFrames + " playout=" + playoutFrames;
+        }
+    }
+    
+    private static final int DELAY_FIELD_COUNT = 8;
+    
+    /**
+     * 获取管线延迟分解（initialize之后有效）
+     * 
+     * algorithmicFrames 可用于回声消除参考信号或音画同步的对齐；totalFrames 为当前配置下的固定延迟加队列积压
+     * 
+     * @return 延迟分解，未初始化时返回null
+     */
+    public PipelineDelay getPipelineDelay() {
+        if (nativeHandle == 0) {
+            return null;
+        }
+        long[] values = new long[DELAY_FIELD_COUNT];
+        if (!nativeGetPipelineDelay(nativeHandle, values)) {
+            return null;
+        }
+        
+        PipelineDelay delay = new PipelineDelay();
+        int index = 0;
+        delay.sampleRate = values[index++];
+        delay.lookaheadHops = values[index++];
+        delay.algorithmicFrames = values[index++];
+        delay.blockingFrames = values[index++];
+        delay.queueFrames = values[index++];
+        delay.resamplerFrames = values[index++];
+        delay.playoutFrames = values[index++];
+        delay.totalFrames = values[index++];
+        return delay;
+    }
+    
+    // ===== JNI原生方法声明 =====
+    
+    /**
+     * 创建AudioProcessor实例
+     * 
+     * @return 原生句柄（0表示失败）
+     */
+    private native long nativeCreate();
+    
+    /**
+     * 初始化音频处理器
      * 
      * @param nativeHandle 原生句柄
      * @param tarBytes 模型文件字节数组（tar.gz格式）
@@ -322,6 +1305,173 @@ public class AudioProcessor {
      */
     private native boolean nativeInitialize(long nativeHandle, byte[] tarBytes, float postFilterBeta, float attenLimDb);
     
+    /**
+     * 从共享模型初始化音频处理器
+     * 
+     * @param nativeHandle 原生句柄
+     * @param modelHandle 模型句柄
+     * @param postFilterBeta 后滤波器beta参数
+     * @param attenLimDb 衰减限制（dB）
+     * @return true-初始化成功，false-初始化失败
+     */
+    private native boolean nativeInitializeFromModel(long nativeHandle, long modelHandle, float postFilterBeta, float attenLimDb);
+    
+    /**
+     * 加载共享模型
+     * 
+     * @param tarBytes 模型文件字节数组（tar.gz格式）
+     * @return 模型句柄（0表示失败）
+     */
+    private static native long nativeLoadModel(byte[] tarBytes);
+    
+    /**
+     * 设置模型缓存目录
+     * 
+     * @param nativeHandle 原生句柄
+     * @param directory 缓存目录绝对路径（null表示禁用缓存）
+     */
+    private native void nativeSetModelCacheDir(long nativeHandle, String directory);
+    
+    /**
+     * 设置模型精度
+     * 
+     * @param nativeHandle 原生句柄
+     * @param precision 模型精度
+     * @param variantTarBytes 变体包（可为null）
+     * @return true-设置成功，false-设置失败
+     */
+    private native boolean nativeSetModelPrecision(long nativeHandle, int precision, byte[] variantTarBytes);
+    
+    /**
+     * 设置推理后端
+     * 
+     * @param nativeHandle 原生句柄
+     * @param backend 推理后端
+     * @return true-设置成功，false-设置失败
+     */
+    private native boolean nativeSetInferenceBackend(long nativeHandle, int backend);
+    
+    /**
+     * 原生库是否包含指定的推理后端
+     * 
+     * @param backend 推理后端
+     * @return true-包含
+     */
+    private static native boolean nativeIsBackendAvailable(int backend);
+    
+    /**
+     * 设置采集和输出采样率
+     * 
+     * @param nativeHandle 原生句柄
+     * @param captureSampleRate 采集采样率（0表示设备原生采样率）
+     * @param outputSampleRate 输出采样率（0表示48000）
+     * @return true-设置成功，false-设置失败
+     */
+    private native boolean nativeSetSampleRates(long nativeHandle, int captureSampleRate, int outputSampleRate);
+    
+    /**
+     * 设置推送模式
+     * 
+     * @param nativeHandle 原生句柄
+     * @param enabled 是否启用
+     * @return true-设置成功，false-设置失败
+     */
+    private native boolean nativeSetPushMode(long nativeHandle, boolean enabled);
+    
+    /**
+     * 推送PCM16音频
+     * 
+     * @param nativeHandle 原生句柄
+     * @param buffer 音频数据（DirectByteBuffer）
+     * @param offset 偏移量（字节）
+     * @param length 长度（字节）
+     * @param timeoutMs 队列满时最长等待时间（毫秒）
+     * @return 接受的字节数，-1表示失败
+     */
+    private native int nativePushPcm16(long nativeHandle, ByteBuffer buffer, int offset, int length, int timeoutMs);
+    
+    /**
+     * 推送float音频
+     * 
+     * @param nativeHandle 原生句柄
+     * @param buffer 音频数据（DirectByteBuffer）
+     * @param offset 偏移量（字节）
+     * @param length 长度（字节）
+     * @param timeoutMs 队列满时最长等待时间（毫秒）
+     * @return 接受的字节数，-1表示失败
+     */
+    private native int nativePushFloat(long nativeHandle, ByteBuffer buffer, int offset, int length, int timeoutMs);
+    
+    /**
+     * 获取不等待即可推送的帧数
+     * 
+     * @param nativeHandle 原生句柄
+     * @return 帧数
+     */
+    private native int nativeGetPushableFrames(long nativeHandle);
+    
+    /**
+     * 设置采集声道数
+     * 
+     * @param nativeHandle 原生句柄
+     * @param channelCount 声道数
+     * @return true-设置成功，false-设置失败
+     */
+    private native boolean nativeSetChannelCount(long nativeHandle, int channelCount);
+    
+    /**
+     * 设置计算门控
+     * 
+     * @param nativeHandle 原生句柄
+     * @param enabled 是否启用
+     * @param silenceDbfs 静音阈值（dBFS）
+     * @param cleanLsnrDb 干净语音LSNR阈值（dB），不大于0时只按静音门控
+     * @return true-设置成功，false-设置失败
+     */
+    private native boolean nativeSetComputeGate(long nativeHandle, boolean enabled, float silenceDbfs, float cleanLsnrDb);
+    
+    /**
+     * 设置处理线程调度
+     * 
+     * @param nativeHandle 原生句柄
+     * @param priority 优先级策略
+     * @param niceValue nice值
+     * @param affinity 亲和性策略
+     * @param cpuMask 核心掩码
+     * @param boostOnBacklog 队列积压时是否自动提升
+     * @return true-设置成功，false-设置失败
+     */
+    private native boolean nativeSetThreadScheduling(long nativeHandle, int priority, int niceValue, int affinity,
+                                                     long cpuMask, boolean boostOnBacklog);
+    
+    /**
+     * 设置同步处理模式
+     * 
+     * @param nativeHandle 原生句柄
+     * @param enabled 是否启用
+     * @param deadlineRatio 截止时间占采集回调时长的比例
+     * @param maxMissedDeadlines 触发回退的超时次数
+     * @return true-设置成功，false-设置失败
+     */
+    private native boolean nativeSetSynchronousMode(long nativeHandle, boolean enabled, float deadlineRatio,
+                                                    int maxMissedDeadlines);
+    
+    /**
+     * 设置延迟档位
+     * 
+     * @param nativeHandle 原生句柄
+     * @param profile 延迟档位
+     * @return true-设置成功，false-设置失败
+     */
+    private native boolean nativeSetLatencyProfile(long nativeHandle, int profile);
+    
+    /**
+     * 释放共享模型
+     * 
+     * @param modelHandle 模型句柄
+     */
+    private static native void nativeFreeModel(long modelHandle);
+    
     /**
      * 开始录制和降噪处理
      * 
@@ -329,7 +1479,45 @@ public class AudioProcessor {
      * @param callback 回调对象
      * @return true-开始成功，false-开始失败
      */
-    private native boolean nativeStart(long nativeHandle, AudioProcessor callback);
+    private native boolean nativeStart(long nativeHandle, AudioDataCallback callback);
+    
+    /**
+     * 开始录制和降噪处理（回调附带帧位置和时间戳）
+     * 
+     * @param nativeHandle 原生句柄
+     * @param callback 回调对象
+     * @return true-开始成功，false-开始失败
+     */
+    private native boolean nativeStartWithFrameInfo(long nativeHandle, FrameInfoCallback callback);
+    
+    /**
+     * 以双工模式开始录制和降噪处理
+     * 
+     * @param nativeHandle 原生句柄
+     * @param monitor 附加回调（可为null）
+     * @return true-开始成功，false-开始失败
+     */
+    private native boolean nativeStartDuplex(long nativeHandle, AudioDataCallback monitor);
+    
+    /**
+     * 以直接输出模式开始录制和降噪处理
+     * 
+     * @param nativeHandle 原生句柄
+     * @param outputBuffer 共享输出环（direct ByteBuffer）
+     * @param slotCount 槽数量
+     * @param callback 写入通知回调（可为null）
+     * @return true-开始成功，false-开始失败
+     */
+    private native boolean nativeStartDirect(long nativeHandle, ByteBuffer outputBuffer, int slotCount,
+                                             DirectAudioCallback callback);
+    
+    /**
+     * 获取直接输出模式下已写入的槽总数
+     * 
+     * @param nativeHandle 原生句柄
+     * @return 已写入的槽总数
+     */
+    private native long nativeGetDirectWriteCount(long nativeHandle);
     
     /**
      * 停止录制和降噪处理
@@ -388,6 +1576,15 @@ public class AudioProcessor {
      */
     private native boolean nativeSetAttenLimDb(long nativeHandle, float attenLimDb);
     
+    /**
+     * 设置参数斜坡时长
+     * 
+     * @param nativeHandle 原生句柄
+     * @param milliseconds 斜坡时长（毫秒）
+     * @return true-设置成功，false-设置失败
+     */
+    private native boolean nativeSetParameterRamp(long nativeHandle, int milliseconds);
+    
     /**
      * 获取当前采样率
      * 
@@ -396,6 +1593,14 @@ public class AudioProcessor {
      */
     private native int nativeGetSampleRate(long nativeHandle);
     
+    /**
+     * 获取实际采集采样率
+     * 
+     * @param nativeHandle 原生句柄
+     * @return 采样率（Hz）
+     */
+    private native int nativeGetCaptureSampleRate(long nativeHandle);
+    
     /**
      * 获取当前声道数
      * 
@@ -420,6 +1625,58 @@ public class AudioProcessor {
      */
     private native int nativeGetQueueSize(long nativeHandle);
     
+    /**
+     * 设置队列溢出策略
+     * 
+     * @param nativeHandle 原生句柄
+     * @param policy 溢出策略
+     */
+    private native void nativeSetOverflowPolicy(long nativeHandle, int policy);
+    
+    /**
+     * 获取因队列溢出而丢弃的帧数
+     * 
+     * @param nativeHandle 原生句柄
+     * @return 丢弃帧数
+     */
+    private native long nativeGetDroppedFrameCount(long nativeHandle);
+    
+    /**
+     * 获取运行统计
+     * 
+     * @param nativeHandle 原生句柄
+     * @param out 输出数组（长度至少STATS_FIELD_COUNT）
+     * @return 是否成功
+     */
+    private native boolean nativeGetStats(long nativeHandle, long[] out);
+    
+    /**
+     * 获取处理线程调度统计
+     * 
+     * @param nativeHandle 原生句柄
+     * @param out 输出数组（长度至少SCHEDULING_FIELD_COUNT）
+     * @return 是否成功
+     */
+    private native boolean nativeGetSchedulingStats(long nativeHandle, long[] out);
+    
+    /**
+     * 获取双工模式播放缓冲区统计
+     * 
+     * @param nativeHandle 原生句柄
+     * @param out 输出数组（长度至少PLAYOUT_FIELD_COUNT）
+     * @return 是否成功
+     */
+    private native boolean nativeGetPlayoutStats(long nativeHandle, long[] out);
+    
+    /**
+     * 获取管线延迟分解
+     * 
+     * @param nativeHandle 原生句柄
+     * @param out 输出数组（长度至少DELAY_FIELD_COUNT）
+     * @return 是否成功
+     */
+    private native boolean nativeGetPipelineDelay(long nativeHandle, long[] out);
+    
     /**
      * 销毁AudioProcessor实例
      * 
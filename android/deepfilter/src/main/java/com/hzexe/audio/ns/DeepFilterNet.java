@@ -16,9 +16,13 @@ import java.nio.ByteOrder;
  * 3. 支持实时音频流处理
  * 4. 使用 Tract 框架进行模型推理
  * 5. 支持纯降噪模式，保守降噪强度
+ * 6. 支持共享模型：模型只解压解析一次，多个实例从同一模型创建
+ * 7. 支持直接处理PCM16（AudioRecord的ENCODING_PCM_16BIT），格式转换在原生层向量化完成
+ * 8. 支持多声道（多麦克风）交织数据，所有声道在一次推理中处理，见 {@link #setChannelCount(int)}
+ * 9. 报告模型算法延迟（STFT 窗口重叠 + 前瞻），见 {@link #getAlgorithmicDelay()}
  * 
  * @author hzexe (https://github.com/hzexe)
- * @version 2.0
+ * @version 2.4
  */
 public class DeepFilterNet {
     
@@ -33,6 +37,12 @@ public class DeepFilterNet {
     // 模型文件字节数组（tar.gz 压缩包）
     private byte[] modelBytes;
     
+    // 共享模型句柄（由loadModel创建，0表示从modelBytes创建）
+    private long modelHandle;
+    
+    // 声道数（initialize之前设置）
+    private int channelCount = 1;
+    
     // 原生句柄
     private long nativeHandle;
     
@@ -58,6 +68,69 @@ public class DeepFilterNet {
         this.modelBytes = modelBytes;
     }
     
+    /**
+     * 构造函数（从共享模型创建）
+     * 
+     * @param modelHandle loadModel返回的模型句柄，需在本实例initialize之后才可释放
+     */
+    public DeepFilterNet(long modelHandle) {
+        this.modelHandle = modelHandle;
+    }
+    
+    /**
+     * 加载共享模型
+     * 
+     * 模型只解压和解析一次，之后每个实例通过DeepFilterNet(long)快速创建
+     * 
+     * @param modelBytes 模型文件字节数组（tar.gz 压缩包）
+     * @return 模型句柄（0 表示失败）
+     */
+    public static long loadModel(byte[] modelBytes) {
+        if (modelBytes == null) {
+            Log.e(TAG, "模型文件为空");
+            return 0;
+        }
+        return nativeLoadModel(modelBytes);
+    }
+    
+    /**
+     * 释放共享模型（已创建的实例不受影响）
+     * 
+     * @param modelHandle 模型句柄
+     */
+    public static void freeModel(long modelHandle) {
+        if (modelHandle != 0) {
+            nativeFreeModel(modelHandle);
+        }
+    }
+    
+    
+    /**
+     * 设置声道数（需在initialize之前调用）
+     * 
+     * 大于1时process/processPcm16的数据为交织布局（如双声道 L0 R0 L1 R1 ...），
+     * 长度为 hop 大小 × 声道数的整数倍；比每个声道各创建一个实例开销更低
+     * 
+     * @param channelCount 声道数（1~16）
+     * @return true-设置成功，false-参数无效或已初始化
+     */
+    public boolean setChannelCount(int channelCount) {
+        if (initialized || channelCount < 1 || channelCount > 16) {
+            Log.e(TAG, "声道数设置无效: " + channelCount);
+            return false;
+        }
+        this.channelCount = channelCount;
+        return true;
+    }
+    
+    /**
+     * 获取声道数
+     * 
+     * @return 声道数，默认1
+     */
+    public int getChannelCount() {
+        return channelCount;
+    }
     
     /**
      * 初始化 DeepFilterNet 引擎
@@ -67,13 +140,17 @@ public class DeepFilterNet {
      * @return true-初始化成功，false-初始化失败
      */
     public boolean initialize(float postFilterBeta, float attenLimDb) {
-        if (modelBytes == null) {
+        if (modelBytes == null && modelHandle == 0) {
             Log.e(TAG, "模型文件未加载，无法初始化");
             return false;
         }
         
         try {
-            nativeHandle = nativeCreate(modelBytes, postFilterBeta, attenLimDb);
+            if (modelHandle != 0) {
+                nativeHandle = nativeCreateFromModel(modelHandle, channelCount, postFilterBeta, attenLimDb);
+            } else {
+                nativeHandle = nativeCreate(modelBytes, channelCount, postFilterBeta, attenLimDb);
+            }
             if (nativeHandle != 0) {
                 initialized = true;
                 Log.d(TAG, "DeepFilterNet 初始化成功，句柄: " + nativeHandle);
@@ -92,30 +169,79 @@ public class DeepFilterNet {
     /**
      * 处理一帧音频数据（DirectByteBuffer 格式）
      * 
-     * @param inputBuffer 输入音频数据缓冲区（DirectByteBuffer，f32，小端序，单声道）
+     * 长度可以是任意整数个 hop（hop 大小由模型决定，DeepFilterNet3 为 480），多个 hop 依次处理；
+     * 不是 hop 整数倍或超出缓冲区容量时返回失败
+     * 
+     * @param inputBuffer 输入音频数据缓冲区（DirectByteBuffer，f32，小端序，多声道时为交织布局）
      * @param inputOffset 输入数据在缓冲区中的偏移量（字节）
-     * @param inputLength 输入数据长度（字节）
-     * @param outputBuffer 输出音频数据缓冲区（DirectByteBuffer，f32，小端序，单声道）
+     * @param inputLength 输入数据长度（字节，hop 大小 × 声道数 × 4 的整数倍）
+     * @param outputBuffer 输出音频数据缓冲区（DirectByteBuffer，f32，小端序，与输入布局相同）
      * @param outputOffset 输出数据在缓冲区中的偏移量（字节）
      * @param outputLength 输出数据长度（字节）
-     * @return LSNR 值（负数表示失败）
+     * @return 最后一个 hop 的 LSNR 值（NaN表示失败，LSNR可为负）
      */
     public float process(ByteBuffer inputBuffer, int inputOffset, int inputLength,
                         ByteBuffer outputBuffer, int outputOffset, int outputLength) {
         if (!initialized) {
             Log.e(TAG, "引擎未初始化，无法处理音频");
-            return -1.0f;
+            return Float.NaN;
         }
         
         if (inputBuffer == null || outputBuffer == null) {
             Log.e(TAG, "输入或输出缓冲区为空");
-            return -1.0f;
+            return Float.NaN;
         }
         
         return nativeProcess(nativeHandle, inputBuffer, inputOffset, inputLength,
                            outputBuffer, outputOffset, outputLength);
     }
     
+    /**
+     * 处理PCM16音频数据（DirectByteBuffer 格式）
+     * 
+     * 适合直接处理AudioRecord读取的ENCODING_PCM_16BIT数据，Java层无需先转换为float；
+     * PCM16与float之间的转换在原生层使用NEON/SSE/AVX2完成，输出超出范围时饱和。
+     * 输入和输出可以是同一缓冲区的同一区间（原地处理）
+     * 
+     * @param inputBuffer 输入音频数据缓冲区（DirectByteBuffer，PCM16，小端序，多声道时为交织布局）
+     * @param inputOffset 输入数据在缓冲区中的偏移量（字节）
+     * @param inputLength 输入数据长度（字节，hop 大小 × 声道数 × 2 的整数倍）
+     * @param outputBuffer 输出音频数据缓冲区（DirectByteBuffer，PCM16，小端序，与输入布局相同）
+     * @param outputOffset 输出数据在缓冲区中的偏移量（字节）
+     * @param outputLength 输出数据长度（字节）
+     * @return 最后一个 hop 的 LSNR 值（NaN表示失败，LSNR可为负）
+     */
+    public float processPcm16(ByteBuffer inputBuffer, int inputOffset, int inputLength,
+                              ByteBuffer outputBuffer, int outputOffset, int outputLength) {
+        if (!initialized) {
+            Log.e(TAG, "引擎未初始化，无法处理音频");
+            return Float.NaN;
+        }
+        
+        if (inputBuffer == null || outputBuffer == null) {
+            Log.e(TAG, "输入或输出缓冲区为空");
+            return Float.NaN;
+        }
+        
+        return nativeProcessPcm16(nativeHandle, inputBuffer, inputOffset, inputLength,
+                                  outputBuffer, outputOffset, outputLength);
+    }
+    
+    /**
+     * 获取模型算法延迟：输出相对输入的固定延迟（fft_size - hop_size + lookahead × hop_size）
+     * 
+     * 不含攒满一个 hop 的分块延迟；回声消除、音画同步时按此值对齐。
+     * DeepFilterNet3 为 1440（30ms），零前瞻模型（如 DeepFilterNet3_ll）为 480（10ms）
+     * 
+     * @return 延迟（每声道采样点数，48kHz），未初始化时返回 0
+     */
+    public int getAlgorithmicDelay() {
+        if (!initialized || nativeHandle == 0) {
+            return 0;
+        }
+        return nativeGetAlgorithmicDelay(nativeHandle);
+    }
+    
     /**
      * 释放资源
      */
@@ -143,11 +269,38 @@ public class DeepFilterNet {
      * 创建 DeepFilterNet 实例
      * 
      * @param modelBytes 模型压缩包字节数组（tar.gz）
+     * @param channelCount 声道数
      * @param postFilterBeta 后滤波器 beta 参数（控制降噪强度）
      * @param attenLimDb 衰减限制（dB）
      * @return 原生句柄（0 表示失败）
      */
-    private native long nativeCreate(byte[] modelBytes, float postFilterBeta, float attenLimDb);
+    private native long nativeCreate(byte[] modelBytes, int channelCount, float postFilterBeta, float attenLimDb);
+    
+    /**
+     * 加载共享模型
+     * 
+     * @param modelBytes 模型压缩包字节数组（tar.gz）
+     * @return 模型句柄（0 表示失败）
+     */
+    private static native long nativeLoadModel(byte[] modelBytes);
+    
+    /**
+     * 从共享模型创建实例
+     * 
+     * @param modelHandle 模型句柄
+     * @param channelCount 声道数
+     * @param postFilterBeta 后滤波器 beta 参数
+     * @param attenLimDb 衰减限制（dB）
+     * @return 原生句柄（0 表示失败）
+     */
+    private native long nativeCreateFromModel(long modelHandle, int channelCount, float postFilterBeta, float attenLimDb);
+    
+    /**
+     * 释放共享模型
+     * 
+     * @param modelHandle 模型句柄
+     */
+    private static native void nativeFreeModel(long modelHandle);
     
     /**
      * 处理一帧音频数据（DirectByteBuffer 版本）
@@ -159,15 +312,38 @@ public class DeepFilterNet {
      * @param outputBuffer 输出缓冲区（DirectByteBuffer，f32，小端序）
      * @param outputOffset 输出缓冲区起始偏移量（字节）
      * @param outputLength 输出缓冲区有效长度（字节）
-     * @return LSNR 值（负数表示失败）
+     * @return LSNR 值（NaN表示失败，LSNR可为负）
      */
     private native float nativeProcess(long handle, ByteBuffer inputBuffer, int inputOffset, int inputLength,
                                        ByteBuffer outputBuffer, int outputOffset, int outputLength);
     
+    /**
+     * 处理PCM16音频数据（DirectByteBuffer 版本）
+     * 
+     * @param handle 原生句柄
+     * @param inputBuffer 输入缓冲区（DirectByteBuffer，PCM16，小端序）
+     * @param inputOffset 输入缓冲区起始偏移量（字节）
+     * @param inputLength 输入缓冲区有效长度（字节）
+     * @param outputBuffer 输出缓冲区（DirectByteBuffer，PCM16，小端序）
+     * @param outputOffset 输出缓冲区起始偏移量（字节）
+     * @param outputLength 输出缓冲区有效长度（字节）
+     * @return LSNR 值（NaN表示失败，LSNR可为负）
+     */
+    private native float nativeProcessPcm16(long handle, ByteBuffer inputBuffer, int inputOffset, int inputLength,
+                                            ByteBuffer outputBuffer, int outputOffset, int outputLength);
+    
     /**
      * 销毁 DeepFilterNet 实例
      * 
      * @param handle 原生句柄
      */
     private native void nativeDestroy(long handle);
+    
+    /**
+     * 获取算法延迟
+     * 
+     * @param handle 原生句柄
+     * @return 延迟（每声道采样点数）
+     */
+    private native int nativeGetAlgorithmicDelay(long handle);
 }
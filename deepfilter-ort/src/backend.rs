@@ -0,0 +1,52 @@
+// 推理后端抽象
+//
+// - df_* C 接口只依赖 Backend trait，实例创建时按后端编号选择实现，其余接口（逐 hop 处理、参数设置、
+//   帧大小和延迟查询）与后端无关
+// - 后端负责完整的一个 hop：STFT 分析、特征提取、三个子网络推理、深度滤波和 STFT 合成，
+//   输入输出均为平面布局 [n_ch, hop_size] 的 f32
+// - tract：tract::SharedTract（默认，目前唯一的实现），按 libDF 的 DfTract 移植，
+//   优化后的计划在模型内共享（见 tract.rs）
+// - 其他实现（如 ONNX Runtime，需要 ort 依赖并在本 crate 中实现 libDF 的前后处理）实现本 trait，
+//   在 deepfilter_ort.h 中分配 DF_BACKEND_* 编号后加入 available/name/create
+
+use anyhow::{bail, Result};
+use ndarray::prelude::*;
+
+use crate::tract::{InstanceParams, SharedModel, SharedTract};
+
+// 与 deepfilter_ort.h 中的 DF_BACKEND_* 一致
+pub const BACKEND_TRACT: i32 = 0;
+
+pub trait Backend {
+    // 后端编号（BACKEND_*）
+    fn id(&self) -> i32;
+    fn hop_size(&self) -> usize;
+    fn fft_size(&self) -> usize;
+    // 模型前瞻（hop 数）
+    fn lookahead(&self) -> usize;
+    fn channels(&self) -> usize;
+    // 处理一个 hop，返回 LSNR
+    fn process(&mut self, input: ArrayView2<f32>, output: ArrayViewMut2<f32>) -> Result<f32>;
+    fn set_pf_beta(&mut self, beta: f32);
+    fn set_atten_lim(&mut self, lim_db: f32);
+}
+
+// 当前构建是否包含该后端
+pub fn available(backend: i32) -> bool {
+    backend == BACKEND_TRACT
+}
+
+pub fn name(backend: i32) -> &'static str {
+    match backend {
+        BACKEND_TRACT => "tract",
+        _ => "unknown",
+    }
+}
+
+// 创建后端实例（共享模型中已优化的计划，只分配实例自己的运行状态）
+pub fn create(backend: i32, model: &SharedModel, params: &InstanceParams) -> Result<Box<dyn Backend>> {
+    match backend {
+        BACKEND_TRACT => Ok(Box::new(SharedTract::new(model, params)?)),
+        _ => bail!("未知的推理后端: {}", backend),
+    }
+}
@@ -1,32 +1,59 @@
-// DeepFilterNet3 集成 - 基于 tract 框架
-// 直接封装 tract.rs 的接口，避免重复实现逻辑
+// DeepFilterNet3 集成 - 默认基于 tract 框架
+// tract 推理见 tract.rs（按 libDF 移植，优化后的计划在模型内共享）；推理后端经 backend::Backend 抽象，创建实例时选择
 
-use std::io::Cursor;
+use std::io::{Cursor, Read, Write};
 
 use jni::JNIEnv;
 use jni::objects::{JClass, JByteBuffer};
 use jni::sys::{jint, jlong, jbyteArray};
 use ndarray::prelude::*;
 
-use df::tract::{DfParams, DfTract, RuntimeParams, ReduceMask};
+use anyhow::Result;
+use flate2::Compression;
+use flate2::read::GzDecoder;
+use flate2::write::GzEncoder;
+
+mod backend;
+mod pcm;
+mod precision;
+mod tract;
+
+use backend::Backend;
 
 // DeepFilterNet 状态包装器（线程安全）
 pub struct DeepFilterNetState {
-    df: DfTract,
+    df: Box<dyn Backend>,
+    // JNI 字节缓冲区转换用的暂存区（按需增长，稳态不再分配）
+    scratch_in: Vec<f32>,
+    scratch_out: Vec<f32>,
+    // 多声道交织 <-> 平面布局转换暂存区（创建时按 n_ch * hop_size 分配，单声道为空）
+    planar: PlanarScratch,
+}
+
+struct PlanarScratch {
+    input: Vec<f32>,
+    output: Vec<f32>,
 }
 
+// 单个实例支持的最大声道数
+const MAX_CHANNELS: usize = 16;
+
 // 实现线程安全
 unsafe impl Send for DeepFilterNetState {}
 unsafe impl Sync for DeepFilterNetState {}
 
-// 创建 DeepFilterNet 实例
+// 已解压的模型和共享的优化后计划（可在多个线程间共享，用于创建多个实例）
+pub struct DeepFilterNetModel {
+    shared: tract::SharedModel,
+}
+
+unsafe impl Send for DeepFilterNetModel {}
+unsafe impl Sync for DeepFilterNetModel {}
+
+// 加载模型：解压 tar.gz，读取配置和各 ONNX 文件的字节，只需执行一次
+// ONNX 的解析和优化在首次创建某一声道数的实例时进行，结果留在模型中供之后的实例共享
 #[no_mangle]
-pub extern "C" fn df_create(
-    tar_buf: *const u8,
-    tar_size: usize,
-    post_filter_beta: f32,
-    atten_lim_db: f32,
-) -> *mut DeepFilterNetState {
+pub extern "C" fn df_model_load(tar_buf: *const u8, tar_size: usize) -> *mut DeepFilterNetModel {
     unsafe {
         if tar_buf.is_null() {
             eprintln!("错误: tar_buf 为空");
@@ -36,35 +63,212 @@ pub extern "C" fn df_create(
         let tar_slice = std::slice::from_raw_parts(tar_buf, tar_size);
         let cursor = Cursor::new(tar_slice);
 
-        let df_params = match DfParams::from_targz(cursor) {
-            Ok(params) => params,
+        match tract::SharedModel::from_targz(cursor) {
+            Ok(shared) => Box::into_raw(Box::new(DeepFilterNetModel { shared })),
             Err(e) => {
                 eprintln!("加载模型失败: {:?}", e);
-                return std::ptr::null_mut();
+                std::ptr::null_mut()
             }
-        };
+        }
+    }
+}
 
-        let runtime_params = RuntimeParams::new(
-            1,                     // n_ch: 音频通道数（1=单声道）
-            post_filter_beta,      // post_filter_beta: 后滤波器 beta 参数（控制降噪强度，>0 启用后滤波）
-            atten_lim_db,          // atten_lim_db: 衰减限制（dB），控制最大降噪幅度
-            -10.,                  // min_db_thresh: 最小 dB 阈值，用于噪声检测
-            30.,                   // max_db_erb_thresh: ERB 解码器最大 dB 阈值
-            20.,                   // max_db_df_thresh: 深度滤波器最大 dB 阈值
-            ReduceMask::MEAN,      // reduce_mask: 掩码缩减方式（MEAN=平均值）
-        );
-
-        let df = match DfTract::new(df_params, &runtime_params) {
-            Ok(d) => d,
-            Err(e) => {
-                eprintln!("初始化 DfTract 失败: {:?}", e);
-                return std::ptr::null_mut();
-            }
-        };
+// 释放模型（已创建的实例各自持有共享计划的引用计数，可在任意时刻释放）
+#[no_mangle]
+pub extern "C" fn df_model_free(model: *mut DeepFilterNetModel) {
+    if !model.is_null() {
+        unsafe {
+            let _ = Box::from_raw(model);
+        }
+    }
+}
 
-        let state = Box::new(DeepFilterNetState { df });
-        Box::into_raw(state) as *mut DeepFilterNetState
+// 将 tar.gz 重新打包为不压缩的 gzip（stored 块），用于磁盘缓存
+// 缓存命中时 from_targz 的解压退化为内存复制；返回的缓冲区需用 df_free_buffer 释放
+#[no_mangle]
+pub extern "C" fn df_model_repack(
+    tar_buf: *const u8,
+    tar_size: usize,
+    out_size: *mut usize,
+) -> *mut u8 {
+    if tar_buf.is_null() || out_size.is_null() {
+        eprintln!("错误: 空指针参数");
+        return std::ptr::null_mut();
     }
+
+    let tar_slice = unsafe { std::slice::from_raw_parts(tar_buf, tar_size) };
+    let repacked = match repack_stored(tar_slice) {
+        Ok(bytes) => bytes.into_boxed_slice(),
+        Err(e) => {
+            eprintln!("重新打包模型失败: {:?}", e);
+            return std::ptr::null_mut();
+        }
+    };
+
+    unsafe {
+        *out_size = repacked.len();
+    }
+    Box::into_raw(repacked) as *mut u8
+}
+
+// 释放 df_model_repack 返回的缓冲区
+#[no_mangle]
+pub extern "C" fn df_free_buffer(buf: *mut u8, size: usize) {
+    if !buf.is_null() {
+        unsafe {
+            let _ = Box::from_raw(std::ptr::slice_from_raw_parts_mut(buf, size));
+        }
+    }
+}
+
+// 按精度（FP32/FP16/INT8）选择子网络并组装为标准格式的不压缩 tar.gz，结果可直接传给 df_model_load
+// variant_buf 可为空：变体只在主包中查找；非空时为同格式的变体包，优先于主包
+// 返回的缓冲区需用 df_free_buffer 释放；精度未知或缺少所选精度的子网络时返回空
+#[no_mangle]
+pub extern "C" fn df_model_select_precision(
+    tar_buf: *const u8,
+    tar_size: usize,
+    variant_buf: *const u8,
+    variant_size: usize,
+    precision: i32,
+    out_size: *mut usize,
+) -> *mut u8 {
+    if tar_buf.is_null() || out_size.is_null() {
+        eprintln!("错误: 空指针参数");
+        return std::ptr::null_mut();
+    }
+
+    let tar_slice = unsafe { std::slice::from_raw_parts(tar_buf, tar_size) };
+    let variant_slice = if variant_buf.is_null() || variant_size == 0 {
+        None
+    } else {
+        Some(unsafe { std::slice::from_raw_parts(variant_buf, variant_size) })
+    };
+
+    let selected = match precision::select(tar_slice, variant_slice, precision) {
+        Ok(bytes) => bytes.into_boxed_slice(),
+        Err(e) => {
+            eprintln!("选择模型精度失败: {:?}", e);
+            return std::ptr::null_mut();
+        }
+    };
+
+    unsafe {
+        *out_size = selected.len();
+    }
+    Box::into_raw(selected) as *mut u8
+}
+
+fn repack_stored(tar_gz: &[u8]) -> Result<Vec<u8>> {
+    let mut tar = Vec::new();
+    GzDecoder::new(tar_gz).read_to_end(&mut tar)?;
+
+    let mut encoder = GzEncoder::new(Vec::with_capacity(tar.len() + tar.len() / 1000 + 64), Compression::none());
+    encoder.write_all(&tar)?;
+    Ok(encoder.finish()?)
+}
+
+// 从已加载的模型创建实例（只构建每路流的运行时状态）
+#[no_mangle]
+pub extern "C" fn df_create_from_model(
+    model: *const DeepFilterNetModel,
+    post_filter_beta: f32,
+    atten_lim_db: f32,
+) -> *mut DeepFilterNetState {
+    df_create_from_model_ex(model, 1, post_filter_beta, atten_lim_db)
+}
+
+// 从已加载的模型创建多声道实例（tract 后端）
+// n_ch: 声道数（1..=MAX_CHANNELS），所有声道在同一次 Backend::process 中处理
+#[no_mangle]
+pub extern "C" fn df_create_from_model_ex(
+    model: *const DeepFilterNetModel,
+    n_ch: usize,
+    post_filter_beta: f32,
+    atten_lim_db: f32,
+) -> *mut DeepFilterNetState {
+    df_create_from_model_backend(model, n_ch, post_filter_beta, atten_lim_db, backend::BACKEND_TRACT)
+}
+
+// 从已加载的模型创建实例，并指定推理后端（DF_BACKEND_*）；后端不可用时返回空
+#[no_mangle]
+pub extern "C" fn df_create_from_model_backend(
+    model: *const DeepFilterNetModel,
+    n_ch: usize,
+    post_filter_beta: f32,
+    atten_lim_db: f32,
+    backend_id: i32,
+) -> *mut DeepFilterNetState {
+    if model.is_null() {
+        eprintln!("错误: model 为空");
+        return std::ptr::null_mut();
+    }
+
+    if n_ch == 0 || n_ch > MAX_CHANNELS {
+        eprintln!("错误: 声道数 {} 超出范围 1..={}", n_ch, MAX_CHANNELS);
+        return std::ptr::null_mut();
+    }
+
+    let model = unsafe { &*model };
+
+    let params = tract::InstanceParams {
+        n_ch,                                   // 音频通道数（1=单声道）
+        post_filter_beta,                       // 后滤波器 beta 参数（控制降噪强度，>0 启用后滤波）
+        atten_lim_db,                           // 衰减限制（dB），控制最大降噪幅度
+        min_db_thresh: -10.,                    // 最小 dB 阈值，用于噪声检测
+        max_db_erb_thresh: 30.,                 // ERB 解码器最大 dB 阈值
+        max_db_df_thresh: 20.,                  // 深度滤波器最大 dB 阈值
+    };
+
+    let df = match backend::create(backend_id, &model.shared, &params) {
+        Ok(d) => d,
+        Err(e) => {
+            eprintln!("初始化推理后端 {} 失败: {:?}", backend::name(backend_id), e);
+            return std::ptr::null_mut();
+        }
+    };
+
+    let hop_size = df.hop_size();
+    let planar_len = if n_ch > 1 { hop_size * n_ch } else { 0 };
+    Box::into_raw(Box::new(DeepFilterNetState {
+        df,
+        scratch_in: vec![0.0; hop_size * n_ch],
+        scratch_out: vec![0.0; hop_size * n_ch],
+        planar: PlanarScratch {
+            input: vec![0.0; planar_len],
+            output: vec![0.0; planar_len],
+        },
+    }))
+}
+
+// 创建 DeepFilterNet 实例（加载模型 + 创建实例，单实例场景使用）
+#[no_mangle]
+pub extern "C" fn df_create(
+    tar_buf: *const u8,
+    tar_size: usize,
+    post_filter_beta: f32,
+    atten_lim_db: f32,
+) -> *mut DeepFilterNetState {
+    df_create_ex(tar_buf, tar_size, 1, post_filter_beta, atten_lim_db)
+}
+
+// 创建多声道 DeepFilterNet 实例（加载模型 + 创建实例）
+#[no_mangle]
+pub extern "C" fn df_create_ex(
+    tar_buf: *const u8,
+    tar_size: usize,
+    n_ch: usize,
+    post_filter_beta: f32,
+    atten_lim_db: f32,
+) -> *mut DeepFilterNetState {
+    let model = df_model_load(tar_buf, tar_size);
+    if model.is_null() {
+        return std::ptr::null_mut();
+    }
+
+    let state = df_create_from_model_ex(model, n_ch, post_filter_beta, atten_lim_db);
+    df_model_free(model);
+    state
 }
 
 // 销毁 DeepFilterNet 实例
@@ -77,7 +281,54 @@ pub extern "C" fn df_destroy(state: *mut DeepFilterNetState) {
     }
 }
 
-// 处理音频帧
+// 处理单个 hop（内部实现，input/output 长度相同，多声道时为平面布局：声道 0 的 hop，声道 1 的 hop……）
+fn process_hop(df: &mut dyn Backend, input: &[f32], output: &mut [f32]) -> Result<f32> {
+    let n_ch = df.channels();
+    let n = input.len() / n_ch;
+    let input_array = ArrayView2::from_shape((n_ch, n), input)?;
+    let output_array = ArrayViewMut2::from_shape((n_ch, n), output)?;
+    df.process(input_array, output_array)
+}
+
+// 交织 -> 平面布局（planar 长度与 input 相同）
+fn deinterleave(input: &[f32], planar: &mut [f32], n_ch: usize) {
+    let frames = input.len() / n_ch;
+    for (c, plane) in planar.chunks_exact_mut(frames).enumerate() {
+        for (dst, src) in plane.iter_mut().zip(input[c..].iter().step_by(n_ch)) {
+            *dst = *src;
+        }
+    }
+}
+
+// 平面 -> 交织布局
+fn interleave(planar: &[f32], output: &mut [f32], n_ch: usize) {
+    let frames = planar.len() / n_ch;
+    for (c, plane) in planar.chunks_exact(frames).enumerate() {
+        for (dst, src) in output[c..].iter_mut().step_by(n_ch).zip(plane) {
+            *dst = *src;
+        }
+    }
+}
+
+// 处理单个交织布局的 hop（hop_size * n_ch 个采样），单声道时直接处理
+fn process_interleaved_hop(
+    df: &mut dyn Backend,
+    planar: &mut PlanarScratch,
+    input: &[f32],
+    output: &mut [f32],
+) -> Result<f32> {
+    if df.channels() == 1 {
+        return process_hop(df, input, output);
+    }
+    let n_ch = df.channels();
+    deinterleave(input, &mut planar.input, n_ch);
+    let lsnr = process_hop(df, &planar.input, &mut planar.output)?;
+    interleave(&planar.output, output, n_ch);
+    Ok(lsnr)
+}
+
+// 处理音频帧（frame_size 为采样点总数，多声道实例为平面布局，见 process_hop）
+// 返回 LSNR（噪声较大时为负）；失败返回 NaN
 #[no_mangle]
 pub extern "C" fn df_process_frame(
     state: *mut DeepFilterNetState,
@@ -88,31 +339,124 @@ pub extern "C" fn df_process_frame(
     unsafe {
         if state.is_null() || input.is_null() || output.is_null() {
             eprintln!("错误: 空指针参数");
-            return -1.0;
+            return f32::NAN;
         }
 
         let state = &mut *state;
         let input_slice = std::slice::from_raw_parts(input, frame_size);
         let output_slice = std::slice::from_raw_parts_mut(output, frame_size);
 
-        let input_array = ArrayView2::from_shape((1, frame_size), input_slice).unwrap();
-        let output_array = ArrayViewMut2::from_shape((1, frame_size), output_slice).unwrap();
+        match process_hop(state.df.as_mut(), input_slice, output_slice) {
+            Ok(lsnr) => lsnr,
+            Err(e) => {
+                eprintln!("处理帧失败: {:?}", e);
+                f32::NAN
+            }
+        }
+    }
+}
+
+// 批量处理多个 hop（一次 FFI 调用内循环调用 Backend::process）
+// n_samples: 采样点总数，必须是 hop_size * n_ch 的整数倍（多声道时每个 hop 为平面布局）
+// lsnr: 每个 hop 的 LSNR 输出数组（可为空，否则至少容纳 n_samples / (hop_size * n_ch) 个值）
+// 返回值: 成功处理的 hop 数；参数无效返回 -1；中途失败时返回已成功处理的 hop 数
+#[no_mangle]
+pub extern "C" fn df_process_frames(
+    state: *mut DeepFilterNetState,
+    input: *const f32,
+    output: *mut f32,
+    n_samples: usize,
+    lsnr: *mut f32,
+) -> i64 {
+    unsafe {
+        if state.is_null() || input.is_null() || output.is_null() {
+            eprintln!("错误: 空指针参数");
+            return -1;
+        }
+
+        let state = &mut *state;
+        let hop_size = state.df.hop_size() * state.df.channels();
+        if hop_size == 0 || n_samples % hop_size != 0 {
+            eprintln!("错误: 采样点数 {} 不是 hop_size * n_ch = {} 的整数倍", n_samples, hop_size);
+            return -1;
+        }
+
+        let n_hops = n_samples / hop_size;
+        let input_slice = std::slice::from_raw_parts(input, n_samples);
+        let output_slice = std::slice::from_raw_parts_mut(output, n_samples);
+        let mut lsnr_slice = if lsnr.is_null() {
+            None
+        } else {
+            Some(std::slice::from_raw_parts_mut(lsnr, n_hops))
+        };
+
+        let hops = input_slice
+            .chunks_exact(hop_size)
+            .zip(output_slice.chunks_exact_mut(hop_size))
+            .enumerate();
+        for (i, (hop_in, hop_out)) in hops {
+            match process_hop(state.df.as_mut(), hop_in, hop_out) {
+                Ok(v) => {
+                    if let Some(l) = lsnr_slice.as_deref_mut() {
+                        l[i] = v;
+                    }
+                }
+                Err(e) => {
+                    // 只在失败时记录一次，不在每个 hop 上打印
+                    eprintln!("处理第 {} 个 hop 失败: {:?}", i, e);
+                    if let Some(l) = lsnr_slice.as_deref_mut() {
+                        l[i] = f32::NAN;
+                    }
+                    return i as i64;
+                }
+            }
+        }
+
+        n_hops as i64
+    }
+}
+
+// 处理交织布局的多声道音频帧（如 AAudio/AudioRecord 的多声道采集数据）
+// n_frames: 每声道帧数，必须等于 hop_size；input/output 各 n_frames * n_ch 个采样
+// 单声道实例等同于 df_process_frame；返回 LSNR（噪声较大时为负），失败返回 NaN
+#[no_mangle]
+pub extern "C" fn df_process_frame_interleaved(
+    state: *mut DeepFilterNetState,
+    input: *const f32,
+    output: *mut f32,
+    n_frames: usize,
+) -> f32 {
+    unsafe {
+        if state.is_null() || input.is_null() || output.is_null() {
+            eprintln!("错误: 空指针参数");
+            return f32::NAN;
+        }
+
+        let state = &mut *state;
+        if n_frames != state.df.hop_size() {
+            eprintln!("错误: 帧数 {} 不等于 hop_size {}", n_frames, state.df.hop_size());
+            return f32::NAN;
+        }
 
-        match state.df.process(input_array, output_array) {
+        let n_samples = n_frames * state.df.channels();
+        let input_slice = std::slice::from_raw_parts(input, n_samples);
+        let output_slice = std::slice::from_raw_parts_mut(output, n_samples);
+
+        match process_interleaved_hop(state.df.as_mut(), &mut state.planar, input_slice, output_slice) {
             Ok(lsnr) => lsnr,
             Err(e) => {
                 eprintln!("处理帧失败: {:?}", e);
-                -1.0
+                f32::NAN
             }
         }
     }
 }
 
-// 设置后滤波器beta参数
+// 设置后滤波器beta参数（修改后端状态，不可与 df_process_frame* 并发调用）
 #[no_mangle]
 pub extern "C" fn df_set_post_filter_beta(state: *mut DeepFilterNetState, beta: f32) {
     unsafe {
-        if !state.is_null() {
+        if state.is_null() {
             eprintln!("错误: state指针为空");
             return;
         }
@@ -122,11 +466,11 @@ pub extern "C" fn df_set_post_filter_beta(state: *mut DeepFilterNetState, beta:
     }
 }
 
-// 设置衰减限制
+// 设置衰减限制（线程要求同上）
 #[no_mangle]
 pub extern "C" fn df_set_atten_lim(state: *mut DeepFilterNetState, lim_db: f32) {
     unsafe {
-        if !state.is_null() {
+        if state.is_null() {
             eprintln!("错误: state指针为空");
             return;
         }
@@ -146,16 +490,138 @@ pub extern "C" fn df_get_frame_size(state: *mut DeepFilterNetState) -> usize {
         }
         
         let state = &*state;
-        state.df.hop_size
+        state.df.hop_size()
+    }
+}
+
+// 获取声道数
+#[no_mangle]
+pub extern "C" fn df_get_channel_count(state: *mut DeepFilterNetState) -> usize {
+    unsafe {
+        if state.is_null() {
+            eprintln!("错误: state指针为空");
+            return 0;
+        }
+
+        let state = &*state;
+        state.df.channels()
+    }
+}
+
+// 获取实例使用的推理后端（DF_BACKEND_*），失败返回 -1
+#[no_mangle]
+pub extern "C" fn df_get_backend(state: *mut DeepFilterNetState) -> i32 {
+    unsafe {
+        if state.is_null() {
+            eprintln!("错误: state指针为空");
+            return -1;
+        }
+
+        let state = &*state;
+        state.df.id()
+    }
+}
+
+// 当前构建是否包含指定的推理后端（1-包含，0-不包含）
+#[no_mangle]
+pub extern "C" fn df_backend_available(backend_id: i32) -> i32 {
+    backend::available(backend_id) as i32
+}
+
+// 获取模型前瞻（hop 数）：max(conv_lookahead, df_lookahead)，零前瞻模型（如 DeepFilterNet3_ll）为 0
+#[no_mangle]
+pub extern "C" fn df_get_lookahead(state: *mut DeepFilterNetState) -> usize {
+    unsafe {
+        if state.is_null() {
+            eprintln!("错误: state指针为空");
+            return 0;
+        }
+
+        let state = &*state;
+        state.df.lookahead()
+    }
+}
+
+// 获取算法延迟（每声道采样点数，模型采样率）：输出相对输入的固定延迟
+// STFT 合成窗口重叠部分 (fft_size - hop_size) 加上前瞻 lookahead * hop_size，
+// 不含调用方攒满一个 hop 的分块延迟
+#[no_mangle]
+pub extern "C" fn df_get_algorithmic_delay(state: *mut DeepFilterNetState) -> usize {
+    unsafe {
+        if state.is_null() {
+            eprintln!("错误: state指针为空");
+            return 0;
+        }
+
+        let state = &*state;
+        algorithmic_delay(state.df.as_ref())
     }
 }
 
-// JNI: 创建实例
+fn algorithmic_delay(df: &dyn Backend) -> usize {
+    df.fft_size().saturating_sub(df.hop_size()) + df.lookahead() * df.hop_size()
+}
+
+// PCM16 -> f32（x / 32768），向量化实现
+#[no_mangle]
+pub extern "C" fn df_pcm16_to_f32(input: *const i16, output: *mut f32, n_samples: usize) {
+    if input.is_null() || output.is_null() {
+        eprintln!("错误: 空指针参数");
+        return;
+    }
+    unsafe {
+        let input_slice = std::slice::from_raw_parts(input as *const u8, n_samples * 2);
+        let output_slice = std::slice::from_raw_parts_mut(output, n_samples);
+        if cfg!(target_endian = "little") {
+            pcm::pcm16le_to_f32(input_slice, output_slice);
+        } else {
+            let samples = std::slice::from_raw_parts(input, n_samples);
+            for (dst, src) in output_slice.iter_mut().zip(samples) {
+                *dst = *src as f32 / 32768.0;
+            }
+        }
+    }
+}
+
+// f32 -> PCM16（饱和、就近取偶），向量化实现
+#[no_mangle]
+pub extern "C" fn df_f32_to_pcm16(input: *const f32, output: *mut i16, n_samples: usize) {
+    if input.is_null() || output.is_null() {
+        eprintln!("错误: 空指针参数");
+        return;
+    }
+    unsafe {
+        let input_slice = std::slice::from_raw_parts(input, n_samples);
+        let output_bytes = std::slice::from_raw_parts_mut(output as *mut u8, n_samples * 2);
+        pcm::f32_to_pcm16le(input_slice, output_bytes);
+        if cfg!(target_endian = "big") {
+            let samples = std::slice::from_raw_parts_mut(output, n_samples);
+            for sample in samples.iter_mut() {
+                *sample = i16::from_le(*sample);
+            }
+        }
+    }
+}
+
+// PCM 转换内核使用的向量指令集名称（"NEON"、"AVX2"、"SSE2" 或 "scalar"）
+#[no_mangle]
+pub extern "C" fn df_pcm_simd_name() -> *const std::os::raw::c_char {
+    let name: &'static [u8] = match pcm::simd_name() {
+        "NEON" => b"NEON\0",
+        "AVX2" => b"AVX2\0",
+        "SSE2" => b"SSE2\0",
+        _ => b"scalar\0",
+    };
+    name.as_ptr() as *const std::os::raw::c_char
+}
+
+// JNI: 创建实例（channels: 声道数，多声道时 nativeProcess/nativeProcessPcm16 的数据为交织布局）
 #[no_mangle]
 pub extern "system" fn Java_com_hzexe_audio_ns_DeepFilterNet_nativeCreate(
     env: JNIEnv,
     _class: JClass,
     tar_bytes: jbyteArray,
+    channels: jint,
     post_filter_beta: f32,
     atten_lim_db: f32,
 ) -> jlong {
@@ -167,7 +633,12 @@ pub extern "system" fn Java_com_hzexe_audio_ns_DeepFilterNet_nativeCreate(
         }
     };
 
-    let state_ptr = df_create(tar_buf.as_ptr(), tar_buf.len(), post_filter_beta, atten_lim_db);
+    if channels <= 0 {
+        eprintln!("错误: 声道数无效: {}", channels);
+        return 0;
+    }
+
+    let state_ptr = df_create_ex(tar_buf.as_ptr(), tar_buf.len(), channels as usize, post_filter_beta, atten_lim_db);
 
     if state_ptr.is_null() {
         0
@@ -176,6 +647,57 @@ pub extern "system" fn Java_com_hzexe_audio_ns_DeepFilterNet_nativeCreate(
     }
 }
 
+// JNI: 加载共享模型
+#[no_mangle]
+pub extern "system" fn Java_com_hzexe_audio_ns_DeepFilterNet_nativeLoadModel(
+    env: JNIEnv,
+    _class: JClass,
+    tar_bytes: jbyteArray,
+) -> jlong {
+    let tar_buf = match env.convert_byte_array(tar_bytes) {
+        Ok(buf) => buf,
+        Err(e) => {
+            eprintln!("转换字节数组失败: {:?}", e);
+            return 0;
+        }
+    };
+
+    df_model_load(tar_buf.as_ptr(), tar_buf.len()) as jlong
+}
+
+// JNI: 从共享模型创建实例
+#[no_mangle]
+pub extern "system" fn Java_com_hzexe_audio_ns_DeepFilterNet_nativeCreateFromModel(
+    _env: JNIEnv,
+    _class: JClass,
+    model_ptr: jlong,
+    channels: jint,
+    post_filter_beta: f32,
+    atten_lim_db: f32,
+) -> jlong {
+    if channels <= 0 {
+        eprintln!("错误: 声道数无效: {}", channels);
+        return 0;
+    }
+
+    df_create_from_model_ex(
+        model_ptr as *const DeepFilterNetModel,
+        channels as usize,
+        post_filter_beta,
+        atten_lim_db,
+    ) as jlong
+}
+
+// JNI: 释放共享模型
+#[no_mangle]
+pub extern "system" fn Java_com_hzexe_audio_ns_DeepFilterNet_nativeFreeModel(
+    _env: JNIEnv,
+    _class: JClass,
+    model_ptr: jlong,
+) {
+    df_model_free(model_ptr as *mut DeepFilterNetModel);
+}
+
 // JNI: 销毁实例
 #[no_mangle]
 pub extern "system" fn Java_com_hzexe_audio_ns_DeepFilterNet_nativeDestroy(
@@ -188,10 +710,67 @@ pub extern "system" fn Java_com_hzexe_audio_ns_DeepFilterNet_nativeDestroy(
     }
 }
 
-// JNI: 处理音频帧（优化版本 - 减少内存分配和复制）
+// JNI: 获取算法延迟（每声道采样点数）
+#[no_mangle]
+pub extern "system" fn Java_com_hzexe_audio_ns_DeepFilterNet_nativeGetAlgorithmicDelay(
+    _env: JNIEnv,
+    _class: JClass,
+    state_ptr: jlong,
+) -> jint {
+    if state_ptr == 0 {
+        return 0;
+    }
+    df_get_algorithmic_delay(state_ptr as *mut DeepFilterNetState) as jint
+}
+
+// 取直接缓冲区 [offset, offset + length) 区间的起始地址（越界或不是直接缓冲区时返回 None）
+fn direct_buffer_region(env: &JNIEnv, buffer: JByteBuffer, offset: jint, length: jint) -> Option<*mut u8> {
+    if offset < 0 || length < 0 {
+        return None;
+    }
+    let capacity = env.get_direct_buffer_capacity(buffer).unwrap_or(0);
+    if offset as usize + length as usize > capacity {
+        eprintln!("错误: 偏移量和长度超出缓冲区容量");
+        return None;
+    }
+    match env.get_direct_buffer_address(buffer) {
+        Ok(ptr) => Some(unsafe { ptr.add(offset as usize) }),
+        Err(e) => {
+            eprintln!("获取缓冲区地址失败: {}", e);
+            None
+        }
+    }
+}
+
+// 逐个交织布局的 hop 处理（hop_samples = hop_size * n_ch），返回最后一个 hop 的 LSNR（可以为负）
+fn process_hops(
+    df: &mut dyn Backend,
+    planar: &mut PlanarScratch,
+    input: &[f32],
+    output: &mut [f32],
+    hop_samples: usize,
+) -> Result<f32> {
+    let mut lsnr = 0.0;
+    for (hop_in, hop_out) in input.chunks_exact(hop_samples).zip(output.chunks_exact_mut(hop_samples)) {
+        lsnr = process_interleaved_hop(df, planar, hop_in, hop_out)?;
+    }
+    Ok(lsnr)
+}
+
+// 确保暂存区至少容纳 n 个采样（按需增长，稳态不再分配）
+fn ensure_scratch(state: &mut DeepFilterNetState, n: usize) {
+    if state.scratch_in.len() < n {
+        state.scratch_in.resize(n, 0.0);
+        state.scratch_out.resize(n, 0.0);
+    }
+}
+
+// JNI: 处理音频帧（f32 小端）
 // input_offset: 输入数组起始偏移量（字节）
-// input_length: 输入数组有效长度（字节）
+// input_length: 输入数组有效长度（字节），必须是 hop_size * n_ch * 4 的整数倍（多声道为交织布局）
 // output_offset: 输出数组起始偏移量（字节）
+// 多个 hop 时逐个处理，返回最后一个 hop 的 LSNR（噪声较大时为负）；失败返回 NaN
+// 小端平台上输入输出按 4 字节对齐且互不重叠时直接在直接缓冲区上处理，不经过暂存区
 #[no_mangle]
 pub extern "system" fn Java_com_hzexe_audio_ns_DeepFilterNet_nativeProcess(
     env: JNIEnv,
@@ -206,78 +785,147 @@ pub extern "system" fn Java_com_hzexe_audio_ns_DeepFilterNet_nativeProcess(
 ) -> f32 {
     if state_ptr == 0 {
         eprintln!("错误: 状态指针为空");
-        return -1.0;
+        return f32::NAN;
     }
 
     if input_length != output_length {
         eprintln!("错误: 输入和输出长度不匹配");
-        return -1.0;
+        return f32::NAN;
     }
 
-    if input_length % 4 != 0 {
-        eprintln!("错误: 长度必须是 4 的倍数");
-        return -1.0;
+    if input_length <= 0 || input_length % 4 != 0 {
+        eprintln!("错误: 长度必须是 4 的正整数倍");
+        return f32::NAN;
     }
 
+    let state = unsafe { &mut *(state_ptr as *mut DeepFilterNetState) };
+    let hop_size = state.df.hop_size() * state.df.channels();
     let frame_size = (input_length / 4) as usize;
+    if hop_size == 0 || frame_size % hop_size != 0 {
+        eprintln!("错误: 采样点数 {} 不是 hop_size * n_ch = {} 的整数倍", frame_size, hop_size);
+        return f32::NAN;
+    }
 
-    let input_ptr = match env.get_direct_buffer_address(input) {
-        Ok(ptr) => ptr,
-        Err(e) => {
-            eprintln!("获取输入缓冲区地址失败: {}", e);
-            return -1.0;
-        }
+    let (input_ptr, output_ptr) = match (
+        direct_buffer_region(&env, input, input_offset, input_length),
+        direct_buffer_region(&env, output, output_offset, output_length),
+    ) {
+        (Some(i), Some(o)) => (i, o),
+        _ => return f32::NAN,
     };
 
-    let output_ptr = match env.get_direct_buffer_address(output) {
-        Ok(ptr) => ptr,
+    let byte_length = input_length as usize;
+    let aligned = (input_ptr as usize) % std::mem::align_of::<f32>() == 0
+        && (output_ptr as usize) % std::mem::align_of::<f32>() == 0;
+    let overlapping = (input_ptr as usize) < (output_ptr as usize) + byte_length
+        && (output_ptr as usize) < (input_ptr as usize) + byte_length;
+
+    if cfg!(target_endian = "little") && aligned && !overlapping {
+        let input_samples = unsafe { std::slice::from_raw_parts(input_ptr as *const f32, frame_size) };
+        let output_samples = unsafe { std::slice::from_raw_parts_mut(output_ptr as *mut f32, frame_size) };
+        return match process_hops(state.df.as_mut(), &mut state.planar, input_samples, output_samples, hop_size) {
+            Ok(lsnr) => lsnr,
+            Err(e) => {
+                eprintln!("处理帧失败: {:?}", e);
+                f32::NAN
+            }
+        };
+    }
+
+    let input_bytes = unsafe { std::slice::from_raw_parts(input_ptr as *const u8, byte_length) };
+    ensure_scratch(state, frame_size);
+    pcm::f32le_to_f32(input_bytes, &mut state.scratch_in[..frame_size]);
+
+    // LSNR 在噪声较大时本身为负（约 -15..35 dB），只有处理出错才不写输出
+    let lsnr = match process_hops(
+        state.df.as_mut(),
+        &mut state.planar,
+        &state.scratch_in[..frame_size],
+        &mut state.scratch_out[..frame_size],
+        hop_size,
+    ) {
+        Ok(lsnr) => lsnr,
         Err(e) => {
-            eprintln!("获取输出缓冲区地址失败: {}", e);
-            return -1.0;
+            eprintln!("处理帧失败: {:?}", e);
+            return f32::NAN;
         }
     };
 
-    let input_bytes = unsafe {
-        std::slice::from_raw_parts(
-            input_ptr.offset(input_offset as isize),
-            input_length as usize,
-        )
-    };
+    let output_bytes = unsafe { std::slice::from_raw_parts_mut(output_ptr, byte_length) };
+    pcm::f32_to_f32le(&state.scratch_out[..frame_size], output_bytes);
+    lsnr
+}
 
-    let output_bytes = unsafe {
-        std::slice::from_raw_parts_mut(
-            output_ptr.offset(output_offset as isize),
-            output_length as usize,
-        )
-    };
+// JNI: 处理音频帧（PCM16 小端，如 AudioRecord 的 ENCODING_PCM_16BIT）
+// input_length: 输入有效长度（字节），必须是 hop_size * n_ch * 2 的整数倍（多声道为交织布局）
+// 输入向量化转换为 f32 后处理，结果向量化转换回 PCM16（饱和）写入输出；输入输出可以是同一区间
+// 返回最后一个 hop 的 LSNR（噪声较大时为负）；失败返回 NaN
+#[no_mangle]
+pub extern "system" fn Java_com_hzexe_audio_ns_DeepFilterNet_nativeProcessPcm16(
+    env: JNIEnv,
+    _class: JClass,
+    state_ptr: jlong,
+    input: JByteBuffer,
+    input_offset: jint,
+    input_length: jint,
+    output: JByteBuffer,
+    output_offset: jint,
+    output_length: jint,
+) -> f32 {
+    if state_ptr == 0 {
+        eprintln!("错误: 状态指针为空");
+        return f32::NAN;
+    }
 
-    let mut input_f32: [f32; 512] = [0.0; 512];
-    let mut output_f32: [f32; 512] = [0.0; 512];
+    if input_length != output_length {
+        eprintln!("错误: 输入和输出长度不匹配");
+        return f32::NAN;
+    }
+
+    if input_length <= 0 || input_length % 2 != 0 {
+        eprintln!("错误: 长度必须是 2 的正整数倍");
+        return f32::NAN;
+    }
 
-    for i in 0..frame_size {
-        let bytes: [u8; 4] = [
-            input_bytes[i * 4] as u8,
-            input_bytes[i * 4 + 1] as u8,
-            input_bytes[i * 4 + 2] as u8,
-            input_bytes[i * 4 + 3] as u8,
-        ];
-        input_f32[i] = f32::from_le_bytes(bytes);
+    let state = unsafe { &mut *(state_ptr as *mut DeepFilterNetState) };
+    let hop_size = state.df.hop_size() * state.df.channels();
+    let frame_size = (input_length / 2) as usize;
+    if hop_size == 0 || frame_size % hop_size != 0 {
+        eprintln!("错误: 采样点数 {} 不是 hop_size * n_ch = {} 的整数倍", frame_size, hop_size);
+        return f32::NAN;
     }
 
-    let lsnr = df_process_frame(
-        state_ptr as *mut DeepFilterNetState,
-        input_f32.as_ptr(),
-        output_f32.as_mut_ptr(),
-        frame_size,
-    );
+    let (input_ptr, output_ptr) = match (
+        direct_buffer_region(&env, input, input_offset, input_length),
+        direct_buffer_region(&env, output, output_offset, output_length),
+    ) {
+        (Some(i), Some(o)) => (i, o),
+        _ => return f32::NAN,
+    };
 
-    for i in 0..frame_size {
-        let bytes = output_f32[i].to_le_bytes();
-        output_bytes[i * 4] = bytes[0];
-        output_bytes[i * 4 + 1] = bytes[1];
-        output_bytes[i * 4 + 2] = bytes[2];
-        output_bytes[i * 4 + 3] = bytes[3];
+    let byte_length = input_length as usize;
+    ensure_scratch(state, frame_size);
+    {
+        let input_bytes = unsafe { std::slice::from_raw_parts(input_ptr as *const u8, byte_length) };
+        pcm::pcm16le_to_f32(input_bytes, &mut state.scratch_in[..frame_size]);
     }
 
+    // LSNR 在噪声较大时本身为负（约 -15..35 dB），只有处理出错才不写输出
+    let lsnr = match process_hops(
+        state.df.as_mut(),
+        &mut state.planar,
+        &state.scratch_in[..frame_size],
+        &mut state.scratch_out[..frame_size],
+        hop_size,
+    ) {
+        Ok(lsnr) => lsnr,
+        Err(e) => {
+            eprintln!("处理帧失败: {:?}", e);
+            return f32::NAN;
+        }
+    };
+
+    let output_bytes = unsafe { std::slice::from_raw_parts_mut(output_ptr, byte_length) };
+    pcm::f32_to_pcm16le(&state.scratch_out[..frame_size], output_bytes);
     lsnr
 }
@@ -0,0 +1,275 @@
+// PCM 格式转换内核（JNI 直接缓冲区 <-> 模型使用的 f32）
+//
+// - PCM16 <-> f32：aarch64 使用 NEON，x86_64 使用 AVX2（运行时检测）或 SSE2，其他平台逐点转换
+// - 所有实现结果逐位一致：PCM16 -> f32 为 x / 32768；f32 -> PCM16 为 x * 32768 饱和到 [-32768, 32767]
+//   后按四舍六入五成双取整（NaN 转换为 -32768）
+// - f32 小端字节序在小端平台上就是内存布局，直接复制
+
+#[cfg(target_arch = "x86_64")]
+use std::arch::x86_64::*;
+
+#[cfg(all(target_arch = "aarch64", target_endian = "little"))]
+use std::arch::aarch64::*;
+
+const PCM16_SCALE: f32 = 32768.0;
+const PCM16_INV_SCALE: f32 = 1.0 / 32768.0;
+const PCM16_MIN: f32 = -32768.0;
+const PCM16_MAX: f32 = 32767.0;
+
+// 当前平台使用的向量指令集
+#[cfg(target_arch = "x86_64")]
+pub fn simd_name() -> &'static str {
+    if is_x86_feature_detected!("avx2") {
+        "AVX2"
+    } else {
+        "SSE2"
+    }
+}
+
+#[cfg(all(target_arch = "aarch64", target_endian = "little"))]
+pub fn simd_name() -> &'static str {
+    "NEON"
+}
+
+#[cfg(not(any(target_arch = "x86_64", all(target_arch = "aarch64", target_endian = "little"))))]
+pub fn simd_name() -> &'static str {
+    "scalar"
+}
+
+// PCM16（小端字节）-> f32，转换 min(src.len() / 2, dst.len()) 个采样
+pub fn pcm16le_to_f32(src: &[u8], dst: &mut [f32]) {
+    let n = dst.len().min(src.len() / 2);
+    unsafe { pcm16_to_f32_raw(src.as_ptr(), dst.as_mut_ptr(), n) }
+}
+
+// f32 -> PCM16（小端字节），转换 min(src.len(), dst.len() / 2) 个采样
+pub fn f32_to_pcm16le(src: &[f32], dst: &mut [u8]) {
+    let n = src.len().min(dst.len() / 2);
+    unsafe { f32_to_pcm16_raw(src.as_ptr(), dst.as_mut_ptr(), n) }
+}
+
+// f32（小端字节）-> f32
+pub fn f32le_to_f32(src: &[u8], dst: &mut [f32]) {
+    let n = dst.len().min(src.len() / 4);
+    if cfg!(target_endian = "little") {
+        unsafe { std::ptr::copy_nonoverlapping(src.as_ptr(), dst.as_mut_ptr() as *mut u8, n * 4) }
+    } else {
+        for (sample, bytes) in dst[..n].iter_mut().zip(src.chunks_exact(4)) {
+            *sample = f32::from_le_bytes([bytes[0], bytes[1], bytes[2], bytes[3]]);
+        }
+    }
+}
+
+// f32 -> f32（小端字节）
+pub fn f32_to_f32le(src: &[f32], dst: &mut [u8]) {
+    let n = src.len().min(dst.len() / 4);
+    if cfg!(target_endian = "little") {
+        unsafe { std::ptr::copy_nonoverlapping(src.as_ptr() as *const u8, dst.as_mut_ptr(), n * 4) }
+    } else {
+        for (sample, bytes) in src[..n].iter().zip(dst.chunks_exact_mut(4)) {
+            bytes.copy_from_slice(&sample.to_le_bytes());
+        }
+    }
+}
+
+// 单个采样 f32 -> PCM16（向量实现的参考语义）
+#[inline]
+fn f32_to_pcm16_sample(x: f32) -> i16 {
+    let scaled = x * PCM16_SCALE;
+    // 比较为假（含 NaN）时取下限，与 SSE maxps / NEON fmaxnm 的行为一致
+    let clamped = if scaled >= PCM16_MIN { scaled } else { PCM16_MIN };
+    let clamped = if clamped <= PCM16_MAX { clamped } else { PCM16_MAX };
+    clamped.round_ties_even() as i16
+}
+
+// src 指向 n 个小端 i16（不要求对齐）
+unsafe fn pcm16_to_f32_raw(src: *const u8, dst: *mut f32, n: usize) {
+    #[cfg(target_arch = "x86_64")]
+    let done = if is_x86_feature_detected!("avx2") {
+        pcm16_to_f32_avx2(src, dst, n)
+    } else {
+        pcm16_to_f32_sse2(src, dst, n)
+    };
+    #[cfg(all(target_arch = "aarch64", target_endian = "little"))]
+    let done = pcm16_to_f32_neon(src, dst, n);
+    #[cfg(not(any(target_arch = "x86_64", all(target_arch = "aarch64", target_endian = "little"))))]
+    let done = 0;
+
+    for i in done..n {
+        let value = i16::from_le_bytes([*src.add(i * 2), *src.add(i * 2 + 1)]);
+        *dst.add(i) = value as f32 * PCM16_INV_SCALE;
+    }
+}
+
+// dst 指向 n 个小端 i16（不要求对齐）
+unsafe fn f32_to_pcm16_raw(src: *const f32, dst: *mut u8, n: usize) {
+    #[cfg(target_arch = "x86_64")]
+    let done = if is_x86_feature_detected!("avx2") {
+        f32_to_pcm16_avx2(src, dst, n)
+    } else {
+        f32_to_pcm16_sse2(src, dst, n)
+    };
+    #[cfg(all(target_arch = "aarch64", target_endian = "little"))]
+    let done = f32_to_pcm16_neon(src, dst, n);
+    #[cfg(not(any(target_arch = "x86_64", all(target_arch = "aarch64", target_endian = "little"))))]
+    let done = 0;
+
+    for i in done..n {
+        let bytes = f32_to_pcm16_sample(*src.add(i)).to_le_bytes();
+        *dst.add(i * 2) = bytes[0];
+        *dst.add(i * 2 + 1) = bytes[1];
+    }
+}
+
+// 以下向量实现返回已转换的采样数，余下不足一个向量的部分由调用方逐点处理
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "sse2")]
+unsafe fn pcm16_to_f32_sse2(src: *const u8, dst: *mut f32, n: usize) -> usize {
+    let scale = _mm_set1_ps(PCM16_INV_SCALE);
+    let mut i = 0;
+    while i + 8 <= n {
+        let v = _mm_loadu_si128(src.add(i * 2) as *const __m128i);
+        // 复制到高 16 位后算术右移完成符号扩展
+        let lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        let hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(dst.add(i), _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst.add(i + 4), _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+        i += 8;
+    }
+    i
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2")]
+unsafe fn pcm16_to_f32_avx2(src: *const u8, dst: *mut f32, n: usize) -> usize {
+    let scale = _mm256_set1_ps(PCM16_INV_SCALE);
+    let mut i = 0;
+    while i + 16 <= n {
+        let lo = _mm256_cvtepi16_epi32(_mm_loadu_si128(src.add(i * 2) as *const __m128i));
+        let hi = _mm256_cvtepi16_epi32(_mm_loadu_si128(src.add(i * 2 + 16) as *const __m128i));
+        _mm256_storeu_ps(dst.add(i), _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+        _mm256_storeu_ps(dst.add(i + 8), _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+        i += 16;
+    }
+    i
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "sse2")]
+unsafe fn f32_to_pcm16_sse2(src: *const f32, dst: *mut u8, n: usize) -> usize {
+    let scale = _mm_set1_ps(PCM16_SCALE);
+    let min = _mm_set1_ps(PCM16_MIN);
+    let max = _mm_set1_ps(PCM16_MAX);
+    let mut i = 0;
+    while i + 8 <= n {
+        // maxps 在任一操作数为 NaN 时返回第二个操作数，NaN 被钳到下限
+        let a = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src.add(i)), scale), min), max);
+        let b = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src.add(i + 4)), scale), min), max);
+        // 默认 MXCSR 舍入模式为最近偶数
+        let packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128(dst.add(i * 2) as *mut __m128i, packed);
+        i += 8;
+    }
+    i
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2")]
+unsafe fn f32_to_pcm16_avx2(src: *const f32, dst: *mut u8, n: usize) -> usize {
+    let scale = _mm256_set1_ps(PCM16_SCALE);
+    let min = _mm256_set1_ps(PCM16_MIN);
+    let max = _mm256_set1_ps(PCM16_MAX);
+    let mut i = 0;
+    while i + 16 <= n {
+        let a = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src.add(i)), scale), min), max);
+        let b = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src.add(i + 8)), scale), min), max);
+        // packs 按 128 位通道交错，重排 64 位块恢复顺序
+        let packed = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+        let ordered = _mm256_permute4x64_epi64(packed, 0xD8);
+        _mm256_storeu_si256(dst.add(i * 2) as *mut __m256i, ordered);
+        i += 16;
+    }
+    i
+}
+
+#[cfg(all(target_arch = "aarch64", target_endian = "little"))]
+unsafe fn pcm16_to_f32_neon(src: *const u8, dst: *mut f32, n: usize) -> usize {
+    let mut i = 0;
+    while i + 8 <= n {
+        // 按字节加载，不要求 i16 对齐
+        let v = vreinterpretq_s16_u8(vld1q_u8(src.add(i * 2)));
+        let lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+        let hi = vcvtq_f32_s32(vmovl_high_s16(v));
+        vst1q_f32(dst.add(i), vmulq_n_f32(lo, PCM16_INV_SCALE));
+        vst1q_f32(dst.add(i + 4), vmulq_n_f32(hi, PCM16_INV_SCALE));
+        i += 8;
+    }
+    i
+}
+
+#[cfg(all(target_arch = "aarch64", target_endian = "little"))]
+unsafe fn f32_to_pcm16_neon(src: *const f32, dst: *mut u8, n: usize) -> usize {
+    let min = vdupq_n_f32(PCM16_MIN);
+    let max = vdupq_n_f32(PCM16_MAX);
+    let mut i = 0;
+    while i + 8 <= n {
+        // fmaxnm 在一个操作数为 NaN 时返回另一个操作数，与 SSE 路径一致
+        let a = vminq_f32(vmaxnmq_f32(vmulq_n_f32(vld1q_f32(src.add(i)), PCM16_SCALE), min), max);
+        let b = vminq_f32(vmaxnmq_f32(vmulq_n_f32(vld1q_f32(src.add(i + 4)), PCM16_SCALE), min), max);
+        let packed = vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(a)), vqmovn_s32(vcvtnq_s32_f32(b)));
+        vst1q_u8(dst.add(i * 2), vreinterpretq_u8_s16(packed));
+        i += 8;
+    }
+    i
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn pcm16_to_f32_matches_scalar() {
+        // 全部 65536 个取值，长度不是向量宽度的整数倍以覆盖尾部
+        let values: Vec<i16> = (i16::MIN..=i16::MAX).collect();
+        let bytes: Vec<u8> = values.iter().flat_map(|v| v.to_le_bytes()).collect();
+        let mut converted = vec![0.0f32; values.len() - 3];
+        pcm16le_to_f32(&bytes[6..], &mut converted);
+        for (i, sample) in converted.iter().enumerate() {
+            assert_eq!(*sample, values[i + 3] as f32 / 32768.0);
+        }
+    }
+
+    #[test]
+    fn f32_to_pcm16_matches_scalar() {
+        let mut input = vec![
+            0.0, -0.0, 1.0, -1.0, 1.5, -1.5, 1e9, -1e9, f32::INFINITY, f32::NEG_INFINITY, f32::NAN,
+            0.5 / 32768.0, 1.5 / 32768.0, 2.5 / 32768.0, -0.5 / 32768.0, -2.5 / 32768.0,
+            32767.5 / 32768.0, -32768.5 / 32768.0,
+        ];
+        for i in 0..10007 {
+            input.push(((i as f32) * 0.37).sin() * 1.2);
+        }
+        let mut bytes = vec![0u8; input.len() * 2];
+        f32_to_pcm16le(&input, &mut bytes);
+        for (i, x) in input.iter().enumerate() {
+            let actual = i16::from_le_bytes([bytes[i * 2], bytes[i * 2 + 1]]);
+            assert_eq!(actual, f32_to_pcm16_sample(*x), "input {}", x);
+        }
+        assert_eq!(f32_to_pcm16_sample(1.0), 32767);
+        assert_eq!(f32_to_pcm16_sample(-1.0), -32768);
+        assert_eq!(f32_to_pcm16_sample(f32::NAN), -32768);
+        assert_eq!(f32_to_pcm16_sample(2.5 / 32768.0), 2);
+    }
+
+    #[test]
+    fn f32le_round_trip() {
+        let input: Vec<f32> = (0..1001).map(|i| i as f32 * 0.25 - 100.0).collect();
+        let mut bytes = vec![0u8; input.len() * 4];
+        f32_to_f32le(&input, &mut bytes);
+        assert_eq!(&bytes[4..8], &input[1].to_le_bytes());
+        let mut output = vec![0.0f32; input.len()];
+        f32le_to_f32(&bytes, &mut output);
+        assert_eq!(input, output);
+    }
+}
@@ -0,0 +1,91 @@
+// 模型精度变体选择
+//
+// - 模型 tar.gz 中 FP32 子网络为 enc.onnx / erb_dec.onnx / df_dec.onnx；
+//   量化变体按后缀命名：enc_fp16.onnx、erb_dec_int8.onnx 等，可放在同一个 tar.gz 中，
+//   也可单独打包为同格式的 tar.gz（变体包，只含 .onnx，优先于主包中的同名文件）
+// - 选择结果重新打包为标准文件名（config.ini + enc.onnx / erb_dec.onnx / df_dec.onnx）的
+//   不压缩 tar.gz，可直接交给 df_model_load，也可原样写入磁盘缓存
+// - 三个子网络必须都有所选精度的变体，缺任何一个都返回错误，不会静默混用精度
+
+use std::io::Read;
+
+use anyhow::{anyhow, Result};
+use flate2::Compression;
+use flate2::read::GzDecoder;
+use flate2::write::GzEncoder;
+
+// 与 deepfilter_ort.h 中的 DF_PRECISION_* 一致
+pub const PRECISION_FP32: i32 = 0;
+pub const PRECISION_FP16: i32 = 1;
+pub const PRECISION_INT8: i32 = 2;
+
+const CONFIG_NAME: &str = "config.ini";
+const NETWORKS: [&str; 3] = ["enc", "erb_dec", "df_dec"];
+
+fn suffix(precision: i32) -> Option<&'static str> {
+    match precision {
+        PRECISION_FP32 => Some(""),
+        PRECISION_FP16 => Some("_fp16"),
+        PRECISION_INT8 => Some("_int8"),
+        _ => None,
+    }
+}
+
+// 读出 tar.gz 中的所有普通文件（按文件名，忽略目录层级）
+fn read_entries(tar_gz: &[u8]) -> Result<Vec<(String, Vec<u8>)>> {
+    let mut archive = tar::Archive::new(GzDecoder::new(tar_gz));
+    let mut entries = Vec::new();
+    for entry in archive.entries()? {
+        let mut entry = entry?;
+        if !entry.header().entry_type().is_file() {
+            continue;
+        }
+        let name = match entry.path()?.file_name().and_then(|n| n.to_str()) {
+            Some(n) => n.to_owned(),
+            None => continue,
+        };
+        let mut data = Vec::with_capacity(entry.size() as usize);
+        entry.read_to_end(&mut data)?;
+        entries.push((name, data));
+    }
+    Ok(entries)
+}
+
+fn append(builder: &mut tar::Builder<GzEncoder<Vec<u8>>>, name: &str, data: &[u8]) -> Result<()> {
+    let mut header = tar::Header::new_gnu();
+    header.set_size(data.len() as u64);
+    header.set_mode(0o644);
+    header.set_cksum();
+    builder.append_data(&mut header, name, data)?;
+    Ok(())
+}
+
+// 按精度组装模型：config.ini 取自主包，子网络优先取变体包
+pub fn select(tar_gz: &[u8], variant_gz: Option<&[u8]>, precision: i32) -> Result<Vec<u8>> {
+    let suffix = suffix(precision).ok_or_else(|| anyhow!("未知的模型精度: {}", precision))?;
+
+    let base = read_entries(tar_gz)?;
+    let variant = match variant_gz {
+        Some(bytes) => read_entries(bytes)?,
+        None => Vec::new(),
+    };
+
+    let config = base
+        .iter()
+        .find(|(name, _)| name == CONFIG_NAME)
+        .ok_or_else(|| anyhow!("模型中缺少 {}", CONFIG_NAME))?;
+
+    let total: usize = base.iter().chain(variant.iter()).map(|(_, data)| data.len()).sum();
+    let mut builder = tar::Builder::new(GzEncoder::new(Vec::with_capacity(total + 16 * 1024), Compression::none()));
+    append(&mut builder, CONFIG_NAME, &config.1)?;
+    for net in NETWORKS.iter() {
+        let wanted = format!("{}{}.onnx", net, suffix);
+        let (_, data) = variant
+            .iter()
+            .chain(base.iter())
+            .find(|(name, _)| *name == wanted)
+            .ok_or_else(|| anyhow!("模型中缺少 {}（精度 {}）", wanted, precision))?;
+        append(&mut builder, &format!("{}.onnx", net), data)?;
+    }
+    Ok(builder.into_inner()?.finish()?)
+}
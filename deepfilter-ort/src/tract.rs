@@ -0,0 +1,463 @@
+// tract 推理：优化后的计划在模型内共享，实例只持有各自的运行状态
+//
+// - 按 libDF tract.rs 的 DfTract 移植：网络输入形状、流式（pulse）转换、LSNR 分级、
+//   ERB 掩码、深度滤波、后滤波和衰减限制与其一致
+// - DfTract::new 按值接收 DfParams，每个实例都要重新解析、优化和流式转换三个子网络；
+//   这里把这一步移到 SharedModel::plans，同一模型、同一声道数只做一次，
+//   计划放在 Arc 中由各实例的 SimpleState 共享
+// - 每个实例只分配 SimpleState、各声道的 DFState（STFT 缓冲和归一化状态）和滚动频谱缓冲
+// - 声道数是网络输入形状的一部分，计划按声道数分别缓存
+
+use std::collections::VecDeque;
+use std::io::{Cursor, Read};
+use std::sync::{Arc, Mutex};
+
+use anyhow::{anyhow, bail, Context, Result};
+use df::{apply_interp_band_gain, calc_norm_alpha, Complex32, DFState};
+use flate2::read::GzDecoder;
+use ini::Ini;
+use ndarray::prelude::*;
+use tract_hir::shapefactoid;
+use tract_onnx::prelude::*;
+use tract_pulse::model::PulsedModel;
+
+use crate::backend::{Backend, BACKEND_TRACT};
+
+type Plan = SimplePlan<TypedFact, Box<dyn TypedOp>, TypedModel>;
+type PlanState = SimpleState<TypedFact, Box<dyn TypedOp>, TypedModel, Arc<Plan>>;
+
+// 创建实例的运行参数（与 libDF 的 RuntimeParams 一致；多声道的 ERB 掩码固定按 MEAN 合并）
+pub struct InstanceParams {
+    pub n_ch: usize,
+    pub post_filter_beta: f32,
+    pub atten_lim_db: f32,
+    pub min_db_thresh: f32,
+    pub max_db_erb_thresh: f32,
+    pub max_db_df_thresh: f32,
+}
+
+// config.ini 中与推理相关的参数
+#[derive(Clone)]
+struct ModelConfig {
+    sr: usize,
+    fft_size: usize,
+    hop_size: usize,
+    nb_erb: usize,
+    nb_df: usize,
+    min_nb_freqs: usize,
+    df_order: usize,
+    conv_lookahead: usize,
+    df_lookahead: usize,
+    conv_ch: usize,
+    alpha: f32,
+}
+
+fn get<T: std::str::FromStr>(config: &Ini, sections: &[&str], key: &str) -> Result<T>
+where
+    T::Err: std::error::Error + Send + Sync + 'static,
+{
+    for section in sections {
+        if let Some(value) = config.section(Some(*section)).and_then(|s| s.get(key)) {
+            return value.parse::<T>().with_context(|| format!("config.ini 中 {} 无效: {}", key, value));
+        }
+    }
+    bail!("config.ini 缺少 {}", key)
+}
+
+impl ModelConfig {
+    fn parse(config: &Ini) -> Result<Self> {
+        const DF: &[&str] = &["df"];
+        const NET: &[&str] = &["deepfilternet"];
+        const ANY: &[&str] = &["df", "deepfilternet"];
+        let sr = get(config, DF, "sr")?;
+        let hop_size = get(config, DF, "hop_size")?;
+        let alpha = match get::<f32>(config, DF, "norm_alpha") {
+            Ok(alpha) => alpha,
+            Err(_) => calc_norm_alpha(sr, hop_size, get(config, DF, "norm_tau")?),
+        };
+        Ok(Self {
+            sr,
+            fft_size: get(config, DF, "fft_size")?,
+            hop_size,
+            nb_erb: get(config, DF, "nb_erb")?,
+            nb_df: get(config, DF, "nb_df")?,
+            min_nb_freqs: get(config, DF, "min_nb_erb_freqs")?,
+            df_order: get(config, ANY, "df_order")?,
+            conv_lookahead: get(config, NET, "conv_lookahead")?,
+            df_lookahead: get(config, ANY, "df_lookahead")?,
+            conv_ch: get(config, NET, "conv_ch")?,
+            alpha,
+        })
+    }
+
+    fn lookahead(&self) -> usize {
+        self.conv_lookahead.max(self.df_lookahead)
+    }
+}
+
+// 流式转换并优化：每次调用输入一帧
+fn pulse(mut model: InferenceModel) -> Result<Arc<Plan>> {
+    model.analyse(true)?;
+    let mut model = model.into_typed()?;
+    model.declutter()?;
+    let pulsed = PulsedModel::new(&model, 1)?;
+    let optimized = pulsed.into_typed()?.into_optimized()?;
+    Ok(Arc::new(SimplePlan::new(optimized)?))
+}
+
+fn read_onnx(bytes: &[u8]) -> Result<InferenceModel> {
+    tract_onnx::onnx()
+        .with_ignore_output_shapes(true)
+        .model_for_read(&mut Cursor::new(bytes))
+}
+
+// 某一声道数下三个子网络的优化后计划（不可变，由实例共享）
+struct Plans {
+    n_ch: usize,
+    enc: Arc<Plan>,
+    erb_dec: Arc<Plan>,
+    df_dec: Arc<Plan>,
+}
+
+impl Plans {
+    fn build(files: &ModelFiles, cfg: &ModelConfig, n_ch: usize) -> Result<Self> {
+        let s = tract_pulse::fact::stream_dim();
+        let f32_fact = |shape| InferenceFact::dt_shape(f32::datum_type(), shape);
+        let n_hidden = cfg.conv_ch * cfg.nb_erb / 4;
+
+        let enc = read_onnx(&files.enc)?
+            .with_input_fact(0, f32_fact(shapefactoid!(n_ch, 1, s, (cfg.nb_erb))))?
+            .with_input_fact(1, f32_fact(shapefactoid!(n_ch, 2, s, (cfg.nb_df))))?
+            .with_input_names(["feat_erb", "feat_spec"])?
+            .with_output_names(["e0", "e1", "e2", "e3", "emb", "c0", "lsnr"])?;
+
+        let erb_dec = read_onnx(&files.erb_dec)?
+            .with_input_fact(0, f32_fact(shapefactoid!(n_ch, s, n_hidden)))?
+            .with_input_fact(1, f32_fact(shapefactoid!(n_ch, (cfg.conv_ch), s, (cfg.nb_erb / 4))))?
+            .with_input_fact(2, f32_fact(shapefactoid!(n_ch, (cfg.conv_ch), s, (cfg.nb_erb / 4))))?
+            .with_input_fact(3, f32_fact(shapefactoid!(n_ch, (cfg.conv_ch), s, (cfg.nb_erb / 2))))?
+            .with_input_fact(4, f32_fact(shapefactoid!(n_ch, (cfg.conv_ch), s, (cfg.nb_erb))))?
+            .with_input_names(["emb", "e3", "e2", "e1", "e0"])?
+            .with_output_names(["m"])?;
+
+        let df_dec = read_onnx(&files.df_dec)?
+            .with_input_fact(0, f32_fact(shapefactoid!(n_ch, s, n_hidden)))?
+            .with_input_fact(1, f32_fact(shapefactoid!(n_ch, (cfg.conv_ch), s, (cfg.nb_df))))?
+            .with_input_names(["emb", "c0"])?
+            .with_output_names(["coefs"])?;
+
+        Ok(Self {
+            n_ch,
+            enc: pulse(enc).context("优化编码器失败")?,
+            erb_dec: pulse(erb_dec).context("优化 ERB 解码器失败")?,
+            df_dec: pulse(df_dec).context("优化 DF 解码器失败")?,
+        })
+    }
+}
+
+// tar.gz 中的配置和三个子网络
+struct ModelFiles {
+    config: Ini,
+    enc: Vec<u8>,
+    erb_dec: Vec<u8>,
+    df_dec: Vec<u8>,
+}
+
+impl ModelFiles {
+    fn from_targz<R: Read>(reader: R) -> Result<Self> {
+        let mut archive = tar::Archive::new(GzDecoder::new(reader));
+        let (mut config, mut enc, mut erb_dec, mut df_dec) = (None, None, None, None);
+        for entry in archive.entries()? {
+            let mut entry = entry?;
+            let path = entry.path()?.into_owned();
+            let slot = match path.file_name().and_then(|n| n.to_str()) {
+                Some("config.ini") => {
+                    config = Some(Ini::read_from(&mut entry)?);
+                    continue;
+                }
+                Some("enc.onnx") => &mut enc,
+                Some("erb_dec.onnx") => &mut erb_dec,
+                Some("df_dec.onnx") => &mut df_dec,
+                _ => continue,
+            };
+            let mut bytes = Vec::new();
+            entry.read_to_end(&mut bytes)?;
+            *slot = Some(bytes);
+        }
+        Ok(Self {
+            config: config.ok_or_else(|| anyhow!("模型中缺少 config.ini"))?,
+            enc: enc.ok_or_else(|| anyhow!("模型中缺少 enc.onnx"))?,
+            erb_dec: erb_dec.ok_or_else(|| anyhow!("模型中缺少 erb_dec.onnx"))?,
+            df_dec: df_dec.ok_or_else(|| anyhow!("模型中缺少 df_dec.onnx"))?,
+        })
+    }
+}
+
+// 已解压的模型和按声道数缓存的计划
+pub struct SharedModel {
+    files: ModelFiles,
+    config: ModelConfig,
+    plans: Mutex<Vec<Arc<Plans>>>,
+}
+
+impl SharedModel {
+    pub fn from_targz<R: Read>(reader: R) -> Result<Self> {
+        let files = ModelFiles::from_targz(reader)?;
+        let config = ModelConfig::parse(&files.config)?;
+        Ok(Self { files, config, plans: Mutex::new(Vec::new()) })
+    }
+
+    // 该声道数的计划：首次调用时解析和优化，之后直接共享
+    fn plans(&self, n_ch: usize) -> Result<Arc<Plans>> {
+        let mut plans = self.plans.lock().map_err(|_| anyhow!("模型计划缓存已损坏"))?;
+        if let Some(found) = plans.iter().find(|p| p.n_ch == n_ch) {
+            return Ok(found.clone());
+        }
+        let built = Arc::new(Plans::build(&self.files, &self.config, n_ch)?);
+        plans.push(built.clone());
+        Ok(built)
+    }
+}
+
+// 衰减限制（dB）换算为保留的原始信号比例，不限制时为 None
+fn atten_lim_factor(lim_db: f32) -> Option<f32> {
+    let lim_db = lim_db.abs();
+    if lim_db >= 100. {
+        None
+    } else if lim_db < 0.01 {
+        Some(1.)
+    } else {
+        Some(10f32.powf(-lim_db / 20.))
+    }
+}
+
+// 后滤波：按增益进一步压低噪声占优的频点（与 libDF 的 post_filter 一致）
+fn post_filter(noisy: &[Complex32], enh: &mut [Complex32], beta: f32) {
+    const EPS: f32 = 1e-12;
+    let beta_p1 = beta + 1.;
+    for (x, y) in noisy.iter().zip(enh.iter_mut()) {
+        let g = (y.norm() / (x.norm() + EPS)).clamp(EPS, 1.);
+        let g_sin = g * (g * std::f32::consts::FRAC_PI_2).sin();
+        let pf = beta_p1 / (1. + beta * (g / g_sin).powi(2));
+        *y *= pf;
+    }
+}
+
+// 单个实例：共享计划上的运行状态和各声道的 STFT 状态
+pub struct SharedTract {
+    enc: PlanState,
+    erb_dec: PlanState,
+    df_dec: PlanState,
+    cfg: ModelConfig,
+    ch: usize,
+    post_filter: bool,
+    post_filter_beta: f32,
+    atten_lim: Option<f32>,
+    min_db_thresh: f32,
+    max_db_erb_thresh: f32,
+    max_db_df_thresh: f32,
+    df_states: Vec<DFState>,
+    // 噪声频谱（深度滤波输入，最新帧在末尾）
+    rolling_x: VecDeque<Array2<Complex32>>,
+    // 待增强频谱（队首为延迟 conv_lookahead 帧后要输出的帧）
+    rolling_y: VecDeque<Array2<Complex32>>,
+    erb_feat: Array4<f32>,
+    cplx_feat: Array4<f32>,
+    cplx_scratch: Vec<Complex32>,
+    mask: Array2<f32>,
+    m_zeros: Vec<f32>,
+}
+
+impl SharedTract {
+    pub fn new(model: &SharedModel, params: &InstanceParams) -> Result<Self> {
+        let plans = model.plans(params.n_ch)?;
+        let cfg = model.config.clone();
+        let ch = params.n_ch;
+        let n_freqs = cfg.fft_size / 2 + 1;
+
+        let mut df_states = Vec::with_capacity(ch);
+        for _ in 0..ch {
+            let mut state = DFState::new(cfg.sr, cfg.fft_size, cfg.hop_size, cfg.nb_erb, cfg.min_nb_freqs);
+            state.init_norm_states(cfg.nb_df);
+            df_states.push(state);
+        }
+        let zero_frame = Array2::<Complex32>::zeros((ch, n_freqs));
+        // 至少容纳 df_order 帧，且包含 lookahead 帧之前的参考帧
+        let rolling_x = (0..cfg.df_order.max(cfg.lookahead() + 1)).map(|_| zero_frame.clone()).collect();
+        let rolling_y = (0..cfg.conv_lookahead + 1).map(|_| zero_frame.clone()).collect();
+
+        Ok(Self {
+            enc: SimpleState::new(plans.enc.clone())?,
+            erb_dec: SimpleState::new(plans.erb_dec.clone())?,
+            df_dec: SimpleState::new(plans.df_dec.clone())?,
+            ch,
+            post_filter: params.post_filter_beta > 0.,
+            post_filter_beta: params.post_filter_beta,
+            atten_lim: atten_lim_factor(params.atten_lim_db),
+            min_db_thresh: params.min_db_thresh,
+            max_db_erb_thresh: params.max_db_erb_thresh,
+            max_db_df_thresh: params.max_db_df_thresh,
+            df_states,
+            rolling_x,
+            rolling_y,
+            erb_feat: Array4::zeros((ch, 1, 1, cfg.nb_erb)),
+            cplx_feat: Array4::zeros((ch, 2, 1, cfg.nb_df)),
+            cplx_scratch: vec![Complex32::new(0., 0.); cfg.nb_df],
+            mask: Array2::zeros((ch, cfg.nb_erb)),
+            m_zeros: vec![0.; cfg.nb_erb],
+            cfg,
+        })
+    }
+
+    // 按 LSNR 决定运行哪些阶段：(ERB 掩码, 全零掩码, 深度滤波)
+    fn stages(&self, lsnr: f32) -> (bool, bool, bool) {
+        if lsnr < self.min_db_thresh {
+            (false, true, false)
+        } else if lsnr > self.max_db_erb_thresh {
+            (false, false, false)
+        } else if lsnr > self.max_db_df_thresh {
+            (true, false, false)
+        } else {
+            (true, false, true)
+        }
+    }
+}
+
+impl Backend for SharedTract {
+    fn id(&self) -> i32 {
+        BACKEND_TRACT
+    }
+
+    fn hop_size(&self) -> usize {
+        self.cfg.hop_size
+    }
+
+    fn fft_size(&self) -> usize {
+        self.cfg.fft_size
+    }
+
+    fn lookahead(&self) -> usize {
+        self.cfg.lookahead()
+    }
+
+    fn channels(&self) -> usize {
+        self.ch
+    }
+
+    fn process(&mut self, noisy: ArrayView2<f32>, mut enh: ArrayViewMut2<f32>) -> Result<f32> {
+        let (nb_erb, nb_df, df_order) = (self.cfg.nb_erb, self.cfg.nb_df, self.cfg.df_order);
+        let energy = noisy.iter().fold(0f32, |acc, x| acc + x * x);
+        if energy / (noisy.len() as f32) < 1e-7 {
+            enh.fill(0.);
+            return Ok(-15.);
+        }
+
+        // 分析：当前帧频谱写入最旧的噪声帧缓冲，同时计算编码器的两路特征
+        let mut spec = self.rolling_x.pop_front().context("频谱缓冲为空")?;
+        for (c, (input, state)) in noisy.axis_iter(Axis(0)).zip(self.df_states.iter_mut()).enumerate() {
+            let mut spec_row = spec.row_mut(c);
+            let spec_ch = spec_row.as_slice_mut().context("频谱缓冲不连续")?;
+            state.analysis(input.as_slice().context("输入不连续")?, spec_ch);
+            let mut erb_row = self.erb_feat.slice_mut(s![c, 0, 0, ..]);
+            state.feat_erb(spec_ch, self.cfg.alpha, erb_row.as_slice_mut().context("特征缓冲不连续")?);
+            state.feat_cplx(&spec_ch[..nb_df], self.cfg.alpha, &mut self.cplx_scratch);
+            for (f, v) in self.cplx_scratch.iter().enumerate() {
+                self.cplx_feat[[c, 0, 0, f]] = v.re;
+                self.cplx_feat[[c, 1, 0, f]] = v.im;
+            }
+        }
+        let mut target = self.rolling_y.pop_front().context("频谱缓冲为空")?;
+        target.assign(&spec);
+        self.rolling_y.push_back(target);
+        self.rolling_x.push_back(spec);
+
+        // 编码器输出：e0, e1, e2, e3, emb, c0, lsnr
+        let mut enc_out = self.enc.run(tvec!(
+            Tensor::from(self.erb_feat.clone()).into(),
+            Tensor::from(self.cplx_feat.clone()).into()
+        ))?;
+        let lsnr_out = enc_out.pop().context("编码器缺少 lsnr 输出")?;
+        let lsnr_values = lsnr_out.as_slice::<f32>()?;
+        let lsnr = lsnr_values.iter().sum::<f32>() / lsnr_values.len().max(1) as f32;
+        let c0 = enc_out.pop().context("编码器缺少 c0 输出")?;
+        let emb = enc_out.pop().context("编码器缺少 emb 输出")?;
+        let (apply_erb, apply_zeros, apply_df) = self.stages(lsnr);
+
+        // 增强延迟 conv_lookahead 帧后的频谱（与网络前瞻对齐）
+        let target = self.rolling_y.front_mut().context("频谱缓冲为空")?;
+        let erb = &self.df_states[0].erb;
+        if apply_erb {
+            let e3 = enc_out.pop().context("编码器缺少 e3 输出")?;
+            let e2 = enc_out.pop().context("编码器缺少 e2 输出")?;
+            let e1 = enc_out.pop().context("编码器缺少 e1 输出")?;
+            let e0 = enc_out.pop().context("编码器缺少 e0 输出")?;
+            let m = self.erb_dec.run(tvec!(emb.clone(), e3, e2, e1, e0))?.pop().context("ERB 解码器无输出")?;
+            let m = m.to_array_view::<f32>()?.into_shape((self.ch, nb_erb))?;
+            // 多声道使用同一掩码（各声道掩码的平均），保持声道间的相对电平
+            let mean = m.mean_axis(Axis(0)).context("掩码为空")?;
+            self.mask.assign(&mean.broadcast((self.ch, nb_erb)).context("掩码形状不匹配")?);
+            for (mut spec_ch, mask_ch) in target.axis_iter_mut(Axis(0)).zip(self.mask.axis_iter(Axis(0))) {
+                apply_interp_band_gain(
+                    spec_ch.as_slice_mut().context("频谱缓冲不连续")?,
+                    mask_ch.as_slice().context("掩码不连续")?,
+                    erb,
+                );
+            }
+        } else if apply_zeros {
+            for mut spec_ch in target.axis_iter_mut(Axis(0)) {
+                apply_interp_band_gain(spec_ch.as_slice_mut().context("频谱缓冲不连续")?, &self.m_zeros, erb);
+            }
+        }
+
+        // 深度滤波：低频 nb_df 个频点由最近 df_order 帧噪声频谱加权得到
+        if apply_df {
+            let coefs = self.df_dec.run(tvec!(emb, c0))?.pop().context("DF 解码器无输出")?;
+            let coefs = coefs.to_array_view::<f32>()?.into_shape((self.ch, nb_df, df_order, 2))?;
+            for c in 0..self.ch {
+                for f in 0..nb_df {
+                    let mut acc = Complex32::new(0., 0.);
+                    for (o, frame) in self.rolling_x.iter().take(df_order).enumerate() {
+                        acc += frame[[c, f]] * Complex32::new(coefs[[c, f, o, 0]], coefs[[c, f, o, 1]]);
+                    }
+                    target[[c, f]] = acc;
+                }
+            }
+        }
+
+        // 后滤波和衰减限制以同一帧的噪声频谱为参考
+        let lookahead = self.cfg.lookahead();
+        let noisy_spec = &self.rolling_x[self.rolling_x.len() - lookahead - 1];
+        if self.post_filter {
+            for (x, mut y) in noisy_spec.axis_iter(Axis(0)).zip(target.axis_iter_mut(Axis(0))) {
+                post_filter(
+                    x.as_slice().context("频谱缓冲不连续")?,
+                    y.as_slice_mut().context("频谱缓冲不连续")?,
+                    self.post_filter_beta,
+                );
+            }
+        }
+        if let Some(lim) = self.atten_lim {
+            target.zip_mut_with(noisy_spec, |y, x| *y = *y * (1. - lim) + *x * lim);
+        }
+
+        // 合成
+        for (state, (mut spec_ch, mut output)) in
+            self.df_states.iter_mut().zip(target.axis_iter_mut(Axis(0)).zip(enh.axis_iter_mut(Axis(0))))
+        {
+            state.synthesis(
+                spec_ch.as_slice_mut().context("频谱缓冲不连续")?,
+                output.as_slice_mut().context("输出不连续")?,
+            );
+        }
+        Ok(lsnr)
+    }
+
+    fn set_pf_beta(&mut self, beta: f32) {
+        self.post_filter = beta > 0.;
+        self.post_filter_beta = beta;
+    }
+
+    fn set_atten_lim(&mut self, lim_db: f32) {
+        self.atten_lim = atten_lim_factor(lim_db);
+    }
+}